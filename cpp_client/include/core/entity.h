@@ -61,6 +61,11 @@ public:
     const Health& getHealth() const { return m_health; }
     const Capacitor& getCapacitor() const { return m_capacitor; }
     
+    // Last state received from the server (interpolation target)
+    glm::vec3 getTargetPosition() const { return m_targetPosition; }
+    glm::vec3 getTargetVelocity() const { return m_targetVelocity; }
+    float getTargetRotation() const { return m_targetRotation; }
+    
     // Ship info
     const std::string& getShipType() const { return m_shipType; }
     const std::string& getShipName() const { return m_shipName; }
@@ -2,6 +2,7 @@
 
 #include "core/entity.h"
 #include <memory>
+#include <optional>
 #include <unordered_map>
 #include <vector>
 #include <string>
@@ -9,6 +10,21 @@
 
 namespace atlas {
 
+/**
+ * Fields of one entity in a delta-encoded STATE_UPDATE
+ * Unset fields did not change and keep their current value
+ */
+struct EntityStateDelta {
+    std::optional<glm::vec3> position;
+    std::optional<float> rotation;
+    std::optional<glm::vec3> velocity;
+    std::optional<Health> health;
+    std::optional<Capacitor> capacitor;
+    std::optional<std::string> shipType;
+    std::optional<std::string> shipName;
+    std::optional<std::string> faction;
+};
+
 /**
  * Client-side entity manager
  * Handles entity lifecycle (spawn, update, destroy) from server messages
@@ -48,6 +64,13 @@ public:
                            const std::string& shipName = "",
                            const std::string& faction = "");
 
+    /**
+     * Apply a delta-encoded entity state from server
+     * Fields missing from the delta keep the entity's last received
+     * value; unknown entities are spawned with defaults for them
+     */
+    void updateEntityState(const std::string& id, const EntityStateDelta& delta);
+
     /**
      * Process state update message
      * Updates all entities and removes those not in the update
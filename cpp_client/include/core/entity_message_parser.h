@@ -30,12 +30,22 @@ public:
 
     /**
      * Parse STATE_UPDATE message
+     * Entity fields missing from the update keep their last value
+     * (the server delta-encodes against the last acknowledged snapshot)
      * @param dataJson JSON string containing entities array
      * @param entityManager EntityManager to update entities in
      * @return true if parsed successfully
      */
     static bool parseStateUpdate(const std::string& dataJson, EntityManager& entityManager);
 
+    /**
+     * Parse STATE_UPDATE message and report its sequence number
+     * @param sequence Set to the snapshot sequence, to be acknowledged
+     *                 back to the server with a STATE_ACK
+     */
+    static bool parseStateUpdate(const std::string& dataJson, EntityManager& entityManager,
+                                 uint64_t& sequence);
+
 private:
     // Helper to parse position from JSON
     static glm::vec3 parsePosition(const nlohmann::json& posJson);
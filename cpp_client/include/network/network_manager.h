@@ -123,6 +123,12 @@ public:
      * Send chat message
      */
     void sendChat(const std::string& message);
+
+    /**
+     * Acknowledge an applied state update so the server can send
+     * later ones as deltas against it
+     */
+    void sendStateAck(uint64_t sequence);
     
     /**
      * Inventory management
@@ -185,6 +191,18 @@ public:
     void setMissionCallback(MissionCallback callback) { m_missionCallback = callback; }
     void setErrorCallback(ErrorCallback callback) { m_errorCallback = callback; }
 
+    /**
+     * Ask for the binary wire encoding at the next connect (default on).
+     * The server decides in connect_ack; until then, and if it declines,
+     * JSON is used.
+     */
+    void setPreferBinaryWire(bool prefer) { m_preferBinaryWire = prefer; }
+
+    /**
+     * Whether the server accepted the binary wire encoding
+     */
+    bool isBinaryWire() const { return m_binaryWire; }
+
     /**
      * Get connection state string
      */
@@ -222,6 +240,8 @@ private:
     std::string m_playerId;
     std::string m_characterName;
     bool m_authenticated;
+    bool m_preferBinaryWire;
+    bool m_binaryWire;
     
     enum class State {
         DISCONNECTED,
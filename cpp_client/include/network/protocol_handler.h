@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <functional>
 
@@ -17,6 +18,10 @@ public:
 
     /**
      * Parse incoming message
+     * 
+     * Binary wire frames are decoded and passed to the handler as the
+     * equivalent JSON type and data, so handlers need not care which
+     * encoding the server used.
      */
     void handleMessage(const std::string& message);
 
@@ -30,9 +35,21 @@ public:
     /**
      * Helper methods for common messages
      */
-    std::string createConnectMessage(const std::string& playerId, const std::string& characterName);
+    std::string createConnectMessage(const std::string& playerId, const std::string& characterName,
+                                     bool binaryWire = false);
     std::string createMoveMessage(float vx, float vy, float vz);
     std::string createChatMessage(const std::string& message);
+    std::string createStateAckMessage(uint64_t sequence);
+
+    /**
+     * Binary wire frames for the high-rate messages, sent once the
+     * server has accepted the binary encoding in connect_ack
+     */
+    std::string createBinaryMoveMessage(float vx, float vy, float vz);
+    std::string createBinaryStateAckMessage(uint64_t sequence);
+    std::string createBinaryTargetLockMessage(const std::string& targetId);
+    std::string createBinaryTargetUnlockMessage(const std::string& targetId);
+    std::string createBinaryModuleActivateMessage(int slotIndex, const std::string& targetId = "");
     
     /**
      * Inventory management messages
@@ -104,6 +121,8 @@ public:
     void setMessageHandler(MessageHandler handler) { m_messageHandler = handler; }
 
 private:
+    void handleFrames(const std::string& frames);
+
     MessageHandler m_messageHandler;
 };
 
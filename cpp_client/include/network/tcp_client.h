@@ -40,6 +40,11 @@ public:
      */
     bool send(const std::string& message);
 
+    /**
+     * Send bytes as-is (binary wire frames carry their own length)
+     */
+    bool sendRaw(const std::string& bytes);
+
     /**
      * Set callback for received messages
      */
@@ -52,6 +57,13 @@ public:
 
 private:
     void receiveThread();
+    bool sendBytes(const char* data, size_t size);
+
+    /**
+     * Move complete messages from the receive buffer to the queue:
+     * binary frames by their length header, JSON by newline
+     */
+    void extractMessages(std::string& buffer);
 
 #ifdef _WIN32
     void* m_socket; // SOCKET on Windows (stored as void* to avoid including winsock2.h in header)
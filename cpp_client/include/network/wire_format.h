@@ -0,0 +1,214 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace atlas {
+
+/**
+ * @brief Compact binary encoding of the high-rate protocol messages
+ *
+ * Negotiated per connection at connect time ("wire":"binary" with a
+ * matching "wire_version"); JSON stays the default and is still used for
+ * the connect handshake and every message without a binary form.
+ *
+ * Mirror of the server's network/wire_format.h; the two must stay in
+ * step, and kVersion changes whenever the encoding does.
+ *
+ * Every binary message is one self-delimiting frame:
+ *
+ *     byte 0     kMagic (0xE7, never the first byte of a JSON message)
+ *     byte 1     kVersion
+ *     byte 2     message Type
+ *     byte 3     flags (reserved, 0)
+ *     bytes 4-7  payload length, little endian
+ *
+ * Payload integers are LEB128 varints (signed ones zigzag-encoded),
+ * floats are quantized to a fixed step and sent as signed varints,
+ * rotations as 16-bit angles, and strings as a varint length plus bytes.
+ */
+namespace wire {
+
+constexpr uint8_t kMagic = 0xE7;
+constexpr uint8_t kVersion = 1;
+constexpr size_t kHeaderSize = 8;
+constexpr uint32_t kMaxPayload = 16u * 1024u * 1024u;
+
+// Quantization steps
+constexpr float kPositionStep = 1.0f / 16.0f;   // meters
+constexpr float kVelocityStep = 0.01f;          // m/s
+constexpr float kPointsStep = 0.1f;             // HP, capacitor, damage
+
+enum class Type : uint8_t {
+    StateUpdate = 1,
+    StateAck,
+    InputMove,
+    SpawnEntity,
+    DamageEvent,
+    TargetLock,
+    TargetUnlock,
+    ModuleActivate,
+    ModuleDeactivate,
+    TargetLockAck,
+    TargetUnlockAck,
+    ModuleActivateAck,
+    ModuleDeactivateAck
+};
+
+struct Header {
+    uint8_t version = kVersion;
+    Type type = Type::StateUpdate;
+    uint8_t flags = 0;
+    uint32_t length = 0;
+};
+
+enum class FrameStatus { Complete, Incomplete, Invalid };
+
+/**
+ * @brief Inspect the frame at the start of a buffer
+ * @param frame_size Set to header + payload size when Complete
+ */
+FrameStatus peekFrame(const char* data, size_t size, Header& header, size_t& frame_size);
+
+/// True if the buffer starts like a binary frame rather than JSON
+inline bool isFrame(const std::string& data) {
+    return !data.empty() && static_cast<uint8_t>(data[0]) == kMagic;
+}
+
+/**
+ * @brief Appends primitives to a byte string
+ */
+class Writer {
+public:
+    explicit Writer(std::string& out) : out_(out) {}
+
+    // Start a frame; the payload length is patched in by endFrame()
+    void beginFrame(Type type);
+    void endFrame();
+
+    void u8(uint8_t v) { out_.push_back(static_cast<char>(v)); }
+    void varint(uint64_t v);
+    void svarint(int64_t v);
+    void quantized(float v, float step);
+    void angle(float radians);
+    void str(const std::string& s);
+
+private:
+    std::string& out_;
+    size_t frame_start_ = 0;
+};
+
+/**
+ * @brief Reads primitives back; every read fails once the data runs out
+ */
+class Reader {
+public:
+    Reader(const char* data, size_t size) : data_(data), size_(size) {}
+
+    bool u8(uint8_t& v);
+    bool varint(uint64_t& v);
+    bool svarint(int64_t& v);
+    bool quantized(float& v, float step);
+    bool angle(float& radians);
+    bool str(std::string& s);
+
+    bool ok() const { return ok_; }
+    size_t remaining() const { return size_ - pos_; }
+
+private:
+    bool fail() { ok_ = false; return false; }
+
+    const char* data_;
+    size_t size_;
+    size_t pos_ = 0;
+    bool ok_ = true;
+};
+
+// --- Messages ---
+
+/// One entity in a state_update or spawn_entity; only fields in the mask are valid
+struct EntityState {
+    enum Field : uint8_t {
+        kPos = 1 << 0,
+        kVel = 1 << 1,
+        kHealth = 1 << 2,
+        kCapacitor = 1 << 3,
+        kShip = 1 << 4,
+        kFaction = 1 << 5
+    };
+
+    std::string id;
+    uint8_t fields = 0;
+    float x = 0, y = 0, z = 0, rotation = 0;
+    float vx = 0, vy = 0, vz = 0;
+    float shield = 0, armor = 0, hull = 0;
+    float shield_max = 0, armor_max = 0, hull_max = 0;
+    float capacitor = 0, capacitor_max = 0;
+    std::string ship_type;
+    std::string ship_name;
+    std::string faction;
+};
+
+struct StateUpdate {
+    uint64_t sequence = 0;
+    bool has_baseline = false;
+    uint64_t baseline = 0;
+    bool partial = true;
+    uint64_t timestamp = 0;   // server milliseconds
+    std::vector<std::string> removed;
+    std::vector<EntityState> entities;
+};
+
+struct StateAck {
+    uint64_t sequence = 0;
+};
+
+struct InputMove {
+    float vx = 0, vy = 0, vz = 0;
+};
+
+struct DamageEvent {
+    std::string target_id;
+    float damage = 0;
+    std::string damage_type;
+    std::string layer_hit;
+    bool shield_depleted = false;
+    bool armor_depleted = false;
+    bool hull_critical = false;
+};
+
+/// target_lock / target_unlock requests and their acks
+struct TargetMessage {
+    std::string target_id;
+    bool success = true;      // acks only
+};
+
+/// module_activate / module_deactivate requests and their acks
+struct ModuleMessage {
+    int32_t slot_index = -1;
+    std::string target_id;    // activate only
+    bool success = true;      // acks only
+};
+
+// Each encode() appends one complete frame to out
+void encode(const StateUpdate& msg, std::string& out);
+void encode(const StateAck& msg, std::string& out);
+void encode(const InputMove& msg, std::string& out);
+void encode(const DamageEvent& msg, std::string& out);
+void encodeSpawnEntity(const EntityState& msg, std::string& out);
+void encode(Type type, const TargetMessage& msg, std::string& out);
+void encode(Type type, const ModuleMessage& msg, std::string& out);
+
+// Each decode() parses one payload (the bytes after the header)
+bool decode(const char* payload, size_t size, StateUpdate& msg);
+bool decode(const char* payload, size_t size, StateAck& msg);
+bool decode(const char* payload, size_t size, InputMove& msg);
+bool decode(const char* payload, size_t size, DamageEvent& msg);
+bool decodeSpawnEntity(const char* payload, size_t size, EntityState& msg);
+bool decode(const char* payload, size_t size, TargetMessage& msg);
+bool decode(const char* payload, size_t size, ModuleMessage& msg);
+
+} // namespace wire
+} // namespace atlas
@@ -86,6 +86,31 @@ void EntityManager::updateEntityState(const std::string& id, const glm::vec3& po
     }
 }
 
+void EntityManager::updateEntityState(const std::string& id, const EntityStateDelta& delta) {
+    auto it = m_entities.find(id);
+    if (it == m_entities.end()) {
+        updateEntityState(id, delta.position.value_or(glm::vec3(0.0f)),
+                          delta.velocity.value_or(glm::vec3(0.0f)),
+                          delta.rotation.value_or(0.0f),
+                          delta.health.value_or(Health()),
+                          delta.capacitor.value_or(Capacitor()),
+                          delta.shipType.value_or(""), delta.shipName.value_or(""),
+                          delta.faction.value_or(""));
+        return;
+    }
+
+    // Fill unchanged fields from the last state the server sent
+    const auto& entity = it->second;
+    updateEntityState(id, delta.position.value_or(entity->getTargetPosition()),
+                      delta.velocity.value_or(entity->getTargetVelocity()),
+                      delta.rotation.value_or(entity->getTargetRotation()),
+                      delta.health.value_or(entity->getHealth()),
+                      delta.capacitor.value_or(entity->getCapacitor()),
+                      delta.shipType.value_or(entity->getShipType()),
+                      delta.shipName.value_or(entity->getShipName()),
+                      delta.faction.value_or(entity->getFaction()));
+}
+
 void EntityManager::processStateUpdate(const std::vector<std::string>& entityIds) {
     // Find entities that are no longer in the update
     std::vector<std::string> toRemove;
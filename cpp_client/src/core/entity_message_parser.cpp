@@ -99,14 +99,19 @@ bool EntityMessageParser::parseDestroyEntity(const std::string& dataJson, Entity
 }
 
 bool EntityMessageParser::parseStateUpdate(const std::string& dataJson, EntityManager& entityManager) {
+    uint64_t sequence = 0;
+    return parseStateUpdate(dataJson, entityManager, sequence);
+}
+
+bool EntityMessageParser::parseStateUpdate(const std::string& dataJson, EntityManager& entityManager,
+                                           uint64_t& sequence) {
     try {
         auto data = nlohmann::json::parse(dataJson);
         
         // Extract snapshot metadata (for future packet loss detection and timing)
-        // TODO: Use these values for interpolation delay calculation and dropped packet detection
-        uint64_t sequence = data.value("sequence", 0ULL);
+        // TODO: Use the timestamp for interpolation delay calculation
+        sequence = data.value("sequence", 0ULL);
         uint64_t timestamp = data.value("timestamp", 0ULL);
-        (void)sequence;   // Suppress unused variable warning
         (void)timestamp;  // Suppress unused variable warning
         
         // Extract entities array
@@ -118,7 +123,7 @@ bool EntityMessageParser::parseStateUpdate(const std::string& dataJson, EntityMa
         auto entitiesArray = data["entities"];
         std::vector<std::string> entityIds;
         
-        // Process each entity
+        // Process each entity; absent fields are unchanged
         for (const auto& entityData : entitiesArray) {
             // Extract entity ID
             std::string entityId = entityData.value("id", "");
@@ -127,52 +132,61 @@ bool EntityMessageParser::parseStateUpdate(const std::string& dataJson, EntityMa
             }
             
             entityIds.push_back(entityId);
+            EntityStateDelta delta;
             
-            // Extract position
-            glm::vec3 position{0.0f};
+            // Extract position and rotation
             if (entityData.contains("pos")) {
-                position = parsePosition(entityData["pos"]);
+                delta.position = parsePosition(entityData["pos"]);
+                if (entityData["pos"].contains("rot")) {
+                    delta.rotation = entityData["pos"].value("rot", 0.0f);
+                }
             }
             
             // Extract velocity
-            glm::vec3 velocity{0.0f};
             if (entityData.contains("vel")) {
                 const auto& velJson = entityData["vel"];
-                velocity.x = velJson.value("vx", 0.0f);
-                velocity.y = velJson.value("vy", 0.0f);
-                velocity.z = velJson.value("vz", 0.0f);
-            }
-            
-            // Extract rotation
-            float rotation = 0.0f;
-            if (entityData.contains("pos") && entityData["pos"].contains("rot")) {
-                rotation = entityData["pos"].value("rot", 0.0f);
+                delta.velocity = glm::vec3(velJson.value("vx", 0.0f),
+                                           velJson.value("vy", 0.0f),
+                                           velJson.value("vz", 0.0f));
             }
             
             // Extract health
-            Health health;
             if (entityData.contains("health")) {
-                health = parseHealth(entityData["health"]);
+                delta.health = parseHealth(entityData["health"]);
             }
             
             // Extract capacitor
-            Capacitor capacitor;
             if (entityData.contains("capacitor")) {
-                capacitor = parseCapacitor(entityData["capacitor"]);
+                delta.capacitor = parseCapacitor(entityData["capacitor"]);
             }
             
             // Extract ship info (needed for correct model selection)
-            std::string shipType = entityData.value("ship_type", "");
-            std::string shipName = entityData.value("ship_name", "");
-            std::string faction = entityData.value("faction", "");
+            if (entityData.contains("ship_type")) {
+                delta.shipType = entityData.value("ship_type", "");
+                delta.shipName = entityData.value("ship_name", "");
+            }
+            if (entityData.contains("faction")) {
+                delta.faction = entityData.value("faction", "");
+            }
             
             // Update entity state
-            entityManager.updateEntityState(entityId, position, velocity, rotation, health, capacitor,
-                                            shipType, shipName, faction);
+            entityManager.updateEntityState(entityId, delta);
         }
         
-        // Process state update (remove entities not in update)
-        entityManager.processStateUpdate(entityIds);
+        if (data.value("partial", false)) {
+            // Interest-managed update: unlisted entities keep their last
+            // state; only the ones the server names are removed
+            if (data.contains("removed") && data["removed"].is_array()) {
+                for (const auto& removedId : data["removed"]) {
+                    if (removedId.is_string()) {
+                        entityManager.destroyEntity(removedId.get<std::string>());
+                    }
+                }
+            }
+        } else {
+            // Process state update (remove entities not in update)
+            entityManager.processStateUpdate(entityIds);
+        }
         return true;
         
     } catch (const nlohmann::json::exception& e) {
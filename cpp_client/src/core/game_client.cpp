@@ -94,9 +94,14 @@ void GameClient::handleDestroyEntity(const std::string& dataJson) {
 }
 
 void GameClient::handleStateUpdate(const std::string& dataJson) {
-    if (!EntityMessageParser::parseStateUpdate(dataJson, m_entityManager)) {
+    uint64_t sequence = 0;
+    if (!EntityMessageParser::parseStateUpdate(dataJson, m_entityManager, sequence)) {
         std::cerr << "GameClient: Failed to parse STATE_UPDATE message" << std::endl;
+        return;
     }
+    
+    // Lets the server delta-encode later updates against this one
+    m_networkManager.sendStateAck(sequence);
 }
 
 void GameClient::handleConnectAck(const std::string& dataJson) {
@@ -8,6 +8,8 @@ NetworkManager::NetworkManager()
     : m_tcpClient(std::make_unique<TCPClient>())
     , m_protocolHandler(std::make_unique<ProtocolHandler>())
     , m_authenticated(false)
+    , m_preferBinaryWire(true)
+    , m_binaryWire(false)
     , m_state(State::DISCONNECTED)
 {
     // Set up callbacks
@@ -33,6 +35,7 @@ bool NetworkManager::connect(const std::string& host, int port,
 
     m_playerId = playerId;
     m_characterName = characterName;
+    m_binaryWire = false;
     m_state = State::CONNECTING;
 
     std::cout << "Connecting to " << host << ":" << port << " as " << characterName << std::endl;
@@ -46,7 +49,7 @@ bool NetworkManager::connect(const std::string& host, int port,
     m_state = State::CONNECTED;
 
     // Send CONNECT message
-    std::string connectMsg = m_protocolHandler->createConnectMessage(playerId, characterName);
+    std::string connectMsg = m_protocolHandler->createConnectMessage(playerId, characterName, m_preferBinaryWire);
     if (!m_tcpClient->send(connectMsg)) {
         std::cerr << "Failed to send CONNECT message" << std::endl;
         disconnect();
@@ -62,6 +65,7 @@ void NetworkManager::disconnect() {
         m_tcpClient->disconnect();
         m_state = State::DISCONNECTED;
         m_authenticated = false;
+        m_binaryWire = false;
         std::cout << "Disconnected" << std::endl;
     }
 }
@@ -84,10 +88,27 @@ void NetworkManager::registerHandler(const std::string& type, TypedMessageHandle
 void NetworkManager::sendMove(float vx, float vy, float vz) {
     if (!isConnected()) return;
     
+    if (m_binaryWire) {
+        m_tcpClient->sendRaw(m_protocolHandler->createBinaryMoveMessage(vx, vy, vz));
+        return;
+    }
+    
     std::string msg = m_protocolHandler->createMoveMessage(vx, vy, vz);
     m_tcpClient->send(msg);
 }
 
+void NetworkManager::sendStateAck(uint64_t sequence) {
+    if (!isConnected()) return;
+    
+    if (m_binaryWire) {
+        m_tcpClient->sendRaw(m_protocolHandler->createBinaryStateAckMessage(sequence));
+        return;
+    }
+    
+    std::string msg = m_protocolHandler->createStateAckMessage(sequence);
+    m_tcpClient->send(msg);
+}
+
 void NetworkManager::sendChat(const std::string& message) {
     if (!isConnected()) return;
     
@@ -136,6 +157,11 @@ void NetworkManager::sendModuleUnfit(const std::string& slotType, int slotIndex)
 void NetworkManager::sendModuleActivate(int slotIndex, const std::string& targetId) {
     if (!isConnected()) return;
     
+    if (m_binaryWire) {
+        m_tcpClient->sendRaw(m_protocolHandler->createBinaryModuleActivateMessage(slotIndex, targetId));
+        return;
+    }
+    
     std::string msg = m_protocolHandler->createModuleActivateMessage(slotIndex, targetId);
     m_tcpClient->send(msg);
 }
@@ -144,6 +170,11 @@ void NetworkManager::sendModuleActivate(int slotIndex, const std::string& target
 void NetworkManager::sendTargetLock(const std::string& targetId) {
     if (!isConnected()) return;
     
+    if (m_binaryWire) {
+        m_tcpClient->sendRaw(m_protocolHandler->createBinaryTargetLockMessage(targetId));
+        return;
+    }
+    
     std::string msg = m_protocolHandler->createTargetLockMessage(targetId);
     m_tcpClient->send(msg);
 }
@@ -151,6 +182,11 @@ void NetworkManager::sendTargetLock(const std::string& targetId) {
 void NetworkManager::sendTargetUnlock(const std::string& targetId) {
     if (!isConnected()) return;
     
+    if (m_binaryWire) {
+        m_tcpClient->sendRaw(m_protocolHandler->createBinaryTargetUnlockMessage(targetId));
+        return;
+    }
+    
     std::string msg = m_protocolHandler->createTargetUnlockMessage(targetId);
     m_tcpClient->send(msg);
 }
@@ -284,7 +320,14 @@ void NetworkManager::onProtocolMessage(const std::string& type, const std::strin
     if (type == "connect_ack") {
         m_state = State::AUTHENTICATED;
         m_authenticated = true;
-        std::cout << "Connection acknowledged by server" << std::endl;
+        try {
+            auto j = nlohmann::json::parse(dataJson);
+            m_binaryWire = m_preferBinaryWire && j.value("wire", "json") == "binary";
+        } catch (const nlohmann::json::exception&) {
+            m_binaryWire = false;
+        }
+        std::cout << "Connection acknowledged by server ("
+                  << (m_binaryWire ? "binary" : "JSON") << " encoding)" << std::endl;
     } else if (type == "error") {
         handleErrorResponse(dataJson);
     }
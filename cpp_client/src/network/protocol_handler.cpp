@@ -1,4 +1,5 @@
 #include "network/protocol_handler.h"
+#include "network/wire_format.h"
 #include <nlohmann/json.hpp>
 #include <iostream>
 #include <chrono>
@@ -11,6 +12,11 @@ ProtocolHandler::ProtocolHandler() {
 }
 
 void ProtocolHandler::handleMessage(const std::string& message) {
+    if (wire::isFrame(message)) {
+        handleFrames(message);
+        return;
+    }
+
     try {
         auto j = json::parse(message);
         
@@ -37,6 +43,127 @@ void ProtocolHandler::handleMessage(const std::string& message) {
     }
 }
 
+namespace {
+
+json entityToJson(const wire::EntityState& e, const char* idKey) {
+    json j;
+    j[idKey] = e.id;
+    if (e.fields & wire::EntityState::kPos) {
+        j["pos"] = {{"x", e.x}, {"y", e.y}, {"z", e.z}, {"rot", e.rotation}};
+    }
+    if (e.fields & wire::EntityState::kVel) {
+        j["vel"] = {{"vx", e.vx}, {"vy", e.vy}, {"vz", e.vz}};
+    }
+    if (e.fields & wire::EntityState::kHealth) {
+        j["health"] = {{"shield", e.shield}, {"armor", e.armor}, {"hull", e.hull},
+                       {"max_shield", e.shield_max}, {"max_armor", e.armor_max},
+                       {"max_hull", e.hull_max}};
+    }
+    if (e.fields & wire::EntityState::kCapacitor) {
+        j["capacitor"] = {{"current", e.capacitor}, {"max", e.capacitor_max}};
+    }
+    if (e.fields & wire::EntityState::kShip) {
+        j["ship_type"] = e.ship_type;
+        j["ship_name"] = e.ship_name;
+    }
+    if (e.fields & wire::EntityState::kFaction) {
+        j["faction"] = e.faction;
+    }
+    return j;
+}
+
+// Decode one frame payload into the type and data of the matching JSON message
+bool frameToJson(const wire::Header& header, const char* payload, std::string& type, json& data) {
+    switch (header.type) {
+        case wire::Type::StateUpdate: {
+            wire::StateUpdate msg;
+            if (!wire::decode(payload, header.length, msg)) return false;
+            type = "state_update";
+            data["sequence"] = msg.sequence;
+            if (msg.has_baseline) data["baseline"] = msg.baseline;
+            data["timestamp"] = msg.timestamp;
+            data["partial"] = msg.partial;
+            data["removed"] = msg.removed;
+            data["entities"] = json::array();
+            for (const auto& e : msg.entities) {
+                data["entities"].push_back(entityToJson(e, "id"));
+            }
+            return true;
+        }
+        case wire::Type::SpawnEntity: {
+            wire::EntityState msg;
+            if (!wire::decodeSpawnEntity(payload, header.length, msg)) return false;
+            type = "spawn_entity";
+            data = entityToJson(msg, "entity_id");
+            if (data.contains("pos")) {
+                data["position"] = data["pos"];
+                data.erase("pos");
+            }
+            return true;
+        }
+        case wire::Type::DamageEvent: {
+            wire::DamageEvent msg;
+            if (!wire::decode(payload, header.length, msg)) return false;
+            type = "damage_event";
+            data["target_id"] = msg.target_id;
+            data["damage"] = msg.damage;
+            data["damage_type"] = msg.damage_type;
+            data["layer_hit"] = msg.layer_hit;
+            data["shield_depleted"] = msg.shield_depleted;
+            data["armor_depleted"] = msg.armor_depleted;
+            data["hull_critical"] = msg.hull_critical;
+            return true;
+        }
+        case wire::Type::TargetLockAck:
+        case wire::Type::TargetUnlockAck: {
+            wire::TargetMessage msg;
+            if (!wire::decode(payload, header.length, msg)) return false;
+            bool lock = header.type == wire::Type::TargetLockAck;
+            type = lock ? "target_lock_ack" : "target_unlock_ack";
+            data["target_id"] = msg.target_id;
+            if (lock) data["success"] = msg.success;
+            return true;
+        }
+        case wire::Type::ModuleActivateAck:
+        case wire::Type::ModuleDeactivateAck: {
+            wire::ModuleMessage msg;
+            if (!wire::decode(payload, header.length, msg)) return false;
+            bool activate = header.type == wire::Type::ModuleActivateAck;
+            type = activate ? "module_activate_ack" : "module_deactivate_ack";
+            data["slot_index"] = msg.slot_index;
+            if (activate) data["success"] = msg.success;
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+
+} // namespace
+
+void ProtocolHandler::handleFrames(const std::string& frames) {
+    size_t offset = 0;
+    while (offset < frames.size()) {
+        wire::Header header;
+        size_t frameSize = 0;
+        if (wire::peekFrame(frames.data() + offset, frames.size() - offset, header, frameSize)
+                != wire::FrameStatus::Complete) {
+            std::cerr << "Malformed binary frame" << std::endl;
+            return;
+        }
+
+        std::string type;
+        json data = json::object();
+        if (!frameToJson(header, frames.data() + offset + wire::kHeaderSize, type, data)) {
+            std::cerr << "Failed to decode binary message type "
+                      << static_cast<int>(header.type) << std::endl;
+        } else if (m_messageHandler) {
+            m_messageHandler(type, data.dump());
+        }
+        offset += frameSize;
+    }
+}
+
 std::string ProtocolHandler::createMessage(const std::string& type, const std::string& dataJson) {
     try {
         json j;
@@ -61,11 +188,17 @@ std::string ProtocolHandler::createMessage(const std::string& type, const std::s
     }
 }
 
-std::string ProtocolHandler::createConnectMessage(const std::string& playerId, const std::string& characterName) {
+std::string ProtocolHandler::createConnectMessage(const std::string& playerId, const std::string& characterName,
+                                                  bool binaryWire) {
     json data;
     data["player_id"] = playerId;
     data["character_name"] = characterName;
     data["version"] = "0.1.0";
+    if (binaryWire) {
+        // Servers that don't know the binary encoding ignore these
+        data["wire"] = "binary";
+        data["wire_version"] = wire::kVersion;
+    }
     return createMessage("connect", data.dump());
 }
 
@@ -79,6 +212,55 @@ std::string ProtocolHandler::createMoveMessage(float vx, float vy, float vz) {
     return createMessage("input_move", data.dump());
 }
 
+std::string ProtocolHandler::createStateAckMessage(uint64_t sequence) {
+    json data;
+    data["sequence"] = sequence;
+    return createMessage("state_ack", data.dump());
+}
+
+std::string ProtocolHandler::createBinaryMoveMessage(float vx, float vy, float vz) {
+    wire::InputMove msg;
+    msg.vx = vx;
+    msg.vy = vy;
+    msg.vz = vz;
+    std::string frame;
+    wire::encode(msg, frame);
+    return frame;
+}
+
+std::string ProtocolHandler::createBinaryStateAckMessage(uint64_t sequence) {
+    wire::StateAck msg;
+    msg.sequence = sequence;
+    std::string frame;
+    wire::encode(msg, frame);
+    return frame;
+}
+
+std::string ProtocolHandler::createBinaryTargetLockMessage(const std::string& targetId) {
+    wire::TargetMessage msg;
+    msg.target_id = targetId;
+    std::string frame;
+    wire::encode(wire::Type::TargetLock, msg, frame);
+    return frame;
+}
+
+std::string ProtocolHandler::createBinaryTargetUnlockMessage(const std::string& targetId) {
+    wire::TargetMessage msg;
+    msg.target_id = targetId;
+    std::string frame;
+    wire::encode(wire::Type::TargetUnlock, msg, frame);
+    return frame;
+}
+
+std::string ProtocolHandler::createBinaryModuleActivateMessage(int slotIndex, const std::string& targetId) {
+    wire::ModuleMessage msg;
+    msg.slot_index = slotIndex;
+    msg.target_id = targetId;
+    std::string frame;
+    wire::encode(wire::Type::ModuleActivate, msg, frame);
+    return frame;
+}
+
 std::string ProtocolHandler::createChatMessage(const std::string& message) {
     json data;
     data["message"] = message;
@@ -1,4 +1,5 @@
 #include "network/tcp_client.h"
+#include "network/wire_format.h"
 #include <iostream>
 #include <cstring>
 
@@ -155,10 +156,19 @@ bool TCPClient::send(const std::string& message) {
 
     std::cout << "[DEBUG] Sending: " << message << std::endl;
 
+    return sendBytes(msg.data(), msg.size());
+}
+
+bool TCPClient::sendRaw(const std::string& bytes) {
+    if (!m_connected) return false;
+    return sendBytes(bytes.data(), bytes.size());
+}
+
+bool TCPClient::sendBytes(const char* data, size_t size) {
 #ifdef _WIN32
-    int result = ::send(static_cast<SOCKET>(reinterpret_cast<uintptr_t>(m_socket)), msg.c_str(), static_cast<int>(msg.length()), 0);
+    int result = ::send(static_cast<SOCKET>(reinterpret_cast<uintptr_t>(m_socket)), data, static_cast<int>(size), 0);
 #else
-    ssize_t result = ::send(m_socket, msg.c_str(), msg.length(), 0);
+    ssize_t result = ::send(m_socket, data, size, 0);
 #endif
 
     if (result == SOCKET_ERROR) {
@@ -185,27 +195,15 @@ void TCPClient::receiveThread() {
 
     while (m_connected) {
 #ifdef _WIN32
-        int bytesReceived = recv(static_cast<SOCKET>(reinterpret_cast<uintptr_t>(m_socket)), buffer, sizeof(buffer) - 1, 0);
+        int bytesReceived = recv(static_cast<SOCKET>(reinterpret_cast<uintptr_t>(m_socket)), buffer, sizeof(buffer), 0);
 #else
-        ssize_t bytesReceived = recv(m_socket, buffer, sizeof(buffer) - 1, 0);
+        ssize_t bytesReceived = recv(m_socket, buffer, sizeof(buffer), 0);
 #endif
 
         if (bytesReceived > 0) {
-            buffer[bytesReceived] = '\0';
-            incompleteMessage += buffer;
-
-            // Process complete messages (delimited by newline)
-            size_t pos;
-            while ((pos = incompleteMessage.find('\n')) != std::string::npos) {
-                std::string message = incompleteMessage.substr(0, pos);
-                incompleteMessage = incompleteMessage.substr(pos + 1);
-
-                if (!message.empty()) {
-                    std::cout << "[DEBUG] Received: " << message << std::endl;
-                    std::lock_guard<std::mutex> lock(m_queueMutex);
-                    m_messageQueue.push(message);
-                }
-            }
+            // Binary frames may contain any byte, so append by length
+            incompleteMessage.append(buffer, static_cast<size_t>(bytesReceived));
+            extractMessages(incompleteMessage);
         } else if (bytesReceived == 0) {
             // Connection closed
             std::cout << "Server closed connection" << std::endl;
@@ -231,4 +229,37 @@ void TCPClient::receiveThread() {
     }
 }
 
+void TCPClient::extractMessages(std::string& buffer) {
+    size_t offset = 0;
+    while (offset < buffer.size()) {
+        std::string message;
+        if (static_cast<uint8_t>(buffer[offset]) == wire::kMagic) {
+            wire::Header header;
+            size_t frameSize = 0;
+            wire::FrameStatus status = wire::peekFrame(buffer.data() + offset, buffer.size() - offset,
+                                                       header, frameSize);
+            if (status == wire::FrameStatus::Incomplete) break;
+            if (status == wire::FrameStatus::Invalid) {
+                // The stream can't be resynchronised after a bad length
+                std::cerr << "Invalid binary frame from server" << std::endl;
+                buffer.clear();
+                return;
+            }
+            message.assign(buffer, offset, frameSize);
+            offset += frameSize;
+        } else {
+            size_t pos = buffer.find('\n', offset);
+            if (pos == std::string::npos) break;
+            message.assign(buffer, offset, pos - offset);
+            offset = pos + 1;
+            if (message.empty()) continue;
+            std::cout << "[DEBUG] Received: " << message << std::endl;
+        }
+
+        std::lock_guard<std::mutex> lock(m_queueMutex);
+        m_messageQueue.push(std::move(message));
+    }
+    buffer.erase(0, offset);
+}
+
 } // namespace atlas
@@ -0,0 +1,362 @@
+#include "network/wire_format.h"
+#include <cmath>
+#include <limits>
+
+namespace atlas {
+namespace wire {
+
+namespace {
+
+constexpr float kPi = 3.14159265358979f;
+
+void writeEntity(Writer& w, const EntityState& e) {
+    w.str(e.id);
+    w.u8(e.fields);
+    if (e.fields & EntityState::kPos) {
+        w.quantized(e.x, kPositionStep);
+        w.quantized(e.y, kPositionStep);
+        w.quantized(e.z, kPositionStep);
+        w.angle(e.rotation);
+    }
+    if (e.fields & EntityState::kVel) {
+        w.quantized(e.vx, kVelocityStep);
+        w.quantized(e.vy, kVelocityStep);
+        w.quantized(e.vz, kVelocityStep);
+    }
+    if (e.fields & EntityState::kHealth) {
+        w.quantized(e.shield, kPointsStep);
+        w.quantized(e.armor, kPointsStep);
+        w.quantized(e.hull, kPointsStep);
+        w.quantized(e.shield_max, kPointsStep);
+        w.quantized(e.armor_max, kPointsStep);
+        w.quantized(e.hull_max, kPointsStep);
+    }
+    if (e.fields & EntityState::kCapacitor) {
+        w.quantized(e.capacitor, kPointsStep);
+        w.quantized(e.capacitor_max, kPointsStep);
+    }
+    if (e.fields & EntityState::kShip) {
+        w.str(e.ship_type);
+        w.str(e.ship_name);
+    }
+    if (e.fields & EntityState::kFaction) {
+        w.str(e.faction);
+    }
+}
+
+bool readEntity(Reader& r, EntityState& e) {
+    if (!r.str(e.id) || !r.u8(e.fields)) return false;
+    if (e.fields & EntityState::kPos) {
+        r.quantized(e.x, kPositionStep);
+        r.quantized(e.y, kPositionStep);
+        r.quantized(e.z, kPositionStep);
+        r.angle(e.rotation);
+    }
+    if (e.fields & EntityState::kVel) {
+        r.quantized(e.vx, kVelocityStep);
+        r.quantized(e.vy, kVelocityStep);
+        r.quantized(e.vz, kVelocityStep);
+    }
+    if (e.fields & EntityState::kHealth) {
+        r.quantized(e.shield, kPointsStep);
+        r.quantized(e.armor, kPointsStep);
+        r.quantized(e.hull, kPointsStep);
+        r.quantized(e.shield_max, kPointsStep);
+        r.quantized(e.armor_max, kPointsStep);
+        r.quantized(e.hull_max, kPointsStep);
+    }
+    if (e.fields & EntityState::kCapacitor) {
+        r.quantized(e.capacitor, kPointsStep);
+        r.quantized(e.capacitor_max, kPointsStep);
+    }
+    if (e.fields & EntityState::kShip) {
+        r.str(e.ship_type);
+        r.str(e.ship_name);
+    }
+    if (e.fields & EntityState::kFaction) {
+        r.str(e.faction);
+    }
+    return r.ok();
+}
+
+// A count can never exceed the bytes left, which bounds reserve()
+bool readCount(Reader& r, uint64_t& count) {
+    return r.varint(count) && count <= r.remaining();
+}
+
+} // namespace
+
+FrameStatus peekFrame(const char* data, size_t size, Header& header, size_t& frame_size) {
+    if (size == 0) return FrameStatus::Incomplete;
+    if (static_cast<uint8_t>(data[0]) != kMagic) return FrameStatus::Invalid;
+    if (size < kHeaderSize) return FrameStatus::Incomplete;
+
+    const auto* bytes = reinterpret_cast<const uint8_t*>(data);
+    header.version = bytes[1];
+    header.type = static_cast<Type>(bytes[2]);
+    header.flags = bytes[3];
+    header.length = static_cast<uint32_t>(bytes[4])
+                  | (static_cast<uint32_t>(bytes[5]) << 8)
+                  | (static_cast<uint32_t>(bytes[6]) << 16)
+                  | (static_cast<uint32_t>(bytes[7]) << 24);
+    if (header.version != kVersion || header.length > kMaxPayload) return FrameStatus::Invalid;
+
+    frame_size = kHeaderSize + header.length;
+    return size >= frame_size ? FrameStatus::Complete : FrameStatus::Incomplete;
+}
+
+// --- Writer ---
+
+void Writer::beginFrame(Type type) {
+    frame_start_ = out_.size();
+    u8(kMagic);
+    u8(kVersion);
+    u8(static_cast<uint8_t>(type));
+    u8(0);
+    out_.append(4, '\0');
+}
+
+void Writer::endFrame() {
+    uint32_t length = static_cast<uint32_t>(out_.size() - frame_start_ - kHeaderSize);
+    for (int i = 0; i < 4; ++i) {
+        out_[frame_start_ + 4 + i] = static_cast<char>((length >> (8 * i)) & 0xFF);
+    }
+}
+
+void Writer::varint(uint64_t v) {
+    while (v >= 0x80) {
+        out_.push_back(static_cast<char>((v & 0x7F) | 0x80));
+        v >>= 7;
+    }
+    out_.push_back(static_cast<char>(v));
+}
+
+void Writer::svarint(int64_t v) {
+    varint((static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63));
+}
+
+void Writer::quantized(float v, float step) {
+    double q = std::nearbyint(static_cast<double>(v) / step);
+    if (!(q == q)) q = 0.0;  // NaN
+    const double limit = static_cast<double>(std::numeric_limits<int64_t>::max() / 2);
+    if (q > limit) q = limit;
+    if (q < -limit) q = -limit;
+    svarint(static_cast<int64_t>(q));
+}
+
+void Writer::angle(float radians) {
+    // Wrap into [-pi, pi) and map onto a signed 16-bit range
+    float wrapped = std::remainder(radians, 2.0f * kPi);
+    int32_t q = static_cast<int32_t>(std::lround(wrapped / kPi * 32768.0f));
+    if (q > 32767) q -= 65536;
+    uint16_t bits = static_cast<uint16_t>(static_cast<int16_t>(q));
+    u8(static_cast<uint8_t>(bits & 0xFF));
+    u8(static_cast<uint8_t>(bits >> 8));
+}
+
+void Writer::str(const std::string& s) {
+    varint(s.size());
+    out_.append(s);
+}
+
+// --- Reader ---
+
+bool Reader::u8(uint8_t& v) {
+    if (!ok_ || pos_ >= size_) return fail();
+    v = static_cast<uint8_t>(data_[pos_++]);
+    return true;
+}
+
+bool Reader::varint(uint64_t& v) {
+    v = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        uint8_t byte = 0;
+        if (!u8(byte)) return false;
+        v |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) return true;
+    }
+    return fail();
+}
+
+bool Reader::svarint(int64_t& v) {
+    uint64_t raw = 0;
+    if (!varint(raw)) return false;
+    v = static_cast<int64_t>(raw >> 1) ^ -static_cast<int64_t>(raw & 1);
+    return true;
+}
+
+bool Reader::quantized(float& v, float step) {
+    int64_t q = 0;
+    if (!svarint(q)) return false;
+    v = static_cast<float>(static_cast<double>(q) * step);
+    return true;
+}
+
+bool Reader::angle(float& radians) {
+    uint8_t lo = 0, hi = 0;
+    if (!u8(lo) || !u8(hi)) return false;
+    int16_t q = static_cast<int16_t>(static_cast<uint16_t>(lo | (hi << 8)));
+    radians = static_cast<float>(q) / 32768.0f * kPi;
+    return true;
+}
+
+bool Reader::str(std::string& s) {
+    uint64_t length = 0;
+    if (!varint(length)) return false;
+    if (length > size_ - pos_) return fail();
+    s.assign(data_ + pos_, static_cast<size_t>(length));
+    pos_ += static_cast<size_t>(length);
+    return true;
+}
+
+// --- Encoders ---
+
+void encode(const StateUpdate& msg, std::string& out) {
+    Writer w(out);
+    w.beginFrame(Type::StateUpdate);
+    w.varint(msg.sequence);
+    w.u8(static_cast<uint8_t>((msg.has_baseline ? 1 : 0) | (msg.partial ? 2 : 0)));
+    if (msg.has_baseline) w.varint(msg.baseline);
+    w.varint(msg.timestamp);
+    w.varint(msg.removed.size());
+    for (const auto& id : msg.removed) w.str(id);
+    w.varint(msg.entities.size());
+    for (const auto& entity : msg.entities) writeEntity(w, entity);
+    w.endFrame();
+}
+
+void encode(const StateAck& msg, std::string& out) {
+    Writer w(out);
+    w.beginFrame(Type::StateAck);
+    w.varint(msg.sequence);
+    w.endFrame();
+}
+
+void encode(const InputMove& msg, std::string& out) {
+    Writer w(out);
+    w.beginFrame(Type::InputMove);
+    w.quantized(msg.vx, kVelocityStep);
+    w.quantized(msg.vy, kVelocityStep);
+    w.quantized(msg.vz, kVelocityStep);
+    w.endFrame();
+}
+
+void encode(const DamageEvent& msg, std::string& out) {
+    Writer w(out);
+    w.beginFrame(Type::DamageEvent);
+    w.str(msg.target_id);
+    w.quantized(msg.damage, kPointsStep);
+    w.str(msg.damage_type);
+    w.str(msg.layer_hit);
+    w.u8(static_cast<uint8_t>((msg.shield_depleted ? 1 : 0) |
+                              (msg.armor_depleted ? 2 : 0) |
+                              (msg.hull_critical ? 4 : 0)));
+    w.endFrame();
+}
+
+void encodeSpawnEntity(const EntityState& msg, std::string& out) {
+    Writer w(out);
+    w.beginFrame(Type::SpawnEntity);
+    writeEntity(w, msg);
+    w.endFrame();
+}
+
+void encode(Type type, const TargetMessage& msg, std::string& out) {
+    Writer w(out);
+    w.beginFrame(type);
+    w.str(msg.target_id);
+    w.u8(msg.success ? 1 : 0);
+    w.endFrame();
+}
+
+void encode(Type type, const ModuleMessage& msg, std::string& out) {
+    Writer w(out);
+    w.beginFrame(type);
+    w.svarint(msg.slot_index);
+    w.str(msg.target_id);
+    w.u8(msg.success ? 1 : 0);
+    w.endFrame();
+}
+
+// --- Decoders ---
+
+bool decode(const char* payload, size_t size, StateUpdate& msg) {
+    Reader r(payload, size);
+    uint8_t flags = 0;
+    if (!r.varint(msg.sequence) || !r.u8(flags)) return false;
+    msg.has_baseline = (flags & 1) != 0;
+    msg.partial = (flags & 2) != 0;
+    msg.baseline = 0;
+    if (msg.has_baseline && !r.varint(msg.baseline)) return false;
+    if (!r.varint(msg.timestamp)) return false;
+
+    uint64_t count = 0;
+    if (!readCount(r, count)) return false;
+    msg.removed.resize(static_cast<size_t>(count));
+    for (auto& id : msg.removed) {
+        if (!r.str(id)) return false;
+    }
+
+    if (!readCount(r, count)) return false;
+    msg.entities.resize(static_cast<size_t>(count));
+    for (auto& entity : msg.entities) {
+        if (!readEntity(r, entity)) return false;
+    }
+    return r.ok();
+}
+
+bool decode(const char* payload, size_t size, StateAck& msg) {
+    Reader r(payload, size);
+    return r.varint(msg.sequence);
+}
+
+bool decode(const char* payload, size_t size, InputMove& msg) {
+    Reader r(payload, size);
+    r.quantized(msg.vx, kVelocityStep);
+    r.quantized(msg.vy, kVelocityStep);
+    r.quantized(msg.vz, kVelocityStep);
+    return r.ok();
+}
+
+bool decode(const char* payload, size_t size, DamageEvent& msg) {
+    Reader r(payload, size);
+    uint8_t flags = 0;
+    r.str(msg.target_id);
+    r.quantized(msg.damage, kPointsStep);
+    r.str(msg.damage_type);
+    r.str(msg.layer_hit);
+    r.u8(flags);
+    msg.shield_depleted = (flags & 1) != 0;
+    msg.armor_depleted = (flags & 2) != 0;
+    msg.hull_critical = (flags & 4) != 0;
+    return r.ok();
+}
+
+bool decodeSpawnEntity(const char* payload, size_t size, EntityState& msg) {
+    Reader r(payload, size);
+    return readEntity(r, msg);
+}
+
+bool decode(const char* payload, size_t size, TargetMessage& msg) {
+    Reader r(payload, size);
+    uint8_t success = 0;
+    r.str(msg.target_id);
+    r.u8(success);
+    msg.success = success != 0;
+    return r.ok();
+}
+
+bool decode(const char* payload, size_t size, ModuleMessage& msg) {
+    Reader r(payload, size);
+    int64_t slot = 0;
+    uint8_t success = 0;
+    r.svarint(slot);
+    r.str(msg.target_id);
+    r.u8(success);
+    msg.slot_index = static_cast<int32_t>(slot);
+    msg.success = success != 0;
+    return r.ok();
+}
+
+} // namespace wire
+} // namespace atlas
@@ -183,6 +183,52 @@ void testMessageParsing() {
         std::cout << "  ✗ Failed to parse DESTROY_ENTITY" << std::endl;
     }
     
+    // Test partial STATE_UPDATE (interest-managed)
+    std::cout << "\n4. Testing partial STATE_UPDATE parsing..." << std::endl;
+    manager.spawnEntity("uuid-far-away", glm::vec3(0.0f), Health(100, 100, 100));
+    manager.spawnEntity("uuid-left-grid", glm::vec3(0.0f), Health(100, 100, 100));
+    std::string partialMsg = R"({
+        "partial": true,
+        "removed": ["uuid-left-grid"],
+        "entities": [
+            {
+                "id": "uuid-123-456",
+                "pos": {"x": 120.0, "y": 220.0, "z": 320.0, "rot": 1.5},
+                "vel": {"vx": 5.0, "vy": 3.0, "vz": 2.0},
+                "health": {"s": 130, "a": 240, "h": 350}
+            }
+        ]
+    })";
+    
+    if (EntityMessageParser::parseStateUpdate(partialMsg, manager) &&
+        manager.getEntity("uuid-far-away") && !manager.getEntity("uuid-left-grid")) {
+        std::cout << "  ✓ Unlisted entity kept, removed entity dropped" << std::endl;
+    } else {
+        std::cout << "  ✗ Partial STATE_UPDATE handled incorrectly" << std::endl;
+    }
+    
+    // Test delta-encoded STATE_UPDATE (only changed fields present)
+    std::cout << "\n5. Testing delta STATE_UPDATE parsing..." << std::endl;
+    std::string deltaMsg = R"({
+        "sequence": 7,
+        "baseline": 6,
+        "partial": true,
+        "removed": [],
+        "entities": [
+            {"id": "uuid-123-456", "health": {"shield": 90, "armor": 240, "hull": 350}}
+        ]
+    })";
+    
+    uint64_t sequence = 0;
+    auto deltaEntity = manager.getEntity("uuid-123-456");
+    if (EntityMessageParser::parseStateUpdate(deltaMsg, manager, sequence) && sequence == 7 &&
+        deltaEntity && deltaEntity->getHealth().shield == 90 &&
+        deltaEntity->getTargetPosition().x == 120.0f && deltaEntity->getShipType() == "Falk") {
+        std::cout << "  ✓ Changed field applied, omitted fields kept" << std::endl;
+    } else {
+        std::cout << "  ✗ Delta STATE_UPDATE handled incorrectly" << std::endl;
+    }
+    
     std::cout << "\nTest 2: PASSED" << std::endl;
 }
 
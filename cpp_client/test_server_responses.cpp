@@ -5,6 +5,7 @@
 
 #include "network/network_manager.h"
 #include "network/protocol_handler.h"
+#include "network/wire_format.h"
 #include <iostream>
 #include <cassert>
 #include <string>
@@ -189,6 +190,62 @@ void testMessageCreation() {
                "Creates market buy message");
 }
 
+// Test 8: Binary wire frames are delivered as their JSON equivalents
+void testBinaryFrameDecoding() {
+    std::cout << "\n=== Test 8: Binary Wire Frames ===" << std::endl;
+    
+    ProtocolHandler handler;
+    std::string lastType;
+    std::string lastData;
+    int messages = 0;
+    handler.setMessageHandler([&](const std::string& type, const std::string& data) {
+        lastType = type;
+        lastData = data;
+        messages++;
+    });
+    
+    wire::StateUpdate update;
+    update.sequence = 9;
+    wire::EntityState ship;
+    ship.id = "ship_1";
+    ship.fields = wire::EntityState::kPos;
+    ship.x = 100.0f;
+    update.entities.push_back(ship);
+    std::string frames;
+    wire::encode(update, frames);
+    
+    wire::TargetMessage ack;
+    ack.target_id = "npc_1";
+    ack.success = false;
+    wire::encode(wire::Type::TargetLockAck, ack, frames);
+    
+    handler.handleMessage(frames);
+    assertTrue(messages == 2, "Both frames in one buffer dispatched");
+    assertTrue(lastType == "target_lock_ack" && lastData.find("\"success\":false") != std::string::npos,
+               "Ack frame becomes target_lock_ack");
+    
+    handler.setMessageHandler([&](const std::string& type, const std::string& data) {
+        lastType = type;
+        lastData = data;
+    });
+    std::string single;
+    wire::encode(update, single);
+    handler.handleMessage(single);
+    assertTrue(lastType == "state_update" && lastData.find("\"sequence\":9") != std::string::npos &&
+               lastData.find("\"pos\"") != std::string::npos && lastData.find("\"health\"") == std::string::npos,
+               "State update frame carries only its present fields");
+    
+    std::string move = handler.createBinaryMoveMessage(1.0f, 2.0f, 3.0f);
+    wire::Header header;
+    size_t frameSize = 0;
+    assertTrue(wire::peekFrame(move.data(), move.size(), header, frameSize) == wire::FrameStatus::Complete &&
+               header.type == wire::Type::InputMove && frameSize == move.size(),
+               "Creates binary move frame");
+    
+    std::string connect = handler.createConnectMessage("p1", "Pilot", true);
+    assertTrue(connect.find("\"wire\":\"binary\"") != std::string::npos, "Connect requests binary encoding");
+}
+
 int main() {
     std::cout << "========================================" << std::endl;
     std::cout << "  Phase 4.8: Server Response Handling  " << std::endl;
@@ -203,6 +260,7 @@ int main() {
     testErrorCallback();
     testResponseStructures();
     testMessageCreation();
+    testBinaryFrameDecoding();
     
     // Summary
     std::cout << "\n========================================" << std::endl;
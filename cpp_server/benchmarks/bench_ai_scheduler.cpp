@@ -0,0 +1,127 @@
+/**
+ * AI think scheduling benchmark
+ *
+ * Fills a world with NPCs at constant density (100 per 150 km cube) plus
+ * a few players, and times AISystem ticks at 30 Hz with every NPC
+ * thinking every tick and with the think scheduler (every tick near
+ * players and in combat, turns every 10 ticks for the rest, at most
+ * 2000 turns a tick). The cost per think it prints divides a tick's time
+ * budget into ai_think_budget_turns. NPCs belong to one faction that likes itself, so idle NPCs
+ * away from players run their full target search and find nothing, as
+ * on a quiet server. Both runs use the spatial index.
+ *
+ * Usage: bench_ai_scheduler [npcs=20000] [ticks=300]
+ */
+
+#include "ecs/world.h"
+#include "components/game_components.h"
+#include "systems/ai_system.h"
+#include "systems/spatial_index_system.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+
+using namespace atlas;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double elapsedMs(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+void populate(ecs::World& world, int npc_count, int player_count) {
+    std::mt19937 rng(4321);
+    float side = 150000.0f * std::cbrt(npc_count / 100.0f);
+    std::uniform_real_distribution<float> coord(0.0f, side);
+
+    auto place = [&](ecs::Entity* e) {
+        auto pos = std::make_unique<components::Position>();
+        pos->x = coord(rng);
+        pos->y = coord(rng);
+        pos->z = coord(rng);
+        e->addComponent(std::move(pos));
+        e->addComponent(std::make_unique<components::Velocity>());
+    };
+
+    for (int i = 0; i < npc_count; ++i) {
+        auto* npc = world.createEntity("npc_" + std::to_string(i));
+        place(npc);
+        auto ai = std::make_unique<components::AI>();
+        ai->behavior = components::AI::Behavior::Aggressive;
+        ai->engagement_range = 20000.0f;
+        npc->addComponent(std::move(ai));
+        auto faction = std::make_unique<components::Faction>();
+        faction->faction_name = "Serpentis";
+        faction->standings["Serpentis"] = 5.0f;
+        npc->addComponent(std::move(faction));
+    }
+    for (int i = 0; i < player_count; ++i) {
+        auto* player = world.createEntity("player_" + std::to_string(i));
+        place(player);
+        player->addComponent(std::make_unique<components::Player>());
+    }
+}
+
+void run(const char* name, int npc_count, int ticks, const systems::AISystem::ThinkSettings& settings) {
+    ecs::World world;
+    populate(world, npc_count, 20);
+    systems::SpatialIndexSystem index(&world);
+    index.refresh();
+    systems::AISystem ai(&world);
+    ai.setSpatialIndex(&index);
+    ai.setThinkSettings(settings);
+
+    const float tick = 1.0f / 30.0f;
+    double total_ms = 0.0;
+    double worst_ms = 0.0;
+    size_t thinks = 0;
+    size_t deferred = 0;
+    for (int i = 0; i < ticks; ++i) {
+        auto start = Clock::now();
+        ai.update(tick);
+        double ms = elapsedMs(start);
+        total_ms += ms;
+        worst_ms = std::max(worst_ms, ms);
+        thinks += ai.getLastThinkCount();
+        deferred = std::max(deferred, ai.getDeferredCount());
+    }
+
+    double mean_ms = total_ms / ticks;
+    std::cout << "  " << std::left << std::setw(12) << name << std::right
+              << "  mean " << std::setw(8) << mean_ms << " ms"
+              << "  worst " << std::setw(8) << worst_ms << " ms"
+              << "  (" << std::setw(5) << mean_ms * 100.0 / (1000.0 * tick) << "% of a tick)"
+              << "  thinks/tick " << std::setw(7) << static_cast<double>(thinks) / ticks
+              << "  us/think " << std::setw(6)
+              << (thinks > 0 ? total_ms * 1000.0 / static_cast<double>(thinks) : 0.0)
+              << "  max deferred " << deferred << "\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int npc_count = argc > 1 ? std::atoi(argv[1]) : 20000;
+    int ticks = argc > 2 ? std::atoi(argv[2]) : 300;
+    if (npc_count <= 0) npc_count = 20000;
+    if (ticks <= 0) ticks = 300;
+
+    std::cout << "AI think scheduling benchmark, " << npc_count << " NPCs, "
+              << ticks << " ticks at 30 Hz\n";
+    std::cout << std::fixed << std::setprecision(3);
+
+    run("every tick", npc_count, ticks, systems::AISystem::ThinkSettings{});
+
+    systems::AISystem::ThinkSettings scheduled;
+    scheduled.think_interval = 10;
+    scheduled.budget_turns = 2000;
+    run("scheduled", npc_count, ticks, scheduled);
+    return 0;
+}
@@ -0,0 +1,153 @@
+/**
+ * ECS component storage microbenchmark
+ *
+ * Compares the previous per-entity storage (unordered_map of
+ * type_index -> unique_ptr<Component>) against the pooled
+ * ComponentStorage used by ecs::World, on 10k and 100k entity worlds.
+ *
+ * Usage: bench_ecs_storage [iterations]
+ */
+
+#include "ecs/world.h"
+#include "components/game_components.h"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+using namespace atlas;
+
+namespace {
+
+// Reference copy of the old Entity storage layout
+class LegacyEntity {
+public:
+    template<typename T>
+    void addComponent(std::unique_ptr<T> c) {
+        components_[std::type_index(typeid(T))] = std::move(c);
+    }
+
+    template<typename T>
+    T* getComponent() {
+        auto it = components_.find(std::type_index(typeid(T)));
+        return it != components_.end() ? static_cast<T*>(it->second.get()) : nullptr;
+    }
+
+private:
+    std::unordered_map<std::type_index, std::unique_ptr<ecs::Component>> components_;
+};
+
+using Clock = std::chrono::steady_clock;
+
+double elapsedMs(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+template<typename Entity>
+void populate(Entity* e, int i) {
+    auto pos = std::make_unique<components::Position>();
+    pos->x = static_cast<float>(i);
+    e->addComponent(std::move(pos));
+    auto vel = std::make_unique<components::Velocity>();
+    vel->vx = 1.0f;
+    vel->vy = 0.5f;
+    e->addComponent(std::move(vel));
+    e->addComponent(std::make_unique<components::Health>());
+    e->addComponent(std::make_unique<components::Capacitor>());
+    e->addComponent(std::make_unique<components::Ship>());
+}
+
+void integrate(components::Position& pos, components::Velocity& vel, float dt) {
+    pos.x += vel.vx * dt;
+    pos.y += vel.vy * dt;
+    pos.z += vel.vz * dt;
+}
+
+void runSize(int entity_count, int iterations) {
+    const float dt = 1.0f / 30.0f;
+
+    // --- Legacy layout ---
+    std::unordered_map<std::string, std::unique_ptr<LegacyEntity>> legacy;
+    for (int i = 0; i < entity_count; ++i) {
+        auto e = std::make_unique<LegacyEntity>();
+        populate(e.get(), i);
+        legacy["ship_" + std::to_string(i)] = std::move(e);
+    }
+
+    auto start = Clock::now();
+    for (int it = 0; it < iterations; ++it) {
+        for (auto& pair : legacy) {
+            auto* pos = pair.second->getComponent<components::Position>();
+            auto* vel = pair.second->getComponent<components::Velocity>();
+            if (pos && vel) integrate(*pos, *vel, dt);
+        }
+    }
+    double legacy_move = elapsedMs(start) / iterations;
+
+    start = Clock::now();
+    for (int it = 0; it < iterations; ++it) {
+        for (auto& pair : legacy) {
+            auto* hp = pair.second->getComponent<components::Health>();
+            if (hp) hp->shield_hp = std::min(hp->shield_hp + hp->shield_recharge_rate * dt, hp->shield_max);
+        }
+    }
+    double legacy_shield = elapsedMs(start) / iterations;
+
+    // --- Pooled layout ---
+    ecs::World world;
+    for (int i = 0; i < entity_count; ++i) {
+        populate(world.createEntity("ship_" + std::to_string(i)), i);
+    }
+
+    start = Clock::now();
+    for (int it = 0; it < iterations; ++it) {
+        for (auto* e : world.getEntities<components::Position, components::Velocity>()) {
+            integrate(*e->getComponent<components::Position>(),
+                      *e->getComponent<components::Velocity>(), dt);
+        }
+    }
+    double pooled_query_move = elapsedMs(start) / iterations;
+
+    start = Clock::now();
+    for (int it = 0; it < iterations; ++it) {
+        world.forEach<components::Velocity>([dt](ecs::Entity* e, components::Velocity& vel) {
+            auto* pos = e->getComponent<components::Position>();
+            if (pos) integrate(*pos, vel, dt);
+        });
+    }
+    double pooled_move = elapsedMs(start) / iterations;
+
+    start = Clock::now();
+    for (int it = 0; it < iterations; ++it) {
+        world.forEach<components::Health>([dt](ecs::Entity*, components::Health& hp) {
+            hp.shield_hp = std::min(hp.shield_hp + hp.shield_recharge_rate * dt, hp.shield_max);
+        });
+    }
+    double pooled_shield = elapsedMs(start) / iterations;
+
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "\n" << entity_count << " entities (" << iterations << " iterations, ms/iteration)\n";
+    std::cout << "  movement  legacy map:          " << legacy_move << "\n";
+    std::cout << "  movement  pooled getEntities:  " << pooled_query_move << "\n";
+    std::cout << "  movement  pooled forEach:      " << pooled_move
+              << "  (" << legacy_move / pooled_move << "x)\n";
+    std::cout << "  shield    legacy map:          " << legacy_shield << "\n";
+    std::cout << "  shield    pooled forEach:      " << pooled_shield
+              << "  (" << legacy_shield / pooled_shield << "x)\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int iterations = argc > 1 ? std::atoi(argv[1]) : 50;
+    if (iterations <= 0) iterations = 50;
+
+    std::cout << "ECS component storage benchmark" << std::endl;
+    runSize(10000, iterations);
+    runSize(100000, iterations / 5 > 0 ? iterations / 5 : 1);
+    return 0;
+}
@@ -0,0 +1,190 @@
+/**
+ * Market order book benchmark
+ *
+ * Fills one station's OrderBook with resting orders spread over many
+ * items (bids below asks, 10% permanent, the rest expiring within 30
+ * days), then times inserts, best-price lookups, market buys, cancels
+ * and the per-tick expiry check. The same orders in the previous flat
+ * vector layout are timed for a best-price scan and one update() pass.
+ *
+ * Usage: bench_order_book [orders=1000000] [items=5000]
+ */
+
+#include "data/order_book.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace atlas;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double elapsedMs(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+void report(const char* name, double ms, size_t ops) {
+    std::cout << "  " << std::left << std::setw(24) << name << std::right
+              << std::setw(12) << ms << " ms" << std::setw(12) << ops << " ops"
+              << std::setw(12) << (ops ? ms * 1e6 / static_cast<double>(ops) : 0.0) << " ns/op\n";
+}
+
+// The MarketHub::Order layout before the order book
+struct FlatOrder {
+    std::string order_id;
+    std::string item_id;
+    std::string item_name;
+    std::string owner_id;
+    bool is_buy_order = false;
+    double price_per_unit = 0.0;
+    int quantity = 1;
+    int quantity_remaining = 1;
+    float duration_remaining = -1.0f;
+    bool fulfilled = false;
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int order_count = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    int item_count = argc > 2 ? std::atoi(argv[2]) : 5000;
+    if (order_count <= 0) order_count = 1000000;
+    if (item_count <= 0) item_count = 5000;
+
+    std::mt19937_64 rng(42);
+    std::uniform_int_distribution<int> pick_item(0, item_count - 1);
+    std::uniform_int_distribution<int> pick_tick(1, 200);       // 0.01 ISK ticks from mid
+    std::uniform_int_distribution<int> pick_qty(1, 1000);
+    std::uniform_real_distribution<float> pick_duration(3600.0f, 30.0f * 86400.0f);
+
+    std::vector<std::string> items(item_count);
+    for (int i = 0; i < item_count; ++i) items[i] = "item_" + std::to_string(i);
+
+    std::vector<data::OrderBook::Order> orders(order_count);
+    std::vector<float> durations(order_count);
+    for (int i = 0; i < order_count; ++i) {
+        auto& order = orders[i];
+        int item = pick_item(rng);
+        order.item_id = items[item];
+        order.item_name = "Item " + std::to_string(item);
+        order.owner_id = "player_" + std::to_string(i % 10000);
+        order.is_buy_order = (i & 1) != 0;
+        double mid = 100.0 + item;
+        double offset = pick_tick(rng) * 0.01;
+        order.price_per_unit = order.is_buy_order ? mid - offset : mid + offset;
+        order.quantity = order.quantity_remaining = pick_qty(rng);
+        durations[i] = (i % 10 == 0) ? -1.0f : pick_duration(rng);
+    }
+
+    std::cout << "Order book benchmark, " << order_count << " orders across "
+              << item_count << " items\n";
+    std::cout << std::fixed << std::setprecision(1);
+
+    data::OrderBook book;
+    std::vector<data::OrderBook::OrderId> ids(order_count);
+    auto start = Clock::now();
+    for (int i = 0; i < order_count; ++i) {
+        ids[i] = book.add(orders[i], durations[i]);
+    }
+    report("insert", elapsedMs(start), order_count);
+
+    const int lookups = 1000000;
+    double checksum = 0.0;
+    start = Clock::now();
+    for (int i = 0; i < lookups; ++i) {
+        const auto* best = book.best(items[pick_item(rng)], (i & 1) != 0);
+        if (best) checksum += best->price_per_unit;
+    }
+    report("best price", elapsedMs(start), lookups);
+
+    // Market buys walk the ask ladder and remove the orders they empty
+    const int buys = 100000;
+    size_t filled = 0;
+    start = Clock::now();
+    for (int i = 0; i < buys; ++i) {
+        const std::string& item = items[pick_item(rng)];
+        int remaining = pick_qty(rng);
+        while (remaining > 0) {
+            const auto* best = book.best(item, false);
+            if (!best) break;
+            int taken = book.fill(best->order_id, remaining);
+            remaining -= taken;
+            filled += static_cast<size_t>(taken);
+        }
+    }
+    report("market buy", elapsedMs(start), buys);
+
+    const int cancels = std::min(200000, order_count);
+    std::shuffle(ids.begin(), ids.end(), rng);
+    size_t cancelled = 0;
+    start = Clock::now();
+    for (int i = 0; i < cancels; ++i) {
+        cancelled += book.cancel(ids[i]) ? 1 : 0;
+    }
+    report("cancel", elapsedMs(start), cancels);
+
+    // One minute of 30 Hz ticks with nothing due, then a day's expiries
+    const int ticks = 1800;
+    start = Clock::now();
+    size_t expired = 0;
+    for (int i = 0; i < ticks; ++i) {
+        expired += book.advance(1.0 / 30.0);
+    }
+    report("tick, nothing due", elapsedMs(start), ticks);
+    size_t before = book.size();
+    start = Clock::now();
+    expired += book.advance(86400.0);
+    report("expire one day", elapsedMs(start), before - book.size());
+
+    // The previous layout: every query and every tick scans all orders
+    std::vector<FlatOrder> flat;
+    flat.reserve(orders.size());
+    for (int i = 0; i < order_count; ++i) {
+        FlatOrder order;
+        order.order_id = "order_" + std::to_string(i + 1);
+        order.item_id = orders[i].item_id;
+        order.item_name = orders[i].item_name;
+        order.owner_id = orders[i].owner_id;
+        order.is_buy_order = orders[i].is_buy_order;
+        order.price_per_unit = orders[i].price_per_unit;
+        order.quantity = order.quantity_remaining = orders[i].quantity;
+        order.duration_remaining = durations[i];
+        flat.push_back(std::move(order));
+    }
+    const int scans = 20;
+    start = Clock::now();
+    for (int i = 0; i < scans; ++i) {
+        const std::string& item = items[pick_item(rng)];
+        double lowest = -1.0;
+        for (const auto& order : flat) {
+            if (order.fulfilled || order.is_buy_order || order.item_id != item) continue;
+            if (lowest < 0.0 || order.price_per_unit < lowest) lowest = order.price_per_unit;
+        }
+        checksum += lowest;
+    }
+    report("flat: best price", elapsedMs(start), scans);
+    start = Clock::now();
+    for (int i = 0; i < scans; ++i) {
+        for (auto& order : flat) {
+            if (order.fulfilled || order.duration_remaining < 0.0f) continue;
+            order.duration_remaining -= 1.0f / 30.0f;
+            if (order.duration_remaining <= 0.0f) order.fulfilled = true;
+        }
+        flat.erase(std::remove_if(flat.begin(), flat.end(),
+                                  [](const FlatOrder& o) { return o.fulfilled; }),
+                   flat.end());
+    }
+    report("flat: tick", elapsedMs(start), scans);
+
+    std::cout << "  (" << filled << " units bought, " << cancelled << " cancelled, "
+              << expired << " expired, " << book.size() << " resting; checksum "
+              << static_cast<long long>(checksum) << ")\n";
+    return 0;
+}
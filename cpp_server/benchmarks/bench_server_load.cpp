@@ -0,0 +1,463 @@
+/**
+ * Dedicated server load test
+ *
+ * Boots a Server in-process on a loopback port, spawns NPC fleets through
+ * GameSession::spawnNPC and connects bot clients over TCP. Each bot acks
+ * every state_update and sends input_move, target_lock, module_activate
+ * and warp_request at rates like a player's. After a warm-up it reports,
+ * for the measurement window:
+ * - tick time percentiles, overall and per phase (from the Profiler)
+ * - bytes the server sent per client
+ * - reply latency: request sent until its ack arrives
+ * - state age: state_update built until it arrives
+ *
+ * The server runs its real main loop with persistence and Steam off; the
+ * bots are driven from one epoll loop on the main thread. Use it to size
+ * a deployment: raise the counts until tick p99 nears the tick period.
+ *
+ * Usage: bench_server_load [clients] [npcs] [seconds] [io_threads] [data_path]
+ */
+
+#include "server.h"
+#include "utils/profiler.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifndef EVE_TCP_SERVER_EPOLL
+int main() {
+    std::cout << "bench_server_load needs the epoll reactor (Linux)" << std::endl;
+    return 0;
+}
+#else
+
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+
+using namespace atlas;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Per-bot request rates
+constexpr auto kMoveInterval = std::chrono::milliseconds(200);
+constexpr auto kModuleInterval = std::chrono::seconds(1);
+constexpr auto kLockInterval = std::chrono::seconds(3);
+constexpr auto kWarpInterval = std::chrono::seconds(30);
+constexpr auto kWarmUp = std::chrono::seconds(2);
+constexpr float kWarpDistance = 300000.0f;
+
+const char* const kPirateFactions[] = {"Venom Syndicate", "Iron Corsairs",
+                                       "Crimson Order", "Hollow Collective"};
+const char* const kPirateShips[] = {"Vipere", "Falk", "Sentinel", "Vipere"};
+
+double elapsedMs(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+uint64_t sinceNs(Clock::time_point start) {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+}
+
+void raiseFileLimit(int clients) {
+    rlimit limit{};
+    getrlimit(RLIMIT_NOFILE, &limit);
+    rlim_t wanted = static_cast<rlim_t>(clients) * 2 + 64;
+    if (limit.rlim_cur < wanted) {
+        limit.rlim_cur = std::min(wanted, limit.rlim_max);
+        setrlimit(RLIMIT_NOFILE, &limit);
+    }
+}
+
+// Value of "key": in a flat JSON message, as the text up to the next
+// delimiter; empty if absent
+std::string field(const std::string& json, const std::string& key) {
+    std::string pattern = "\"" + key + "\":";
+    size_t pos = json.find(pattern);
+    if (pos == std::string::npos) return "";
+    pos += pattern.size();
+    if (pos < json.size() && json[pos] == '"') {
+        size_t end = json.find('"', pos + 1);
+        return end == std::string::npos ? "" : json.substr(pos + 1, end - pos - 1);
+    }
+    size_t end = json.find_first_of(",}]", pos);
+    return json.substr(pos, end == std::string::npos ? std::string::npos : end - pos);
+}
+
+struct Bot {
+    int fd = -1;
+    std::string entity_id;              // set by connect_ack
+    std::string target_id;              // NPC this bot fights
+    std::string in;                     // partial line
+    std::string out;                    // unsent bytes
+    uint64_t bytes_in = 0;
+    uint64_t messages_out = 0;
+    Clock::time_point next_move, next_module, next_lock, next_warp;
+    std::deque<Clock::time_point> locks, modules, warps;   // awaiting replies
+    int warp_leg = 0;
+};
+
+struct Stats {
+    utils::LatencyHistogram lock_reply, module_reply, warp_reply, state_age;
+    uint64_t state_updates = 0;
+
+    void reset() { *this = Stats(); }
+};
+
+class BotDriver {
+public:
+    BotDriver(int clients, int npcs, uint16_t port)
+        : bots_(static_cast<size_t>(clients)), npcs_(npcs), port_(port), rng_(42) {}
+
+    ~BotDriver() {
+        for (auto& bot : bots_) {
+            if (bot.fd >= 0) close(bot.fd);
+        }
+        if (epfd_ >= 0) close(epfd_);
+    }
+
+    /// Open every connection and send connect; returns how many opened
+    int connectAll() {
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(port_);
+        inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+
+        epfd_ = epoll_create1(0);
+        int opened = 0;
+        for (size_t i = 0; i < bots_.size(); ++i) {
+            Bot& bot = bots_[i];
+            bot.fd = socket(AF_INET, SOCK_STREAM, 0);
+            if (bot.fd < 0 || connect(bot.fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+                if (bot.fd >= 0) close(bot.fd);
+                bot.fd = -1;
+                continue;
+            }
+            fcntl(bot.fd, F_SETFL, fcntl(bot.fd, F_GETFL, 0) | O_NONBLOCK);
+            epoll_event ev{};
+            ev.events = EPOLLIN;
+            ev.data.u64 = i;
+            epoll_ctl(epfd_, EPOLL_CTL_ADD, bot.fd, &ev);
+            if (npcs_ > 0) bot.target_id = "load_npc_" + std::to_string(i % npcs_);
+            send(bot, "{\"type\":\"connect\",\"data\":{\"player_id\":\"bot_" + std::to_string(i) +
+                      "\",\"character_name\":\"Bot " + std::to_string(i) + "\"}}\n");
+            ++opened;
+        }
+        return opened;
+    }
+
+    /// Drive the bots until deadline, or until stop_when_ready and every
+    /// open bot has its connect_ack
+    void run(Clock::time_point deadline, bool stop_when_ready = false) {
+        std::vector<epoll_event> events(256);
+        char buf[65536];
+        while (Clock::now() < deadline) {
+            if (stop_when_ready && ready_ == opened()) return;
+            int n = epoll_wait(epfd_, events.data(), static_cast<int>(events.size()), 1);
+            for (int e = 0; e < n; ++e) {
+                Bot& bot = bots_[events[e].data.u64];
+                ssize_t bytes;
+                while ((bytes = recv(bot.fd, buf, sizeof(buf), 0)) > 0) {
+                    bot.bytes_in += static_cast<uint64_t>(bytes);
+                    bot.in.append(buf, static_cast<size_t>(bytes));
+                    size_t start = 0, end;
+                    while ((end = bot.in.find('\n', start)) != std::string::npos) {
+                        onMessage(bot, bot.in.substr(start, end - start));
+                        start = end + 1;
+                    }
+                    bot.in.erase(0, start);
+                }
+            }
+
+            auto now = Clock::now();
+            for (auto& bot : bots_) {
+                if (!bot.entity_id.empty()) act(bot, now);
+                flush(bot);
+            }
+        }
+    }
+
+    uint64_t bytesIn() const {
+        uint64_t total = 0;
+        for (const auto& bot : bots_) total += bot.bytes_in;
+        return total;
+    }
+
+    uint64_t messagesOut() const {
+        uint64_t total = 0;
+        for (const auto& bot : bots_) total += bot.messages_out;
+        return total;
+    }
+
+    int opened() const {
+        int count = 0;
+        for (const auto& bot : bots_) count += bot.fd >= 0;
+        return count;
+    }
+
+    int ready() const { return ready_; }
+    Stats& stats() { return stats_; }
+
+private:
+    void send(Bot& bot, const std::string& message) {
+        bot.out += message;
+        ++bot.messages_out;
+    }
+
+    void flush(Bot& bot) {
+        while (!bot.out.empty()) {
+            ssize_t n = ::send(bot.fd, bot.out.data(), bot.out.size(), MSG_NOSIGNAL);
+            if (n <= 0) return;
+            bot.out.erase(0, static_cast<size_t>(n));
+        }
+    }
+
+    void onMessage(Bot& bot, const std::string& line) {
+        std::string type = field(line, "type");
+        auto now = Clock::now();
+        if (type == "state_update") {
+            // The timestamp is steady_clock milliseconds on the same host
+            long long sent_ms = std::atoll(field(line, "timestamp").c_str());
+            long long now_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                now.time_since_epoch()).count();
+            stats_.state_age.record(static_cast<uint64_t>(std::max(0LL, now_ms - sent_ms)) * 1000000);
+            ++stats_.state_updates;
+            send(bot, "{\"type\":\"state_ack\",\"data\":{\"sequence\":" +
+                      field(line, "sequence") + "}}\n");
+        } else if (type == "connect_ack") {
+            bot.entity_id = field(line, "player_entity_id");
+            // Spread the bots' request phases over each interval
+            auto offset = [&](Clock::duration interval) {
+                return now + std::chrono::duration_cast<Clock::duration>(
+                    interval * std::uniform_real_distribution<double>(0.0, 1.0)(rng_));
+            };
+            bot.next_move = offset(kMoveInterval);
+            bot.next_module = offset(kModuleInterval);
+            bot.next_lock = offset(kLockInterval);
+            bot.next_warp = offset(kWarpInterval);
+            ++ready_;
+        } else if (type == "target_lock_ack") {
+            reply(bot.locks, stats_.lock_reply);
+        } else if (type == "module_activate_ack") {
+            reply(bot.modules, stats_.module_reply);
+        } else if (type == "warp_result") {
+            reply(bot.warps, stats_.warp_reply);
+        }
+    }
+
+    // Replies to one request type arrive in request order
+    static void reply(std::deque<Clock::time_point>& pending, utils::LatencyHistogram& histogram) {
+        if (pending.empty()) return;
+        histogram.record(sinceNs(pending.front()));
+        pending.pop_front();
+    }
+
+    void act(Bot& bot, Clock::time_point now) {
+        std::uniform_real_distribution<float> axis(-1.0f, 1.0f);
+        if (now >= bot.next_move) {
+            std::ostringstream move;
+            move << "{\"type\":\"input_move\",\"data\":{\"velocity\":{\"x\":" << axis(rng_)
+                 << ",\"y\":0,\"z\":" << axis(rng_) << "}}}\n";
+            send(bot, move.str());
+            bot.next_move += kMoveInterval;
+        }
+        if (bot.target_id.empty()) return;
+        if (now >= bot.next_lock) {
+            send(bot, "{\"type\":\"target_lock\",\"data\":{\"target_id\":\"" + bot.target_id + "\"}}\n");
+            bot.locks.push_back(now);
+            bot.next_lock += kLockInterval;
+        }
+        if (now >= bot.next_module) {
+            send(bot, "{\"type\":\"module_activate\",\"data\":{\"slot_index\":0,\"target_id\":\"" +
+                      bot.target_id + "\"}}\n");
+            bot.modules.push_back(now);
+            bot.next_module += kModuleInterval;
+        }
+        if (now >= bot.next_warp) {
+            // Shuttle between two points far enough apart to warp
+            float x = (bot.warp_leg++ % 2 == 0) ? kWarpDistance : 0.0f;
+            send(bot, "{\"type\":\"warp_request\",\"data\":{\"dest_x\":" + std::to_string(x) +
+                      ",\"dest_y\":0,\"dest_z\":0}}\n");
+            bot.warps.push_back(now);
+            bot.next_warp += kWarpInterval;
+        }
+    }
+
+    std::vector<Bot> bots_;
+    int npcs_;
+    uint16_t port_;
+    int epfd_ = -1;
+    int ready_ = 0;
+    std::mt19937 rng_;
+    Stats stats_;
+};
+
+bool writeConfig(const std::string& path, const std::string& dir, int clients,
+                 int io_threads, const std::string& data_path) {
+    std::ofstream file(path);
+    if (!file.is_open()) return false;
+    file << "{\n"
+         << "  \"host\": \"127.0.0.1\",\n"
+         << "  \"port\": 0,\n"
+         << "  \"max_connections\": " << clients + 16 << ",\n"
+         << "  \"network_io_threads\": " << io_threads << ",\n"
+         << "  \"persistent_world\": false,\n"
+         << "  \"auto_save\": false,\n"
+         << "  \"use_whitelist\": false,\n"
+         << "  \"use_steam\": false,\n"
+         << "  \"data_path\": \"" << data_path << "\",\n"
+         << "  \"save_path\": \"" << dir << "\",\n"
+         << "  \"log_path\": \"" << dir << "\",\n"
+         << "  \"metrics_file\": \"\"\n"
+         << "}\n";
+    return file.good();
+}
+
+// Samples a scope recorded between two Profiler::collect() calls
+utils::LatencyHistogram window(const std::vector<utils::Profiler::ScopeStats>& before,
+                               const std::vector<utils::Profiler::ScopeStats>& after,
+                               const std::string& path) {
+    utils::LatencyHistogram result;
+    for (const auto& scope : after) {
+        if (scope.path != path) continue;
+        result = scope.histogram;
+        for (const auto& earlier : before) {
+            if (earlier.id == scope.id) result.subtract(earlier.histogram);
+        }
+    }
+    return result;
+}
+
+void printLatency(const std::string& label, const utils::LatencyHistogram& h) {
+    auto ms = [&](double q) { return static_cast<double>(h.percentile(q)) / 1e6; };
+    std::cout << "  " << std::left << std::setw(18) << label << std::right
+              << "p50 " << std::setw(7) << ms(0.50)
+              << "  p90 " << std::setw(7) << ms(0.90)
+              << "  p99 " << std::setw(7) << ms(0.99)
+              << "  p99.9 " << std::setw(7) << ms(0.999)
+              << "  max " << std::setw(7) << static_cast<double>(h.max()) / 1e6
+              << "  (n=" << h.count() << ")\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int clients = argc > 1 ? std::atoi(argv[1]) : 200;
+    int npcs = argc > 2 ? std::atoi(argv[2]) : 500;
+    int seconds = argc > 3 ? std::atoi(argv[3]) : 20;
+    int io_threads = argc > 4 ? std::atoi(argv[4]) : 1;
+    std::string data_path = argc > 5 ? argv[5] : "../data";
+    if (clients <= 0) clients = 200;
+    if (npcs < 0) npcs = 0;
+    if (seconds <= 0) seconds = 20;
+    if (io_threads <= 0) io_threads = 1;
+    raiseFileLimit(clients);
+
+    const std::string dir = "/tmp/bench_server_load";
+    const std::string config_path = dir + "/server.json";
+    mkdir(dir.c_str(), 0755);
+    if (!writeConfig(config_path, dir, clients, io_threads, data_path)) {
+        std::cerr << "Cannot write " << config_path << std::endl;
+        return 1;
+    }
+
+    // Per-connection logging would dominate the run
+    std::streambuf* saved_cout = std::cout.rdbuf(nullptr);
+    Server server(config_path);
+    if (!server.initialize()) {
+        std::cout.rdbuf(saved_cout);
+        std::cerr << "Failed to initialize server" << std::endl;
+        return 1;
+    }
+
+    // NPC fleets spread over the area the players spawn in
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> spread(-3000.0f, 3000.0f);
+    for (int i = 0; i < npcs; ++i) {
+        float anchor = static_cast<float>(i % clients);
+        server.getGameSession()->spawnNPC(
+            "load_npc_" + std::to_string(i), "Load NPC " + std::to_string(i),
+            kPirateShips[i % 4], kPirateFactions[i % 4],
+            anchor * 50.0f + spread(rng), 0.0f, anchor * 30.0f + spread(rng));
+    }
+
+    std::thread loop([&server] { server.run(); });
+
+    BotDriver bots(clients, npcs, server.getPort());
+    auto start = Clock::now();
+    int opened = bots.connectAll();
+    bots.run(start + std::chrono::seconds(30), true);
+    double connect_ms = elapsedMs(start);
+    bots.run(Clock::now() + kWarmUp);
+
+    // Measurement window
+    auto profile_before = utils::Profiler::instance().collect();
+    auto schedule_before = server.getMetrics().getScheduleStats();
+    uint64_t bytes_before = bots.bytesIn();
+    uint64_t messages_before = bots.messagesOut();
+    bots.stats().reset();
+    start = Clock::now();
+    bots.run(start + std::chrono::seconds(seconds));
+    double window_s = elapsedMs(start) / 1000.0;
+    auto profile_after = utils::Profiler::instance().collect();
+    auto schedule_after = server.getMetrics().getScheduleStats();
+    uint64_t bytes = bots.bytesIn() - bytes_before;
+    uint64_t messages = bots.messagesOut() - messages_before;
+    size_t entities = server.getWorld()->getEntityCount();
+
+    server.requestStop();
+    loop.join();
+    server.stop();
+    std::cout.rdbuf(saved_cout);
+
+    const Stats& stats = bots.stats();
+    int ready = bots.ready();
+    std::cout << "Server load test: " << clients << " clients, " << npcs << " NPCs ("
+              << entities << " entities), " << io_threads << " I/O thread"
+              << (io_threads == 1 ? "" : "s") << ", " << seconds << " s window" << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "  connected         " << ready << " / " << opened << " / " << clients
+              << " (acked / opened / requested) in " << connect_ms << " ms\n";
+    std::cout << "  ticks             " << schedule_after.ticks - schedule_before.ticks
+              << "  overruns " << schedule_after.overruns - schedule_before.overruns
+              << "  late " << schedule_after.late_ticks - schedule_before.late_ticks
+              << "  skipped " << schedule_after.skipped_ticks - schedule_before.skipped_ticks
+              << "  tidi " << schedule_after.dilation << "\n";
+    std::cout << "tick time (ms)\n";
+    printLatency("tick", window(profile_before, profile_after, "tick"));
+    printLatency("  inbound", window(profile_before, profile_after, "tick/inbound"));
+    printLatency("  world", window(profile_before, profile_after, "tick/world"));
+    printLatency("  session", window(profile_before, profile_after, "tick/session"));
+    std::cout << "traffic\n";
+    std::cout << "  server -> client  " << static_cast<double>(bytes) / 1024.0 / window_s /
+                     std::max(1, ready) << " KB/s per client, "
+              << static_cast<double>(bytes) / (1024.0 * 1024.0) << " MB total, "
+              << static_cast<double>(stats.state_updates) / window_s / std::max(1, ready)
+              << " state updates/s per client\n";
+    std::cout << "  client -> server  " << static_cast<double>(messages) / window_s
+              << " messages/s\n";
+    std::cout << "message latency (ms)\n";
+    printLatency("target_lock", stats.lock_reply);
+    printLatency("module_activate", stats.module_reply);
+    printLatency("warp_request", stats.warp_reply);
+    printLatency("state age", stats.state_age);
+
+    std::remove(config_path.c_str());
+    return ready == clients ? 0 : 1;
+}
+
+#endif // EVE_TCP_SERVER_EPOLL
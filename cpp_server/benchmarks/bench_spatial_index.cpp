@@ -0,0 +1,129 @@
+/**
+ * AI target acquisition benchmark
+ *
+ * Times one AISystem tick in which every NPC is idle and searches for a
+ * target, with the brute-force scan and with the SpatialIndexSystem
+ * grid, for 100 to 10k NPCs. NPC density is kept constant (100 NPCs per
+ * 150 km cube), as when more grids fill up rather than one grid getting
+ * denser, so the index cost should grow linearly while the scan grows
+ * quadratically.
+ *
+ * Usage: bench_spatial_index [iterations]
+ */
+
+#include "ecs/world.h"
+#include "components/game_components.h"
+#include "systems/ai_system.h"
+#include "systems/spatial_index_system.h"
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace atlas;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double elapsedMs(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+void populate(ecs::World& world, int npc_count) {
+    std::mt19937 rng(1234);
+    float side = 150000.0f * std::cbrt(npc_count / 100.0f);
+    std::uniform_real_distribution<float> coord(0.0f, side);
+
+    auto place = [&](ecs::Entity* e) {
+        auto pos = std::make_unique<components::Position>();
+        pos->x = coord(rng);
+        pos->y = coord(rng);
+        pos->z = coord(rng);
+        e->addComponent(std::move(pos));
+        e->addComponent(std::make_unique<components::Velocity>());
+    };
+
+    for (int i = 0; i < npc_count; ++i) {
+        auto* npc = world.createEntity("npc_" + std::to_string(i));
+        place(npc);
+        auto ai = std::make_unique<components::AI>();
+        ai->behavior = components::AI::Behavior::Aggressive;
+        ai->engagement_range = 20000.0f;
+        npc->addComponent(std::move(ai));
+    }
+    for (int i = 0; i < npc_count / 10; ++i) {
+        auto* player = world.createEntity("player_" + std::to_string(i));
+        place(player);
+        player->addComponent(std::make_unique<components::Player>());
+    }
+}
+
+void resetToIdle(ecs::World& world) {
+    world.forEach<components::AI>([](ecs::Entity*, components::AI& ai) {
+        ai.state = components::AI::State::Idle;
+        ai.target_entity_id.clear();
+    });
+}
+
+double timeTicks(ecs::World& world, systems::AISystem& ai, int iterations) {
+    double total = 0.0;
+    for (int it = 0; it < iterations; ++it) {
+        resetToIdle(world);
+        auto start = Clock::now();
+        ai.update(1.0f / 30.0f);
+        total += elapsedMs(start);
+    }
+    return total / iterations;
+}
+
+void runSize(int npc_count, int iterations) {
+    ecs::World world;
+    populate(world, npc_count);
+
+    systems::SpatialIndexSystem index(&world);
+    systems::AISystem ai(&world);
+
+    // Brute force is quadratic; keep the large sizes bearable
+    int scan_iterations = npc_count >= 5000 ? 1 : iterations;
+    double scan_ms = timeTicks(world, ai, scan_iterations);
+
+    auto start = Clock::now();
+    index.refresh();
+    double build_ms = elapsedMs(start);
+
+    start = Clock::now();
+    for (int it = 0; it < iterations; ++it) {
+        index.refresh();
+    }
+    double refresh_ms = elapsedMs(start) / iterations;
+
+    ai.setSpatialIndex(&index);
+    double grid_ms = timeTicks(world, ai, iterations);
+
+    std::cout << std::setw(6) << npc_count
+              << "  scan " << std::setw(10) << scan_ms
+              << "  grid " << std::setw(8) << grid_ms
+              << "  (" << std::setw(6) << scan_ms / grid_ms << "x)"
+              << "  build " << std::setw(7) << build_ms
+              << "  refresh " << std::setw(7) << refresh_ms
+              << "  cells " << index.getCellCount() << "\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int iterations = argc > 1 ? std::atoi(argv[1]) : 10;
+    if (iterations <= 0) iterations = 10;
+
+    std::cout << "AI target acquisition benchmark (ms per AI tick, all NPCs idle)" << std::endl;
+    std::cout << std::fixed << std::setprecision(3);
+    for (int npc_count : {100, 1000, 2500, 5000, 10000}) {
+        runSize(npc_count, iterations);
+    }
+    return 0;
+}
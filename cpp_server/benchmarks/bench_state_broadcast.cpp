@@ -0,0 +1,176 @@
+/**
+ * State update encoding benchmark
+ *
+ * Encodes one tick of state updates for C clients that all see the same
+ * N moving entities. Each client has its own SnapshotDelta, like a
+ * GameSession player. The tick is encoded once with each entity
+ * serialized per client, and once through a FragmentCache, where each
+ * entity's field groups are encoded once and shared. Both JSON and binary
+ * wire updates are timed, with clients that never acknowledge (full
+ * snapshots) and with clients that acknowledge every update (deltas).
+ *
+ * Usage: bench_state_broadcast [entities] [clients] [ticks]
+ */
+
+#include "ecs/world.h"
+#include "components/game_components.h"
+#include "network/fragment_cache.h"
+#include "network/snapshot_delta.h"
+#include "network/wire_format.h"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace atlas;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double elapsedMs(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+std::vector<ecs::Entity*> populate(ecs::World& world, int count) {
+    std::vector<ecs::Entity*> entities;
+    for (int i = 0; i < count; ++i) {
+        auto* e = world.createEntity("npc_" + std::to_string(i));
+        e->addComponent(std::make_unique<components::Position>());
+        auto vel = std::make_unique<components::Velocity>();
+        vel->vx = 50.0f;
+        e->addComponent(std::move(vel));
+        e->addComponent(std::make_unique<components::Health>());
+        e->addComponent(std::make_unique<components::Capacitor>());
+        auto ship = std::make_unique<components::Ship>();
+        ship->ship_type = "Frigate";
+        ship->ship_name = "Rifter";
+        e->addComponent(std::move(ship));
+        auto faction = std::make_unique<components::Faction>();
+        faction->faction_name = "Minmatar";
+        e->addComponent(std::move(faction));
+        entities.push_back(e);
+    }
+    return entities;
+}
+
+// Every run starts from the same positions, so outputs can be compared
+void reset(const std::vector<ecs::Entity*>& entities) {
+    for (size_t i = 0; i < entities.size(); ++i) {
+        entities[i]->getComponent<components::Position>()->x = static_cast<float>(i) * 100.0f;
+    }
+}
+
+void advance(ecs::World& world) {
+    world.forEach<components::Position>([](ecs::Entity*, components::Position& pos) {
+        pos.x += 1.5f;
+    });
+}
+
+struct Result {
+    double ms = 0;
+    size_t bytes = 0;
+};
+
+// One mode: JSON or binary, cached or not, acking or not
+Result run(ecs::World& world, const std::vector<ecs::Entity*>& entities, int clients,
+           int ticks, bool binary, bool cached, bool ack) {
+    std::vector<network::SnapshotDelta> deltas(static_cast<size_t>(clients));
+    network::FragmentCache cache;
+    network::wire::StateUpdate msg;
+    std::string records;
+    std::string out;
+    Result result;
+
+    reset(entities);
+    for (int tick = 0; tick < ticks; ++tick) {
+        advance(world);
+        uint64_t sequence = static_cast<uint64_t>(tick);
+        auto start = Clock::now();
+        cache.beginTick();
+        for (auto& delta : deltas) {
+            if (binary) {
+                msg.sequence = sequence;
+                msg.has_baseline = delta.baselineFor(sequence, msg.baseline);
+                out.clear();
+                if (cached) {
+                    records.clear();
+                    size_t count = 0;
+                    for (const auto* e : entities) {
+                        if (delta.appendEntityRecord(records, cache.get(*e), sequence)) ++count;
+                    }
+                    network::wire::encode(msg, records, count, out);
+                } else {
+                    msg.entities.resize(entities.size());
+                    size_t count = 0;
+                    for (const auto* e : entities) {
+                        if (delta.writeEntity(msg.entities[count], *e, sequence)) ++count;
+                    }
+                    msg.entities.resize(count);
+                    network::wire::encode(msg, out);
+                }
+                result.bytes += out.size();
+            } else {
+                std::ostringstream json;
+                json << "{\"type\":\"state_update\",\"data\":{\"sequence\":" << sequence
+                     << ",\"entities\":[";
+                bool first = true;
+                for (const auto* e : entities) {
+                    if (cached) delta.writeEntity(json, cache.get(*e), sequence, first);
+                    else delta.writeEntity(json, *e, sequence, first);
+                }
+                json << "]}}";
+                result.bytes += json.str().size();
+            }
+            if (ack) delta.acknowledge(sequence);
+        }
+        result.ms += elapsedMs(start);
+    }
+    result.ms /= ticks;
+    result.bytes /= static_cast<size_t>(ticks);
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int entity_count = argc > 1 ? std::atoi(argv[1]) : 500;
+    int clients = argc > 2 ? std::atoi(argv[2]) : 50;
+    int ticks = argc > 3 ? std::atoi(argv[3]) : 30;
+    if (entity_count <= 0) entity_count = 500;
+    if (clients <= 0) clients = 50;
+    if (ticks <= 0) ticks = 30;
+
+    ecs::World world;
+    auto entities = populate(world, entity_count);
+
+    std::cout << "State update encoding: " << entity_count << " entities visible to "
+              << clients << " clients, " << ticks << " ticks" << std::endl;
+    std::cout << std::left << std::setw(22) << "mode"
+              << std::right << std::setw(14) << "per client"
+              << std::setw(14) << "cached"
+              << std::setw(10) << "speedup"
+              << std::setw(14) << "bytes/tick" << std::endl;
+
+    for (int binary = 0; binary < 2; ++binary) {
+        for (int ack = 0; ack < 2; ++ack) {
+            Result plain = run(world, entities, clients, ticks, binary != 0, false, ack != 0);
+            Result cached = run(world, entities, clients, ticks, binary != 0, true, ack != 0);
+            std::string mode = std::string(binary ? "binary" : "json") + (ack ? ", delta" : ", full");
+            std::cout << std::left << std::setw(22) << mode << std::right << std::fixed
+                      << std::setprecision(2)
+                      << std::setw(11) << plain.ms << " ms"
+                      << std::setw(11) << cached.ms << " ms"
+                      << std::setw(9) << std::setprecision(1) << (plain.ms / cached.ms) << "x"
+                      << std::setw(14) << cached.bytes << std::endl;
+            if (plain.bytes != cached.bytes) {
+                std::cerr << "  size mismatch: " << plain.bytes << " vs " << cached.bytes << std::endl;
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
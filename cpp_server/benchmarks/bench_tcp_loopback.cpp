@@ -0,0 +1,197 @@
+/**
+ * TCP server load generator
+ *
+ * Starts a TCPServer with an echo handler on a loopback port and opens N
+ * simulated clients against it. It reports:
+ * - connect time, and thread count and RSS with all clients idle
+ * - round-trip throughput while every client pipelines M small
+ *   newline-delimited messages and waits for the echoes
+ * - how long it takes the server to reap the closed connections
+ *
+ * The clients are driven from one epoll loop in this process, so the
+ * thread count shown is the server's I/O threads plus the main thread.
+ *
+ * Usage: bench_tcp_loopback [clients] [messages_per_client] [io_threads]
+ */
+
+#include "network/tcp_server.h"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifndef EVE_TCP_SERVER_EPOLL
+int main() {
+    std::cout << "bench_tcp_loopback needs the epoll reactor (Linux)" << std::endl;
+    return 0;
+}
+#else
+
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/resource.h>
+
+using namespace atlas;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double elapsedMs(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+std::string procStatus(const std::string& key) {
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.compare(0, key.size(), key) == 0) {
+            size_t start = line.find_first_not_of(" \t", key.size());
+            return start == std::string::npos ? "" : line.substr(start);
+        }
+    }
+    return "?";
+}
+
+void raiseFileLimit(int clients) {
+    rlimit limit{};
+    getrlimit(RLIMIT_NOFILE, &limit);
+    rlim_t wanted = static_cast<rlim_t>(clients) * 2 + 64;
+    if (limit.rlim_cur < wanted) {
+        limit.rlim_cur = std::min(wanted, limit.rlim_max);
+        setrlimit(RLIMIT_NOFILE, &limit);
+    }
+}
+
+struct Client {
+    int fd = -1;
+    int replies = 0;
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int clients = argc > 1 ? std::atoi(argv[1]) : 2000;
+    int messages = argc > 2 ? std::atoi(argv[2]) : 50;
+    int io_threads = argc > 3 ? std::atoi(argv[3]) : 1;
+    if (clients <= 0) clients = 2000;
+    if (messages <= 0) messages = 50;
+    raiseFileLimit(clients);
+
+    network::TCPServer server("127.0.0.1", 0, clients + 16, io_threads);
+    server.setMessageHandler([&](const network::ClientConnection& client, const std::string& msg) {
+        server.sendToClient(client, msg);
+    });
+    // Connection logging would dominate the run
+    std::streambuf* saved_cout = std::cout.rdbuf(nullptr);
+    if (!server.initialize()) {
+        std::cout.rdbuf(saved_cout);
+        std::cerr << "Failed to start server" << std::endl;
+        return 1;
+    }
+    server.start();
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(server.getPort());
+    inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+
+    // Connect phase
+    auto start = Clock::now();
+    std::vector<Client> conns;
+    conns.reserve(static_cast<size_t>(clients));
+    for (int i = 0; i < clients; ++i) {
+        int fd = socket(AF_INET, SOCK_STREAM, 0);
+        if (fd < 0 || connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+            if (fd >= 0) close(fd);
+            break;
+        }
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+        conns.push_back(Client{fd, 0});
+    }
+    while (server.getClientCount() < static_cast<int>(conns.size()) && elapsedMs(start) < 30000) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    double connect_ms = elapsedMs(start);
+    std::string idle_threads = procStatus("Threads:");
+    std::string idle_rss = procStatus("VmRSS:");
+
+    // Active phase: every client pipelines all its messages, then the
+    // echoes are collected with one client-side epoll loop
+    int epfd = epoll_create1(0);
+    for (size_t i = 0; i < conns.size(); ++i) {
+        epoll_event ev{};
+        ev.events = EPOLLIN;
+        ev.data.u64 = i;
+        epoll_ctl(epfd, EPOLL_CTL_ADD, conns[i].fd, &ev);
+    }
+
+    std::string burst;
+    for (int m = 0; m < messages; ++m) {
+        burst += "{\"type\":\"input_move\",\"data\":{\"seq\":" + std::to_string(m) + "}}\n";
+    }
+
+    start = Clock::now();
+    for (auto& c : conns) {
+        size_t offset = 0;
+        while (offset < burst.size()) {
+            ssize_t n = send(c.fd, burst.data() + offset, burst.size() - offset, MSG_NOSIGNAL);
+            if (n > 0) offset += static_cast<size_t>(n);
+            else std::this_thread::yield();
+        }
+    }
+
+    long long expected = static_cast<long long>(conns.size()) * messages;
+    long long received = 0;
+    std::vector<epoll_event> events(256);
+    char buf[16384];
+    while (received < expected && elapsedMs(start) < 60000) {
+        int n = epoll_wait(epfd, events.data(), static_cast<int>(events.size()), 100);
+        for (int e = 0; e < n; ++e) {
+            Client& c = conns[events[e].data.u64];
+            ssize_t bytes;
+            while ((bytes = recv(c.fd, buf, sizeof(buf), 0)) > 0) {
+                for (ssize_t b = 0; b < bytes; ++b) {
+                    if (buf[b] == '\n') {
+                        ++c.replies;
+                        ++received;
+                    }
+                }
+            }
+        }
+    }
+    double active_ms = elapsedMs(start);
+    std::string active_threads = procStatus("Threads:");
+
+    // Close phase
+    start = Clock::now();
+    for (auto& c : conns) close(c.fd);
+    close(epfd);
+    while (server.getClientCount() > 0 && elapsedMs(start) < 30000) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    double reap_ms = elapsedMs(start);
+    server.stop();
+    std::cout.rdbuf(saved_cout);
+
+    std::cout << "TCP loopback load test (" << io_threads << " I/O thread"
+              << (io_threads == 1 ? "" : "s") << ")" << std::endl;
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "  clients connected   " << conns.size() << " / " << clients
+              << " in " << connect_ms << " ms" << std::endl;
+    std::cout << "  idle                threads " << idle_threads << ", RSS " << idle_rss << std::endl;
+    std::cout << "  echoed              " << received << " / " << expected << " messages in "
+              << active_ms << " ms (" << std::setprecision(0)
+              << (received / (active_ms / 1000.0)) << " msg/s)" << std::setprecision(1) << std::endl;
+    std::cout << "  active              threads " << active_threads << std::endl;
+    std::cout << "  reaped              in " << reap_ms << " ms" << std::endl;
+    return received == expected ? 0 : 1;
+}
+
+#endif // EVE_TCP_SERVER_EPOLL
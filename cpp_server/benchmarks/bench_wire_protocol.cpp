@@ -0,0 +1,163 @@
+/**
+ * State update encoding benchmark
+ *
+ * Encodes and decodes one full state_update of 10 to 1000 ships in the
+ * JSON format the server sends by default and in the binary wire format
+ * (network/wire_format.h), and reports bytes per entity and microseconds
+ * per message for each. The JSON is laid out exactly as GameSession
+ * writes it. JSON decoding is timed only when the benchmark is built
+ * against the client's nlohmann/json.
+ *
+ * Usage: bench_wire_protocol [iterations]
+ */
+
+#include "network/wire_format.h"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef BENCH_HAVE_NLOHMANN_JSON
+#include <nlohmann/json.hpp>
+#endif
+
+using namespace atlas;
+namespace wire = atlas::network::wire;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double elapsedUs(Clock::time_point start) {
+    return std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+}
+
+wire::StateUpdate makeUpdate(int entity_count) {
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> coord(-150000.0f, 150000.0f);
+    std::uniform_real_distribution<float> speed(-300.0f, 300.0f);
+    std::uniform_real_distribution<float> angle(-3.14f, 3.14f);
+    std::uniform_real_distribution<float> hp(0.0f, 5000.0f);
+
+    wire::StateUpdate msg;
+    msg.sequence = 123456;
+    msg.partial = true;
+    msg.timestamp = 987654321;
+    for (int i = 0; i < entity_count; ++i) {
+        wire::EntityState e;
+        e.id = "npc_" + std::to_string(i);
+        e.fields = wire::EntityState::kPos | wire::EntityState::kVel | wire::EntityState::kHealth
+                 | wire::EntityState::kCapacitor | wire::EntityState::kShip | wire::EntityState::kFaction;
+        e.x = coord(rng);
+        e.y = coord(rng);
+        e.z = coord(rng);
+        e.rotation = angle(rng);
+        e.vx = speed(rng);
+        e.vy = speed(rng);
+        e.vz = speed(rng);
+        e.shield = hp(rng);
+        e.armor = hp(rng);
+        e.hull = hp(rng);
+        e.shield_max = e.armor_max = e.hull_max = 5000.0f;
+        e.capacitor = hp(rng);
+        e.capacitor_max = 5000.0f;
+        e.ship_type = "Frigate";
+        e.ship_name = "Rifter";
+        e.faction = "Minmatar";
+        msg.entities.push_back(std::move(e));
+    }
+    return msg;
+}
+
+std::string encodeJson(const wire::StateUpdate& msg) {
+    std::ostringstream json;
+    json << "{\"type\":\"state_update\",\"data\":{"
+         << "\"sequence\":" << msg.sequence << ","
+         << "\"timestamp\":" << msg.timestamp << ","
+         << "\"partial\":true,\"removed\":[],\"entities\":[";
+    bool first = true;
+    for (const auto& e : msg.entities) {
+        if (!first) json << ",";
+        first = false;
+        json << "{\"id\":\"" << e.id << "\""
+             << ",\"pos\":{\"x\":" << e.x << ",\"y\":" << e.y << ",\"z\":" << e.z
+             << ",\"rot\":" << e.rotation << "}"
+             << ",\"vel\":{\"vx\":" << e.vx << ",\"vy\":" << e.vy << ",\"vz\":" << e.vz << "}"
+             << ",\"health\":{\"shield\":" << e.shield << ",\"armor\":" << e.armor
+             << ",\"hull\":" << e.hull << ",\"max_shield\":" << e.shield_max
+             << ",\"max_armor\":" << e.armor_max << ",\"max_hull\":" << e.hull_max << "}"
+             << ",\"capacitor\":{\"current\":" << e.capacitor << ",\"max\":" << e.capacitor_max << "}"
+             << ",\"ship_type\":\"" << e.ship_type << "\""
+             << ",\"ship_name\":\"" << e.ship_name << "\""
+             << ",\"faction\":\"" << e.faction << "\"}";
+    }
+    json << "]}}";
+    return json.str();
+}
+
+void runSize(int entity_count, int iterations) {
+    wire::StateUpdate msg = makeUpdate(entity_count);
+
+    std::string json;
+    auto start = Clock::now();
+    for (int it = 0; it < iterations; ++it) {
+        json = encodeJson(msg);
+    }
+    double json_encode_us = elapsedUs(start) / iterations;
+
+    std::string frame;
+    start = Clock::now();
+    for (int it = 0; it < iterations; ++it) {
+        frame.clear();
+        wire::encode(msg, frame);
+    }
+    double binary_encode_us = elapsedUs(start) / iterations;
+
+    wire::StateUpdate decoded;
+    start = Clock::now();
+    for (int it = 0; it < iterations; ++it) {
+        if (!wire::decode(frame.data() + wire::kHeaderSize, frame.size() - wire::kHeaderSize, decoded)) {
+            std::cerr << "binary decode failed" << std::endl;
+            std::exit(1);
+        }
+    }
+    double binary_decode_us = elapsedUs(start) / iterations;
+
+    std::cout << std::setw(5) << entity_count
+              << "  json " << std::setw(6) << json.size() / entity_count << " B/ent"
+              << "  enc " << std::setw(8) << json_encode_us;
+#ifdef BENCH_HAVE_NLOHMANN_JSON
+    start = Clock::now();
+    size_t parsed = 0;
+    for (int it = 0; it < iterations; ++it) {
+        auto doc = nlohmann::json::parse(json);
+        parsed += doc["data"]["entities"].size();
+    }
+    double json_decode_us = elapsedUs(start) / iterations;
+    std::cout << "  dec " << std::setw(9) << json_decode_us;
+    if (parsed == 0) std::cout << " (empty)";
+#endif
+    std::cout << "  |  binary " << std::setw(4) << frame.size() / entity_count << " B/ent"
+              << "  enc " << std::setw(7) << binary_encode_us
+              << "  dec " << std::setw(7) << binary_decode_us
+              << "  (" << std::setw(5) << static_cast<double>(json.size()) / frame.size()
+              << "x smaller)\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int iterations = argc > 1 ? std::atoi(argv[1]) : 200;
+    if (iterations <= 0) iterations = 200;
+
+    std::cout << "State update encoding benchmark (us per message, all fields sent)" << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+    for (int entity_count : {10, 100, 500, 1000}) {
+        runSize(entity_count, iterations);
+    }
+    return 0;
+}
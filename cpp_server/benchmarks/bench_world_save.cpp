@@ -0,0 +1,133 @@
+/**
+ * World save format benchmark
+ *
+ * Saves and loads the same world as JSON (world_state.json), compressed
+ * JSON (.atlasw) and the columnar binary format (.atlasb), and reports
+ * encode, write, load times and file sizes.
+ *
+ * Usage: bench_world_save [entities] [directory]
+ */
+
+#include "data/world_binary_format.h"
+#include "data/world_persistence.h"
+#include "components/game_components.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+using namespace atlas;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double elapsedMs(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+long fileSize(const std::string& path) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    return file ? static_cast<long>(file.tellg()) : -1;
+}
+
+// A mix resembling a populated server: every entity moves and fights,
+// some are NPCs, a few carry cargo
+void populate(ecs::World& world, int entity_count) {
+    static const char* kFactions[] = {"Caldari", "Amarr", "Gallente", "Minmatar"};
+    for (int i = 0; i < entity_count; ++i) {
+        auto* e = world.createEntity("ship_" + std::to_string(i));
+        auto pos = std::make_unique<components::Position>();
+        pos->x = static_cast<float>(i) * 10.0f;
+        pos->y = static_cast<float>(i % 100);
+        e->addComponent(std::move(pos));
+        auto vel = std::make_unique<components::Velocity>();
+        vel->vx = 1.0f;
+        e->addComponent(std::move(vel));
+        e->addComponent(std::make_unique<components::Health>());
+        e->addComponent(std::make_unique<components::Capacitor>());
+        auto ship = std::make_unique<components::Ship>();
+        ship->ship_name = "Rifter";
+        e->addComponent(std::move(ship));
+        auto faction = std::make_unique<components::Faction>();
+        faction->faction_name = kFactions[i % 4];
+        e->addComponent(std::move(faction));
+        if (i % 2 == 0) {
+            auto ai = std::make_unique<components::AI>();
+            ai->target_entity_id = "ship_" + std::to_string((i + 1) % entity_count);
+            e->addComponent(std::move(ai));
+            e->addComponent(std::make_unique<components::Weapon>());
+        }
+        if (i % 20 == 0) {
+            auto cargo = std::make_unique<components::Inventory>();
+            components::Inventory::Item ore;
+            ore.item_id = "veldspar";
+            ore.name = "Veldspar";
+            ore.type = "ore";
+            ore.quantity = 1000;
+            cargo->items.push_back(ore);
+            e->addComponent(std::move(cargo));
+        }
+    }
+}
+
+void report(const char* name, double save_ms, double load_ms, long bytes, size_t loaded) {
+    std::cout << "  " << std::left << std::setw(12) << name << std::right
+              << std::setw(10) << save_ms << std::setw(10) << load_ms
+              << std::setw(14) << bytes << std::setw(10) << loaded << "\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int entity_count = argc > 1 ? std::atoi(argv[1]) : 100000;
+    if (entity_count <= 0) entity_count = 100000;
+    std::string dir = argc > 2 ? argv[2] : "/tmp";
+
+    ecs::World world;
+    populate(world, entity_count);
+
+    data::WorldPersistence persistence;
+    data::WorldBinaryFormat binary(persistence);
+    const std::string json_path = dir + "/bench_world.json";
+    const std::string atlasw_path = dir + "/bench_world.atlasw";
+    const std::string atlasb_path = dir + "/bench_world.atlasb";
+
+    std::cout << "World save benchmark, " << entity_count << " entities\n";
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "  format       save ms   load ms         bytes    loaded\n";
+
+    auto start = Clock::now();
+    persistence.saveWorld(&world, json_path);
+    double save_ms = elapsedMs(start);
+    ecs::World json_world;
+    start = Clock::now();
+    persistence.loadWorld(&json_world, json_path);
+    report("json", save_ms, elapsedMs(start), fileSize(json_path), json_world.getEntityCount());
+
+    start = Clock::now();
+    persistence.saveWorldCompressed(&world, atlasw_path);
+    save_ms = elapsedMs(start);
+    ecs::World atlasw_world;
+    start = Clock::now();
+    persistence.loadWorldCompressed(&atlasw_world, atlasw_path);
+    report("compressed", save_ms, elapsedMs(start), fileSize(atlasw_path),
+           atlasw_world.getEntityCount());
+
+    start = Clock::now();
+    binary.save(&world, atlasb_path);
+    save_ms = elapsedMs(start);
+    ecs::World atlasb_world;
+    start = Clock::now();
+    binary.load(&atlasb_world, atlasb_path);
+    report("binary", save_ms, elapsedMs(start), fileSize(atlasb_path),
+           atlasb_world.getEntityCount());
+
+    std::remove(json_path.c_str());
+    std::remove(atlasw_path.c_str());
+    std::remove(atlasb_path.c_str());
+    return 0;
+}
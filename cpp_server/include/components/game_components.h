@@ -2,6 +2,8 @@
 #define EVE_COMPONENTS_GAME_COMPONENTS_H
 
 #include "ecs/component.h"
+#include "ecs/entity_handle.h"
+#include "data/order_book.h"
 #include <string>
 #include <vector>
 #include <map>
@@ -183,6 +185,7 @@ public:
     Behavior behavior = Behavior::Aggressive;
     State state = State::Idle;
     std::string target_entity_id;
+    ecs::EntityHandle target_handle;  // cached resolution of target_entity_id (not persisted)
     float orbit_distance = 1000.0f;  // preferred orbit distance (0 = auto from ship class)
     float awareness_range = 50000.0f;  // meters
     float flee_threshold = 0.25f;  // flee when total HP (shield+armor+hull) below this fraction of max
@@ -621,21 +624,10 @@ public:
  */
 class MarketHub : public ecs::Component {
 public:
-    struct Order {
-        std::string order_id;
-        std::string item_id;
-        std::string item_name;
-        std::string owner_id;       // entity that placed the order
-        bool is_buy_order = false;   // true = buy, false = sell
-        double price_per_unit = 0.0;
-        int quantity = 1;
-        int quantity_remaining = 1;
-        float duration_remaining = -1.0f;  // seconds, -1 = permanent
-        bool fulfilled = false;
-    };
+    using Order = data::OrderBook::Order;
 
     std::string station_id;
-    std::vector<Order> orders;
+    data::OrderBook orders;     // resting buy and sell orders
     double broker_fee_rate = 0.02;  // 2% broker fee
     double sales_tax_rate = 0.04;   // 4% sales tax
 
@@ -1072,6 +1064,21 @@ public:
     COMPONENT_TYPE(Docked)
 };
 
+/**
+ * @brief Solar system an entity is currently in
+ *
+ * GameSession gives player and NPC ships the server's solar_system when
+ * it spawns them. Entities without one count as being in that system.
+ * Used by interest management: clients never receive entities from
+ * other systems.
+ */
+class SystemLocation : public ecs::Component {
+public:
+    std::string system_id;               // matches SolarSystem::system_id
+
+    COMPONENT_TYPE(SystemLocation)
+};
+
 /**
  * @brief Wreck entity — remains of a destroyed ship
  */
@@ -17,6 +17,7 @@ struct ServerConfig {
     std::string host = "0.0.0.0";
     uint16_t port = 8765;
     int max_connections = 100;
+    int network_io_threads = 1;      // epoll I/O threads (Linux)
     
     // Server settings
     std::string server_name = "EVE OFFLINE Dedicated Server";
@@ -24,6 +25,9 @@ struct ServerConfig {
     bool persistent_world = true;
     bool auto_save = true;
     int save_interval_seconds = 300; // 5 minutes
+    std::string save_format = "json"; // json, compressed (.atlasw) or binary (.atlasb)
+    bool save_journal = true;        // autosave appends changes to world_state.journal
+    int journal_compact_percent = 50; // rewrite the base once the journal reaches this % of it
     
     // Access control
     bool use_whitelist = false;
@@ -38,13 +42,45 @@ struct ServerConfig {
     
     // Game settings
     float tick_rate = 30.0f;
+    std::string tick_catch_up = "catch_up";   // "catch_up", "skip" or "dilate"
+    int tick_max_catch_up = 5;                // missed ticks replayed before skipping
+    int tick_spin_us = 500;                   // busy-wait before each tick deadline
     int max_entities = 10000;
+    int system_worker_threads = 0;   // 0 = run ECS systems sequentially
+    std::string solar_system = "thyrkstad";   // system this server simulates; ships spawn in it
+    
+    // Per-client interest management (state update relevance)
+    float interest_near_range = 150000.0f;    // meters; sent every tick
+    float interest_far_range = 1000000.0f;    // meters; <= 0 = whole system
+    int interest_far_interval = 10;           // ticks between far updates
+    
+    // NPC AI think scheduling: NPCs in combat or near a player think every
+    // tick, the rest take turns within a per-tick budget
+    float ai_near_range = 60000.0f;           // meters from a player
+    int ai_think_interval = 10;               // ticks between turns; 1 = every tick
+    int ai_think_budget_turns = 2000;         // turns per tick; 0 = no limit
     
     // Paths
     std::string data_path = "../data";
     std::string save_path = "./saves";
     std::string log_path = "./logs";
     
+    // Logging: async mode writes from a background thread
+    bool log_async = true;
+    int log_flush_interval_ms = 200;
+    int log_queue_size = 8192;        // lines buffered per logging thread
+    int log_max_file_mb = 64;         // rotate server.log at this size; 0 = never
+    int log_max_files = 5;            // rotated files kept
+    
+    // Metrics in the Prometheus text format, rewritten every interval;
+    // empty disables the file
+    std::string metrics_file = "./logs/metrics.prom";
+    int metrics_interval_seconds = 10;
+    
+    // Record the starting world and every tick's client commands here for
+    // --replay; empty disables recording
+    std::string tick_recording = "";
+    
     // Load from JSON file
     bool loadFromFile(const std::string& filepath);
     
@@ -0,0 +1,98 @@
+#ifndef EVE_DATA_ASYNC_WORLD_SAVER_H
+#define EVE_DATA_ASYNC_WORLD_SAVER_H
+
+#include "data/world_journal.h"
+#include "data/world_persistence.h"
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace atlas {
+namespace data {
+
+/**
+ * @brief Saves the world without stalling the tick thread
+ *
+ * begin() takes a WorldSnapshot on the calling thread; encoding in the
+ * requested SaveFormat and the atomic file write then run on a worker
+ * thread while the simulation continues. One save runs at a time.
+ * Given a WorldJournal, the worker commits the snapshot to it instead,
+ * writing only what changed.
+ *
+ * @code
+ *   if (saver.begin(world, path, SaveFormat::Json)) { ... }
+ *   AsyncWorldSaver::Result result;
+ *   if (saver.poll(result)) { ... }   // once per tick
+ * @endcode
+ */
+class AsyncWorldSaver {
+public:
+    struct Result {
+        bool ok = false;
+        std::string filepath;
+        size_t entities = 0;
+        size_t bytes = 0;               // size of the file written
+        double snapshot_ms = 0.0;       // on the thread that called begin()
+        double background_ms = 0.0;     // encode + write
+        bool journaled = false;         // committed to a WorldJournal
+        bool compacted = false;         // the journal rewrote its base save
+        size_t upserts = 0;             // journal records written
+        size_t removals = 0;
+    };
+
+    explicit AsyncWorldSaver(const WorldPersistence& persistence);
+
+    /// Finishes a pending save before returning
+    ~AsyncWorldSaver();
+
+    AsyncWorldSaver(const AsyncWorldSaver&) = delete;
+    AsyncWorldSaver& operator=(const AsyncWorldSaver&) = delete;
+
+    /**
+     * @brief Snapshot world now and save it to filepath in the background
+     * @return false, without taking a snapshot, while the previous save runs
+     */
+    bool begin(const ecs::World* world, const std::string& filepath, SaveFormat format);
+
+    /**
+     * @brief Snapshot world now and commit it to journal in the background
+     *
+     * The journal must outlive the save; it is only used on the worker
+     * thread until wait() returns or the save is polled.
+     */
+    bool begin(const ecs::World* world, WorldJournal& journal);
+
+    /// Whether a save is still running
+    bool isBusy() const;
+
+    /// Hand over the result of a finished save, once; false if there is none
+    bool poll(Result& out);
+
+    /// Block until the running save (if any) has finished
+    void wait();
+
+private:
+    bool start(const ecs::World* world, const std::string& filepath, SaveFormat format,
+               WorldJournal* journal);
+    void workerLoop();
+
+    const WorldPersistence& persistence_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::unique_ptr<WorldSnapshot> job_;
+    WorldJournal* journal_ = nullptr;   // journaled save when set
+    SaveFormat format_ = SaveFormat::Json;
+    Result current_;
+    bool busy_ = false;
+    bool has_result_ = false;
+    bool stop_ = false;
+    std::thread worker_;                // started by the first begin()
+};
+
+} // namespace data
+} // namespace atlas
+
+#endif // EVE_DATA_ASYNC_WORLD_SAVER_H
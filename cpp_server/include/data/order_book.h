@@ -0,0 +1,133 @@
+#ifndef EVE_DATA_ORDER_BOOK_H
+#define EVE_DATA_ORDER_BOOK_H
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace atlas {
+namespace data {
+
+/**
+ * @brief Resting market orders of one station, in price-time priority
+ *
+ * Each item has a bid ladder (highest price first) and an ask ladder
+ * (lowest price first). A price level keeps its orders in a FIFO linked
+ * through the order slots, ordered by id, and ids grow with placement
+ * time, so the front of a ladder is always the order to trade with next.
+ *
+ * - add, cancel, and removing a filled order: O(log levels)
+ * - find and best: O(1)
+ * - advance: O(log n) per order that is due; orders that are not due
+ *   cost nothing (a min-heap on expiry time, with lazy deletion)
+ *
+ * Order pointers stay valid until the next call that adds or removes an
+ * order. Not thread-safe; owned by the MarketHub component.
+ */
+class OrderBook {
+public:
+    using OrderId = uint64_t;
+
+    struct Order {
+        OrderId order_id = 0;
+        std::string item_id;
+        std::string item_name;
+        std::string owner_id;       // entity that placed the order
+        bool is_buy_order = false;  // true = buy, false = sell
+        double price_per_unit = 0.0;
+        int quantity = 1;
+        int quantity_remaining = 1;
+        double expires_at = -1.0;   // book time in seconds, < 0 = permanent
+    };
+
+    /**
+     * @brief Rest an order in the book
+     * @param order order_id 0 assigns the next id; a restored order keeps its own
+     * @param duration seconds until it expires, < 0 = permanent
+     * @return the order id, or 0 if the id is taken or nothing remains
+     */
+    OrderId add(Order order, float duration = -1.0f);
+
+    /// Remove an order; copies it to removed if given. False if unknown
+    bool cancel(OrderId id, Order* removed = nullptr);
+
+    /// Take up to quantity from an order, removing it once empty; returns the amount taken
+    int fill(OrderId id, int quantity);
+
+    const Order* find(OrderId id) const;
+
+    /// Front of the item's bid (buy_side) or ask ladder; nullptr if empty
+    const Order* best(const std::string& item_id, bool buy_side) const;
+
+    /**
+     * @brief Move the book clock forward and drop every order that is due
+     * @param on_expire called with each expired order before it is removed
+     * @return number of orders expired
+     */
+    size_t advance(double delta_seconds,
+                   const std::function<void(const Order&)>& on_expire = nullptr);
+
+    /// Seconds until the order expires, or -1 if permanent
+    float durationRemaining(const Order& order) const;
+
+    double now() const { return now_; }
+    size_t size() const { return index_.size(); }
+    bool empty() const { return index_.empty(); }
+    size_t itemCount() const { return items_.size(); }
+
+    /// Visit every resting order (no particular order)
+    template<typename Fn>
+    void forEach(Fn&& fn) const {
+        for (const auto& slot : slots_) {
+            if (slot.live) fn(slot.order);
+        }
+    }
+
+private:
+    static constexpr uint32_t kNone = UINT32_MAX;
+
+    struct Slot {
+        Order order;
+        uint32_t prev = kNone;      // neighbours within the price level
+        uint32_t next = kNone;
+        bool live = false;
+    };
+
+    struct Level {
+        uint32_t head = kNone;
+        uint32_t tail = kNone;
+    };
+
+    struct ItemBook {
+        std::map<double, Level, std::greater<double>> bids;
+        std::map<double, Level> asks;
+    };
+
+    struct Expiry {
+        double at;
+        OrderId id;
+        bool operator>(const Expiry& other) const { return at > other.at; }
+    };
+
+    Level* levelOf(const Order& order);
+    void link(Level& level, uint32_t slot);
+    void remove(uint32_t slot);
+    void compactExpiries();
+
+    std::vector<Slot> slots_;
+    std::vector<uint32_t> free_slots_;
+    std::unordered_map<OrderId, uint32_t> index_;
+    std::unordered_map<std::string, ItemBook> items_;
+    std::vector<Expiry> expiries_;      // min-heap on at
+    size_t stale_expiries_ = 0;         // heap entries of orders already gone
+    OrderId next_id_ = 1;
+    double now_ = 0.0;
+};
+
+} // namespace data
+} // namespace atlas
+
+#endif // EVE_DATA_ORDER_BOOK_H
@@ -0,0 +1,138 @@
+#ifndef EVE_DATA_TICK_RECORDING_H
+#define EVE_DATA_TICK_RECORDING_H
+
+#include "ecs/world.h"
+#include "network/protocol_handler.h"
+#include "network/tcp_server.h"
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace atlas {
+namespace data {
+
+/**
+ * @brief A client command as GameSession::processInbound() applies it
+ *
+ * GameSession queues exactly this from the network threads, so what is
+ * recorded is what ran.
+ */
+struct RecordedCommand {
+    enum class Kind : uint8_t { Message, Frame, Disconnect };
+    Kind kind = Kind::Message;
+    network::ClientConnection client{};
+    network::MessageType type = network::MessageType::CONNECT;
+    std::string data;   // JSON data block, or one binary frame
+};
+
+/**
+ * @brief Writes a tick recording: a world snapshot and its handle
+ * table, then every tick's delta and the commands applied on it
+ *
+ * Replaying a recording (Server::replay) re-runs the same ticks with the
+ * same input in the same order, headless and as fast as possible. The
+ * handle table (World::HandleLayout) lets the replay give every entity
+ * the handle it had, so handle-ordered logic decides the same way.
+ *
+ * @code
+ *   header   magic "ATLASTR\0", u32 version, u32 reserved,
+ *            u64 snapshot size, snapshot (WorldBinaryFormat image)
+ *   layout   u32 slot count, u32 generation per slot,         version 2+
+ *            u32 free count, u32 free slot each,
+ *            u32 entity count, per entity (creation order):
+ *                u32 slot, u16 id length, id
+ *   records  'T' u64 tick number, f32 delta                  tick start
+ *            'C' u8 kind, u16 message type, i64 socket, u16 port,
+ *                u16 address length, address, u32 data length, data
+ *            'Z'                                              clean end
+ * @endcode
+ *
+ * Records are buffered and written in blocks of about kFlushBytes, so a
+ * crash loses at most the last block; a reader stops at a torn record.
+ * Main thread only.
+ */
+class TickRecorder {
+public:
+    static constexpr uint32_t kVersion = 2;
+    static constexpr size_t kFlushBytes = 64 * 1024;
+
+    TickRecorder() = default;
+    ~TickRecorder();
+
+    TickRecorder(const TickRecorder&) = delete;
+    TickRecorder& operator=(const TickRecorder&) = delete;
+
+    /// Create filepath and write the header; snapshot is the world at tick 0
+    bool open(const std::string& filepath, const std::string& snapshot,
+              const ecs::World::HandleLayout& layout = {});
+
+    bool isOpen() const { return file_ != nullptr; }
+
+    /// Start a tick; commands recorded after this were applied on it
+    void beginTick(uint64_t number, float delta);
+
+    void recordCommand(const RecordedCommand& command);
+
+    /// Write the end marker and close the file
+    void close();
+
+    uint64_t getTickCount() const { return ticks_; }
+    uint64_t getCommandCount() const { return commands_; }
+    uint64_t getBytesWritten() const { return bytes_; }
+
+private:
+    void flush();
+
+    FILE* file_ = nullptr;
+    std::string buffer_;
+    uint64_t ticks_ = 0;
+    uint64_t commands_ = 0;
+    uint64_t bytes_ = 0;
+};
+
+/**
+ * @brief Reads a recording written by TickRecorder, one tick at a time
+ */
+class TickRecordingReader {
+public:
+    struct Tick {
+        uint64_t number = 0;
+        float delta = 0.0f;
+        std::vector<RecordedCommand> commands;
+    };
+
+    /// Read the header and snapshot; false if the file is not a recording
+    bool open(const std::string& filepath);
+
+    /// World snapshot to start from (WorldBinaryFormat image)
+    const std::string& getSnapshot() const { return snapshot_; }
+
+    /// Handle table of the snapshot; empty for version 1 recordings
+    const ecs::World::HandleLayout& getHandleLayout() const { return layout_; }
+
+    /// Read the next tick; false at the end of the recording
+    bool next(Tick& tick);
+
+    /// Whether the recording ended without its end marker (crash, torn write)
+    bool isTruncated() const { return truncated_; }
+
+private:
+    template<typename T> bool read(T& value);
+    bool readBytes(std::string& out, size_t size);
+    bool readLayout();
+
+    std::ifstream file_;
+    std::string snapshot_;
+    ecs::World::HandleLayout layout_;
+    bool has_tick_ = false;     // a 'T' record was read ahead
+    Tick pending_;
+    bool done_ = false;
+    bool truncated_ = false;
+};
+
+} // namespace data
+} // namespace atlas
+
+#endif // EVE_DATA_TICK_RECORDING_H
@@ -0,0 +1,82 @@
+#ifndef EVE_DATA_WORLD_BINARY_FORMAT_H
+#define EVE_DATA_WORLD_BINARY_FORMAT_H
+
+#include "data/world_persistence.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace atlas {
+namespace data {
+
+/**
+ * @brief Versioned binary world save (.atlasb), loaded through mmap
+ *
+ * The file is columnar: one section per component type holding
+ * fixed-width records (entity index + the component's persisted fields),
+ * so loading a section is a loop of memcpy's with no parsing. Strings
+ * are stored once in a shared string table and referenced by index.
+ *
+ * @code
+ *   header      magic "ATLASWB\0", version, section count, entity count,
+ *               journal_seq, string table offset, file size, string table checksum
+ *   directory   per section: tag, record size, record count, offset, checksum
+ *   sections    8-byte aligned; tag 1 = entity ids, tag 2 = JSON fallback,
+ *               other tags = one component type each
+ *   strings     count, offsets[count + 1], bytes
+ * @endcode
+ *
+ * Components whose persisted data is nested (inventories, order books,
+ * relationship lists, ...) keep their JSON encoding, stored per entity
+ * in the fallback section. A loader skips sections with tags it does
+ * not know, so new component sections can be added without a version
+ * bump; changing an existing record layout needs one.
+ */
+class WorldBinaryFormat {
+public:
+    static constexpr uint32_t kVersion = 1;
+
+    explicit WorldBinaryFormat(const WorldPersistence& persistence);
+
+    /// Encode entities into a file image; journal_seq is stored in the header
+    std::string encode(const std::vector<const ecs::Entity*>& entities,
+                       uint64_t journal_seq = 0) const;
+
+    std::string encodeWorld(const ecs::World* world, uint64_t journal_seq = 0) const;
+    std::string encodeSnapshot(const WorldSnapshot& snapshot, uint64_t journal_seq = 0) const;
+
+    /**
+     * @brief Create the entities of a file image in world
+     * @param journal_seq receives the header's journal sequence if not null
+     * @return false if the image is truncated, corrupt or a newer version
+     */
+    bool decode(ecs::World* world, const char* data, size_t size,
+                uint64_t* journal_seq = nullptr) const;
+
+    /// Save the world atomically (see WorldPersistence::writeFileAtomic)
+    bool save(const ecs::World* world, const std::string& filepath) const;
+
+    /// Map filepath into memory and decode it
+    bool load(ecs::World* world, const std::string& filepath,
+              uint64_t* journal_seq = nullptr) const;
+
+    /// Whether the file starts with the .atlasb magic
+    static bool isBinaryFile(const std::string& filepath);
+
+    /**
+     * @brief Convert a save between formats
+     *
+     * A JSON or .atlasw input is written as .atlasb; an .atlasb input is
+     * written back as JSON.
+     */
+    bool convert(const std::string& input_path, const std::string& output_path) const;
+
+private:
+    const WorldPersistence& persistence_;
+};
+
+} // namespace data
+} // namespace atlas
+
+#endif // EVE_DATA_WORLD_BINARY_FORMAT_H
@@ -0,0 +1,115 @@
+#ifndef EVE_DATA_WORLD_JOURNAL_H
+#define EVE_DATA_WORLD_JOURNAL_H
+
+#include "data/world_persistence.h"
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace atlas {
+namespace data {
+
+/**
+ * @brief Incremental world persistence: a base save plus a change journal
+ *
+ * Each commit compares a WorldSnapshot with what is already on disk and
+ * appends only the entities that changed, appeared or disappeared to an
+ * append-only journal, so an autosave writes the churn instead of the
+ * whole world. Once the journal grows past a fraction of the base save
+ * it is compacted: the full world is written as the new base and the
+ * journal starts over.
+ *
+ * Components are plain data written through raw pointers, so an entity
+ * counts as dirty when the fingerprint of its serialized record differs
+ * from the one last written. Fingerprinting runs wherever commit() runs
+ * (the autosave thread), never on the tick.
+ *
+ * Journal format, one line per record:
+ * @code
+ *   B <seq> <records>          batch header
+ *   U <entity json>            upsert an entity
+ *   D <entity id>              remove an entity
+ *   E <seq> <checksum>         batch trailer; FNV-1a of the record lines
+ * @endcode
+ * The base save records the last batch it contains as "journal_seq"
+ * (in the file header for the binary format).
+ * load() replays complete batches newer than that and drops a torn tail
+ * left by a crash mid-append.
+ *
+ * Not thread-safe; use from one thread at a time.
+ */
+class WorldJournal {
+public:
+    struct CommitStats {
+        bool ok = false;
+        bool compacted = false;     // wrote a new base instead of a batch
+        size_t upserts = 0;
+        size_t removals = 0;
+        uint64_t bytes = 0;         // bytes written
+    };
+
+    /**
+     * @param base_path    full save (world_state.json, .atlasw or .atlasb)
+     * @param journal_path append-only change log
+     * @param format       encoding of the base save
+     */
+    WorldJournal(const WorldPersistence& persistence, const std::string& base_path,
+                 const std::string& journal_path, SaveFormat format);
+
+    /// Compact once the journal exceeds this share of the base size (default 0.5)
+    void setCompactRatio(double ratio) { compact_ratio_ = ratio; }
+
+    /// Whether a base save or journal exists to load
+    bool exists() const;
+
+    /**
+     * @brief Load the base save, then replay the journal on top of it
+     *
+     * Also records what is on disk, so the next commit writes only changes.
+     */
+    bool load(ecs::World* world);
+
+    /// Append the changes since the last commit; compacts when due
+    CommitStats commit(const WorldSnapshot& snapshot);
+
+    /// Write snapshot as the new base and empty the journal
+    CommitStats compact(const WorldSnapshot& snapshot);
+
+    uint64_t getSequence() const { return seq_; }
+    uint64_t getJournalBytes() const { return journal_bytes_; }
+    uint64_t getBaseBytes() const { return base_bytes_; }
+    const std::string& getJournalPath() const { return journal_path_; }
+
+    /// 64-bit FNV-1a; fingerprints entity records
+    static uint64_t fingerprint(const std::string& data);
+
+    /// Sum of every entity record's fingerprint; independent of entity order
+    static uint64_t fingerprintWorld(const WorldPersistence& persistence, const ecs::World* world);
+
+private:
+    bool replay(ecs::World* world, uint64_t base_seq);
+    void serializeAll(const WorldSnapshot& snapshot, std::vector<std::string>& records,
+                      std::vector<uint64_t>& prints) const;
+    CommitStats writeBase(const WorldSnapshot& snapshot, const std::vector<std::string>& records,
+                          const std::vector<uint64_t>& prints);
+
+    const WorldPersistence& persistence_;
+    std::string base_path_;
+    std::string journal_path_;
+    SaveFormat format_;
+    double compact_ratio_ = 0.5;
+
+    uint64_t seq_ = 0;              // last batch written or replayed
+    uint64_t base_bytes_ = 0;
+    uint64_t journal_bytes_ = 0;
+    bool has_base_ = false;
+
+    // Fingerprint of every entity as it stands on disk
+    std::unordered_map<std::string, uint64_t> on_disk_;
+};
+
+} // namespace data
+} // namespace atlas
+
+#endif // EVE_DATA_WORLD_JOURNAL_H
@@ -4,16 +4,49 @@
 #include "ecs/world.h"
 #include <string>
 #include <cstdint>
+#include <memory>
+#include <vector>
 
 namespace atlas {
 namespace data {
 
+/**
+ * @brief Detached copy of the persisted parts of a world
+ *
+ * Taken on the tick thread by WorldPersistence::snapshotWorld(); it
+ * shares nothing with the live world, so it can be serialized on
+ * another thread while the simulation keeps running.
+ */
+class WorldSnapshot {
+public:
+    WorldSnapshot() = default;
+    WorldSnapshot(const WorldSnapshot&) = delete;
+    WorldSnapshot& operator=(const WorldSnapshot&) = delete;
+
+    size_t getEntityCount() const { return entities_.size(); }
+    const std::vector<std::unique_ptr<ecs::Entity>>& getEntities() const { return entities_; }
+
+private:
+    friend class WorldPersistence;
+
+    // Declared first so the entities release their slots before it goes
+    ecs::ComponentStorage storage_;
+    std::vector<std::unique_ptr<ecs::Entity>> entities_;
+};
+
+/// Encoding of a full world save on disk
+enum class SaveFormat {
+    Json,           ///< world_state.json
+    Compressed,     ///< RLE-compressed JSON, world_state.atlasw
+    Binary          ///< columnar binary, world_state.atlasb (see WorldBinaryFormat)
+};
+
 /**
  * @brief Serializes and deserializes world state for persistent worlds
  *
  * Saves all entity data (position, velocity, health, capacitor, ship,
  * faction, AI, weapon, target, wormhole, fleet membership, station,
- * docked, wreck, captain personality, fleet morale, captain relationship,
+ * docked, system location, wreck, captain personality, fleet morale, captain relationship,
  * emotional state, captain memory, fleet formation, fleet cargo pool,
  * rumor log, mineral deposit, system resources, market hub) to a JSON
  * file and restores it on load.
@@ -36,6 +69,20 @@ public:
     /// Serialize world state to a JSON string (useful for tests and network).
     std::string serializeWorld(const ecs::World* world) const;
 
+    /// Serialize a single entity to a JSON object string.
+    std::string serializeEntity(const ecs::Entity* entity) const;
+
+    /**
+     * @brief Copy every persisted component into a detached snapshot
+     *
+     * Costs one component copy per entity and component, far less than
+     * serializing; call it on the thread that owns the world.
+     */
+    std::unique_ptr<WorldSnapshot> snapshotWorld(const ecs::World* world) const;
+
+    /// Serialize a snapshot to the same JSON as serializeWorld(); thread-safe.
+    std::string serializeSnapshot(const WorldSnapshot& snapshot) const;
+
     /// Deserialize a JSON string into the world.
     bool deserializeWorld(ecs::World* world, const std::string& json) const;
 
@@ -56,9 +103,32 @@ public:
     /// Compute a simple 32-bit checksum.
     static uint32_t checksum(const std::string& data);
 
+    /// Build the .atlasw file image (header + compressed data) for a JSON string.
+    static std::string encodeCompressed(const std::string& json);
+
+    /// Recover the JSON from an .atlasw file image; false if it is corrupt.
+    static bool decodeCompressed(const std::string& image, std::string& json);
+
+    /**
+     * @brief Replace filepath with data atomically
+     *
+     * Writes a temporary file next to it, flushes it to disk and renames
+     * it over the target, so a crash leaves either the old or the new file.
+     */
+    static bool writeFileAtomic(const std::string& filepath, const std::string& data);
+
+    /// File extension for a save format, including the dot
+    static const char* saveFormatExtension(SaveFormat format);
+
+    /// Parse "json", "compressed" or "binary"; false if name is unknown
+    static bool parseSaveFormat(const std::string& name, SaveFormat& out);
+
 private:
-    /// Serialize a single entity to a JSON object string.
-    std::string serializeEntity(const ecs::Entity* entity) const;
+    friend class WorldJournal;
+    friend class WorldBinaryFormat;
+
+    /// Serialize entities into the {"entities":[...]} document.
+    std::string serializeEntities(const std::vector<const ecs::Entity*>& entities) const;
 
     /// Deserialize a single entity JSON object and create it in the world.
     bool deserializeEntity(ecs::World* world, const std::string& json) const;
@@ -0,0 +1,52 @@
+#ifndef EVE_ECS_COMMAND_BUFFER_H
+#define EVE_ECS_COMMAND_BUFFER_H
+
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace atlas {
+namespace ecs {
+
+class World;
+
+/**
+ * @brief Queue of deferred structural changes
+ *
+ * Systems running in parallel (or inside World::parallelFor chunks)
+ * must not create or destroy entities or add or remove components,
+ * because that rewrites pools and cached queries other threads are
+ * reading. They record the change here instead; the World applies the
+ * queue at the end of the tick, in recording order.
+ *
+ * Recording is thread-safe. Commands should look entities up by handle
+ * when they run, since the entity may be gone by then.
+ */
+class CommandBuffer {
+public:
+    using Command = std::function<void(World&)>;
+
+    CommandBuffer() = default;
+    CommandBuffer(const CommandBuffer&) = delete;
+    CommandBuffer& operator=(const CommandBuffer&) = delete;
+
+    void record(Command command);
+
+    /**
+     * @brief Run and clear every recorded command
+     * @return Number of commands executed
+     */
+    size_t apply(World& world);
+
+    size_t size() const;
+    bool empty() const { return size() == 0; }
+
+private:
+    mutable std::mutex mutex_;
+    std::vector<Command> commands_;
+};
+
+} // namespace ecs
+} // namespace atlas
+
+#endif // EVE_ECS_COMMAND_BUFFER_H
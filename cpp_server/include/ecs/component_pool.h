@@ -0,0 +1,260 @@
+#ifndef EVE_ECS_COMPONENT_POOL_H
+#define EVE_ECS_COMPONENT_POOL_H
+
+#include "component.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace atlas {
+namespace ecs {
+
+class Entity;
+
+/**
+ * @brief Dense, process-wide integer id for each component type
+ *
+ * Ids are handed out on first use and are small enough to index
+ * arrays directly, replacing std::type_index hash lookups.
+ */
+using ComponentTypeId = uint32_t;
+
+namespace detail {
+inline ComponentTypeId nextComponentTypeId() {
+    static std::atomic<ComponentTypeId> counter{0};
+    return counter.fetch_add(1, std::memory_order_relaxed);
+}
+} // namespace detail
+
+template<typename T>
+ComponentTypeId componentTypeId() {
+    static const ComponentTypeId id = detail::nextComponentTypeId();
+    return id;
+}
+
+/**
+ * @brief Type-erased interface so storage can release any component
+ */
+class ComponentPoolBase {
+public:
+    virtual ~ComponentPoolBase() = default;
+
+    // Destroy the component in the given slot and make the slot reusable
+    virtual void release(uint32_t slot) = 0;
+
+    // Number of live components in the pool
+    virtual size_t size() const = 0;
+
+    // Component in an occupied slot
+    virtual Component* component(uint32_t slot) = 0;
+
+    /**
+     * @brief Move the components in order[i] to slot i and drop free slots
+     *
+     * Every slot's generation changes. Callers must re-point whatever
+     * refers to the old slots (see World::canonicalize).
+     */
+    virtual void reorder(const std::vector<uint32_t>& order) = 0;
+};
+
+/**
+ * @brief Contiguous storage for every component of type T in a world
+ *
+ * Components live by value in fixed-size pages, so all Positions (or
+ * Velocities, Healths, ...) are packed next to each other and can be
+ * streamed through with each(). Pages are never moved or freed while
+ * the pool is alive, so a T* stays valid until that component is
+ * removed. Freed slots are reused before the pool grows; each slot's
+ * generation changes whenever a new component is stored in it, so a
+ * reused or replaced component can be told apart from the old one.
+ */
+template<typename T>
+class ComponentPool : public ComponentPoolBase {
+public:
+    // Aim for roughly 16 KB pages, but never fewer than 16 components
+    static constexpr uint32_t kPageSize =
+        (16384 / sizeof(T)) < 16 ? 16 : static_cast<uint32_t>(16384 / sizeof(T));
+
+    ComponentPool() = default;
+    ComponentPool(const ComponentPool&) = delete;
+    ComponentPool& operator=(const ComponentPool&) = delete;
+
+    ~ComponentPool() override {
+        for (uint32_t slot = 0; slot < owners_.size(); ++slot) {
+            if (owners_[slot]) at(slot)->~T();
+        }
+    }
+
+    /**
+     * @brief Move a component into the pool
+     * @return Slot index that identifies the component within this pool
+     */
+    uint32_t emplace(Entity* owner, T&& value) {
+        uint32_t slot;
+        if (!free_slots_.empty()) {
+            slot = free_slots_.back();
+            free_slots_.pop_back();
+        } else {
+            slot = static_cast<uint32_t>(owners_.size());
+            if (slot / kPageSize >= pages_.size()) {
+                pages_.push_back(std::make_unique<Page>());
+            }
+            owners_.push_back(nullptr);
+            generations_.push_back(0);
+        }
+        new (at(slot)) T(std::move(value));
+        owners_[slot] = owner;
+        ++generations_[slot];
+        ++live_;
+        return slot;
+    }
+
+    /**
+     * @brief Replace the component in an occupied slot, keeping its address
+     */
+    void replace(uint32_t slot, T&& value) {
+        T* ptr = at(slot);
+        ptr->~T();
+        new (ptr) T(std::move(value));
+        ++generations_[slot];
+    }
+
+    void release(uint32_t slot) override {
+        if (slot >= owners_.size() || !owners_[slot]) return;
+        at(slot)->~T();
+        owners_[slot] = nullptr;
+        free_slots_.push_back(slot);
+        --live_;
+    }
+
+    size_t size() const override { return live_; }
+
+    Component* component(uint32_t slot) override { return at(slot); }
+
+    void reorder(const std::vector<uint32_t>& order) override {
+        std::vector<std::unique_ptr<Page>> pages;
+        std::vector<Entity*> owners;
+        owners.reserve(order.size());
+        for (uint32_t slot : order) {
+            uint32_t to = static_cast<uint32_t>(owners.size());
+            if (to / kPageSize >= pages.size()) pages.push_back(std::make_unique<Page>());
+            T* from = at(slot);
+            new (&pages.back()->data[to % kPageSize]) T(std::move(*from));
+            from->~T();
+            owners.push_back(owners_[slot]);
+            owners_[slot] = nullptr;
+        }
+        for (uint32_t slot = 0; slot < owners_.size(); ++slot) {
+            if (owners_[slot]) at(slot)->~T();   // not listed: dropped
+        }
+        std::vector<uint32_t> generations(owners.size(), 1);
+        for (uint32_t slot = 0; slot < owners.size() && slot < generations_.size(); ++slot) {
+            generations[slot] = generations_[slot] + 1;
+        }
+        pages_ = std::move(pages);
+        owners_ = std::move(owners);
+        generations_ = std::move(generations);
+        free_slots_.clear();
+        live_ = owners_.size();
+    }
+
+    // Changes every time a component is emplaced into or replaced in the slot
+    uint32_t generation(uint32_t slot) const { return generations_[slot]; }
+
+    T* get(uint32_t slot) { return at(slot); }
+    const T* get(uint32_t slot) const {
+        return const_cast<ComponentPool*>(this)->at(slot);
+    }
+
+    /**
+     * @brief Visit every live component in storage order
+     *
+     * Components may be added or removed from inside fn; new
+     * components appended during the walk are visited as well.
+     */
+    template<typename Fn>
+    void each(Fn&& fn) {
+        for (uint32_t slot = 0; slot < owners_.size(); ++slot) {
+            Entity* owner = owners_[slot];
+            if (owner) fn(owner, *at(slot));
+        }
+    }
+
+    // Number of slots (live or free); the bound for eachInRange()
+    uint32_t slotCount() const { return static_cast<uint32_t>(owners_.size()); }
+
+    /**
+     * @brief Visit live components in slots [begin, end)
+     *
+     * Disjoint ranges touch disjoint memory, so they can be walked from
+     * different threads as long as no component is added or removed.
+     */
+    template<typename Fn>
+    void eachInRange(uint32_t begin, uint32_t end, Fn&& fn) {
+        if (end > owners_.size()) end = static_cast<uint32_t>(owners_.size());
+        for (uint32_t slot = begin; slot < end; ++slot) {
+            Entity* owner = owners_[slot];
+            if (owner) fn(owner, *at(slot));
+        }
+    }
+
+private:
+    struct Page {
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type data[kPageSize];
+    };
+
+    T* at(uint32_t slot) {
+        return std::launder(reinterpret_cast<T*>(&pages_[slot / kPageSize]->data[slot % kPageSize]));
+    }
+
+    std::vector<std::unique_ptr<Page>> pages_;
+    std::vector<Entity*> owners_;         // nullptr marks a free slot
+    std::vector<uint32_t> generations_;   // per slot, see generation()
+    std::vector<uint32_t> free_slots_;
+    size_t live_ = 0;
+};
+
+/**
+ * @brief Owns one ComponentPool per component type
+ */
+class ComponentStorage {
+public:
+    ComponentStorage() = default;
+    ComponentStorage(const ComponentStorage&) = delete;
+    ComponentStorage& operator=(const ComponentStorage&) = delete;
+
+    template<typename T>
+    ComponentPool<T>& pool() {
+        ComponentTypeId id = componentTypeId<T>();
+        if (id >= pools_.size()) pools_.resize(id + 1);
+        if (!pools_[id]) pools_[id] = std::make_unique<ComponentPool<T>>();
+        return *static_cast<ComponentPool<T>*>(pools_[id].get());
+    }
+
+    // Returns nullptr if no component of type T was ever stored
+    template<typename T>
+    ComponentPool<T>* findPool() {
+        ComponentTypeId id = componentTypeId<T>();
+        if (id >= pools_.size()) return nullptr;
+        return static_cast<ComponentPool<T>*>(pools_[id].get());
+    }
+
+    size_t poolCount() const { return pools_.size(); }
+
+    ComponentPoolBase* poolById(ComponentTypeId id) {
+        return id < pools_.size() ? pools_[id].get() : nullptr;
+    }
+
+private:
+    std::vector<std::unique_ptr<ComponentPoolBase>> pools_;
+};
+
+} // namespace ecs
+} // namespace atlas
+
+#endif // EVE_ECS_COMPONENT_POOL_H
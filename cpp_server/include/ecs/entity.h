@@ -2,32 +2,60 @@
 #define EVE_ECS_ENTITY_H
 
 #include "component.h"
+#include "component_pool.h"
+#include "entity_handle.h"
 #include <string>
-#include <unordered_map>
-#include <typeindex>
 #include <memory>
 #include <vector>
 
 namespace atlas {
 namespace ecs {
 
+/**
+ * @brief Receives structural changes (component add/remove) on entities
+ *
+ * The World implements this to keep its cached queries up to date.
+ */
+class EntityObserver {
+public:
+    virtual ~EntityObserver() = default;
+    virtual void onComponentAdded(Entity* entity, ComponentTypeId type) = 0;
+    virtual void onComponentRemoved(Entity* entity, ComponentTypeId type) = 0;
+    // An existing component was overwritten in place by addComponent()
+    virtual void onComponentReplaced(Entity* entity, ComponentTypeId type) = 0;
+};
+
 /**
  * @brief Entity represents a game object
  * 
  * Entities are just IDs with attached components.
  * They represent ships, NPCs, projectiles, stations, etc.
+ *
+ * Component data lives in the per-type ComponentPools of the owning
+ * ComponentStorage (normally the World's); the entity only keeps a
+ * short list of (type id, slot) pairs. An entity constructed without
+ * storage owns a private one.
  */
 class Entity {
 public:
-    explicit Entity(const std::string& id);
-    ~Entity() = default;
+    explicit Entity(const std::string& id, ComponentStorage* storage = nullptr,
+                    EntityObserver* observer = nullptr);
+    ~Entity();
+    
+    Entity(const Entity&) = delete;
+    Entity& operator=(const Entity&) = delete;
     
-    // Get entity ID
+    // Get entity ID (string identity used by the protocol and persistence)
     const std::string& getId() const { return id_; }
     
+    // Get integer handle (invalid for entities not owned by a World)
+    EntityHandle getHandle() const { return handle_; }
+    
     // Component management
+    // The component is moved into pooled storage; use the returned
+    // pointer (or getComponent) rather than the moved-from argument.
     template<typename T>
-    Entity& addComponent(std::unique_ptr<T> component);
+    T* addComponent(std::unique_ptr<T> component);
     
     template<typename T>
     void removeComponent();
@@ -41,52 +69,102 @@ public:
     template<typename T>
     bool hasComponent() const;
     
+    // Identity of the current T (pool slot and generation); changes when
+    // T is replaced or removed and added again, 0 if there is none
+    template<typename T>
+    uint64_t getComponentGeneration() const;
+    
     // Check if has all specified component types
-    bool hasComponents(const std::vector<std::type_index>& types) const;
+    bool hasComponents(const std::vector<ComponentTypeId>& types) const;
+    
+    // Number of attached components
+    size_t getComponentCount() const { return components_.size(); }
     
 private:
+    friend class World;
+    
+    struct ComponentRef {
+        ComponentTypeId type;
+        uint32_t slot;
+        Component* ptr;
+    };
+    
+    const ComponentRef* findRef(ComponentTypeId type) const {
+        for (const auto& ref : components_) {
+            if (ref.type == type) return &ref;
+        }
+        return nullptr;
+    }
+    
     std::string id_;
-    std::unordered_map<std::type_index, std::unique_ptr<Component>> components_;
+    EntityHandle handle_;
+    std::unique_ptr<ComponentStorage> owned_storage_;
+    ComponentStorage* storage_;
+    EntityObserver* observer_;
+    std::vector<ComponentRef> components_;
 };
 
 // Template implementation
 template<typename T>
-Entity& Entity::addComponent(std::unique_ptr<T> component) {
+T* Entity::addComponent(std::unique_ptr<T> component) {
     static_assert(std::is_base_of<Component, T>::value, "T must inherit from Component");
-    components_[std::type_index(typeid(T))] = std::move(component);
-    return *this;
+    if (!component) return nullptr;
+    ComponentTypeId type = componentTypeId<T>();
+    ComponentPool<T>& pool = storage_->pool<T>();
+    if (const ComponentRef* existing = findRef(type)) {
+        pool.replace(existing->slot, std::move(*component));
+        if (observer_) observer_->onComponentReplaced(this, type);
+        return static_cast<T*>(existing->ptr);
+    }
+    uint32_t slot = pool.emplace(this, std::move(*component));
+    T* ptr = pool.get(slot);
+    components_.push_back({type, slot, ptr});
+    if (observer_) observer_->onComponentAdded(this, type);
+    return ptr;
 }
 
 template<typename T>
 void Entity::removeComponent() {
     static_assert(std::is_base_of<Component, T>::value, "T must inherit from Component");
-    components_.erase(std::type_index(typeid(T)));
+    ComponentTypeId type = componentTypeId<T>();
+    for (size_t i = 0; i < components_.size(); ++i) {
+        if (components_[i].type == type) {
+            storage_->pool<T>().release(components_[i].slot);
+            components_[i] = components_.back();
+            components_.pop_back();
+            if (observer_) observer_->onComponentRemoved(this, type);
+            return;
+        }
+    }
 }
 
 template<typename T>
 T* Entity::getComponent() {
     static_assert(std::is_base_of<Component, T>::value, "T must inherit from Component");
-    auto it = components_.find(std::type_index(typeid(T)));
-    if (it != components_.end()) {
-        return static_cast<T*>(it->second.get());
-    }
-    return nullptr;
+    const ComponentRef* ref = findRef(componentTypeId<T>());
+    return ref ? static_cast<T*>(ref->ptr) : nullptr;
 }
 
 template<typename T>
 const T* Entity::getComponent() const {
     static_assert(std::is_base_of<Component, T>::value, "T must inherit from Component");
-    auto it = components_.find(std::type_index(typeid(T)));
-    if (it != components_.end()) {
-        return static_cast<const T*>(it->second.get());
-    }
-    return nullptr;
+    const ComponentRef* ref = findRef(componentTypeId<T>());
+    return ref ? static_cast<const T*>(ref->ptr) : nullptr;
 }
 
 template<typename T>
 bool Entity::hasComponent() const {
     static_assert(std::is_base_of<Component, T>::value, "T must inherit from Component");
-    return components_.find(std::type_index(typeid(T))) != components_.end();
+    return findRef(componentTypeId<T>()) != nullptr;
+}
+
+template<typename T>
+uint64_t Entity::getComponentGeneration() const {
+    static_assert(std::is_base_of<Component, T>::value, "T must inherit from Component");
+    const ComponentRef* ref = findRef(componentTypeId<T>());
+    if (!ref) return 0;
+    uint32_t generation = storage_->pool<T>().generation(ref->slot);
+    return (static_cast<uint64_t>(ref->slot) << 32) | generation;
 }
 
 } // namespace ecs
@@ -0,0 +1,57 @@
+#ifndef EVE_ECS_ENTITY_HANDLE_H
+#define EVE_ECS_ENTITY_HANDLE_H
+
+#include <cstdint>
+#include <functional>
+
+namespace atlas {
+namespace ecs {
+
+/**
+ * @brief Compact integer identity for an entity within one World
+ *
+ * The index addresses the World's slot array directly; the generation
+ * is bumped whenever that slot is freed, so a handle kept after its
+ * entity was destroyed resolves to nullptr instead of to whatever
+ * entity reused the slot. Generation 0 is never issued, so a
+ * default-constructed handle is always invalid.
+ *
+ * String entity IDs remain the identity used by the network protocol
+ * and persistence; in-process cross references should prefer handles.
+ */
+struct EntityHandle {
+    uint32_t index = 0;
+    uint32_t generation = 0;
+
+    bool isValid() const { return generation != 0; }
+
+    uint64_t toBits() const {
+        return (static_cast<uint64_t>(generation) << 32) | index;
+    }
+
+    static EntityHandle fromBits(uint64_t bits) {
+        return {static_cast<uint32_t>(bits & 0xFFFFFFFFu), static_cast<uint32_t>(bits >> 32)};
+    }
+
+    bool operator==(const EntityHandle& other) const {
+        return index == other.index && generation == other.generation;
+    }
+    bool operator!=(const EntityHandle& other) const { return !(*this == other); }
+    bool operator<(const EntityHandle& other) const {
+        return index != other.index ? index < other.index : generation < other.generation;
+    }
+};
+
+} // namespace ecs
+} // namespace atlas
+
+namespace std {
+template<>
+struct hash<atlas::ecs::EntityHandle> {
+    size_t operator()(const atlas::ecs::EntityHandle& h) const noexcept {
+        return std::hash<uint64_t>()(h.toBits());
+    }
+};
+} // namespace std
+
+#endif // EVE_ECS_ENTITY_HANDLE_H
@@ -0,0 +1,121 @@
+#ifndef EVE_ECS_QUERY_H
+#define EVE_ECS_QUERY_H
+
+#include "entity.h"
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace atlas {
+namespace ecs {
+
+/**
+ * @brief Persistent set of entities that have a fixed list of components
+ *
+ * Queries are created once per component signature by World::view() and
+ * kept up to date incrementally as components are added or removed and
+ * entities are destroyed. Iterating a query never allocates and costs
+ * O(matching entities) rather than O(all entities).
+ *
+ * Membership changes swap-remove from the entity list, so do not add or
+ * remove the queried component types while iterating the same query;
+ * copy the list (World::getEntities) for loops that do.
+ */
+class Query {
+public:
+    explicit Query(std::vector<ComponentTypeId> types) : types_(std::move(types)) {}
+
+    Query(const Query&) = delete;
+    Query& operator=(const Query&) = delete;
+
+    const std::vector<ComponentTypeId>& getTypes() const { return types_; }
+    const std::vector<Entity*>& entities() const { return entities_; }
+    size_t size() const { return entities_.size(); }
+    bool empty() const { return entities_.empty(); }
+
+    // Bumped whenever an entity joins or leaves the query, or one of the
+    // queried components is replaced in place
+    uint64_t getVersion() const { return version_; }
+
+    std::vector<Entity*>::const_iterator begin() const { return entities_.begin(); }
+    std::vector<Entity*>::const_iterator end() const { return entities_.end(); }
+
+    bool matches(const Entity& entity) const { return entity.hasComponents(types_); }
+
+    // Add or drop the entity depending on whether it now matches
+    void refresh(Entity* entity) {
+        bool member = contains(*entity);
+        bool match = matches(*entity);
+        if (match && !member) {
+            uint32_t slot = entity->getHandle().index;
+            if (slot >= positions_.size()) positions_.resize(slot + 1, kNotMember);
+            positions_[slot] = static_cast<uint32_t>(entities_.size());
+            entities_.push_back(entity);
+            ++version_;
+        } else if (!match && member) {
+            remove(entity);
+        }
+    }
+
+    void remove(Entity* entity) {
+        if (!contains(*entity)) return;
+        uint32_t slot = entity->getHandle().index;
+        uint32_t pos = positions_[slot];
+        Entity* last = entities_.back();
+        entities_[pos] = last;
+        positions_[last->getHandle().index] = pos;
+        entities_.pop_back();
+        positions_[slot] = kNotMember;
+        ++version_;
+    }
+
+    // Drop every member (World::canonicalize refills in creation order)
+    void clear() {
+        entities_.clear();
+        positions_.clear();
+        ++version_;
+    }
+
+    // A member's component was replaced; membership is unchanged
+    void touch(const Entity& entity) {
+        if (contains(entity)) ++version_;
+    }
+
+    bool contains(const Entity& entity) const {
+        uint32_t slot = entity.getHandle().index;
+        return slot < positions_.size() && positions_[slot] != kNotMember
+            && entities_[positions_[slot]] == &entity;
+    }
+
+private:
+    static constexpr uint32_t kNotMember = 0xFFFFFFFFu;
+
+    std::vector<ComponentTypeId> types_;
+    std::vector<Entity*> entities_;
+    std::vector<uint32_t> positions_;  // handle index -> position in entities_
+    uint64_t version_ = 0;
+};
+
+namespace detail {
+inline uint32_t nextQuerySlot() {
+    static std::atomic<uint32_t> counter{0};
+    return counter.fetch_add(1, std::memory_order_relaxed);
+}
+} // namespace detail
+
+/**
+ * @brief Dense id per component-list spelling, used as a lookup cache
+ *
+ * Different orderings of the same components get different slots but
+ * resolve to the same Query inside the World.
+ */
+template<typename... ComponentTypes>
+uint32_t querySlot() {
+    static const uint32_t slot = detail::nextQuerySlot();
+    return slot;
+}
+
+} // namespace ecs
+} // namespace atlas
+
+#endif // EVE_ECS_QUERY_H
@@ -1,7 +1,9 @@
 #ifndef EVE_ECS_SYSTEM_H
 #define EVE_ECS_SYSTEM_H
 
+#include "component_pool.h"
 #include <string>
+#include <vector>
 
 namespace atlas {
 namespace ecs {
@@ -9,6 +11,20 @@ namespace ecs {
 // Forward declaration
 class World;
 
+/**
+ * @brief Components a system reads and writes during update()
+ *
+ * A system that never declares anything is exclusive: the scheduler
+ * will not run it alongside any other system. Systems that create or
+ * destroy entities, or add/remove components, inside update() must
+ * stay exclusive.
+ */
+struct SystemAccess {
+    std::vector<ComponentTypeId> reads;
+    std::vector<ComponentTypeId> writes;
+    bool exclusive = true;
+};
+
 /**
  * @brief Base class for all systems
  * 
@@ -31,8 +47,33 @@ public:
      */
     virtual std::string getName() const = 0;
     
+    /**
+     * @brief Declared component access, used by the parallel scheduler
+     */
+    const SystemAccess& getAccess() const { return access_; }
+    
 protected:
+    // Declare component access (typically from the constructor). Any
+    // declaration opts the system into parallel scheduling.
+    template<typename T>
+    void reads() {
+        access_.reads.push_back(componentTypeId<T>());
+        access_.exclusive = false;
+    }
+    
+    template<typename T>
+    void writes() {
+        access_.writes.push_back(componentTypeId<T>());
+        access_.exclusive = false;
+    }
+    
+    // Declare that update() touches no components (e.g. on-demand systems)
+    void declaresNoComponentAccess() { access_.exclusive = false; }
+    
     World* world_;
+    
+private:
+    SystemAccess access_;
 };
 
 } // namespace ecs
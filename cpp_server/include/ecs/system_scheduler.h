@@ -0,0 +1,62 @@
+#ifndef EVE_ECS_SYSTEM_SCHEDULER_H
+#define EVE_ECS_SYSTEM_SCHEDULER_H
+
+#include "system.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace atlas {
+namespace utils { class ThreadPool; }
+namespace ecs {
+
+/**
+ * @brief Runs a World's systems as a dependency DAG
+ *
+ * Two systems conflict when either writes a component the other reads
+ * or writes, or when either is exclusive (has not declared its access,
+ * or makes structural changes). Conflicting systems keep their
+ * registration order; everything else may run concurrently on the
+ * thread pool. Because only non-conflicting systems overlap, a tick
+ * produces the same result as the sequential order.
+ */
+class SystemScheduler {
+public:
+    struct SystemTiming {
+        std::string name;
+        double last_ms = 0.0;
+        double total_ms = 0.0;
+        double max_ms = 0.0;
+        uint64_t runs = 0;
+    };
+
+    /// Build the dependency graph for systems in registration order
+    void build(const std::vector<System*>& systems);
+
+    /// Run every system once; a null pool runs them sequentially
+    void run(float delta_time, utils::ThreadPool* pool);
+
+    static bool conflicts(const SystemAccess& a, const SystemAccess& b);
+
+    const std::vector<SystemTiming>& getTimings() const { return timings_; }
+
+    /// Indices of the systems each system must wait for
+    const std::vector<std::vector<size_t>>& getDependencies() const { return dependencies_; }
+
+    /// Length of the longest dependency chain (1 = fully parallel)
+    size_t getCriticalPathLength() const;
+
+private:
+    void runOne(size_t index, float delta_time);
+
+    std::vector<System*> systems_;
+    std::vector<std::vector<size_t>> dependencies_;
+    std::vector<std::vector<size_t>> dependents_;
+    std::vector<SystemTiming> timings_;
+    std::vector<int> profile_scopes_;   // utils::Profiler scope per system
+};
+
+} // namespace ecs
+} // namespace atlas
+
+#endif // EVE_ECS_SYSTEM_SCHEDULER_H
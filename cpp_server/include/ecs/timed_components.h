@@ -0,0 +1,169 @@
+#ifndef EVE_ECS_TIMED_COMPONENTS_H
+#define EVE_ECS_TIMED_COMPONENTS_H
+
+#include "world.h"
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace atlas {
+namespace ecs {
+
+/**
+ * @brief Components of type T that are only visited when their work is due
+ *
+ * Replaces "subtract delta_time from every timer, every tick" with one
+ * timer per entity on the World's TimerWheel for the owning system. When
+ * an entity's timer fires, the owner's advance function runs once for the
+ * whole time since that entity was last visited (the same code the
+ * per-tick loop used to run with delta_time) and returns how long until
+ * the entity needs visiting again. Entities with nothing due cost nothing
+ * per tick.
+ *
+ * Between visits the component's countdown fields lag behind; a reader
+ * that needs the exact value adds pendingSeconds(). Changes made through
+ * the owning system go through modify(), which brings the entity up to
+ * date first and reschedules it afterwards. Entities that gain T (or
+ * whose T is replaced), and entities passed to modify(), are looked at
+ * again on the next update(), so fields set right after addComponent()
+ * or an install call count.
+ *
+ * Not thread-safe; used from the owning system's update() and API calls.
+ */
+template<typename T>
+class TimedComponents {
+public:
+    /**
+     * Apply elapsed seconds to one component; return the seconds until it
+     * next needs a visit, or a negative value if nothing is running
+     */
+    using Advance = std::function<float(Entity*, T&, float)>;
+
+    TimedComponents(World* world, std::string wheel_name, Advance advance)
+        : world_(world), wheel_name_(std::move(wheel_name)), advance_(std::move(advance)) {}
+
+    TimedComponents(const TimedComponents&) = delete;
+    TimedComponents& operator=(const TimedComponents&) = delete;
+
+    /// Pick up entities that gained T, then advance the clock and visit the due ones
+    void update(float delta_time) {
+        TimerWheel& timers = wheel();
+        const Query& query = world_->view<T>();
+        if (query.getVersion() != seen_version_) {
+            seen_version_ = query.getVersion();
+            discover(query);
+        }
+        for (uint64_t key : modified_) {
+            auto it = tracked_.find(key);
+            if (it == tracked_.end()) continue;
+            Entity* entity = world_->getEntity(EntityHandle::fromBits(key));
+            T* component = entity ? entity->getComponent<T>() : nullptr;
+            if (component && entity->getComponentGeneration<T>() == it->second.generation) {
+                visit(entity, *component, it->second);
+            }
+        }
+        modified_.clear();
+        timers.advance(delta_time, [this](TimerWheel::TimerId id, uint64_t key) {
+            auto it = tracked_.find(key);
+            if (it == tracked_.end() || it->second.timer != id) return;    // superseded
+            it->second.timer = 0;
+            Entity* entity = world_->getEntity(EntityHandle::fromBits(key));
+            T* component = entity ? entity->getComponent<T>() : nullptr;
+            if (!component || entity->getComponentGeneration<T>() != it->second.generation) {
+                tracked_.erase(it);
+                return;
+            }
+            visit(entity, *component, it->second);
+        });
+    }
+
+    /**
+     * @brief Change an entity's component outside the timer callbacks
+     * @param change Callable as change(T&), run once the entity is up to date
+     */
+    template<typename Fn>
+    void modify(Entity* entity, Fn&& change) {
+        T* component = entity ? entity->getComponent<T>() : nullptr;
+        if (!component) return;
+        Tracked& tracked = track(entity);
+        visit(entity, *component, tracked);
+        change(*component);
+        visit(entity, *component, tracked);
+        modified_.push_back(entity->getHandle().toBits());
+    }
+
+    /// Seconds not yet applied to this entity's component (0 if untracked)
+    float pendingSeconds(const Entity* entity) const {
+        if (!entity || !wheel_) return 0.0f;
+        auto it = tracked_.find(entity->getHandle().toBits());
+        if (it == tracked_.end()) return 0.0f;
+        return static_cast<float>(wheel_->getTime() - it->second.synced_at);
+    }
+
+    size_t getTrackedCount() const { return tracked_.size(); }
+    size_t getScheduledCount() const { return wheel_ ? wheel_->size() : 0; }
+
+private:
+    struct Tracked {
+        TimerWheel::TimerId timer = 0;
+        double synced_at = 0.0;         // wheel time the component was last advanced to
+        uint64_t generation = 0;        // a replaced or re-added component starts over
+    };
+
+    TimerWheel& wheel() {
+        if (!wheel_) wheel_ = &world_->getTimerWheel(wheel_name_);
+        return *wheel_;
+    }
+
+    Tracked& track(Entity* entity) {
+        Tracked& tracked = tracked_[entity->getHandle().toBits()];
+        uint64_t generation = entity->getComponentGeneration<T>();
+        if (tracked.generation != generation) {
+            if (tracked.timer) wheel().cancel(tracked.timer);
+            tracked = Tracked{0, wheel().getTime(), generation};
+        }
+        return tracked;
+    }
+
+    void discover(const Query& query) {
+        // Drop entities that lost T or were destroyed, then start new ones
+        for (auto it = tracked_.begin(); it != tracked_.end();) {
+            Entity* entity = world_->getEntity(EntityHandle::fromBits(it->first));
+            if (!entity || entity->getComponentGeneration<T>() != it->second.generation) {
+                if (it->second.timer) wheel().cancel(it->second.timer);
+                it = tracked_.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        for (Entity* entity : query) {
+            if (tracked_.count(entity->getHandle().toBits())) continue;
+            visit(entity, *entity->getComponent<T>(), track(entity));
+        }
+    }
+
+    void visit(Entity* entity, T& component, Tracked& tracked) {
+        TimerWheel& timers = wheel();
+        float elapsed = static_cast<float>(timers.getTime() - tracked.synced_at);
+        tracked.synced_at = timers.getTime();
+        float next = advance_(entity, component, elapsed);
+        if (tracked.timer) timers.cancel(tracked.timer);
+        tracked.timer = next >= 0.0f
+            ? timers.scheduleAfter(next, entity->getHandle().toBits()) : 0;
+    }
+
+    World* world_;
+    std::string wheel_name_;
+    Advance advance_;
+    TimerWheel* wheel_ = nullptr;
+    std::unordered_map<uint64_t, Tracked> tracked_;    // by EntityHandle bits
+    std::vector<uint64_t> modified_;                    // rescheduled again on update()
+    uint64_t seen_version_ = UINT64_MAX;
+};
+
+} // namespace ecs
+} // namespace atlas
+
+#endif // EVE_ECS_TIMED_COMPONENTS_H
@@ -0,0 +1,140 @@
+#ifndef EVE_ECS_TIMER_WHEEL_H
+#define EVE_ECS_TIMER_WHEEL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace atlas {
+namespace ecs {
+
+/**
+ * @brief Hierarchical timing wheel: "fire at tick T" without per-tick scans
+ *
+ * Time is counted in ticks of 1/ticks_per_second seconds. Level k has 64
+ * slots of 64^k ticks each; a timer sits on the level of the highest
+ * base-64 digit in which its due tick differs from the current tick, and
+ * moves down a level when the wheel reaches its slot. Per-level occupancy
+ * bitmaps let advance() jump straight to the next slot that holds
+ * anything.
+ *
+ * - schedule and cancel: O(1)
+ * - waiting: nothing; a timer is touched once per level it cascades
+ *   through (at most 11, normally 2-3)
+ * - advance: O(levels) per occupied slot passed, plus the timers fired
+ *
+ * Each timer carries a 64-bit key chosen by the caller (usually an
+ * EntityHandle::toBits()), handed back when it fires. Timers due on the
+ * same tick fire in no particular order. A timer is never due before the
+ * tick after the one it was scheduled on. Not thread-safe.
+ */
+class TimerWheel {
+public:
+    using TimerId = uint64_t;   // 0 = no timer
+
+    static constexpr double kDefaultTicksPerSecond = 30.0;
+
+    explicit TimerWheel(double ticks_per_second = kDefaultTicksPerSecond);
+
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+
+    /// Fire key on tick due_tick (the next tick if that has passed)
+    TimerId schedule(uint64_t due_tick, uint64_t key);
+
+    /// Fire key once the wheel's clock reaches when (seconds)
+    TimerId scheduleAt(double when, uint64_t key);
+
+    /// Fire key delay seconds from now
+    TimerId scheduleAfter(double delay, uint64_t key) { return scheduleAt(time_ + delay, key); }
+
+    /// Drop a pending timer; false if it already fired or was cancelled
+    bool cancel(TimerId id);
+
+    bool isPending(TimerId id) const;
+
+    /**
+     * @brief Move the clock forward and fire every timer that came due
+     * @param fire Callable as fire(TimerId, uint64_t key). It may schedule
+     *             and cancel timers, but must not call advance().
+     * @return number of timers fired
+     *
+     * getTime() already reads the new time while timers fire.
+     */
+    template<typename Fn>
+    size_t advance(double delta_seconds, Fn&& fire);
+
+    /// Tick containing time t (seconds)
+    uint64_t tickAt(double t) const;
+
+    uint64_t getTick() const { return cursor_; }
+    double getTime() const { return time_; }
+    double getTicksPerSecond() const { return ticks_per_second_; }
+    size_t size() const { return count_; }
+    bool empty() const { return count_ == 0; }
+
+private:
+    static constexpr uint32_t kNone = UINT32_MAX;
+    static constexpr int kSlotBits = 6;
+    static constexpr uint32_t kSlots = 1u << kSlotBits;
+    static constexpr int kLevels = (64 + kSlotBits - 1) / kSlotBits;
+    static constexpr uint32_t kFiring = UINT32_MAX - 1;    // Node::slot while queued in firing_
+
+    struct Node {
+        uint64_t due = 0;
+        uint64_t key = 0;
+        uint32_t prev = kNone;
+        uint32_t next = kNone;
+        uint32_t slot = kNone;          // level * kSlots + slot, kFiring, or kNone when free
+        uint32_t generation = 1;
+    };
+
+    static TimerId makeId(uint32_t index, uint32_t generation) {
+        return (static_cast<uint64_t>(generation) << 32) | index;
+    }
+    const Node* lookup(TimerId id) const;
+
+    void insert(uint32_t index);
+    void unlink(uint32_t index);
+    void release(uint32_t index);
+
+    /// Move the cursor to the next tick <= target with timers due and
+    /// queue them in firing_; false once the cursor has reached target
+    bool collectDue(uint64_t target);
+
+    double ticks_per_second_;
+    double time_ = 0.0;
+    uint64_t cursor_ = 0;
+    size_t count_ = 0;
+
+    std::vector<Node> nodes_;
+    std::vector<uint32_t> free_nodes_;
+    std::vector<uint32_t> heads_;       // kLevels * kSlots list heads
+    uint64_t occupied_[kLevels] = {};   // bit per non-empty slot
+    std::vector<uint32_t> firing_;
+};
+
+template<typename Fn>
+size_t TimerWheel::advance(double delta_seconds, Fn&& fire) {
+    if (delta_seconds > 0.0) time_ += delta_seconds;
+    const uint64_t target = tickAt(time_);
+    size_t fired = 0;
+    while (collectDue(target)) {
+        for (size_t i = 0; i < firing_.size(); ++i) {
+            uint32_t index = firing_[i];
+            Node& node = nodes_[index];
+            if (node.slot != kFiring) continue;     // cancelled by an earlier callback
+            TimerId id = makeId(index, node.generation);
+            uint64_t key = node.key;
+            release(index);
+            ++fired;
+            fire(id, key);
+        }
+    }
+    return fired;
+}
+
+} // namespace ecs
+} // namespace atlas
+
+#endif // EVE_ECS_TIMER_WHEEL_H
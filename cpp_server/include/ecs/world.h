@@ -1,16 +1,25 @@
 #ifndef EVE_ECS_WORLD_H
 #define EVE_ECS_WORLD_H
 
+#include "command_buffer.h"
 #include "entity.h"
+#include "query.h"
 #include "system.h"
+#include "system_scheduler.h"
+#include "timer_wheel.h"
+#include <array>
+#include <atomic>
+#include <map>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
 #include <memory>
-#include <typeindex>
 #include <algorithm>
+#include <functional>
 
 namespace atlas {
+namespace utils { class ThreadPool; }
 namespace ecs {
 
 /**
@@ -19,10 +28,10 @@ namespace ecs {
  * The World represents the game state and coordinates
  * all entities and systems in the game.
  */
-class World {
+class World : public EntityObserver {
 public:
-    World() = default;
-    ~World() = default;
+    World();
+    ~World() override;
     
     // Entity management
     Entity* createEntity(const std::string& id);
@@ -30,53 +39,266 @@ public:
     Entity* getEntity(const std::string& id);
     const Entity* getEntity(const std::string& id) const;
     
+    // Handle-based access: O(1) array lookup, nullptr for stale handles
+    Entity* getEntity(EntityHandle handle) {
+        return handle.index < slots_.size() && slots_[handle.index].generation == handle.generation
+            ? slots_[handle.index].entity : nullptr;
+    }
+    const Entity* getEntity(EntityHandle handle) const {
+        return const_cast<World*>(this)->getEntity(handle);
+    }
+    bool isAlive(EntityHandle handle) const { return getEntity(handle) != nullptr; }
+    
+    // Translate a string ID to its handle (invalid handle if unknown)
+    EntityHandle getHandle(const std::string& id) const;
+    
     // Get all entities
     std::vector<Entity*> getAllEntities();
     
-    // Get entities with specific components
+    /**
+     * @brief The handle table: which slot each entity holds, each slot's
+     * generation and the order freed slots are reused in
+     *
+     * Entities are listed in creation order. A world with the same
+     * entities can take the same handles with restoreHandleLayout(), which
+     * is what lets a replay reproduce a recorded run.
+     */
+    struct HandleLayout {
+        struct Placement {
+            std::string id;
+            uint32_t index = 0;
+        };
+        std::vector<uint32_t> generations;   // per slot
+        std::vector<uint32_t> free_slots;    // reused from the back
+        std::vector<Placement> entities;     // creation order
+    };
+    HandleLayout getHandleLayout() const;
+    
+    /**
+     * @brief Move this world's entities into the handles of layout
+     *
+     * Only for a world no system has run on yet: handles held elsewhere
+     * become stale. Calls canonicalize() afterwards.
+     * @return false (and changes nothing) unless layout lists exactly this
+     *         world's entities in distinct slots
+     */
+    bool restoreHandleLayout(const HandleLayout& layout);
+    
+    /**
+     * @brief Pack every component pool and rebuild every query in entity
+     * creation order
+     *
+     * Iteration order otherwise depends on the history of frees and slot
+     * reuse; after this it depends only on the entities and their order.
+     * Component addresses change, so nothing may hold a component pointer
+     * across the call.
+     */
+    void canonicalize();
+    
+    // Get entities with specific components (a copy of the cached query,
+    // safe to iterate while adding/removing components or entities)
     template<typename... ComponentTypes>
     std::vector<Entity*> getEntities();
     
+    /**
+     * @brief Cached query over entities that have all ComponentTypes
+     *
+     * The query is registered on first use and maintained incrementally
+     * afterwards, so repeated calls neither scan the world nor allocate.
+     * See Query for the iteration rules.
+     */
+    template<typename... ComponentTypes>
+    const Query& view();
+    
+    // Number of registered cached queries
+    size_t getQueryCount() const { return queries_.size(); }
+    
+    /**
+     * @brief Visit every component of type T in pooled storage order
+     * @param fn Callable as fn(Entity*, T&)
+     *
+     * Walks the packed ComponentPool<T> directly, so hot systems touch
+     * contiguous memory instead of hashing per entity.
+     */
+    template<typename T, typename Fn>
+    void forEach(Fn&& fn);
+    
+    // Number of live components of type T
+    template<typename T>
+    size_t getComponentCount();
+    
+    /**
+     * @brief Run body(begin, end) over [0, count) split into chunks
+     *
+     * Chunks run on the world's worker pool when one is configured and
+     * inline otherwise. Safe to call from inside a scheduled system: the
+     * waiting thread helps execute the chunks.
+     */
+    void parallelFor(size_t count, size_t chunk_size,
+                     const std::function<void(size_t, size_t)>& body);
+    
+    /**
+     * @brief forEach<T> split into page-sized chunks across workers
+     * @param fn Callable as fn(Entity*, T&), invoked concurrently
+     *
+     * fn may modify the visited component but must not make structural
+     * changes; record those with defer() instead.
+     */
+    template<typename T, typename Fn>
+    void parallelForEach(Fn&& fn);
+    
+    /**
+     * @brief Run a structural change now, or at the end of the tick
+     *
+     * While update() is running systems the command is queued on the
+     * world's CommandBuffer and applied after the last system finishes;
+     * outside of update() it executes immediately.
+     */
+    void defer(CommandBuffer::Command command);
+    
+    bool isUpdating() const { return updating_; }
+    CommandBuffer& getCommandBuffer() { return commands_; }
+    
+    /**
+     * @brief Shared timing wheel for one clock domain, created on first use
+     *
+     * Systems whose work comes due after a delay (job completion, cycles,
+     * despawns) schedule it here instead of counting down a timer on every
+     * entity every tick. Each domain is advanced by its owner, normally the
+     * system named name, from that system's update(); systems that run in
+     * parallel therefore never share a wheel, and a name should have one
+     * owner. The reference stays valid for the lifetime of the World.
+     */
+    TimerWheel& getTimerWheel(const std::string& name);
+    
     // System management
     void addSystem(std::unique_ptr<System> system);
     
     // Update all systems
     void update(float delta_time);
     
+    /**
+     * @brief Run non-conflicting systems in parallel
+     * @param count Worker threads for the scheduler pool (0 = sequential)
+     *
+     * Systems declare their component access (System::reads/writes);
+     * undeclared systems still run alone, in registration order.
+     */
+    void setWorkerThreads(size_t count);
+    size_t getWorkerThreads() const;
+    
+    // Shared worker pool, or nullptr when running sequentially
+    utils::ThreadPool* getThreadPool() { return thread_pool_.get(); }
+    
+    // Per-system timing from the most recent and all previous ticks
+    const std::vector<SystemScheduler::SystemTiming>& getSystemTimings() const {
+        return scheduler_.getTimings();
+    }
+    
+    const SystemScheduler& getScheduler() const { return scheduler_; }
+    
     // Get entity count
     size_t getEntityCount() const { return entities_.size(); }
     
+    // EntityObserver: keep cached queries in sync with structural changes
+    void onComponentAdded(Entity* entity, ComponentTypeId type) override;
+    void onComponentRemoved(Entity* entity, ComponentTypeId type) override;
+    void onComponentReplaced(Entity* entity, ComponentTypeId type) override;
+    
 private:
+    Query& registerQuery(std::vector<ComponentTypeId> types);
+    void forgetEntity(Entity* entity);
+    
+    // Queries are keyed by their sorted component list; query_slots_
+    // caches the lookup per querySlot<Ts...>() spelling. Registration is
+    // serialized so parallel systems may call view() concurrently.
+    static constexpr uint32_t kMaxQuerySlots = 512;
+    std::map<std::vector<ComponentTypeId>, std::unique_ptr<Query>> queries_;
+    std::array<std::atomic<Query*>, kMaxQuerySlots> query_slots_;
+    std::mutex query_mutex_;
+    std::vector<std::vector<Query*>> queries_by_type_;
+
+    std::map<std::string, std::unique_ptr<TimerWheel>> timer_wheels_;
+    std::mutex timer_wheel_mutex_;
+
+    EntityHandle allocateHandle(Entity* entity);
+    void releaseHandle(EntityHandle handle);
+    
+    // Handle slots; generation is bumped each time a slot is freed
+    struct EntitySlot {
+        Entity* entity = nullptr;
+        uint32_t generation = 1;
+        uint64_t created = 0;       // creation sequence of the current entity
+    };
+    std::vector<EntitySlot> slots_;
+    std::vector<uint32_t> free_slots_;
+    uint64_t next_created_ = 0;
+    
+    // Live entities sorted by creation sequence
+    std::vector<Entity*> entitiesInCreationOrder() const;
+
+    // Declared before entities_ so pools outlive the entities using them
+    ComponentStorage storage_;
+    // Owns the entities; the string ID side of the mapping
     std::unordered_map<std::string, std::unique_ptr<Entity>> entities_;
     std::vector<std::unique_ptr<System>> systems_;
     
-    // Helper to get type indices from component types
-    template<typename... ComponentTypes>
-    std::vector<std::type_index> getTypeIndices();
+    SystemScheduler scheduler_;
+    bool scheduler_dirty_ = true;
+    bool updating_ = false;
+    CommandBuffer commands_;
+    std::unique_ptr<utils::ThreadPool> thread_pool_;
 };
 
 // Template implementation
 template<typename... ComponentTypes>
 std::vector<Entity*> World::getEntities() {
-    std::vector<Entity*> result;
-    
     if constexpr (sizeof...(ComponentTypes) == 0) {
         // Return all entities if no component types specified
         return getAllEntities();
     } else {
-        // Get type indices for the requested components
-        std::vector<std::type_index> types = {std::type_index(typeid(ComponentTypes))...};
-        
-        // Filter entities that have all requested components
-        for (auto& pair : entities_) {
-            Entity* entity = pair.second.get();
-            if (entity->hasComponents(types)) {
-                result.push_back(entity);
-            }
+        return view<ComponentTypes...>().entities();
+    }
+}
+
+template<typename... ComponentTypes>
+const Query& World::view() {
+    static_assert(sizeof...(ComponentTypes) > 0, "view() needs at least one component type");
+    uint32_t slot = querySlot<ComponentTypes...>();
+    if (slot < kMaxQuerySlots) {
+        if (Query* cached = query_slots_[slot].load(std::memory_order_acquire)) {
+            return *cached;
         }
     }
-    
-    return result;
+    std::lock_guard<std::mutex> lock(query_mutex_);
+    Query& query = registerQuery({componentTypeId<ComponentTypes>()...});
+    if (slot < kMaxQuerySlots) {
+        query_slots_[slot].store(&query, std::memory_order_release);
+    }
+    return query;
+}
+
+template<typename T, typename Fn>
+void World::forEach(Fn&& fn) {
+    if (auto* pool = storage_.findPool<T>()) {
+        pool->each(std::forward<Fn>(fn));
+    }
+}
+
+template<typename T, typename Fn>
+void World::parallelForEach(Fn&& fn) {
+    auto* pool = storage_.findPool<T>();
+    if (!pool) return;
+    parallelFor(pool->slotCount(), ComponentPool<T>::kPageSize,
+                [pool, &fn](size_t begin, size_t end) {
+                    pool->eachInRange(static_cast<uint32_t>(begin), static_cast<uint32_t>(end), fn);
+                });
+}
+
+template<typename T>
+size_t World::getComponentCount() {
+    auto* pool = storage_.findPool<T>();
+    return pool ? pool->size() : 0;
 }
 
 } // namespace ecs
@@ -4,7 +4,13 @@
 #include "ecs/world.h"
 #include "network/tcp_server.h"
 #include "network/protocol_handler.h"
+#include "network/interest_manager.h"
+#include "network/snapshot_delta.h"
+#include "network/fragment_cache.h"
+#include "network/wire_format.h"
 #include "data/ship_database.h"
+#include "data/tick_recording.h"
+#include "utils/mpsc_queue.h"
 #include <string>
 #include <unordered_map>
 #include <mutex>
@@ -22,6 +28,7 @@ namespace systems {
     class AnomalySystem;
     class MissionSystem;
     class MissionGeneratorSystem;
+    class SpatialIndexSystem;
 }
 
 /**
@@ -31,7 +38,7 @@ namespace systems {
  * - Handling connect/disconnect messages
  * - Spawning player entities on connect
  * - Processing player input (movement, commands)
- * - Broadcasting entity state updates each tick
+ * - Sending each client the entity states relevant to it each tick
  * - Spawning NPC entities on startup
  */
 class GameSession {
@@ -40,10 +47,27 @@ public:
                          const std::string& data_path = "../data");
     ~GameSession() = default;
 
-    /// Initialize message handlers and spawn initial NPCs
-    void initialize();
+    /// Initialize message handlers and (unless told not to) spawn initial NPCs
+    void initialize(bool spawn_initial_npcs = true);
 
-    /// Called each server tick to broadcast state to all clients
+    /**
+     * Apply every client message received since the last call
+     * 
+     * Network threads only parse and queue messages; this runs their
+     * handlers, in arrival order, on the calling (main) thread. Call it
+     * at the start of each tick, before World::update().
+     * 
+     * @return Number of queued commands applied
+     */
+    size_t processInbound();
+
+    /// Record every command processInbound() applies (nullptr stops recording)
+    void setRecorder(data::TickRecorder* recorder) { recorder_ = recorder; }
+
+    /// Queue a recorded command as if a network thread had received it
+    void replayCommand(const data::RecordedCommand& command) { inbound_.push(command); }
+
+    /// Called each server tick to send each client its relevant entity states
     void update(float delta_time);
 
     /// Get the number of connected players
@@ -73,18 +97,49 @@ public:
     /// Set pointer to the MissionGeneratorSystem for mission offers
     void setMissionGeneratorSystem(systems::MissionGeneratorSystem* mg) { mission_generator_ = mg; }
 
+    /// Use the spatial index for per-client relevance queries
+    void setSpatialIndex(const systems::SpatialIndexSystem* index) { interest_.setSpatialIndex(index); }
+
+    /// Configure per-client interest management ranges and far-entity rate
+    void setInterestSettings(const network::InterestManager::Settings& settings) { interest_.setSettings(settings); }
+
+    /// Solar system that spawned player and NPC ships are placed in
+    void setSolarSystem(const std::string& system_id) { solar_system_ = system_id; }
+    const std::string& getSolarSystem() const { return solar_system_; }
+
     /// Get the ship database (read-only)
     const data::ShipDatabase& getShipDatabase() const { return ship_db_; }
 
+    /**
+     * Spawn a hostile or empire NPC ship with AI and a weapon
+     * 
+     * Main thread only (before the server starts, or during a tick).
+     * Does nothing if the id is already taken.
+     */
+    void spawnNPC(const std::string& id, const std::string& name, const std::string& ship,
+                  const std::string& faction, float x, float y, float z);
+
 private:
+    /// A parsed client message waiting for processInbound()
+    using InboundCommand = data::RecordedCommand;
+
     // --- Message handlers ---
     /**
-     * Routes incoming client messages to appropriate handlers
+     * Parses an incoming client message and queues it for the main thread
+     * 
+     * Runs on a network thread and must not touch the world or players_.
+     * 
      * @param client Client connection info
      * @param raw Raw message string from network
      */
     void onClientMessage(const network::ClientConnection& client, const std::string& raw);
     
+    /**
+     * Routes a parsed JSON message to its handler (main thread)
+     */
+    void dispatchMessage(const network::ClientConnection& client, network::MessageType type,
+                         const std::string& data);
+    
     /**
      * Handle client connection
      * 
@@ -127,6 +182,18 @@ private:
      */
     void handleChat(const network::ClientConnection& client, const std::string& data);
     
+    /**
+     * Handle state update acknowledgement
+     * 
+     * Records the newest snapshot the client has applied so later state
+     * updates can be delta-encoded against it.
+     * Expected format: {"type":"state_ack","data":{"sequence":42}}
+     * 
+     * @param client Client connection info
+     * @param data JSON message data with the acknowledged sequence
+     */
+    void handleStateAck(const network::ClientConnection& client, const std::string& data);
+    
     /**
      * Handle target lock request
      * 
@@ -171,6 +238,35 @@ private:
      */
     void handleModuleDeactivate(const network::ClientConnection& client, const std::string& data);
     
+    /**
+     * Handle one or more binary wire-protocol frames
+     * 
+     * Decodes each frame and dispatches it to the same apply* logic the
+     * JSON handlers use. Only clients that negotiated the binary
+     * encoding at connect send these.
+     * 
+     * @param client Client connection info
+     * @param raw Bytes starting with a frame header
+     */
+    void handleBinaryMessage(const network::ClientConnection& client, const std::string& raw);
+    
+    // Message logic shared by the JSON and binary paths
+    void applyInputMove(const network::ClientConnection& client, float vx, float vy, float vz);
+    void applyStateAck(const network::ClientConnection& client, uint64_t sequence);
+    void applyTargetLock(const network::ClientConnection& client, const std::string& target_id);
+    void applyTargetUnlock(const network::ClientConnection& client, const std::string& target_id);
+    void applyModuleActivate(const network::ClientConnection& client, int slot_index,
+                             const std::string& target_id);
+    void applyModuleDeactivate(const network::ClientConnection& client, int slot_index);
+    
+    /**
+     * Look up a connected player
+     * @param entity_id Set to the player's ship entity id
+     * @param binary Set to whether the client uses the binary encoding
+     * @return false if the socket has no player
+     */
+    bool findPlayer(const network::ClientConnection& client, std::string& entity_id, bool& binary) const;
+    
     /**
      * Handle dock request
      * 
@@ -294,17 +390,38 @@ private:
 
     // --- State broadcast ---
     /**
-     * Build full state update message
+     * Build a state update message for one client
      * 
-     * Creates JSON message with all entity states including:
+     * Creates JSON message with the states of the entities in the
+     * client's relevance set for this tick, including:
      * - Position, velocity, rotation
      * - Health (shield, armor, hull)
-     * - Target locks
-     * - Active modules
+     * - Capacitor, ship type and faction
+     * 
+     * The message is marked "partial": entities not listed keep their
+     * last state on the client, and "removed" lists entities to drop.
+     * Entity fields are delta-encoded against the client's acknowledged
+     * "baseline" snapshot; without one every field is sent. Field groups
+     * come from the tick's fragment cache, shared by all clients.
+     * 
+     * @param snapshot Entities and removals chosen by the InterestManager
+     * @param sequence Per-client snapshot sequence number
+     * @param delta The client's delta encoder state
+     * @return JSON string with format: {"type":"state_update","data":{"entities":[...],"removed":[...]}}
+     */
+    std::string buildStateUpdate(const network::InterestManager::Snapshot& snapshot,
+                                 uint64_t sequence, network::SnapshotDelta& delta);
+
+    /**
+     * Build a state update for a binary wire-protocol client
+     * 
+     * Same content as buildStateUpdate(), encoded as one binary frame.
      * 
-     * @return JSON string with format: {"type":"state_update","entities":[...]}
+     * @param out Receives the frame; cleared first
      */
-    std::string buildStateUpdate() const;
+    void buildBinaryStateUpdate(const network::InterestManager::Snapshot& snapshot,
+                                uint64_t sequence, network::SnapshotDelta& delta,
+                                std::string& out);
     
     /**
      * Build entity spawn notification
@@ -319,8 +436,6 @@ private:
 
     // --- NPC management ---
     void spawnInitialNPCs();
-    void spawnNPC(const std::string& id, const std::string& name, const std::string& ship,
-                  const std::string& faction, float x, float y, float z);
 
     // --- Player entity helpers ---
     std::string createPlayerEntity(const std::string& player_id,
@@ -353,6 +468,19 @@ private:
      * @return Extracted float value, or fallback if not found
      */
     static float extractJsonFloat(const std::string& json, const std::string& key, float fallback = 0.0f);
+    
+    /**
+     * Extract an unsigned integer value from a simple JSON object
+     * 
+     * Like extractJsonFloat, but keeps full 64-bit precision for
+     * counters such as snapshot sequence numbers.
+     * 
+     * @param json JSON string to parse
+     * @param key Key name to extract
+     * @param value Set to the extracted value
+     * @return true if the key was found and parsed
+     */
+    static bool extractJsonUInt(const std::string& json, const std::string& key, uint64_t& value);
 
     ecs::World* world_;
     network::TCPServer* tcp_server_;
@@ -366,19 +494,34 @@ private:
     systems::AnomalySystem* anomaly_system_ = nullptr;
     systems::MissionSystem* mission_system_ = nullptr;
     systems::MissionGeneratorSystem* mission_generator_ = nullptr;
+    network::InterestManager interest_;
+    std::string solar_system_;
 
     // Map socket → entity_id for connected players
     struct PlayerInfo {
         std::string entity_id;
         std::string character_name;
         network::ClientConnection connection;
+        network::InterestManager::ClientState interest;  // entities this client knows
+        network::SnapshotDelta delta;                    // field baselines for this client
+        uint64_t snapshot_sequence = 0;                  // next state_update sequence
+        bool binary_wire = false;                        // negotiated binary encoding
+        // Removals resent until acked, since a lagging client's queued
+        // state updates may be dropped: entity id -> last sequence sent in
+        std::unordered_map<std::string, uint64_t> unacked_removed;
     };
 
     std::unordered_map<int, PlayerInfo> players_;  // keyed by socket fd
     mutable std::mutex players_mutex_;
 
     std::atomic<uint32_t> next_entity_id_{1};
-    mutable std::atomic<uint64_t> snapshot_sequence_{0};  // Sequence number for snapshots
+    uint32_t next_interest_phase_ = 0;  // guarded by players_mutex_
+    network::wire::StateUpdate wire_update_;  // reused by buildBinaryStateUpdate
+    std::string entity_records_;              // reused by buildBinaryStateUpdate
+    network::FragmentCache fragments_;        // entity encodings for this tick
+    utils::MpscQueue<InboundCommand> inbound_;  // network threads → main thread
+    data::TickRecorder* recorder_ = nullptr;
+    std::string state_frame_;                 // reused outbound frame buffer
 };
 
 } // namespace atlas
@@ -0,0 +1,103 @@
+#ifndef EVE_FRAGMENT_CACHE_H
+#define EVE_FRAGMENT_CACHE_H
+
+#include "network/wire_format.h"
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+
+namespace atlas {
+
+namespace ecs { class Entity; }
+
+namespace network {
+
+/**
+ * @brief Per-tick cache of entity state encodings shared by all clients
+ *
+ * Every client's state_update carries the same current values for an
+ * entity; clients differ only in which field groups they need. The cache
+ * reads each entity's components once per tick and encodes each field
+ * group (as JSON text and as wire bytes) the first time any client needs
+ * it, so an entity visible to 50 clients is serialized once, not 50 times.
+ *
+ * Entries are keyed by entity pointer and are only valid until the next
+ * beginTick(). Not thread-safe.
+ */
+class FragmentCache {
+public:
+    /// Field groups; the order matches the wire::EntityState field bits
+    enum Group { kPos, kVel, kHealth, kCapacitor, kShip, kFaction, kGroupCount };
+
+    /// An entity's state, one slot per group
+    struct Fields {
+        std::array<float, 4> pos{};
+        std::array<float, 3> vel{};
+        std::array<float, 6> health{};
+        std::array<float, 2> capacitor{};
+        std::string ship_type;
+        std::string ship_name;
+        std::string faction;
+        std::array<bool, kGroupCount> present{};
+    };
+
+    /**
+     * @brief One entity's cached state and encodings
+     */
+    class Fragment {
+    public:
+        const std::string& id() const { return id_; }
+        const Fields& fields() const { return fields_; }
+
+        /// The group as a JSON member, with its leading comma
+        const std::string& json(int group);
+
+        /// The group's wire bytes (see wire::encodeEntityFields)
+        const std::string& binary(int group);
+
+    private:
+        friend class FragmentCache;
+
+        std::string id_;
+        Fields fields_;
+        std::array<std::string, kGroupCount> json_;
+        std::array<std::string, kGroupCount> binary_;
+        wire::EntityState wire_;            // fields_ in wire form, for binary()
+        uint32_t json_ready_ = 0;
+        uint32_t binary_ready_ = 0;
+        bool wire_ready_ = false;
+        size_t* encode_count_ = nullptr;
+    };
+
+    /// Invalidate every entry; call once per tick before encoding updates
+    void beginTick();
+
+    /// The entity's fragment, captured on first use this tick
+    Fragment& get(const ecs::Entity& entity);
+
+    /// Entities captured this tick
+    size_t size() const { return used_; }
+
+    /// Group encodings produced this tick (JSON and binary)
+    size_t getEncodeCount() const { return encode_count_; }
+
+    // Shared with SnapshotDelta's uncached path
+    static void capture(const ecs::Entity& entity, Fields& out);
+    static bool groupEquals(const Fields& a, const Fields& b, int group);
+    static void writeGroup(std::ostream& out, const Fields& fields, int group);
+    static void toWire(const std::string& id, const Fields& fields, wire::EntityState& out);
+
+private:
+    std::unordered_map<const ecs::Entity*, size_t> index_;
+    std::deque<Fragment> fragments_;    // stable addresses; reused to keep string capacity
+    size_t used_ = 0;
+    size_t encode_count_ = 0;
+};
+
+} // namespace network
+} // namespace atlas
+
+#endif // EVE_FRAGMENT_CACHE_H
@@ -0,0 +1,82 @@
+#ifndef EVE_INTEREST_MANAGER_H
+#define EVE_INTEREST_MANAGER_H
+
+#include "ecs/entity.h"
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace atlas {
+
+namespace ecs { class World; }
+namespace systems { class SpatialIndexSystem; }
+
+namespace network {
+
+/**
+ * @brief Per-client relevance filtering for state updates
+ *
+ * Each client only hears about entities in its own solar system
+ * (SystemLocation, or home_system without one) that are not docked:
+ * - within near_range of its ship (on grid), its own ship, and
+ *   LODPriority::force_visible entities: every tick;
+ * - farther away but within far_range: every far_interval ticks,
+ *   staggered between clients so the extra work is spread out.
+ *
+ * The client keeps entities it was told about until they appear in a
+ * removal list, which is sent when an entity is destroyed or drops out
+ * of the relevance set.
+ */
+class InterestManager {
+public:
+    struct Settings {
+        float near_range = 150000.0f;     // meters; one grid
+        float far_range = 1000000.0f;     // meters; <= 0 means whole system
+        int far_interval = 10;            // ticks between far refreshes
+        std::string home_system;          // system of entities without a SystemLocation
+    };
+
+    // What one client has been told about
+    struct ClientState {
+        struct Known {
+            ecs::EntityHandle handle;
+            uint64_t last_seen = 0;       // tick the entity was last relevant
+        };
+        std::unordered_map<std::string, Known> known;
+        uint64_t ticks = 0;
+        uint32_t phase = 0;               // staggers full refreshes
+    };
+
+    struct Snapshot {
+        std::vector<const ecs::Entity*> entities;   // states to send now
+        std::vector<std::string> removed;           // entities to drop
+        bool full = false;                          // far tier included
+    };
+
+    explicit InterestManager(ecs::World* world) : world_(world) {}
+
+    void setSettings(const Settings& settings) { settings_ = settings; }
+    const Settings& getSettings() const { return settings_; }
+
+    // Use a spatial index for range queries instead of scanning
+    void setSpatialIndex(const systems::SpatialIndexSystem* index) { spatial_index_ = index; }
+
+    /**
+     * @brief Build this tick's relevance set for one client
+     * @param observer_id Entity ID of the client's ship
+     * @param state The client's state, updated to match what is sent
+     * @param out Filled with the entities to send and the removals
+     */
+    void collect(const std::string& observer_id, ClientState& state, Snapshot& out) const;
+
+private:
+    ecs::World* world_;
+    const systems::SpatialIndexSystem* spatial_index_ = nullptr;
+    Settings settings_;
+};
+
+} // namespace network
+} // namespace atlas
+
+#endif // EVE_INTEREST_MANAGER_H
@@ -0,0 +1,50 @@
+#ifndef EVE_MESSAGE_BUFFER_H
+#define EVE_MESSAGE_BUFFER_H
+
+#include "network/wire_format.h"
+#include <memory>
+#include <string>
+
+namespace atlas {
+namespace network {
+
+/**
+ * @brief Immutable, reference-counted outbound message
+ *
+ * Holds one message exactly as it goes on the wire: binary frames as they
+ * are, JSON with its terminating newline. Copies share the bytes, so a
+ * message queued to many connections is serialized and stored once.
+ */
+class MessageBuffer {
+public:
+    MessageBuffer() = default;
+
+    /// Takes the message, newline-terminating JSON if it isn't already
+    explicit MessageBuffer(std::string data) {
+        if (!wire::isFrame(data) && (data.empty() || data.back() != '\n')) {
+            data.push_back('\n');
+        }
+        data_ = std::make_shared<const std::string>(std::move(data));
+    }
+
+    const std::string& str() const { return data_ ? *data_ : empty_string(); }
+    const char* data() const { return str().data(); }
+    size_t size() const { return data_ ? data_->size() : 0; }
+    bool empty() const { return size() == 0; }
+
+    /// Number of MessageBuffers sharing these bytes
+    long useCount() const { return data_.use_count(); }
+
+private:
+    static const std::string& empty_string() {
+        static const std::string empty;
+        return empty;
+    }
+
+    std::shared_ptr<const std::string> data_;
+};
+
+} // namespace network
+} // namespace atlas
+
+#endif // EVE_MESSAGE_BUFFER_H
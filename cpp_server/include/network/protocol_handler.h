@@ -25,6 +25,7 @@ enum class MessageType {
     DISCONNECT,
     INPUT_MOVE,
     STATE_UPDATE,
+    STATE_ACK,
     CHAT,
     COMMAND,
     SPAWN_ENTITY,
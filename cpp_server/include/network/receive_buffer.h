@@ -0,0 +1,82 @@
+#ifndef EVE_RECEIVE_BUFFER_H
+#define EVE_RECEIVE_BUFFER_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace atlas {
+namespace network {
+
+/**
+ * @brief Per-connection receive buffer that splits a TCP stream into messages
+ *
+ * Bytes are received straight into a growable ring buffer (writeSpace() /
+ * commit()), and next() extracts complete messages in the two framings
+ * clients use on one stream:
+ *
+ * - JSON messages terminated by '\n' (a trailing '\r' is dropped and
+ *   blank lines are skipped)
+ * - binary wire frames (network/wire_format.h), which start with the
+ *   magic byte and carry their own length
+ *
+ * One recv can therefore yield any number of messages, and a message
+ * may arrive over many reads. Messages are copied into a caller-owned
+ * string, so after warm-up nothing is allocated per message. The buffer
+ * only grows when a single message does not fit, up to the message size
+ * limit.
+ */
+class ReceiveBuffer {
+public:
+    static constexpr size_t kInitialCapacity = 4096;
+    static constexpr size_t kDefaultMaxMessage = 1024 * 1024;
+
+    enum class Status {
+        Message,    ///< A message was written to out
+        NeedMore,   ///< No complete message buffered
+        Error       ///< Invalid frame or message over the limit; drop the connection
+    };
+
+    explicit ReceiveBuffer(size_t max_message = kDefaultMaxMessage);
+
+    /**
+     * @brief Contiguous free space to receive into
+     *
+     * Grows the buffer when it is full. Call next() until it stops
+     * returning Message before asking for more space.
+     *
+     * @param available Set to the number of writable bytes
+     */
+    char* writeSpace(size_t& available);
+
+    /// Mark bytes written at writeSpace() as received
+    void commit(size_t bytes);
+
+    /**
+     * @brief Extract the next complete message
+     * @param out Receives the message without its delimiter; its
+     *            capacity is reused across calls
+     */
+    Status next(std::string& out);
+
+    size_t size() const { return size_; }
+    size_t capacity() const { return storage_.size(); }
+
+private:
+    char at(size_t offset) const { return storage_[(head_ + offset) & mask_]; }
+    void copyOut(size_t length, std::string& out) const;
+    void consume(size_t bytes);
+    void grow();
+
+    std::vector<char> storage_;  // power-of-two size
+    size_t mask_;
+    size_t head_ = 0;            // index of the oldest byte
+    size_t size_ = 0;            // bytes buffered
+    size_t scanned_ = 0;         // bytes already searched for '\n'
+    size_t max_message_;
+};
+
+} // namespace network
+} // namespace atlas
+
+#endif // EVE_RECEIVE_BUFFER_H
@@ -0,0 +1,133 @@
+#ifndef EVE_SNAPSHOT_DELTA_H
+#define EVE_SNAPSHOT_DELTA_H
+
+#include "network/fragment_cache.h"
+#include "network/wire_format.h"
+#include <array>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+
+namespace atlas {
+
+namespace ecs { class Entity; }
+
+namespace network {
+
+/**
+ * @brief Per-client delta encoding of entity states in state_update
+ *
+ * Entity state is split into field groups (pos, vel, health, capacitor,
+ * ship info, faction). For each entity the encoder remembers the values
+ * last sent to the client, the sequence at which each group last changed
+ * and which recent snapshots carried the entity. An ack (state_ack) only
+ * proves that one snapshot arrived; queued updates can be dropped for a
+ * lagging client. So each entity is synced at the newest acknowledged
+ * snapshot that carried it, and a group is written only if it changed
+ * after that. An entity no acknowledged snapshot carried is sent in full.
+ * Entities with nothing to send are left out of the update altogether.
+ *
+ * Without an acknowledgement, or when it is more than kMaxBaselineAge
+ * snapshots old, the encoder falls back to full snapshots.
+ */
+class SnapshotDelta {
+public:
+    static constexpr uint64_t kMaxBaselineAge = 32;
+    static constexpr uint64_t kAckWindow = 64;     // snapshots tracked as received/carried
+
+    /**
+     * @brief Record that the client applied the snapshot with this sequence
+     *
+     * The newest acknowledgement is the baseline; older ones still count
+     * as received if they fall within the last kAckWindow snapshots.
+     */
+    void acknowledge(uint64_t sequence);
+
+    /**
+     * @brief Find the baseline the snapshot with this sequence is encoded against
+     * @param baseline Set to the acknowledged sequence when there is one
+     * @return false if the snapshot must be sent in full
+     */
+    bool baselineFor(uint64_t sequence, uint64_t& baseline) const;
+
+    /**
+     * @brief Append one entity's JSON object to a state_update
+     *
+     * Call with increasing sequence numbers; every entity sent in the
+     * snapshot with this sequence must pass through here.
+     *
+     * @param out Stream to write to; a leading comma is written if needed
+     * @param entity Entity to encode
+     * @param sequence Sequence of the snapshot being built
+     * @param first Whether this is the first entity in the array; cleared
+     *              once something has been written
+     * @return true if anything was written
+     */
+    bool writeEntity(std::ostream& out, const ecs::Entity& entity, uint64_t sequence, bool& first);
+
+    /**
+     * @brief Binary counterpart of writeEntity() for wire-protocol clients
+     * @param out Filled with the fields to send; its mask says which
+     * @return true if there is anything to send
+     */
+    bool writeEntity(wire::EntityState& out, const ecs::Entity& entity, uint64_t sequence);
+
+    /**
+     * @brief writeEntity() using encodings shared across clients this tick
+     *
+     * Produces the same JSON as the uncached overload, but every field
+     * group comes from the fragment, encoded at most once per tick.
+     */
+    bool writeEntity(std::ostream& out, FragmentCache::Fragment& fragment, uint64_t sequence,
+                     bool& first);
+
+    /**
+     * @brief Append the entity's wire record (id, mask, fields) from the fragment
+     * @return true if anything was appended
+     */
+    bool appendEntityRecord(std::string& records, FragmentCache::Fragment& fragment,
+                            uint64_t sequence);
+
+    /**
+     * @brief Forget an entity the client was told to remove
+     *
+     * If it becomes relevant again it is sent in full.
+     */
+    void forget(const std::string& entity_id);
+
+    size_t getTrackedCount() const { return entities_.size(); }
+    bool hasAcknowledgement() const { return acked_; }
+    uint64_t getAcknowledged() const { return acked_sequence_; }
+
+private:
+    static constexpr int kGroupCount = FragmentCache::kGroupCount;
+    using Values = FragmentCache::Fields;   // values as last sent
+
+    struct Record {
+        Values sent;
+        std::array<uint64_t, kGroupCount> changed{};  // sequence of last change
+        uint64_t last_carried = 0;   // newest snapshot the entity was encoded in
+        uint64_t carried = 0;        // bit i: encoded in snapshot last_carried - i
+        uint64_t synced = 0;         // client holds the entity as of this snapshot
+        bool is_synced = false;
+    };
+
+    // Move record.synced up to the newest acknowledged snapshot that carried it
+    void confirm(Record& record) const;
+
+    // Update the entity's record from its current values; returns the
+    // mask of groups to send
+    uint32_t select(const std::string& id, const Values& current, uint64_t sequence, Record*& record);
+
+    std::unordered_map<std::string, Record> entities_;
+    Values scratch_;
+    uint64_t acked_sequence_ = 0;
+    uint64_t received_ = 0;          // bit i: snapshot acked_sequence_ - i acknowledged
+    bool acked_ = false;
+};
+
+} // namespace network
+} // namespace atlas
+
+#endif // EVE_SNAPSHOT_DELTA_H
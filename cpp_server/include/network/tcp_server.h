@@ -8,6 +8,9 @@
 #include <mutex>
 #include <thread>
 #include <atomic>
+#include <unordered_map>
+#include "network/message_buffer.h"
+#include "utils/mpsc_queue.h"
 
 #ifdef _WIN32
 #include <winsock2.h>
@@ -23,6 +26,11 @@ typedef int socket_t;
 #define SOCKET_ERROR -1
 #endif
 
+// Linux uses an epoll reactor; other platforms fall back to a thread per client
+#if defined(__linux__)
+#define EVE_TCP_SERVER_EPOLL 1
+#endif
+
 namespace atlas {
 namespace network {
 
@@ -37,12 +45,28 @@ struct ClientConnection {
 
 /**
  * @brief TCP server for handling client connections
- * 
- * Manages network communication with game clients
+ *
+ * Manages network communication with game clients. On Linux all sockets
+ * are non-blocking and served by a small, fixed set of I/O threads, each
+ * running an edge-triggered epoll loop that accepts, reads, writes and
+ * closes connections. Thousands of mostly idle clients therefore cost
+ * only their buffers, not a thread each. The message handler runs on the
+ * I/O thread that owns the connection.
+ *
+ * sendToClient() may be called from any thread and never touches the
+ * socket: it appends to the connection's outbound queue and hands the
+ * connection to its I/O thread, which writes everything queued with one
+ * sendmsg() call. Messages sent close together (or inside a SendBatch)
+ * therefore leave in a single write, and a slow client never blocks the
+ * caller.
  */
 class TCPServer {
 public:
-    explicit TCPServer(const std::string& host, uint16_t port, int max_connections);
+    /**
+     * @param io_threads Number of I/O threads (epoll only; at least 1)
+     */
+    explicit TCPServer(const std::string& host, uint16_t port, int max_connections,
+                       int io_threads = 1);
     ~TCPServer();
 
     // Server control
@@ -50,37 +74,119 @@ public:
     void start();
     void stop();
     bool isRunning() const { return running_; }
-    
+
+    /// Port actually bound (useful when constructed with port 0)
+    uint16_t getPort() const { return port_; }
+
     // Client management
     int getClientCount() const;
     std::vector<ClientConnection> getClients() const;
-    
+
     // Message handling
     using MessageHandler = std::function<void(const ClientConnection&, const std::string&)>;
     void setMessageHandler(MessageHandler handler);
-    
-    // Send data
-    bool sendToClient(const ClientConnection& client, const std::string& data);
+
+    /// Called once when a connection closes, before its socket is released
+    using DisconnectHandler = std::function<void(const ClientConnection&)>;
+    void setDisconnectHandler(DisconnectHandler handler);
+
+    /**
+     * @brief Queue a message for one client
+     * 
+     * JSON messages are newline-terminated if they aren't already.
+     * 
+     * @param replaceable The message is superseded by the next replaceable
+     *        one (e.g. state_update). Once a client has kSendHighWater
+     *        bytes queued, its queued replaceable messages are dropped in
+     *        favour of the newest instead of growing the queue.
+     * @return false if the client is gone or was dropped as too slow
+     */
+    bool sendToClient(const ClientConnection& client, const std::string& data,
+                      bool replaceable = false);
+
+    /// Queue a shared message; the bytes are not copied per connection
+    bool sendToClient(const ClientConnection& client, const MessageBuffer& message,
+                      bool replaceable = false);
+
     void broadcastToAll(const std::string& data);
-    
+    void broadcastToAll(const MessageBuffer& message);
+
+    /**
+     * @brief Defers I/O thread wake-ups on this thread until destroyed
+     * 
+     * Everything sent to a client within the batch is written together
+     * instead of the I/O thread racing the sender. Batches may nest.
+     */
+    class SendBatch {
+    public:
+        SendBatch();
+        ~SendBatch();
+        SendBatch(const SendBatch&) = delete;
+        SendBatch& operator=(const SendBatch&) = delete;
+    };
+
+    /// Replaceable messages dropped for lagging clients since start
+    uint64_t getDroppedMessages() const { return dropped_messages_; }
+
+    /// Queued output above which replaceable messages are dropped
+    static constexpr size_t kSendHighWater = 256 * 1024;
+    /// Output queued per connection before it is dropped as too slow
+    static constexpr size_t kMaxPendingOutput = 4 * 1024 * 1024;
+
 private:
+    struct Connection;
+    struct BatchState;
+
     std::string host_;
     uint16_t port_;
     int max_connections_;
+    int io_threads_;
     socket_t server_socket_;
     std::atomic<bool> running_;
-    
-    std::vector<ClientConnection> clients_;
+
+    std::unordered_map<socket_t, std::shared_ptr<Connection>> connections_;
     mutable std::mutex clients_mutex_;
-    
+
     MessageHandler message_handler_;
-    
+    DisconnectHandler disconnect_handler_;
+    std::atomic<uint64_t> dropped_messages_{0};
+
+#ifdef EVE_TCP_SERVER_EPOLL
+    struct IOLoop {
+        int epoll_fd = -1;
+        int wake_fd = -1;    // eventfd that interrupts epoll_wait
+        std::thread thread;
+        utils::MpscQueue<std::shared_ptr<Connection>> ready;  // connections with queued output
+        std::atomic<bool> wake_pending{false};
+        // Connections closed while handling the current epoll batch; a later
+        // event in the same batch may still point at them
+        std::vector<std::shared_ptr<Connection>> closed;
+    };
+    std::vector<std::unique_ptr<IOLoop>> loops_;
+    size_t next_loop_ = 0;   // round-robin assignment; accept runs on loop 0 only
+
+    void runLoop(IOLoop& loop);
+    void acceptConnections();
+    bool readConnection(Connection& conn);
+    bool flushPending(Connection& conn);
+    void flushReady(IOLoop& loop);
+    void closeConnection(IOLoop& loop, Connection* conn);
+    static void wakeLoop(IOLoop& loop);
+#else
     std::thread accept_thread_;
     std::vector<std::thread> client_threads_;
-    
-    // Internal methods
+
     void acceptLoop();
-    void handleClient(ClientConnection client);
+    void handleClient(std::shared_ptr<Connection> conn);
+#endif
+
+    // Internal methods
+    std::shared_ptr<Connection> createConnection(socket_t socket, const sockaddr_in& addr);
+    void addConnection(const std::shared_ptr<Connection>& conn);
+    std::shared_ptr<Connection> findConnection(const ClientConnection& client) const;
+    bool dispatchMessages(Connection& conn);
+    bool sendTo(const std::shared_ptr<Connection>& conn, const MessageBuffer& message, bool replaceable);
+    static BatchState& batchState();
     void closeSocket(socket_t socket);
     bool initializeSockets();
     void cleanupSockets();
@@ -14,7 +14,10 @@
 #include "systems/station_system.h"
 #include "systems/movement_system.h"
 #include "systems/combat_system.h"
+#include "systems/spatial_index_system.h"
 #include "data/world_persistence.h"
+#include "data/async_world_saver.h"
+#include "data/tick_recording.h"
 #include "utils/server_metrics.h"
 #include "ui/server_console.h"
 
@@ -37,19 +40,57 @@ public:
     void stop();
     void run();
 
+    /**
+     * @brief Re-run a tick recording headless, as fast as possible
+     *
+     * Loads the recording's starting world into the still-empty world,
+     * with every entity on the handle it had when recorded, and with
+     * storage and queries in creation order as the recording run had them
+     * (World::canonicalize). It then applies each recorded tick's
+     * commands and delta through the same inbound, world and session
+     * phases as the main loop, without a network or a clock.
+     * Prints throughput, tick percentiles and a world fingerprint to
+     * compare against other builds or the recording run. Use instead of
+     * initialize().
+     *
+     * @return false if the recording cannot be read
+     */
+    bool replay(const std::string& recording_path);
+
+    /**
+     * @brief Make run() return after the current tick; callable from any thread
+     *
+     * Unlike stop(), tears nothing down, so the owner can call stop() on
+     * its own thread once run() has returned.
+     */
+    void requestStop() { stop_requested_ = true; }
+
     // Status
     bool isRunning() const { return running_; }
     int getPlayerCount() const;
+
+    /// Port the TCP server is bound to (after initialize(); useful with port 0)
+    uint16_t getPort() const { return tcp_server_ ? tcp_server_->getPort() : 0; }
     
     // Get game world
     ecs::World* getWorld() { return game_world_.get(); }
 
+    /// Game session, once initialize() has run
+    GameSession* getGameSession() { return game_session_.get(); }
+
     // World persistence
+    /// Save synchronously (shutdown, console); waits for a running autosave
     bool saveWorld();
     bool loadWorld();
 
+    /// Snapshot the world and save it on the background saver thread
+    bool beginAutoSave();
+
     // Metrics
     const utils::ServerMetrics& getMetrics() const { return metrics_; }
+
+    /// Order-independent hash of every entity's persisted state, in hex
+    std::string getWorldFingerprint() const;
     
     // Console
     ServerConsole& getConsole() { return console_; }
@@ -62,19 +103,28 @@ private:
     std::unique_ptr<ecs::World> game_world_;
     std::unique_ptr<GameSession> game_session_;
     data::WorldPersistence world_persistence_;
+    data::SaveFormat save_format_ = data::SaveFormat::Json;
+    std::unique_ptr<data::WorldJournal> world_journal_;     // when save_journal is set
+    data::AsyncWorldSaver world_saver_;
+    data::TickRecorder recorder_;                           // when tick_recording is set
     utils::ServerMetrics metrics_;
     ServerConsole console_;
     systems::TargetingSystem* targeting_system_ = nullptr;
     systems::StationSystem* station_system_ = nullptr;
     systems::MovementSystem* movement_system_ = nullptr;
     systems::CombatSystem* combat_system_ = nullptr;
+    systems::SpatialIndexSystem* spatial_index_system_ = nullptr;
     
     std::atomic<bool> running_;
+    std::atomic<bool> stop_requested_{false};
     
     // Internal methods
     void mainLoop();
     void updateSteam();
     void initializeGameWorld();
+    void createGameSession(bool spawn_initial_npcs = true);
+    bool ensureSaveDirectory();
+    std::string worldSavePath() const;
 };
 
 } // namespace atlas
@@ -3,19 +3,41 @@
 
 #include "ecs/system.h"
 #include "ecs/entity.h"
+#include <cstdint>
+#include <deque>
 #include <string>
+#include <vector>
 
 namespace atlas {
+namespace components { class AI; }
 namespace systems {
 
+class SpatialIndexSystem;
+
 /**
  * @brief Handles AI behavior for NPCs
  * 
  * Implements NPC AI states: idle, approaching, orbiting, attacking, fleeing.
  * NPCs can detect players, approach them, orbit at preferred distance, and attack.
+ *
+ * Not every NPC thinks every tick. NPCs in a combat state (approaching,
+ * orbiting, attacking, fleeing), ones that were just hit, ones within
+ * near_range of a player and ones whose LODPriority is at least 1 think
+ * every tick. The rest take turns: each gets one think every
+ * think_interval ticks, staggered by handle so the work is spread out.
+ * Those turns are capped at budget_turns per tick; NPCs that miss out
+ * wait in a queue and go first next tick. The cap is a count, not a
+ * time, so a replay makes the same decisions on any machine.
+ * bench_ai_scheduler reports the cost of one think for sizing it.
  */
 class AISystem : public ecs::System {
 public:
+    struct ThinkSettings {
+        float near_range = 60000.0f;      // meters from a player; think every tick
+        int think_interval = 1;           // ticks between turns for the rest; 1 = every tick
+        int budget_turns = 0;             // turns per tick for the rest; 0 = no limit
+    };
+
     explicit AISystem(ecs::World* world);
     ~AISystem() override = default;
     
@@ -75,8 +97,64 @@ public:
      * @return The attacking entity, or nullptr if no friendly is under attack
      */
     ecs::Entity* findAttackerOfFriendly(ecs::Entity* entity);
+
+    /**
+     * Resolve an AI's current target entity.
+     *
+     * Uses the cached target_handle when it still refers to the entity
+     * named by target_entity_id, falling back to a string lookup (and
+     * refreshing the cache) when the ID was set elsewhere or the old
+     * target was destroyed.
+     *
+     * @return The target entity, or nullptr if it does not exist
+     */
+    static ecs::Entity* resolveTarget(ecs::World* world, components::AI& ai);
+    
+    /**
+     * Use a spatial index for target, deposit and defensive-assist searches.
+     *
+     * Without one (the default) those searches scan every positioned
+     * entity. The index must be updated before this system runs.
+     */
+    void setSpatialIndex(const SpatialIndexSystem* index) { spatial_index_ = index; }
+
+    void setThinkSettings(const ThinkSettings& settings) { think_settings_ = settings; }
+    const ThinkSettings& getThinkSettings() const { return think_settings_; }
+
+    /// NPCs that thought on the last tick, every-tick ones included
+    size_t getLastThinkCount() const { return last_think_count_; }
+
+    /// NPCs whose turn came but that were left over for a later tick
+    size_t getDeferredCount() const { return deferred_.size(); }
     
 private:
+    // Per handle index; generations tell a recycled slot from its old entity
+    struct ThinkSlot {
+        uint64_t hot_tick = 0;          // last tick it was marked to think every tick
+        uint64_t think_tick = 0;        // last tick this NPC thought
+        uint32_t queued_generation = 0; // handle generation waiting in deferred_
+    };
+
+    ThinkSlot& thinkSlot(ecs::EntityHandle handle);
+
+    /// Stamp hot_tick on NPCs near a player, recently hit, or high LODPriority
+    void markEveryTick();
+
+    /// Approaching, orbiting, attacking or fleeing
+    static bool inCombat(const components::AI& ai);
+
+    /// Run the behavior for the NPC's current state
+    void think(ecs::Entity* entity);
+
+    const SpatialIndexSystem* spatial_index_ = nullptr;
+    std::vector<ecs::Entity*> nearby_;  // scratch buffer for index queries
+
+    ThinkSettings think_settings_;
+    uint64_t tick_ = 0;
+    std::vector<ThinkSlot> think_slots_;
+    std::deque<ecs::EntityHandle> deferred_;    // oldest turn first
+    size_t last_think_count_ = 0;
+    
     /**
      * Idle behavior state
      * 
@@ -2,6 +2,7 @@
 #define EVE_SYSTEMS_ANOMALY_SYSTEM_H
 
 #include "ecs/system.h"
+#include "ecs/timed_components.h"
 #include "components/game_components.h"
 #include <string>
 #include <vector>
@@ -15,6 +16,8 @@ namespace systems {
  * Uses a deterministic seed per system to spawn combat, mining, data,
  * relic, gas, and wormhole anomalies.  The difficulty scales with
  * the system's security status (lower sec = harder content).
+ * Despawn timers live on the world's timing wheel, so an anomaly is
+ * only visited when it despawns.
  */
 class AnomalySystem : public ecs::System {
 public:
@@ -82,6 +85,11 @@ private:
      * @brief Generate a name for an anomaly based on type and index
      */
     static std::string generateName(components::Anomaly::Type type, int index);
+
+    /// Count down the despawn timer; seconds left, or -1 once completed
+    static float advanceDespawn(components::Anomaly& anomaly, float elapsed);
+
+    ecs::TimedComponents<components::Anomaly> anomalies_;
 };
 
 } // namespace systems
@@ -65,6 +65,16 @@ private:
     float getResistance(float em_resist, float thermal_resist, 
                        float kinetic_resist, float explosive_resist,
                        const std::string& damage_type);
+    
+    /**
+     * @brief Append a hit to the target's DamageEvent
+     *
+     * Creating the DamageEvent is a structural change, so for targets
+     * that do not have one yet it goes through World::defer().
+     */
+    void recordDamageEvent(ecs::Entity* target, float damage, const std::string& damage_type,
+                           const std::string& layer, bool shield_depleted,
+                           bool armor_depleted, bool hull_critical);
 };
 
 } // namespace systems
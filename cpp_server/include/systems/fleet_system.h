@@ -2,6 +2,7 @@
 #define EVE_SYSTEMS_FLEET_SYSTEM_H
 
 #include "ecs/system.h"
+#include "ecs/entity.h"
 #include <string>
 #include <vector>
 #include <map>
@@ -19,6 +20,7 @@ struct FleetMemberInfo {
     std::string squad_id;
     std::string wing_id;
     bool online = true;
+    ecs::EntityHandle handle;  // cached resolution of entity_id
 };
 
 /**
@@ -208,6 +210,7 @@ private:
     int next_fleet_id_ = 1;
 
     void applyFleetBonuses(const std::string& fleet_id);
+    ecs::Entity* resolveMember(const std::string& entity_id, FleetMemberInfo& info);
     void removeFleetBonuses(const std::string& entity_id);
 };
 
@@ -7,6 +7,8 @@
 
 namespace atlas {
 
+namespace systems { class SpatialIndexSystem; }
+
 /**
  * @brief Server-side LOD culling for large battle optimisation
  *
@@ -29,6 +31,14 @@ public:
                                  float observerX, float observerY, float observerZ,
                                  float cull_distance = 50000.0f);
 
+    /// Same as above, but only computes distances for entities the spatial
+    /// index reports within `cull_distance`; everything else is culled
+    /// without a distance check.  The index must be refreshed first.
+    static void updatePriorities(ecs::World* world,
+                                 const systems::SpatialIndexSystem& index,
+                                 float observerX, float observerY, float observerZ,
+                                 float cull_distance = 50000.0f);
+
     /// Return entities whose LODPriority is effectively culled (priority <= 0
     /// and not force_visible).
     static std::vector<ecs::Entity*> getCulledEntities(ecs::World* world);
@@ -2,6 +2,8 @@
 #define EVE_SYSTEMS_MANUFACTURING_SYSTEM_H
 
 #include "ecs/system.h"
+#include "ecs/timed_components.h"
+#include "components/game_components.h"
 #include <string>
 
 namespace atlas {
@@ -11,7 +13,9 @@ namespace systems {
  * @brief Manufacturing system for blueprint-based production
  *
  * Manages manufacturing jobs: starting jobs, ticking time,
- * completing runs, and delivering output.
+ * completing runs, and delivering output. A facility is only visited
+ * when its next run finishes (see ecs::TimedComponents), so idle and
+ * long-running jobs cost nothing per tick.
  */
 class ManufacturingSystem : public ecs::System {
 public:
@@ -57,7 +61,11 @@ public:
     int getTotalRunsCompleted(const std::string& facility_entity_id);
 
 private:
+    /// Run the facility's active jobs forward; seconds until the next run ends, -1 if none
+    static float advanceJobs(components::ManufacturingFacility& facility, float elapsed);
+
     int job_counter_ = 0;
+    ecs::TimedComponents<components::ManufacturingFacility> facilities_;
 };
 
 } // namespace systems
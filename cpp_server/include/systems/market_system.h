@@ -2,12 +2,20 @@
 #define EVE_SYSTEMS_MARKET_SYSTEM_H
 
 #include "ecs/system.h"
+#include "data/order_book.h"
+#include <cstdint>
 #include <string>
 #include <vector>
 
 namespace atlas {
 namespace systems {
 
+/**
+ * @brief Station markets: order placement, trading and expiry
+ *
+ * Orders rest in each MarketHub's OrderBook; update() only advances the
+ * book clocks, so it costs nothing per resting order.
+ */
 class MarketSystem : public ecs::System {
 public:
     explicit MarketSystem(ecs::World* world);
@@ -18,28 +26,50 @@ public:
 
     /**
      * @brief Place a sell order at a station
-     * @return order_id or empty string on failure
+     *
+     * The broker fee is charged up front and is not refunded.
+     *
+     * @param price_per_unit must be finite and positive
+     * @param duration seconds until the order expires, < 0 = permanent
+     * @return order_id, or 0 on failure
      */
-    std::string placeSellOrder(const std::string& station_id,
-                                const std::string& seller_id,
-                                const std::string& item_id,
-                                const std::string& item_name,
-                                int quantity,
-                                double price_per_unit);
+    uint64_t placeSellOrder(const std::string& station_id,
+                            const std::string& seller_id,
+                            const std::string& item_id,
+                            const std::string& item_name,
+                            int quantity,
+                            double price_per_unit,
+                            float duration = -1.0f);
 
     /**
      * @brief Place a buy order at a station
-     * @return order_id or empty string on failure
+     *
+     * The broker fee is charged up front and is not refunded. The price of
+     * the full quantity is held in escrow; the part for units still unfilled
+     * is refunded when the order is cancelled or expires.
+     *
+     * @param price_per_unit must be finite and positive
+     * @param duration seconds until the order expires, < 0 = permanent
+     * @return order_id, or 0 on failure
+     */
+    uint64_t placeBuyOrder(const std::string& station_id,
+                           const std::string& buyer_id,
+                           const std::string& item_id,
+                           const std::string& item_name,
+                           int quantity,
+                           double price_per_unit,
+                           float duration = -1.0f);
+
+    /**
+     * @brief Withdraw an order placed by owner_id
+     * @return false if there is no such order of theirs at the station
      */
-    std::string placeBuyOrder(const std::string& station_id,
-                               const std::string& buyer_id,
-                               const std::string& item_id,
-                               const std::string& item_name,
-                               int quantity,
-                               double price_per_unit);
+    bool cancelOrder(const std::string& station_id,
+                     const std::string& owner_id,
+                     uint64_t order_id);
 
     /**
-     * @brief Buy directly from the lowest-priced sell order
+     * @brief Buy directly from the sell orders, cheapest and oldest first
      * @return quantity actually bought
      */
     int buyFromMarket(const std::string& station_id,
@@ -78,7 +108,8 @@ public:
     int seedNPCOrders(const std::string& station_id);
 
 private:
-    int order_counter_ = 0;
+    /// Return the unspent escrow of a buy order leaving the book
+    void refundEscrow(const data::OrderBook::Order& order);
 };
 
 } // namespace systems
@@ -2,6 +2,7 @@
 #define EVE_SYSTEMS_MOVEMENT_SYSTEM_H
 
 #include "ecs/system.h"
+#include "ecs/entity_handle.h"
 #include <string>
 #include <vector>
 #include <map>
@@ -83,7 +84,7 @@ private:
     struct MovementCommand {
         enum class Type { None, Orbit, Approach, Warp, Stop };
         Type type = Type::None;
-        std::string target_id;
+        ecs::EntityHandle target;
         float orbit_distance = 1000.0f;
         float warp_dest_x = 0.0f;
         float warp_dest_y = 0.0f;
@@ -93,7 +94,8 @@ private:
         float align_time = 2.5f;     // seconds for align phase (from Ship component)
         bool warping = false;
     };
-    std::map<std::string, MovementCommand> movement_commands_;
+    // Keyed by handle so the per-tick loop resolves entities by array index
+    std::map<ecs::EntityHandle, MovementCommand> movement_commands_;
 
     std::vector<CollisionZone> m_collisionZones;
 
@@ -2,6 +2,8 @@
 #define EVE_SYSTEMS_PI_SYSTEM_H
 
 #include "ecs/system.h"
+#include "ecs/timed_components.h"
+#include "components/game_components.h"
 #include <string>
 
 namespace atlas {
@@ -11,7 +13,8 @@ namespace systems {
  * @brief Planetary Interaction system
  *
  * Manages planetary colonies: extraction cycles, processing,
- * storage, and resource transfer to player inventory.
+ * storage, and resource transfer to player inventory. A colony is only
+ * visited when one of its extractors or processors completes a cycle.
  */
 class PISystem : public ecs::System {
 public:
@@ -63,6 +66,11 @@ public:
 private:
     int extractor_counter_ = 0;
     int processor_counter_ = 0;
+
+    /// Run the colony's cycles forward; seconds until the next one completes, -1 if idle
+    static float advanceColony(components::PlanetaryColony* colony, float delta_time);
+
+    ecs::TimedComponents<components::PlanetaryColony> colonies_;
 };
 
 } // namespace systems
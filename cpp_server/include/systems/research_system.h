@@ -2,6 +2,8 @@
 #define EVE_SYSTEMS_RESEARCH_SYSTEM_H
 
 #include "ecs/system.h"
+#include "ecs/timed_components.h"
+#include "components/game_components.h"
 #include <string>
 
 namespace atlas {
@@ -11,6 +13,7 @@ namespace systems {
  * @brief Research system for blueprint ME/TE research and invention
  *
  * Manages research jobs: ME research, TE research, and T2 invention.
+ * A lab is only visited when one of its jobs finishes.
  */
 class ResearchSystem : public ecs::System {
 public:
@@ -78,6 +81,11 @@ private:
     // Uses a simple LCG to keep results predictable in tests
     unsigned int rng_state_ = 42;
     float nextRandom();
+
+    /// Run the lab's active jobs forward; seconds until the next one ends, -1 if none
+    float advanceJobs(components::ResearchLab& lab, float elapsed);
+
+    ecs::TimedComponents<components::ResearchLab> labs_;
 };
 
 } // namespace systems
@@ -0,0 +1,113 @@
+#ifndef EVE_SYSTEMS_SPATIAL_INDEX_SYSTEM_H
+#define EVE_SYSTEMS_SPATIAL_INDEX_SYSTEM_H
+
+#include "ecs/system.h"
+#include "ecs/entity.h"
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace atlas {
+namespace systems {
+
+/**
+ * @brief Hashed uniform grid over every entity with a Position
+ *
+ * Space is divided into cubic cells (25 km by default, so a 150 km grid
+ * spans a handful of cells per axis) and only occupied cells are stored.
+ * update() re-syncs the grid with the Position components: entities that
+ * stay inside their cell only have their cached coordinates refreshed,
+ * and only entities that cross a cell boundary are moved between cells.
+ *
+ * Queries return entities as of the last update(), so the system should
+ * be registered before any system that queries it. Registering it first
+ * also keeps it exclusive: it declares no component access, so the
+ * scheduler never runs it alongside the systems that read the index.
+ */
+class SpatialIndexSystem : public ecs::System {
+public:
+    static constexpr float kDefaultCellSize = 25000.0f;  // meters
+
+    explicit SpatialIndexSystem(ecs::World* world, float cell_size = kDefaultCellSize);
+    ~SpatialIndexSystem() override = default;
+
+    void update(float delta_time) override;
+    std::string getName() const override { return "SpatialIndexSystem"; }
+
+    /**
+     * @brief Sync the grid with the current Position components
+     *
+     * Called by update(); call it directly after moving entities outside
+     * of a tick if they must be queryable straight away.
+     */
+    void refresh();
+
+    /**
+     * @brief Append every indexed entity within radius of a point
+     */
+    void queryRadius(float x, float y, float z, float radius,
+                     std::vector<ecs::Entity*>& out) const;
+
+    /**
+     * @brief Append every indexed entity inside an axis-aligned box
+     */
+    void queryAABB(float min_x, float min_y, float min_z,
+                   float max_x, float max_y, float max_z,
+                   std::vector<ecs::Entity*>& out) const;
+
+    /**
+     * @brief Up to k entities nearest to a point, closest first
+     * @param max_radius Ignore anything farther away than this
+     * @param filter Optional predicate; rejected entities are skipped
+     */
+    std::vector<ecs::Entity*> queryNearest(float x, float y, float z, size_t k, float max_radius,
+                                           const std::function<bool(ecs::Entity*)>& filter = {}) const;
+
+    float getCellSize() const { return cell_size_; }
+    size_t getIndexedCount() const { return indexed_count_; }
+    size_t getCellCount() const { return cells_.size(); }
+
+    // Entities moved between cells by the most recent refresh()
+    size_t getLastCellChanges() const { return last_cell_changes_; }
+
+private:
+    struct Entry {
+        ecs::EntityHandle handle;
+        float x, y, z;
+    };
+
+    // Where each indexed entity lives, addressed by handle index
+    struct Record {
+        ecs::EntityHandle handle;
+        uint64_t cell = 0;
+        uint32_t position = 0;   // index within the cell's entry list
+        uint32_t stamp = 0;      // refresh that last saw the entity
+        bool indexed = false;
+    };
+
+    int64_t cellCoord(float v) const;
+    static uint64_t cellKey(int64_t cx, int64_t cy, int64_t cz);
+
+    void insert(Record& record, ecs::EntityHandle handle, uint64_t cell, float x, float y, float z);
+    void removeFromCell(Record& record);
+
+    // Visit entries in every occupied cell overlapping the box
+    void visitCells(float min_x, float min_y, float min_z,
+                    float max_x, float max_y, float max_z,
+                    const std::function<void(const Entry&)>& fn) const;
+
+    float cell_size_;
+    float inv_cell_size_;
+    std::unordered_map<uint64_t, std::vector<Entry>> cells_;
+    std::vector<Record> records_;
+    size_t indexed_count_ = 0;
+    uint32_t stamp_ = 0;
+    size_t last_cell_changes_ = 0;
+};
+
+} // namespace systems
+} // namespace atlas
+
+#endif // EVE_SYSTEMS_SPATIAL_INDEX_SYSTEM_H
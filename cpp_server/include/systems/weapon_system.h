@@ -2,6 +2,7 @@
 #define EVE_SYSTEMS_WEAPON_SYSTEM_H
 
 #include "ecs/system.h"
+#include "ecs/entity.h"
 #include <string>
 
 namespace atlas {
@@ -30,6 +31,12 @@ public:
      */
     bool fireWeapon(const std::string& shooter_id, const std::string& target_id);
     
+    /**
+     * @brief Attempt to fire a weapon using already-resolved entities
+     * @return true if weapon fired successfully
+     */
+    bool fireWeapon(ecs::Entity* shooter, ecs::Entity* target);
+    
 private:
     /**
      * @brief Calculate damage falloff based on distance
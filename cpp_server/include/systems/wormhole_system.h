@@ -2,6 +2,8 @@
 #define EVE_SYSTEMS_WORMHOLE_SYSTEM_H
 
 #include "ecs/system.h"
+#include "ecs/timed_components.h"
+#include "components/game_components.h"
 #include "data/wormhole_database.h"
 #include <string>
 
@@ -11,8 +13,11 @@ namespace systems {
 /**
  * @brief Manages wormhole connections: lifetime decay, mass tracking, and collapse
  *
- * Each tick the system ages every WormholeConnection entity and collapses
- * any that exceed their lifetime or have their remaining mass depleted.
+ * The system ages every WormholeConnection entity and collapses any that
+ * exceed their lifetime or have their remaining mass depleted. Ageing is
+ * driven by the world's timing wheel: a wormhole is visited when it is due
+ * to collapse and at least every kAgeRefreshSeconds in between, so saved
+ * elapsed_hours lag by at most that much.
  */
 class WormholeSystem : public ecs::System {
 public:
@@ -46,6 +51,14 @@ public:
      * @return fraction, or -1.0 if entity not found
      */
     float getRemainingLifetimeFraction(const std::string& wormhole_entity_id) const;
+
+    static constexpr float kAgeRefreshSeconds = 60.0f;
+
+private:
+    /// Age one wormhole; seconds until its next visit, or -1 once collapsed
+    static float advanceAge(components::WormholeConnection& wh, float elapsed);
+
+    ecs::TimedComponents<components::WormholeConnection> wormholes_;
 };
 
 } // namespace systems
@@ -5,6 +5,9 @@
 #include <fstream>
 #include <mutex>
 #include <memory>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 
 namespace atlas {
 namespace utils {
@@ -45,6 +48,13 @@ enum class LogLevel {
  *   log.init("./logs");            // opens ./logs/server.log
  *   log.setLevel(LogLevel::INFO);
  *   log.info("Server started on port " + std::to_string(8765));
+ *
+ * By default every call writes and flushes synchronously. After
+ * startAsync(), a call only formats the line and pushes it onto a
+ * lock-free ring owned by the calling thread; a background thread
+ * writes all rings in batches every flush interval. A full ring drops
+ * the line and counts it instead of blocking the caller. FATAL lines
+ * and flush() wait for the writer.
  */
 class Logger {
 public:
@@ -88,20 +98,63 @@ public:
     /// Check whether a log file is currently open
     bool isFileOpen() const;
 
+    /**
+     * @brief Rotate the log file by size
+     * @param max_file_bytes Rotate once the file reaches this size (0 = never)
+     * @param max_files      Rotated files kept (server.log.1 .. .N)
+     */
+    void setRotation(size_t max_file_bytes, int max_files);
+
+    /**
+     * @brief Switch to asynchronous logging
+     * @param queue_capacity    Lines buffered per logging thread (rounded
+     *                          up to a power of two); applies to threads
+     *                          that have not logged asynchronously yet
+     * @param flush_interval_ms Maximum delay before a line is written
+     */
+    void startAsync(size_t queue_capacity = 8192, int flush_interval_ms = 200);
+
+    /// Write everything queued and return to synchronous logging
+    void stopAsync();
+
+    bool isAsync() const;
+
+    /// Block until every line logged before the call has been written
+    void flush();
+
+    /// Lines dropped because a thread's queue was full
+    uint64_t getDroppedCount() const;
+
 private:
     Logger();
     ~Logger();
     Logger(const Logger&) = delete;
     Logger& operator=(const Logger&) = delete;
 
+    struct AsyncState;
+
     static std::string levelToString(LogLevel level);
     static std::string timestamp();
 
+    std::string formatLine(LogLevel level, const std::string& message) const;
+    void writeFile(const std::string& data);    // mutex_ held
+    void rotate();                              // mutex_ held
+    void writerLoop();
+    void drainQueues();
+
     std::ofstream log_file_;
-    LogLevel min_level_ = LogLevel::INFO;
-    bool console_output_ = true;
-    bool file_output_ = true;
-    mutable std::mutex mutex_;
+    std::string log_path_;
+    size_t file_bytes_ = 0;
+    size_t max_file_bytes_ = 0;
+    int max_files_ = 5;
+    std::atomic<LogLevel> min_level_{LogLevel::INFO};
+    std::atomic<bool> console_output_{true};
+    std::atomic<bool> file_output_{true};
+    mutable std::mutex mutex_;                  // file and console output
+
+    std::unique_ptr<AsyncState> async_;         // created by the first startAsync()
+    std::atomic<bool> async_enabled_{false};
+    std::atomic<int> async_producers_{0};
 };
 
 } // namespace utils
@@ -0,0 +1,83 @@
+#ifndef EVE_UTILS_MPSC_QUEUE_H
+#define EVE_UTILS_MPSC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+namespace atlas {
+namespace utils {
+
+/**
+ * @brief Unbounded lock-free multi-producer, single-consumer queue
+ *
+ * Linked list with a dummy head node (Vyukov's MPSC design). push() is
+ * one atomic exchange plus a release store, so producers never block each
+ * other or the consumer. pop() must only be called from one thread at a
+ * time. Items are popped in the order their push() exchanged the head.
+ *
+ * A producer preempted between its exchange and its store hides the items
+ * pushed after it until it resumes; pop() then reports empty and the
+ * consumer picks them up on its next drain.
+ *
+ * T must be default-constructible (for the dummy node) and movable.
+ */
+template <typename T>
+class MpscQueue {
+public:
+    MpscQueue() : head_(new Node()), tail_(head_.load(std::memory_order_relaxed)) {}
+
+    ~MpscQueue() {
+        Node* node = tail_;
+        while (node) {
+            Node* next = node->next.load(std::memory_order_relaxed);
+            delete node;
+            node = next;
+        }
+    }
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    /// Append an item; safe from any number of threads
+    void push(T value) {
+        Node* node = new Node(std::move(value));
+        Node* prev = head_.exchange(node, std::memory_order_acq_rel);
+        prev->next.store(node, std::memory_order_release);
+    }
+
+    /**
+     * @brief Remove the oldest item (consumer thread only)
+     * @return false if the queue is empty
+     */
+    bool pop(T& out) {
+        Node* dummy = tail_;
+        Node* next = dummy->next.load(std::memory_order_acquire);
+        if (!next) return false;
+        out = std::move(next->value);
+        tail_ = next;   // next becomes the new dummy
+        delete dummy;
+        return true;
+    }
+
+    /// True if nothing is visible to the consumer (consumer thread only)
+    bool empty() const {
+        return tail_->next.load(std::memory_order_acquire) == nullptr;
+    }
+
+private:
+    struct Node {
+        Node() = default;
+        explicit Node(T v) : value(std::move(v)) {}
+        T value{};
+        std::atomic<Node*> next{nullptr};
+    };
+
+    std::atomic<Node*> head_;   // last pushed node, shared by producers
+    Node* tail_;                // dummy node, owned by the consumer
+};
+
+} // namespace utils
+} // namespace atlas
+
+#endif // EVE_UTILS_MPSC_QUEUE_H
@@ -0,0 +1,172 @@
+#ifndef EVE_UTILS_PROFILER_H
+#define EVE_UTILS_PROFILER_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace atlas {
+namespace utils {
+
+/**
+ * @brief Log-linear latency histogram (HDR-style)
+ *
+ * Values are nanoseconds. Every power of two is split into 32 linear
+ * sub-buckets, so a value is reported within about 3% whatever its
+ * magnitude, from nanoseconds up to 2^40 ns (~18 minutes).
+ */
+class LatencyHistogram {
+public:
+    static constexpr int kSubBucketBits = 5;
+    static constexpr int kSubBuckets = 1 << kSubBucketBits;
+    static constexpr int kMaxBits = 40;
+    static constexpr size_t kBucketCount = (kMaxBits - kSubBucketBits + 1) * kSubBuckets;
+
+    LatencyHistogram();
+
+    void record(uint64_t ns);
+
+    /// Add another histogram's samples (merging threads)
+    void add(const LatencyHistogram& other);
+
+    /// Remove an earlier snapshot of the same histogram (windowing)
+    void subtract(const LatencyHistogram& earlier);
+
+    /// Value at quantile q in [0, 1], in nanoseconds
+    uint64_t percentile(double q) const;
+
+    uint64_t count() const { return count_; }
+    uint64_t sum() const { return sum_; }
+    uint64_t max() const { return max_; }
+    double meanNs() const { return count_ ? static_cast<double>(sum_) / count_ : 0.0; }
+
+    static size_t bucketIndex(uint64_t ns);
+    static uint64_t bucketLow(size_t index);
+    static uint64_t bucketHigh(size_t index);
+
+private:
+    friend class Profiler;
+
+    std::vector<uint64_t> counts_;
+    uint64_t count_ = 0;
+    uint64_t sum_ = 0;
+    uint64_t max_ = 0;
+};
+
+/**
+ * @brief Hierarchical scoped-timer profiler
+ *
+ * Scopes form a tree by nesting: a ProfileScope opened while another is
+ * active on the same thread becomes its child ("tick/session/encode").
+ * Each thread records into its own histograms with relaxed atomic
+ * stores, so timing a scope takes no lock. collect() merges all threads
+ * on demand; readers may see the newest samples slightly late.
+ *
+ * Scope registration takes a mutex on first use only; ProfileScope
+ * caches ids per thread.
+ */
+class Profiler {
+public:
+    static constexpr int kMaxScopes = 256;
+    static constexpr int kNoScope = -1;
+
+    struct ScopeStats {
+        int id = kNoScope;
+        std::string path;           // names from the root, joined by '/'
+        int depth = 0;
+        LatencyHistogram histogram;
+    };
+
+    static Profiler& instance();
+
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+
+    /// Id of the scope called name under parent; registered on first use
+    int scope(int parent, const std::string& name);
+
+    /// Record a sample for a scope on the calling thread
+    void record(int scope, uint64_t ns);
+
+    /// Innermost scope open on the calling thread (kNoScope at the top)
+    static int current();
+
+    /// Every scope's samples merged over all threads, in tree order
+    std::vector<ScopeStats> collect() const;
+
+    size_t getScopeCount() const { return scope_count_.load(std::memory_order_acquire); }
+
+private:
+    friend class ProfileScope;
+
+    struct Node {
+        int parent = kNoScope;
+        std::string name;
+        std::string path;
+        int depth = 0;
+    };
+
+    // One thread's histogram for one scope. Only the owning thread
+    // writes, so plain load + store replaces read-modify-write.
+    struct AtomicHistogram {
+        std::array<std::atomic<uint64_t>, LatencyHistogram::kBucketCount> counts{};
+        std::atomic<uint64_t> count{0};
+        std::atomic<uint64_t> sum{0};
+        std::atomic<uint64_t> max{0};
+    };
+
+    struct Shard {
+        std::array<std::atomic<AtomicHistogram*>, kMaxScopes> scopes{};
+        std::vector<std::unique_ptr<AtomicHistogram>> owned;
+    };
+
+    Profiler() = default;
+
+    Shard& localShard();
+    static void setCurrent(int scope);
+
+    mutable std::mutex mutex_;                    // nodes_ and shards_
+    std::vector<Node> nodes_;
+    std::atomic<size_t> scope_count_{0};
+    std::vector<std::unique_ptr<Shard>> shards_;
+    std::vector<Shard*> free_shards_;             // left by exited threads
+};
+
+/**
+ * @brief Times the enclosing block into a Profiler scope
+ *
+ * @code
+ *   utils::ProfileScope scope("encode");
+ * @endcode
+ *
+ * The name must outlive the program (a string literal); ids are cached
+ * by its address.
+ */
+class ProfileScope {
+public:
+    explicit ProfileScope(const char* name);
+
+    /// Time a scope registered up front with Profiler::scope()
+    explicit ProfileScope(int scope);
+
+    ~ProfileScope();
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    int scope_;
+    int parent_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+} // namespace utils
+} // namespace atlas
+
+#endif // EVE_UTILS_PROFILER_H
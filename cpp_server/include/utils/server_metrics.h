@@ -5,6 +5,9 @@
 #include <chrono>
 #include <mutex>
 #include <cstdint>
+#include <vector>
+#include "utils/profiler.h"
+#include "utils/tick_scheduler.h"
 
 namespace atlas {
 namespace utils {
@@ -16,6 +19,9 @@ namespace utils {
  * Call `recordTickStart()` and `recordTickEnd()` around the
  * main-loop body, and `logSummary()` periodically for a
  * human-readable status line.
+ *
+ * Per-phase latency comes from the utils::Profiler scopes; the
+ * profile methods report them over the same window as the tick stats.
  */
 class ServerMetrics {
 public:
@@ -34,6 +40,24 @@ public:
     /// Total number of ticks recorded
     uint64_t getTotalTicks() const;
 
+    /// Latest schedule counters from the main loop's TickScheduler
+    void setScheduleStats(const TickScheduler::Stats& stats);
+    TickScheduler::Stats getScheduleStats() const;
+
+    // --- Autosave ---
+    struct SaveStats {
+        uint64_t saves = 0;
+        uint64_t failures = 0;
+        double last_tick_ms = 0.0;          // snapshot time on the tick thread
+        double max_tick_ms = 0.0;
+        double last_background_ms = 0.0;    // serialize + compress + write
+        uint64_t last_bytes = 0;
+    };
+
+    /// Record a finished autosave; tick_ms is the part the tick waited for
+    void recordSave(double tick_ms, double background_ms, uint64_t bytes, bool ok);
+    SaveStats getSaveStats() const;
+
     // --- Counters ---
     void setEntityCount(int count);
     void setPlayerCount(int count);
@@ -53,6 +77,11 @@ public:
      *
      * Example:
      *   "[Metrics] tick avg=2.13ms min=1.80ms max=4.21ms | entities=42 players=3 | uptime 0d 1h 5m 30s | ticks=113400"
+     *
+     * Once schedule stats are set, the line ends with
+     *   " | overruns=2 late=1 skipped=0 tidi=1.00"
+     * and once a save has finished with
+     *   " | saves=3 save_tick=0.41ms save_bg=12.70ms"
      */
     std::string summary() const;
 
@@ -67,7 +96,28 @@ public:
     /// Reset tick-timing accumulators (keeps uptime & total tick count)
     void resetWindow();
 
+    // --- Profiler scopes ---
+    /// Profiler scopes over the current window, in tree order
+    std::vector<Profiler::ScopeStats> getProfile() const;
+
+    /// Indented per-scope table (count, p50, p99, p999, max in ms)
+    std::string profileReport() const;
+
+    /**
+     * @brief All metrics in the Prometheus text exposition format
+     *
+     * Scope quantiles cover the current window; _count and _sum are
+     * cumulative.
+     */
+    std::string scrapeText() const;
+
+    /// Write scrapeText() to path atomically (temp file + rename)
+    bool writeScrapeFile(const std::string& path) const;
+
 private:
+    /// Turn cumulative scope stats into stats over the current window
+    void subtractBaseline(std::vector<Profiler::ScopeStats>& profile) const;
+
     // Tick timing – current window
     double tick_sum_ms_ = 0.0;
     double tick_max_ms_ = 0.0;
@@ -82,6 +132,14 @@ private:
     int entity_count_ = 0;
     int player_count_ = 0;
 
+    TickScheduler::Stats schedule_;
+    bool has_schedule_ = false;
+
+    SaveStats save_;
+
+    // Profiler state at the start of the window, indexed by scope id
+    std::vector<LatencyHistogram> profile_baseline_;
+
     mutable std::mutex mutex_;
 };
 
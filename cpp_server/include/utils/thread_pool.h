@@ -0,0 +1,102 @@
+#ifndef EVE_UTILS_THREAD_POOL_H
+#define EVE_UTILS_THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace atlas {
+namespace utils {
+
+/**
+ * @brief Fixed-size work-stealing thread pool
+ *
+ * Each worker owns a task deque. Tasks submitted from a worker go to
+ * that worker's deque (popped LIFO for cache locality); tasks submitted
+ * from other threads are spread round-robin. Idle workers steal from
+ * the opposite end of other workers' deques.
+ *
+ * Waiting is done through TaskGroup, whose wait() executes pending
+ * tasks on the calling thread, so nested parallel work cannot deadlock
+ * the pool.
+ */
+class ThreadPool {
+public:
+    using Task = std::function<void()>;
+
+    explicit ThreadPool(size_t worker_count);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    size_t getWorkerCount() const { return workers_.size(); }
+
+    /// Queue a task for execution on some worker
+    void submit(Task task);
+
+    /**
+     * @brief Run one queued task on the calling thread, if any
+     * @return true if a task was executed
+     */
+    bool runPendingTask();
+
+private:
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    void workerLoop(size_t index);
+    bool popLocal(size_t index, Task& out);
+    bool steal(size_t thief, Task& out);
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues_;
+    std::vector<std::thread> workers_;
+
+    std::mutex wake_mutex_;
+    std::condition_variable wake_cv_;
+    std::atomic<size_t> pending_{0};
+    std::atomic<size_t> next_queue_{0};
+    std::atomic<bool> stopping_{false};
+};
+
+/**
+ * @brief Set of tasks that can be waited on together
+ *
+ * With a null pool every task runs inline inside run(). The first
+ * exception thrown by a task is rethrown from wait().
+ */
+class TaskGroup {
+public:
+    explicit TaskGroup(ThreadPool* pool) : pool_(pool) {}
+    ~TaskGroup() { drain(); }
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    void run(ThreadPool::Task task);
+
+    /// Block until every task has finished, helping to execute queued work
+    void wait();
+
+private:
+    void drain();
+
+    ThreadPool* pool_;
+    std::atomic<size_t> outstanding_{0};
+    std::mutex error_mutex_;
+    std::exception_ptr error_;
+};
+
+} // namespace utils
+} // namespace atlas
+
+#endif // EVE_UTILS_THREAD_POOL_H
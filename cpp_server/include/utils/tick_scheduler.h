@@ -0,0 +1,119 @@
+#ifndef EVE_TICK_SCHEDULER_H
+#define EVE_TICK_SCHEDULER_H
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace atlas {
+namespace utils {
+
+/**
+ * @brief Fixed-timestep tick scheduler for the server main loop
+ *
+ * Ticks are due on an absolute grid (start + n * period), so sleep
+ * inaccuracy and varying tick cost never accumulate into drift. Each wait
+ * sleeps with sleep_until() to shortly before the deadline and spins the
+ * rest, which keeps tick starts within a few microseconds of schedule.
+ * Every tick advances the simulation by the same fixed step.
+ *
+ * When ticks fall behind by a full period or more, the catch-up policy
+ * decides what happens to the missed ticks:
+ * - Skip:    drop them and continue on the original grid
+ * - CatchUp: run up to max_catch_up_ticks of them back to back, drop the rest
+ * - Dilate:  drop nothing and move the grid; the simulation runs slower
+ *            than real time (see Stats::dilation)
+ *
+ * Lower-priority work (autosave, background simulation) can ask
+ * hasBudget() whether it fits in what is left of the current tick.
+ */
+class TickScheduler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    enum class CatchUpPolicy { Skip, CatchUp, Dilate };
+
+    struct Settings {
+        double tick_rate = 30.0;                  // ticks per second
+        CatchUpPolicy policy = CatchUpPolicy::CatchUp;
+        int max_catch_up_ticks = 5;               // CatchUp only
+        std::chrono::microseconds spin{500};      // busy-wait before each deadline
+    };
+
+    struct Tick {
+        uint64_t number = 0;        // ticks simulated before this one
+        float delta = 0.0f;         // seconds to advance; always the fixed step
+        double lateness_ms = 0.0;   // start time past the tick's deadline
+        bool catching_up = false;   // runs back to back to recover missed ticks
+    };
+
+    struct Stats {
+        uint64_t ticks = 0;
+        uint64_t overruns = 0;         // ticks whose work took longer than a period
+        uint64_t late_ticks = 0;       // ticks started a full period or more late
+        uint64_t skipped_ticks = 0;    // missed ticks never simulated
+        uint64_t catch_up_ticks = 0;   // ticks run back to back
+        double max_lateness_ms = 0.0;
+        double last_work_ms = 0.0;
+        double dilation = 1.0;         // simulated time / real time, smoothed
+    };
+
+    TickScheduler();
+    explicit TickScheduler(const Settings& settings);
+
+    /// Start the schedule; the first tick is due at now
+    void start(Clock::time_point now = Clock::now());
+
+    /// Sleep until the next tick is due, then begin it
+    Tick waitNext();
+
+    /**
+     * @brief Begin the next tick at now without waiting
+     *
+     * Applies the catch-up policy if the tick is a full period late.
+     * waitNext() calls this once the deadline is reached.
+     */
+    Tick beginTick(Clock::time_point now);
+
+    /// End the current tick's work; counts an overrun if it took over a period
+    void endTick(Clock::time_point now = Clock::now());
+
+    /// Deadline of the next tick
+    Clock::time_point nextDeadline() const { return deadline_; }
+
+    /// Time left for deferrable work before the next deadline (ms; may be negative)
+    double remainingBudgetMs(Clock::time_point now = Clock::now()) const;
+
+    /**
+     * @brief Whether work estimated at estimated_ms fits in this tick
+     *
+     * Always false while catching up on missed ticks.
+     */
+    bool hasBudget(double estimated_ms, Clock::time_point now = Clock::now()) const;
+
+    float getStepSeconds() const { return step_seconds_; }
+    double getPeriodMs() const;
+    const Settings& getSettings() const { return settings_; }
+    const Stats& getStats() const { return stats_; }
+
+    /// "skip", "catch_up" or "dilate"
+    static const char* policyName(CatchUpPolicy policy);
+    static bool parsePolicy(const std::string& name, CatchUpPolicy& out);
+
+private:
+    Settings settings_;
+    Clock::duration period_;
+    float step_seconds_;
+
+    Clock::time_point deadline_;        // when the next tick is due
+    Clock::time_point tick_begin_;      // when the current tick began
+    Clock::time_point last_begin_;
+    bool catching_up_ = false;
+    bool started_ = false;
+    Stats stats_;
+};
+
+} // namespace utils
+} // namespace atlas
+
+#endif // EVE_TICK_SCHEDULER_H
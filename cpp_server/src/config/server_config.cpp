@@ -39,11 +39,15 @@ bool ServerConfig::loadFromFile(const std::string& filepath) {
         if (key == "host") host = value;
         else if (key == "port") port = static_cast<uint16_t>(std::stoi(value));
         else if (key == "max_connections") max_connections = std::stoi(value);
+        else if (key == "network_io_threads") network_io_threads = std::stoi(value);
         else if (key == "server_name") server_name = value;
         else if (key == "server_description") server_description = value;
         else if (key == "persistent_world") persistent_world = (value == "true");
         else if (key == "auto_save") auto_save = (value == "true");
         else if (key == "save_interval_seconds") save_interval_seconds = std::stoi(value);
+        else if (key == "save_format") save_format = value;
+        else if (key == "save_journal") save_journal = (value == "true");
+        else if (key == "journal_compact_percent") journal_compact_percent = std::stoi(value);
         else if (key == "use_whitelist") use_whitelist = (value == "true");
         else if (key == "public_server") public_server = (value == "true");
         else if (key == "password") password = value;
@@ -52,10 +56,29 @@ bool ServerConfig::loadFromFile(const std::string& filepath) {
         else if (key == "steam_authentication") steam_authentication = (value == "true");
         else if (key == "steam_server_browser") steam_server_browser = (value == "true");
         else if (key == "tick_rate") tick_rate = std::stof(value);
+        else if (key == "tick_catch_up") tick_catch_up = value;
+        else if (key == "tick_max_catch_up") tick_max_catch_up = std::stoi(value);
+        else if (key == "tick_spin_us") tick_spin_us = std::stoi(value);
         else if (key == "max_entities") max_entities = std::stoi(value);
+        else if (key == "system_worker_threads") system_worker_threads = std::stoi(value);
+        else if (key == "solar_system") solar_system = value;
+        else if (key == "interest_near_range") interest_near_range = std::stof(value);
+        else if (key == "interest_far_range") interest_far_range = std::stof(value);
+        else if (key == "interest_far_interval") interest_far_interval = std::stoi(value);
+        else if (key == "ai_near_range") ai_near_range = std::stof(value);
+        else if (key == "ai_think_interval") ai_think_interval = std::stoi(value);
+        else if (key == "ai_think_budget_turns") ai_think_budget_turns = std::stoi(value);
         else if (key == "data_path") data_path = value;
         else if (key == "save_path") save_path = value;
         else if (key == "log_path") log_path = value;
+        else if (key == "log_async") log_async = (value == "true");
+        else if (key == "log_flush_interval_ms") log_flush_interval_ms = std::stoi(value);
+        else if (key == "log_queue_size") log_queue_size = std::stoi(value);
+        else if (key == "log_max_file_mb") log_max_file_mb = std::stoi(value);
+        else if (key == "log_max_files") log_max_files = std::stoi(value);
+        else if (key == "metrics_file") metrics_file = value;
+        else if (key == "metrics_interval_seconds") metrics_interval_seconds = std::stoi(value);
+        else if (key == "tick_recording") tick_recording = value;
     }
     
     file.close();
@@ -72,11 +95,15 @@ bool ServerConfig::saveToFile(const std::string& filepath) const {
     file << "  \"host\": \"" << host << "\"," << std::endl;
     file << "  \"port\": " << port << "," << std::endl;
     file << "  \"max_connections\": " << max_connections << "," << std::endl;
+    file << "  \"network_io_threads\": " << network_io_threads << "," << std::endl;
     file << "  \"server_name\": \"" << server_name << "\"," << std::endl;
     file << "  \"server_description\": \"" << server_description << "\"," << std::endl;
     file << "  \"persistent_world\": " << (persistent_world ? "true" : "false") << "," << std::endl;
     file << "  \"auto_save\": " << (auto_save ? "true" : "false") << "," << std::endl;
     file << "  \"save_interval_seconds\": " << save_interval_seconds << "," << std::endl;
+    file << "  \"save_format\": \"" << save_format << "\"," << std::endl;
+    file << "  \"save_journal\": " << (save_journal ? "true" : "false") << "," << std::endl;
+    file << "  \"journal_compact_percent\": " << journal_compact_percent << "," << std::endl;
     file << "  \"use_whitelist\": " << (use_whitelist ? "true" : "false") << "," << std::endl;
     file << "  \"public_server\": " << (public_server ? "true" : "false") << "," << std::endl;
     file << "  \"password\": \"" << password << "\"," << std::endl;
@@ -85,10 +112,29 @@ bool ServerConfig::saveToFile(const std::string& filepath) const {
     file << "  \"steam_authentication\": " << (steam_authentication ? "true" : "false") << "," << std::endl;
     file << "  \"steam_server_browser\": " << (steam_server_browser ? "true" : "false") << "," << std::endl;
     file << "  \"tick_rate\": " << tick_rate << "," << std::endl;
+    file << "  \"tick_catch_up\": \"" << tick_catch_up << "\"," << std::endl;
+    file << "  \"tick_max_catch_up\": " << tick_max_catch_up << "," << std::endl;
+    file << "  \"tick_spin_us\": " << tick_spin_us << "," << std::endl;
     file << "  \"max_entities\": " << max_entities << "," << std::endl;
+    file << "  \"system_worker_threads\": " << system_worker_threads << "," << std::endl;
+    file << "  \"solar_system\": \"" << solar_system << "\"," << std::endl;
+    file << "  \"interest_near_range\": " << interest_near_range << "," << std::endl;
+    file << "  \"interest_far_range\": " << interest_far_range << "," << std::endl;
+    file << "  \"interest_far_interval\": " << interest_far_interval << "," << std::endl;
+    file << "  \"ai_near_range\": " << ai_near_range << "," << std::endl;
+    file << "  \"ai_think_interval\": " << ai_think_interval << "," << std::endl;
+    file << "  \"ai_think_budget_turns\": " << ai_think_budget_turns << "," << std::endl;
     file << "  \"data_path\": \"" << data_path << "\"," << std::endl;
     file << "  \"save_path\": \"" << save_path << "\"," << std::endl;
-    file << "  \"log_path\": \"" << log_path << "\"" << std::endl;
+    file << "  \"log_path\": \"" << log_path << "\"," << std::endl;
+    file << "  \"log_async\": " << (log_async ? "true" : "false") << "," << std::endl;
+    file << "  \"log_flush_interval_ms\": " << log_flush_interval_ms << "," << std::endl;
+    file << "  \"log_queue_size\": " << log_queue_size << "," << std::endl;
+    file << "  \"log_max_file_mb\": " << log_max_file_mb << "," << std::endl;
+    file << "  \"log_max_files\": " << log_max_files << "," << std::endl;
+    file << "  \"metrics_file\": \"" << metrics_file << "\"," << std::endl;
+    file << "  \"metrics_interval_seconds\": " << metrics_interval_seconds << "," << std::endl;
+    file << "  \"tick_recording\": \"" << tick_recording << "\"" << std::endl;
     file << "}" << std::endl;
     
     file.close();
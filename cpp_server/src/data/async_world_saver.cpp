@@ -0,0 +1,147 @@
+#include "data/async_world_saver.h"
+#include "data/world_binary_format.h"
+#include "utils/profiler.h"
+#include <chrono>
+#include <utility>
+
+namespace atlas {
+namespace data {
+
+namespace {
+
+double msSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+AsyncWorldSaver::AsyncWorldSaver(const WorldPersistence& persistence)
+    : persistence_(persistence) {}
+
+AsyncWorldSaver::~AsyncWorldSaver() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    cv_.notify_all();
+    if (worker_.joinable()) worker_.join();
+}
+
+bool AsyncWorldSaver::begin(const ecs::World* world, const std::string& filepath,
+                            SaveFormat format) {
+    return start(world, filepath, format, nullptr);
+}
+
+bool AsyncWorldSaver::begin(const ecs::World* world, WorldJournal& journal) {
+    return start(world, journal.getJournalPath(), SaveFormat::Json, &journal);
+}
+
+bool AsyncWorldSaver::start(const ecs::World* world, const std::string& filepath,
+                            SaveFormat format, WorldJournal* journal) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (busy_) return false;
+    }
+
+    // The only part that touches the live world
+    auto start = std::chrono::steady_clock::now();
+    auto snapshot = persistence_.snapshotWorld(world);
+
+    Result result;
+    result.filepath = filepath;
+    result.entities = snapshot->getEntityCount();
+    result.snapshot_ms = msSince(start);
+    result.journaled = journal != nullptr;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        job_ = std::move(snapshot);
+        journal_ = journal;
+        format_ = format;
+        current_ = std::move(result);
+        busy_ = true;
+        has_result_ = false;
+        if (!worker_.joinable()) {
+            worker_ = std::thread(&AsyncWorldSaver::workerLoop, this);
+        }
+    }
+    cv_.notify_all();
+    return true;
+}
+
+bool AsyncWorldSaver::isBusy() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return busy_;
+}
+
+bool AsyncWorldSaver::poll(Result& out) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (busy_ || !has_result_) return false;
+    out = current_;
+    has_result_ = false;
+    return true;
+}
+
+void AsyncWorldSaver::wait() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [this] { return !busy_; });
+}
+
+void AsyncWorldSaver::workerLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        cv_.wait(lock, [this] { return stop_ || job_; });
+        if (!job_) return;      // stopping with nothing pending
+
+        auto snapshot = std::move(job_);
+        WorldJournal* journal = journal_;
+        SaveFormat format = format_;
+        std::string filepath = current_.filepath;
+        lock.unlock();
+
+        auto start = std::chrono::steady_clock::now();
+        bool ok;
+        size_t bytes;
+        WorldJournal::CommitStats commit;
+        if (journal) {
+            utils::ProfileScope autosave("autosave");
+            commit = journal->commit(*snapshot);
+            snapshot.reset();
+            ok = commit.ok;
+            bytes = commit.bytes;
+        } else {
+            utils::ProfileScope autosave("autosave");
+            std::string data;
+            {
+                utils::ProfileScope scope("serialize");
+                data = format == SaveFormat::Binary
+                           ? WorldBinaryFormat(persistence_).encodeSnapshot(*snapshot)
+                           : persistence_.serializeSnapshot(*snapshot);
+            }
+            snapshot.reset();
+            if (format == SaveFormat::Compressed) {
+                utils::ProfileScope scope("compress");
+                data = WorldPersistence::encodeCompressed(data);
+            }
+            utils::ProfileScope scope("write");
+            ok = WorldPersistence::writeFileAtomic(filepath, data);
+            bytes = data.size();
+        }
+        double elapsed = msSince(start);
+
+        lock.lock();
+        current_.ok = ok;
+        current_.bytes = ok ? bytes : 0;
+        current_.background_ms = elapsed;
+        current_.compacted = commit.compacted;
+        current_.upserts = commit.upserts;
+        current_.removals = commit.removals;
+        busy_ = false;
+        has_result_ = true;
+        cv_.notify_all();
+    }
+}
+
+} // namespace data
+} // namespace atlas
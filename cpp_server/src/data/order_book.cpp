@@ -0,0 +1,167 @@
+#include "data/order_book.h"
+#include <algorithm>
+
+namespace atlas {
+namespace data {
+
+OrderBook::OrderId OrderBook::add(Order order, float duration) {
+    if (order.quantity_remaining <= 0) return 0;
+    if (order.order_id == 0) {
+        order.order_id = next_id_;
+    } else if (index_.count(order.order_id)) {
+        return 0;
+    }
+    next_id_ = std::max(next_id_, order.order_id + 1);
+    order.expires_at = duration < 0.0f ? -1.0 : now_ + duration;
+
+    uint32_t slot;
+    if (!free_slots_.empty()) {
+        slot = free_slots_.back();
+        free_slots_.pop_back();
+    } else {
+        slot = static_cast<uint32_t>(slots_.size());
+        slots_.emplace_back();
+    }
+    Slot& s = slots_[slot];
+    s.order = std::move(order);
+    s.live = true;
+    index_.emplace(s.order.order_id, slot);
+    link(*levelOf(s.order), slot);
+
+    if (s.order.expires_at >= 0.0) {
+        expiries_.push_back({s.order.expires_at, s.order.order_id});
+        std::push_heap(expiries_.begin(), expiries_.end(), std::greater<Expiry>());
+    }
+    return s.order.order_id;
+}
+
+bool OrderBook::cancel(OrderId id, Order* removed) {
+    auto it = index_.find(id);
+    if (it == index_.end()) return false;
+    if (removed) *removed = slots_[it->second].order;
+    remove(it->second);
+    return true;
+}
+
+int OrderBook::fill(OrderId id, int quantity) {
+    auto it = index_.find(id);
+    if (it == index_.end() || quantity <= 0) return 0;
+    Order& order = slots_[it->second].order;
+    int taken = std::min(quantity, order.quantity_remaining);
+    order.quantity_remaining -= taken;
+    if (order.quantity_remaining <= 0) {
+        remove(it->second);
+    }
+    return taken;
+}
+
+const OrderBook::Order* OrderBook::find(OrderId id) const {
+    auto it = index_.find(id);
+    return it == index_.end() ? nullptr : &slots_[it->second].order;
+}
+
+const OrderBook::Order* OrderBook::best(const std::string& item_id, bool buy_side) const {
+    auto it = items_.find(item_id);
+    if (it == items_.end()) return nullptr;
+    if (buy_side) {
+        const auto& bids = it->second.bids;
+        return bids.empty() ? nullptr : &slots_[bids.begin()->second.head].order;
+    }
+    const auto& asks = it->second.asks;
+    return asks.empty() ? nullptr : &slots_[asks.begin()->second.head].order;
+}
+
+size_t OrderBook::advance(double delta_seconds,
+                          const std::function<void(const Order&)>& on_expire) {
+    now_ += delta_seconds;
+    size_t expired = 0;
+    while (!expiries_.empty() && expiries_.front().at <= now_) {
+        Expiry due = expiries_.front();
+        std::pop_heap(expiries_.begin(), expiries_.end(), std::greater<Expiry>());
+        expiries_.pop_back();
+
+        auto it = index_.find(due.id);
+        if (it == index_.end() || slots_[it->second].order.expires_at != due.at) {
+            // Filled or cancelled since it was queued
+            if (stale_expiries_ > 0) --stale_expiries_;
+            continue;
+        }
+        Order& order = slots_[it->second].order;
+        if (on_expire) on_expire(order);
+        order.expires_at = -1.0;    // its heap entry is gone already
+        remove(it->second);
+        ++expired;
+    }
+    return expired;
+}
+
+float OrderBook::durationRemaining(const Order& order) const {
+    if (order.expires_at < 0.0) return -1.0f;
+    return static_cast<float>(std::max(0.0, order.expires_at - now_));
+}
+
+OrderBook::Level* OrderBook::levelOf(const Order& order) {
+    ItemBook& item = items_[order.item_id];
+    if (order.is_buy_order) return &item.bids[order.price_per_unit];
+    return &item.asks[order.price_per_unit];
+}
+
+void OrderBook::link(Level& level, uint32_t slot) {
+    // Keep the level sorted by id; a new order goes to the tail, an older
+    // one being restored from a save walks back to its place
+    OrderId id = slots_[slot].order.order_id;
+    uint32_t after = level.tail;
+    while (after != kNone && slots_[after].order.order_id > id) {
+        after = slots_[after].prev;
+    }
+    uint32_t before = after == kNone ? level.head : slots_[after].next;
+    slots_[slot].prev = after;
+    slots_[slot].next = before;
+    if (after == kNone) level.head = slot; else slots_[after].next = slot;
+    if (before == kNone) level.tail = slot; else slots_[before].prev = slot;
+}
+
+void OrderBook::remove(uint32_t slot) {
+    Slot& s = slots_[slot];
+    auto item_it = items_.find(s.order.item_id);
+    ItemBook& item = item_it->second;
+
+    auto unlink = [&](Level& level) {
+        if (s.prev == kNone) level.head = s.next; else slots_[s.prev].next = s.next;
+        if (s.next == kNone) level.tail = s.prev; else slots_[s.next].prev = s.prev;
+        return level.head == kNone;
+    };
+    if (s.order.is_buy_order) {
+        auto level = item.bids.find(s.order.price_per_unit);
+        if (unlink(level->second)) item.bids.erase(level);
+    } else {
+        auto level = item.asks.find(s.order.price_per_unit);
+        if (unlink(level->second)) item.asks.erase(level);
+    }
+    if (item.bids.empty() && item.asks.empty()) items_.erase(item_it);
+
+    if (s.order.expires_at >= 0.0) ++stale_expiries_;
+    index_.erase(s.order.order_id);
+    s.order = Order{};
+    s.prev = s.next = kNone;
+    s.live = false;
+    free_slots_.push_back(slot);
+
+    compactExpiries();
+}
+
+void OrderBook::compactExpiries() {
+    // Heavily cancelled books would otherwise keep a heap entry for every
+    // order ever placed
+    if (stale_expiries_ < 1024 || stale_expiries_ * 2 < expiries_.size()) return;
+    expiries_.erase(std::remove_if(expiries_.begin(), expiries_.end(),
+        [this](const Expiry& e) {
+            auto it = index_.find(e.id);
+            return it == index_.end() || slots_[it->second].order.expires_at != e.at;
+        }), expiries_.end());
+    std::make_heap(expiries_.begin(), expiries_.end(), std::greater<Expiry>());
+    stale_expiries_ = 0;
+}
+
+} // namespace data
+} // namespace atlas
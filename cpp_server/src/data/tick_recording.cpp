@@ -0,0 +1,237 @@
+#include "data/tick_recording.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+namespace atlas {
+namespace data {
+
+namespace {
+
+// Host byte order, like the .atlasb snapshot it carries
+constexpr char kMagic[8] = {'A', 'T', 'L', 'A', 'S', 'T', 'R', '\0'};
+constexpr char kTickRecord = 'T';
+constexpr char kCommandRecord = 'C';
+constexpr char kEndRecord = 'Z';
+
+template<typename T>
+void append(std::string& out, T value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// TickRecorder
+// ---------------------------------------------------------------------------
+
+TickRecorder::~TickRecorder() {
+    close();
+}
+
+bool TickRecorder::open(const std::string& filepath, const std::string& snapshot,
+                        const ecs::World::HandleLayout& layout) {
+    close();
+    file_ = std::fopen(filepath.c_str(), "wb");
+    if (!file_) {
+        std::cerr << "[TickRecorder] Cannot create " << filepath << std::endl;
+        return false;
+    }
+    ticks_ = commands_ = bytes_ = 0;
+    buffer_.clear();
+    buffer_.reserve(kFlushBytes * 2);
+    buffer_.append(kMagic, sizeof(kMagic));
+    append<uint32_t>(buffer_, kVersion);
+    append<uint32_t>(buffer_, 0);
+    append<uint64_t>(buffer_, snapshot.size());
+    buffer_.append(snapshot);
+    append<uint32_t>(buffer_, static_cast<uint32_t>(layout.generations.size()));
+    for (uint32_t generation : layout.generations) append<uint32_t>(buffer_, generation);
+    append<uint32_t>(buffer_, static_cast<uint32_t>(layout.free_slots.size()));
+    for (uint32_t slot : layout.free_slots) append<uint32_t>(buffer_, slot);
+    append<uint32_t>(buffer_, static_cast<uint32_t>(layout.entities.size()));
+    for (const auto& placement : layout.entities) {
+        const size_t id_size = std::min<size_t>(placement.id.size(), UINT16_MAX);
+        append<uint32_t>(buffer_, placement.index);
+        append<uint16_t>(buffer_, static_cast<uint16_t>(id_size));
+        buffer_.append(placement.id, 0, id_size);
+    }
+    flush();
+    return file_ != nullptr;
+}
+
+void TickRecorder::beginTick(uint64_t number, float delta) {
+    if (!file_) return;
+    buffer_.push_back(kTickRecord);
+    append<uint64_t>(buffer_, number);
+    append<float>(buffer_, delta);
+    ++ticks_;
+    if (buffer_.size() >= kFlushBytes) flush();
+}
+
+void TickRecorder::recordCommand(const RecordedCommand& command) {
+    if (!file_) return;
+    const std::string& address = command.client.address;
+    const size_t address_size = std::min<size_t>(address.size(), UINT16_MAX);
+    buffer_.push_back(kCommandRecord);
+    append<uint8_t>(buffer_, static_cast<uint8_t>(command.kind));
+    append<uint16_t>(buffer_, static_cast<uint16_t>(command.type));
+    append<int64_t>(buffer_, static_cast<int64_t>(command.client.socket));
+    append<uint16_t>(buffer_, command.client.port);
+    append<uint16_t>(buffer_, static_cast<uint16_t>(address_size));
+    buffer_.append(address, 0, address_size);
+    append<uint32_t>(buffer_, static_cast<uint32_t>(command.data.size()));
+    buffer_.append(command.data);
+    ++commands_;
+    if (buffer_.size() >= kFlushBytes) flush();
+}
+
+void TickRecorder::close() {
+    if (!file_) return;
+    buffer_.push_back(kEndRecord);
+    flush();
+    if (file_) {
+        std::fclose(file_);
+        file_ = nullptr;
+    }
+}
+
+void TickRecorder::flush() {
+    if (buffer_.empty()) return;
+    if (std::fwrite(buffer_.data(), 1, buffer_.size(), file_) != buffer_.size()) {
+        // Stop recording rather than leave a gap in the middle of the log
+        std::cerr << "[TickRecorder] Write failed, recording stopped" << std::endl;
+        std::fclose(file_);
+        file_ = nullptr;
+    } else {
+        std::fflush(file_);
+        bytes_ += buffer_.size();
+    }
+    buffer_.clear();
+}
+
+// ---------------------------------------------------------------------------
+// TickRecordingReader
+// ---------------------------------------------------------------------------
+
+template<typename T>
+bool TickRecordingReader::read(T& value) {
+    return static_cast<bool>(file_.read(reinterpret_cast<char*>(&value), sizeof(value)));
+}
+
+bool TickRecordingReader::readBytes(std::string& out, size_t size) {
+    out.resize(size);
+    return size == 0 || static_cast<bool>(file_.read(&out[0], static_cast<std::streamsize>(size)));
+}
+
+bool TickRecordingReader::open(const std::string& filepath) {
+    file_.open(filepath, std::ios::binary);
+    if (!file_) return false;
+
+    char magic[sizeof(kMagic)];
+    uint32_t version = 0, reserved = 0;
+    uint64_t snapshot_size = 0;
+    layout_ = ecs::World::HandleLayout();
+    if (!file_.read(magic, sizeof(magic)) || std::memcmp(magic, kMagic, sizeof(kMagic)) != 0 ||
+        !read(version) || version > TickRecorder::kVersion || !read(reserved) ||
+        !read(snapshot_size) || !readBytes(snapshot_, snapshot_size) ||
+        (version >= 2 && !readLayout())) {
+        file_.close();
+        return false;
+    }
+    has_tick_ = done_ = truncated_ = false;
+    return true;
+}
+
+bool TickRecordingReader::readLayout() {
+    // Counts are checked against what is left of the file before resizing
+    auto fits = [this](uint32_t count, size_t record_size) {
+        std::streampos here = file_.tellg();
+        file_.seekg(0, std::ios::end);
+        std::streamoff left = file_.tellg() - here;
+        file_.seekg(here);
+        return static_cast<uint64_t>(count) * record_size <= static_cast<uint64_t>(left);
+    };
+    uint32_t count = 0;
+    if (!read(count) || !fits(count, sizeof(uint32_t))) return false;
+    layout_.generations.resize(count);
+    for (auto& generation : layout_.generations) {
+        if (!read(generation)) return false;
+    }
+    if (!read(count) || !fits(count, sizeof(uint32_t))) return false;
+    layout_.free_slots.resize(count);
+    for (auto& slot : layout_.free_slots) {
+        if (!read(slot)) return false;
+    }
+    if (!read(count) || !fits(count, sizeof(uint32_t) + sizeof(uint16_t))) return false;
+    layout_.entities.resize(count);
+    for (auto& placement : layout_.entities) {
+        uint16_t id_size = 0;
+        if (!read(placement.index) || !read(id_size) || !readBytes(placement.id, id_size)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool TickRecordingReader::next(Tick& tick) {
+    if (done_ || !file_.is_open()) return false;
+
+    // Each tick's commands run until the next 'T' record or the end
+    while (true) {
+        char record = 0;
+        if (!file_.get(record)) {
+            truncated_ = true;
+            break;
+        }
+        if (record == kEndRecord) break;
+
+        if (record == kTickRecord) {
+            Tick started;
+            if (!read(started.number) || !read(started.delta)) {
+                truncated_ = true;
+                break;
+            }
+            if (has_tick_) {
+                tick = std::move(pending_);
+                pending_ = std::move(started);
+                return true;
+            }
+            pending_ = std::move(started);
+            has_tick_ = true;
+            continue;
+        }
+
+        if (record != kCommandRecord || !has_tick_) {
+            std::cerr << "[TickRecordingReader] Unexpected record, stopping" << std::endl;
+            truncated_ = true;
+            break;
+        }
+        RecordedCommand command;
+        uint8_t kind = 0;
+        uint16_t type = 0, address_size = 0;
+        int64_t socket = 0;
+        uint32_t data_size = 0;
+        if (!read(kind) || !read(type) || !read(socket) || !read(command.client.port) ||
+            !read(address_size) || !readBytes(command.client.address, address_size) ||
+            !read(data_size) || !readBytes(command.data, data_size)) {
+            truncated_ = true;
+            break;
+        }
+        command.kind = static_cast<RecordedCommand::Kind>(kind);
+        command.type = static_cast<network::MessageType>(type);
+        command.client.socket = static_cast<decltype(command.client.socket)>(socket);
+        pending_.commands.push_back(std::move(command));
+    }
+
+    // End of the recording (or a torn record): hand out the last tick with
+    // the commands read so far
+    done_ = true;
+    if (!has_tick_) return false;
+    tick = std::move(pending_);
+    has_tick_ = false;
+    return true;
+}
+
+} // namespace data
+} // namespace atlas
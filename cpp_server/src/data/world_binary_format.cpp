@@ -0,0 +1,733 @@
+#include "data/world_binary_format.h"
+#include "components/game_components.h"
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <type_traits>
+#include <unordered_map>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace atlas {
+namespace data {
+
+namespace {
+
+// ---------------------------------------------------------------------------
+// File layout
+// ---------------------------------------------------------------------------
+
+// Everything is stored in host byte order; all supported targets are
+// little-endian
+constexpr char kMagic[8] = {'A', 'T', 'L', 'A', 'S', 'W', 'B', '\0'};
+constexpr uint32_t kEntitySection = 1;      // record: id string
+constexpr uint32_t kJsonSection = 2;        // record: entity index, JSON string
+
+struct FileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t section_count;
+    uint64_t entity_count;
+    uint64_t journal_seq;
+    uint64_t string_table_offset;
+    uint64_t file_size;
+    uint32_t string_table_checksum;
+    uint32_t reserved;
+};
+
+struct SectionHeader {
+    uint32_t tag;
+    uint32_t record_size;
+    uint64_t count;
+    uint64_t offset;
+    uint32_t checksum;          // FNV-1a over the records
+    uint32_t reserved;
+};
+
+static_assert(sizeof(FileHeader) == 56, "FileHeader layout is part of the format");
+static_assert(sizeof(SectionHeader) == 32, "SectionHeader layout is part of the format");
+
+uint32_t fnv1a(const char* data, size_t size) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+size_t align8(size_t n) { return (n + 7) & ~size_t(7); }
+
+template<typename P>
+void put(std::string& out, const P& value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(P));
+}
+
+template<typename P>
+P get(const char* p) {
+    P value;
+    std::memcpy(&value, p, sizeof(P));
+    return value;
+}
+
+// ---------------------------------------------------------------------------
+// Component layouts
+// ---------------------------------------------------------------------------
+
+// fields() visits exactly what serializeEntity() writes for the component,
+// in a fixed order. Tags are part of the format: never reuse one.
+template<typename T> struct Layout;
+
+template<> struct Layout<components::Position> {
+    static constexpr uint32_t kTag = 100;
+    template<typename C, typename F> static void fields(C& c, F&& f) {
+        f(c.x); f(c.y); f(c.z); f(c.rotation);
+    }
+};
+
+template<> struct Layout<components::Velocity> {
+    static constexpr uint32_t kTag = 101;
+    template<typename C, typename F> static void fields(C& c, F&& f) {
+        f(c.vx); f(c.vy); f(c.vz); f(c.angular_velocity); f(c.max_speed);
+    }
+};
+
+template<> struct Layout<components::Health> {
+    static constexpr uint32_t kTag = 102;
+    template<typename C, typename F> static void fields(C& c, F&& f) {
+        f(c.hull_hp); f(c.hull_max); f(c.armor_hp); f(c.armor_max);
+        f(c.shield_hp); f(c.shield_max); f(c.shield_recharge_rate);
+        f(c.hull_em_resist); f(c.hull_thermal_resist);
+        f(c.hull_kinetic_resist); f(c.hull_explosive_resist);
+        f(c.armor_em_resist); f(c.armor_thermal_resist);
+        f(c.armor_kinetic_resist); f(c.armor_explosive_resist);
+        f(c.shield_em_resist); f(c.shield_thermal_resist);
+        f(c.shield_kinetic_resist); f(c.shield_explosive_resist);
+    }
+};
+
+template<> struct Layout<components::Capacitor> {
+    static constexpr uint32_t kTag = 103;
+    template<typename C, typename F> static void fields(C& c, F&& f) {
+        f(c.capacitor); f(c.capacitor_max); f(c.recharge_rate);
+    }
+};
+
+template<> struct Layout<components::Ship> {
+    static constexpr uint32_t kTag = 104;
+    template<typename C, typename F> static void fields(C& c, F&& f) {
+        f(c.ship_type); f(c.ship_class); f(c.ship_name); f(c.race);
+        f(c.cpu); f(c.cpu_max); f(c.powergrid); f(c.powergrid_max);
+        f(c.signature_radius); f(c.scan_resolution);
+        f(c.max_locked_targets); f(c.max_targeting_range);
+    }
+};
+
+template<> struct Layout<components::Faction> {
+    static constexpr uint32_t kTag = 105;
+    template<typename C, typename F> static void fields(C& c, F&& f) {
+        f(c.faction_name);
+    }
+};
+
+template<> struct Layout<components::AI> {
+    static constexpr uint32_t kTag = 106;
+    template<typename C, typename F> static void fields(C& c, F&& f) {
+        f(c.behavior); f(c.state); f(c.target_entity_id);
+        f(c.orbit_distance); f(c.awareness_range);
+    }
+};
+
+template<> struct Layout<components::Weapon> {
+    static constexpr uint32_t kTag = 107;
+    template<typename C, typename F> static void fields(C& c, F&& f) {
+        f(c.weapon_type); f(c.damage_type); f(c.damage);
+        f(c.optimal_range); f(c.falloff_range); f(c.tracking_speed);
+        f(c.rate_of_fire); f(c.capacitor_cost); f(c.ammo_type); f(c.ammo_count);
+    }
+};
+
+template<> struct Layout<components::Player> {
+    static constexpr uint32_t kTag = 108;
+    template<typename C, typename F> static void fields(C& c, F&& f) {
+        f(c.player_id); f(c.character_name); f(c.isk); f(c.corporation);
+    }
+};
+
+template<> struct Layout<components::FleetMembership> {
+    static constexpr uint32_t kTag = 109;
+    template<typename C, typename F> static void fields(C& c, F&& f) {
+        f(c.fleet_id); f(c.role); f(c.squad_id); f(c.wing_id);
+    }
+};
+
+template<> struct Layout<components::Station> {
+    static constexpr uint32_t kTag = 110;
+    template<typename C, typename F> static void fields(C& c, F&& f) {
+        f(c.station_name); f(c.docking_range); f(c.repair_cost_per_hp); f(c.docked_count);
+    }
+};
+
+template<> struct Layout<components::Docked> {
+    static constexpr uint32_t kTag = 111;
+    template<typename C, typename F> static void fields(C& c, F&& f) {
+        f(c.station_id);
+    }
+};
+
+template<> struct Layout<components::Wreck> {
+    static constexpr uint32_t kTag = 112;
+    template<typename C, typename F> static void fields(C& c, F&& f) {
+        f(c.source_entity_id); f(c.lifetime_remaining); f(c.salvaged);
+    }
+};
+
+template<> struct Layout<components::LODPriority> {
+    static constexpr uint32_t kTag = 113;
+    template<typename C, typename F> static void fields(C& c, F&& f) {
+        f(c.priority); f(c.force_visible); f(c.impostor_distance);
+    }
+};
+
+template<> struct Layout<components::WarpProfile> {
+    static constexpr uint32_t kTag = 114;
+    template<typename C, typename F> static void fields(C& c, F&& f) {
+        f(c.warp_speed); f(c.mass_norm); f(c.intensity); f(c.comfort_scale);
+    }
+};
+
+template<> struct Layout<components::SystemLocation> {
+    static constexpr uint32_t kTag = 115;
+    template<typename C, typename F> static void fields(C& c, F&& f) {
+        f(c.system_id);
+    }
+};
+
+template<typename... Ts> struct TypeList {};
+
+using ColumnTypes = TypeList<
+    components::Position, components::Velocity, components::Health,
+    components::Capacitor, components::Ship, components::Faction,
+    components::AI, components::Weapon, components::Player,
+    components::FleetMembership, components::Station, components::Docked,
+    components::Wreck, components::LODPriority, components::WarpProfile,
+    components::SystemLocation>;
+
+// The rest of WorldPersistence's persisted components, kept as JSON
+using JsonTypes = TypeList<
+    components::Standings, components::WormholeConnection,
+    components::SolarSystem, components::Inventory, components::LootTable,
+    components::Corporation, components::DroneBay, components::ContractBoard,
+    components::CaptainPersonality, components::FleetMorale,
+    components::CaptainRelationship, components::EmotionalState,
+    components::CaptainMemory, components::FleetFormation,
+    components::FleetCargoPool, components::RumorLog,
+    components::MineralDeposit, components::SystemResources,
+    components::MarketHub, components::AnomalyVisualCue,
+    components::WarpVisual, components::WarpEvent,
+    components::TacticalProjection, components::PlayerPresence,
+    components::FactionCulture>;
+
+template<typename... Ts>
+bool hasAny(const ecs::Entity& entity, TypeList<Ts...>) {
+    return (entity.hasComponent<Ts>() || ...);
+}
+
+template<typename... Ts>
+void copyAll(const ecs::Entity& from, ecs::Entity& to, TypeList<Ts...>) {
+    auto copy = [&](const auto* component) {
+        using T = std::decay_t<decltype(*component)>;
+        if (component) to.addComponent(std::make_unique<T>(*component));
+    };
+    (copy(from.getComponent<Ts>()), ...);
+}
+
+// ---------------------------------------------------------------------------
+// Field codecs
+// ---------------------------------------------------------------------------
+
+template<typename V>
+constexpr uint32_t fieldSize() {
+    if constexpr (std::is_same<V, std::string>::value || std::is_enum<V>::value) return 4;
+    else if constexpr (std::is_same<V, bool>::value) return 1;
+    else return sizeof(V);
+}
+
+struct SizeOf {
+    uint32_t size = 0;
+    template<typename V> void operator()(const V&) { size += fieldSize<V>(); }
+};
+
+template<typename T>
+uint32_t recordSize() {
+    T sample;
+    SizeOf sizer;
+    Layout<T>::fields(sample, sizer);
+    return 4 + sizer.size;      // entity index + fields
+}
+
+class StringTable {
+public:
+    uint32_t intern(const std::string& s) {
+        auto it = index_.find(s);
+        if (it != index_.end()) return it->second;
+        uint32_t id = static_cast<uint32_t>(strings_.size());
+        strings_.push_back(&index_.emplace(s, id).first->first);
+        return id;
+    }
+
+    // count, offsets[count + 1], bytes
+    std::string encode() const {
+        std::string out;
+        put(out, static_cast<uint32_t>(strings_.size()));
+        uint32_t offset = 0;
+        put(out, offset);
+        for (const auto* s : strings_) {
+            offset += static_cast<uint32_t>(s->size());
+            put(out, offset);
+        }
+        for (const auto* s : strings_) out += *s;
+        return out;
+    }
+
+private:
+    std::unordered_map<std::string, uint32_t> index_;
+    std::vector<const std::string*> strings_;     // by id; keys of index_
+};
+
+class StringTableView {
+public:
+    bool open(const char* data, size_t size) {
+        if (size < 4) return false;
+        count_ = get<uint32_t>(data);
+        if ((size - 4) / 4 < static_cast<size_t>(count_) + 1) return false;
+        offsets_ = data + 4;
+        bytes_ = offsets_ + (static_cast<size_t>(count_) + 1) * 4;
+        bytes_size_ = size - static_cast<size_t>(bytes_ - data);
+        return get<uint32_t>(offsets_ + static_cast<size_t>(count_) * 4) <= bytes_size_;
+    }
+
+    bool lookup(uint32_t id, std::string& out) const {
+        if (id >= count_) return false;
+        uint32_t begin = get<uint32_t>(offsets_ + static_cast<size_t>(id) * 4);
+        uint32_t end = get<uint32_t>(offsets_ + (static_cast<size_t>(id) + 1) * 4);
+        if (begin > end || end > bytes_size_) return false;
+        out.assign(bytes_ + begin, end - begin);
+        return true;
+    }
+
+private:
+    uint32_t count_ = 0;
+    const char* offsets_ = nullptr;
+    const char* bytes_ = nullptr;
+    size_t bytes_size_ = 0;
+};
+
+struct RecordWriter {
+    std::string& out;
+    StringTable& strings;
+
+    template<typename V> void operator()(const V& value) {
+        if constexpr (std::is_same<V, std::string>::value) put(out, strings.intern(value));
+        else if constexpr (std::is_enum<V>::value) put(out, static_cast<int32_t>(value));
+        else if constexpr (std::is_same<V, bool>::value) out.push_back(value ? 1 : 0);
+        else put(out, value);
+    }
+};
+
+struct RecordReader {
+    const char* p;
+    const StringTableView& strings;
+    bool ok = true;
+
+    template<typename V> void operator()(V& value) {
+        if constexpr (std::is_same<V, std::string>::value) {
+            ok = strings.lookup(get<uint32_t>(p), value) && ok;
+        } else if constexpr (std::is_enum<V>::value) {
+            value = static_cast<V>(get<int32_t>(p));
+        } else if constexpr (std::is_same<V, bool>::value) {
+            value = *p != 0;
+        } else {
+            value = get<V>(p);
+        }
+        p += fieldSize<V>();
+    }
+};
+
+struct BuiltSection {
+    SectionHeader header{};
+    std::string data;
+};
+
+template<typename T>
+void encodeColumn(const std::vector<const ecs::Entity*>& entities, StringTable& strings,
+                  std::vector<BuiltSection>& sections) {
+    BuiltSection section;
+    section.header.tag = Layout<T>::kTag;
+    section.header.record_size = recordSize<T>();
+    RecordWriter writer{section.data, strings};
+    for (size_t i = 0; i < entities.size(); ++i) {
+        const T* component = entities[i]->getComponent<T>();
+        if (!component) continue;
+        put(section.data, static_cast<uint32_t>(i));
+        Layout<T>::fields(*component, writer);
+        ++section.header.count;
+    }
+    if (section.header.count > 0) sections.push_back(std::move(section));
+}
+
+template<typename... Ts>
+void encodeColumns(const std::vector<const ecs::Entity*>& entities, StringTable& strings,
+                   std::vector<BuiltSection>& sections, TypeList<Ts...>) {
+    (encodeColumn<Ts>(entities, strings, sections), ...);
+}
+
+template<typename T>
+bool decodeColumn(const SectionHeader& section, const char* data,
+                  const std::vector<ecs::Entity*>& entities, const StringTableView& strings) {
+    if (section.record_size != recordSize<T>()) {
+        std::cerr << "[WorldBinaryFormat] Section " << section.tag
+                  << " has an unexpected record size" << std::endl;
+        return false;
+    }
+    const char* p = data + section.offset;
+    for (uint64_t i = 0; i < section.count; ++i, p += section.record_size) {
+        uint32_t index = get<uint32_t>(p);
+        if (index >= entities.size()) return false;
+        if (!entities[index]) continue;     // id already taken in the world
+        auto component = std::make_unique<T>();
+        RecordReader reader{p + 4, strings};
+        Layout<T>::fields(*component, reader);
+        if (!reader.ok) return false;
+        entities[index]->addComponent(std::move(component));
+    }
+    return true;
+}
+
+// 1 = decoded, 0 = failed, -1 = tag not known to this build
+template<typename... Ts>
+int decodeColumns(const SectionHeader& section, const char* data,
+                  const std::vector<ecs::Entity*>& entities, const StringTableView& strings,
+                  TypeList<Ts...>) {
+    int result = -1;
+    ((section.tag == Layout<Ts>::kTag
+          ? (result = decodeColumn<Ts>(section, data, entities, strings) ? 1 : 0, true)
+          : false) || ...);
+    return result;
+}
+
+// ---------------------------------------------------------------------------
+// Memory-mapped input
+// ---------------------------------------------------------------------------
+
+class MappedFile {
+public:
+    MappedFile() = default;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ~MappedFile() {
+#ifndef _WIN32
+        if (addr_) munmap(addr_, size_);
+#endif
+    }
+
+    bool open(const std::string& path) {
+#ifdef _WIN32
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open()) return false;
+        std::ostringstream ss;
+        ss << file.rdbuf();
+        buffer_ = ss.str();
+        data_ = buffer_.data();
+        size_ = buffer_.size();
+        return size_ > 0;
+#else
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st;
+        if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+            close(fd);
+            return false;
+        }
+        size_ = static_cast<size_t>(st.st_size);
+        void* addr = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (addr == MAP_FAILED) return false;
+        addr_ = addr;
+        data_ = static_cast<const char*>(addr);
+        // Sections are read front to back
+        madvise(addr_, size_, MADV_SEQUENTIAL);
+        return true;
+#endif
+    }
+
+    const char* data() const { return data_; }
+    size_t size() const { return size_; }
+
+private:
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+#ifdef _WIN32
+    std::string buffer_;
+#else
+    void* addr_ = nullptr;
+#endif
+};
+
+bool readFile(const std::string& path, std::string& out) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) return false;
+    std::ostringstream ss;
+    ss << file.rdbuf();
+    out = ss.str();
+    return true;
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// WorldBinaryFormat
+// ---------------------------------------------------------------------------
+
+WorldBinaryFormat::WorldBinaryFormat(const WorldPersistence& persistence)
+    : persistence_(persistence) {}
+
+std::string WorldBinaryFormat::encode(const std::vector<const ecs::Entity*>& entities,
+                                      uint64_t journal_seq) const {
+    StringTable strings;
+    std::vector<BuiltSection> sections;
+
+    BuiltSection ids;
+    ids.header.tag = kEntitySection;
+    ids.header.record_size = 4;
+    ids.header.count = entities.size();
+    ids.data.reserve(entities.size() * 4);
+    for (const auto* entity : entities) put(ids.data, strings.intern(entity->getId()));
+    sections.push_back(std::move(ids));
+
+    // Nested components go through the JSON encoder, one record holding
+    // just those components per entity that has any
+    BuiltSection json;
+    json.header.tag = kJsonSection;
+    json.header.record_size = 8;
+    ecs::ComponentStorage scratch;
+    for (size_t i = 0; i < entities.size(); ++i) {
+        if (!hasAny(*entities[i], JsonTypes())) continue;
+        ecs::Entity part(entities[i]->getId(), &scratch);
+        copyAll(*entities[i], part, JsonTypes());
+        put(json.data, static_cast<uint32_t>(i));
+        put(json.data, strings.intern(persistence_.serializeEntity(&part)));
+        ++json.header.count;
+    }
+    if (json.header.count > 0) sections.push_back(std::move(json));
+
+    encodeColumns(entities, strings, sections, ColumnTypes());
+
+    // Lay out header, directory, sections and string table
+    size_t offset = sizeof(FileHeader) + sections.size() * sizeof(SectionHeader);
+    for (auto& section : sections) {
+        offset = align8(offset);
+        section.header.offset = offset;
+        section.header.checksum = fnv1a(section.data.data(), section.data.size());
+        offset += section.data.size();
+    }
+    std::string table = strings.encode();
+    size_t table_offset = align8(offset);
+
+    FileHeader header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.section_count = static_cast<uint32_t>(sections.size());
+    header.entity_count = entities.size();
+    header.journal_seq = journal_seq;
+    header.string_table_offset = table_offset;
+    header.file_size = table_offset + table.size();
+    header.string_table_checksum = fnv1a(table.data(), table.size());
+
+    std::string out;
+    out.reserve(header.file_size);
+    put(out, header);
+    for (const auto& section : sections) put(out, section.header);
+    for (const auto& section : sections) {
+        out.resize(section.header.offset, '\0');
+        out += section.data;
+    }
+    out.resize(table_offset, '\0');
+    out += table;
+    return out;
+}
+
+std::string WorldBinaryFormat::encodeWorld(const ecs::World* world, uint64_t journal_seq) const {
+    auto entities = const_cast<ecs::World*>(world)->getAllEntities();
+    return encode(std::vector<const ecs::Entity*>(entities.begin(), entities.end()), journal_seq);
+}
+
+std::string WorldBinaryFormat::encodeSnapshot(const WorldSnapshot& snapshot,
+                                              uint64_t journal_seq) const {
+    std::vector<const ecs::Entity*> entities;
+    entities.reserve(snapshot.getEntityCount());
+    for (const auto& entity : snapshot.getEntities()) entities.push_back(entity.get());
+    return encode(entities, journal_seq);
+}
+
+bool WorldBinaryFormat::decode(ecs::World* world, const char* data, size_t size,
+                               uint64_t* journal_seq) const {
+    if (size < sizeof(FileHeader)) {
+        std::cerr << "[WorldBinaryFormat] File too short" << std::endl;
+        return false;
+    }
+    FileHeader header = get<FileHeader>(data);
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0) {
+        std::cerr << "[WorldBinaryFormat] Invalid magic" << std::endl;
+        return false;
+    }
+    if (header.version == 0 || header.version > kVersion) {
+        std::cerr << "[WorldBinaryFormat] Unsupported version " << header.version << std::endl;
+        return false;
+    }
+    if (header.file_size != size ||
+        (size - sizeof(FileHeader)) / sizeof(SectionHeader) < header.section_count ||
+        header.string_table_offset > size) {
+        std::cerr << "[WorldBinaryFormat] File truncated or corrupt" << std::endl;
+        return false;
+    }
+
+    StringTableView strings;
+    const char* table = data + header.string_table_offset;
+    size_t table_size = size - header.string_table_offset;
+    if (fnv1a(table, table_size) != header.string_table_checksum ||
+        !strings.open(table, table_size)) {
+        std::cerr << "[WorldBinaryFormat] Invalid string table" << std::endl;
+        return false;
+    }
+
+    // Validate every section before touching the world
+    std::vector<SectionHeader> sections(header.section_count);
+    const SectionHeader* entity_section = nullptr;
+    const SectionHeader* json_section = nullptr;
+    for (uint32_t i = 0; i < header.section_count; ++i) {
+        SectionHeader& s = sections[i];
+        s = get<SectionHeader>(data + sizeof(FileHeader) + i * sizeof(SectionHeader));
+        if (s.record_size == 0 || s.offset > size ||
+            s.count > (size - s.offset) / s.record_size ||
+            fnv1a(data + s.offset, s.count * s.record_size) != s.checksum) {
+            std::cerr << "[WorldBinaryFormat] Section " << s.tag << " is corrupt" << std::endl;
+            return false;
+        }
+        if (s.tag == kEntitySection) entity_section = &s;
+        if (s.tag == kJsonSection) json_section = &s;
+    }
+    if (!entity_section || entity_section->record_size != 4 ||
+        entity_section->count != header.entity_count ||
+        (json_section && json_section->record_size != 8)) {
+        std::cerr << "[WorldBinaryFormat] Missing or malformed entity section" << std::endl;
+        return false;
+    }
+
+    std::vector<std::string> ids(header.entity_count);
+    for (uint64_t i = 0; i < header.entity_count; ++i) {
+        if (!strings.lookup(get<uint32_t>(data + entity_section->offset + i * 4), ids[i])) {
+            return false;
+        }
+    }
+
+    // Entities with nested components are created by the JSON decoder,
+    // the rest directly
+    std::vector<ecs::Entity*> entities(header.entity_count, nullptr);
+    std::vector<bool> created(header.entity_count, false);
+    if (json_section) {
+        std::string json;
+        const char* p = data + json_section->offset;
+        for (uint64_t i = 0; i < json_section->count; ++i, p += 8) {
+            uint32_t index = get<uint32_t>(p);
+            if (index >= entities.size() || !strings.lookup(get<uint32_t>(p + 4), json)) return false;
+            created[index] = true;
+            if (persistence_.deserializeEntity(world, json)) {
+                entities[index] = world->getEntity(ids[index]);
+            }
+        }
+    }
+    for (size_t i = 0; i < entities.size(); ++i) {
+        if (!created[i]) entities[i] = world->createEntity(ids[i]);
+    }
+
+    for (const auto& section : sections) {
+        if (section.tag == kEntitySection || section.tag == kJsonSection) continue;
+        if (decodeColumns(section, data, entities, strings, ColumnTypes()) == 0) return false;
+    }
+
+    if (journal_seq) *journal_seq = header.journal_seq;
+    std::cout << "[WorldBinaryFormat] Loaded " << header.entity_count
+              << " entities" << std::endl;
+    return true;
+}
+
+bool WorldBinaryFormat::save(const ecs::World* world, const std::string& filepath) const {
+    if (!WorldPersistence::writeFileAtomic(filepath, encodeWorld(world))) {
+        std::cerr << "[WorldBinaryFormat] Cannot write file: " << filepath << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool WorldBinaryFormat::load(ecs::World* world, const std::string& filepath,
+                             uint64_t* journal_seq) const {
+    MappedFile file;
+    if (!file.open(filepath)) {
+        std::cerr << "[WorldBinaryFormat] Cannot open file for reading: "
+                  << filepath << std::endl;
+        return false;
+    }
+    return decode(world, file.data(), file.size(), journal_seq);
+}
+
+bool WorldBinaryFormat::isBinaryFile(const std::string& filepath) {
+    std::ifstream file(filepath, std::ios::binary);
+    char magic[sizeof(kMagic)] = {};
+    return file.read(magic, sizeof(magic)) && std::memcmp(magic, kMagic, sizeof(kMagic)) == 0;
+}
+
+bool WorldBinaryFormat::convert(const std::string& input_path,
+                                const std::string& output_path) const {
+    ecs::World world;
+    if (isBinaryFile(input_path)) {
+        uint64_t journal_seq = 0;
+        if (!load(&world, input_path, &journal_seq)) return false;
+        std::string json = persistence_.serializeWorld(&world);
+        if (journal_seq > 0) {
+            json.insert(1, "\"journal_seq\":" + std::to_string(journal_seq) + ",");
+        }
+        return WorldPersistence::writeFileAtomic(output_path, json);
+    }
+
+    std::string json;
+    if (!readFile(input_path, json)) {
+        std::cerr << "[WorldBinaryFormat] Cannot open file for reading: "
+                  << input_path << std::endl;
+        return false;
+    }
+    if (json.compare(0, 4, "ALSW") == 0) {      // .atlasw magic
+        std::string image = std::move(json);
+        if (!WorldPersistence::decodeCompressed(image, json)) return false;
+    }
+
+    // Keep the journal position of a journaled base save
+    uint64_t journal_seq = 0;
+    const std::string key = "\"journal_seq\":";
+    size_t pos = json.find(key);
+    if (pos != std::string::npos && pos < json.find('[')) {
+        journal_seq = std::strtoull(json.c_str() + pos + key.size(), nullptr, 10);
+    }
+
+    if (!persistence_.deserializeWorld(&world, json)) return false;
+    return WorldPersistence::writeFileAtomic(output_path, encodeWorld(&world, journal_seq));
+}
+
+} // namespace data
+} // namespace atlas
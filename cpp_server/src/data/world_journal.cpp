@@ -0,0 +1,320 @@
+#include "data/world_journal.h"
+#include "data/world_binary_format.h"
+#include "utils/logger.h"
+#include "utils/profiler.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <unordered_set>
+#include <vector>
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+namespace atlas {
+namespace data {
+
+namespace {
+
+bool readFile(const std::string& path, std::string& out) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) return false;
+    std::ostringstream ss;
+    ss << file.rdbuf();
+    out = ss.str();
+    return true;
+}
+
+// Append and flush to disk; a batch is durable once this returns
+bool appendDurable(const std::string& path, const std::string& data) {
+    FILE* file = std::fopen(path.c_str(), "ab");
+    if (!file) return false;
+    bool ok = std::fwrite(data.data(), 1, data.size(), file) == data.size();
+    ok = std::fflush(file) == 0 && ok;
+#ifndef _WIN32
+    ok = fsync(fileno(file)) == 0 && ok;
+#endif
+    ok = std::fclose(file) == 0 && ok;
+    return ok;
+}
+
+// Next '\n'-terminated line at pos; false if the line is unterminated
+bool nextLine(const std::string& data, size_t& pos, std::string& line) {
+    size_t end = data.find('\n', pos);
+    if (end == std::string::npos) return false;
+    line.assign(data, pos, end - pos);
+    pos = end + 1;
+    return true;
+}
+
+// journal_seq from a base save; 0 for saves written without a journal
+uint64_t baseSequence(const std::string& json) {
+    const std::string key = "\"journal_seq\":";
+    size_t pos = json.find(key);
+    if (pos == std::string::npos || pos > json.find('[')) return 0;
+    return std::strtoull(json.c_str() + pos + key.size(), nullptr, 10);
+}
+
+} // namespace
+
+WorldJournal::WorldJournal(const WorldPersistence& persistence, const std::string& base_path,
+                           const std::string& journal_path, SaveFormat format)
+    : persistence_(persistence), base_path_(base_path),
+      journal_path_(journal_path), format_(format) {}
+
+uint64_t WorldJournal::fingerprint(const std::string& data) {
+    uint64_t hash = 14695981039346656037ull;
+    for (unsigned char c : data) {
+        hash ^= c;
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+uint64_t WorldJournal::fingerprintWorld(const WorldPersistence& persistence,
+                                        const ecs::World* world) {
+    uint64_t sum = 0;
+    for (const auto* entity : const_cast<ecs::World*>(world)->getAllEntities()) {
+        sum += fingerprint(persistence.serializeEntity(entity));
+    }
+    return sum;
+}
+
+bool WorldJournal::exists() const {
+    return std::ifstream(base_path_).good() || std::ifstream(journal_path_).good();
+}
+
+bool WorldJournal::load(ecs::World* world) {
+    std::unordered_set<std::string> existing;
+    for (const auto* entity : world->getAllEntities()) existing.insert(entity->getId());
+
+    uint64_t base_seq = 0;
+    has_base_ = false;
+    base_bytes_ = 0;
+    std::string data;
+    if (format_ == SaveFormat::Binary) {
+        if (std::ifstream(base_path_).good()) {
+            if (!WorldBinaryFormat(persistence_).load(world, base_path_, &base_seq)) return false;
+            base_bytes_ = static_cast<uint64_t>(
+                std::ifstream(base_path_, std::ios::binary | std::ios::ate).tellg());
+            has_base_ = true;
+        }
+    } else if (readFile(base_path_, data)) {
+        base_bytes_ = data.size();
+        std::string json;
+        if (format_ == SaveFormat::Compressed) {
+            if (!WorldPersistence::decodeCompressed(data, json)) return false;
+        } else {
+            json = std::move(data);
+        }
+        base_seq = baseSequence(json);
+        if (!persistence_.deserializeWorld(world, json)) return false;
+        has_base_ = true;
+    }
+
+    seq_ = base_seq;
+    replay(world, base_seq);
+
+    // What the files now hold; entities that were in the world before
+    // the load are written by the next commit
+    on_disk_.clear();
+    for (const auto* entity : world->getAllEntities()) {
+        if (existing.count(entity->getId())) continue;
+        on_disk_[entity->getId()] = fingerprint(persistence_.serializeEntity(entity));
+    }
+    return true;
+}
+
+bool WorldJournal::replay(ecs::World* world, uint64_t base_seq) {
+    std::string data;
+    journal_bytes_ = 0;
+    if (!readFile(journal_path_, data)) return true;
+
+    size_t pos = 0;
+    size_t valid = 0;
+    size_t batches = 0;
+    std::string line;
+    std::vector<std::string> records;
+    while (pos < data.size()) {
+        unsigned long long seq = 0, count = 0;
+        if (!nextLine(data, pos, line) ||
+            std::sscanf(line.c_str(), "B %llu %llu", &seq, &count) != 2) break;
+
+        size_t body_start = pos;
+        records.clear();
+        bool complete = true;
+        for (unsigned long long i = 0; i < count; ++i) {
+            if (!nextLine(data, pos, line) || line.size() < 2 ||
+                (line[0] != 'U' && line[0] != 'D') || line[1] != ' ') {
+                complete = false;
+                break;
+            }
+            records.push_back(std::move(line));
+        }
+        size_t body_end = pos;
+
+        unsigned long long end_seq = 0;
+        unsigned int csum = 0;
+        if (!complete || !nextLine(data, pos, line) ||
+            std::sscanf(line.c_str(), "E %llu %u", &end_seq, &csum) != 2 || end_seq != seq ||
+            WorldPersistence::checksum(data.substr(body_start, body_end - body_start)) != csum) {
+            break;
+        }
+        valid = pos;
+
+        // Batches at or before base_seq are already in the base save
+        if (seq <= base_seq) continue;
+        for (const auto& record : records) {
+            std::string payload = record.substr(2);
+            if (record[0] == 'D') {
+                world->destroyEntity(payload);
+            } else {
+                world->destroyEntity(WorldPersistence::extractString(payload, "id"));
+                persistence_.deserializeEntity(world, payload);
+            }
+        }
+        seq_ = std::max<uint64_t>(seq_, seq);
+        ++batches;
+    }
+
+    if (valid < data.size()) {
+        // A crash mid-append leaves a torn batch; drop it so new
+        // batches are not appended after garbage
+        utils::Logger::instance().warn(
+            "[WorldJournal] Discarding " + std::to_string(data.size() - valid) +
+            " bytes of incomplete journal in " + journal_path_);
+        WorldPersistence::writeFileAtomic(journal_path_, data.substr(0, valid));
+    }
+    journal_bytes_ = valid;
+
+    if (batches > 0) {
+        utils::Logger::instance().info(
+            "[WorldJournal] Replayed " + std::to_string(batches) + " journal batches");
+    }
+    return true;
+}
+
+void WorldJournal::serializeAll(const WorldSnapshot& snapshot,
+                                std::vector<std::string>& records,
+                                std::vector<uint64_t>& prints) const {
+    utils::ProfileScope scope("serialize");
+    records.reserve(snapshot.getEntityCount());
+    prints.reserve(snapshot.getEntityCount());
+    for (const auto& entity : snapshot.getEntities()) {
+        records.push_back(persistence_.serializeEntity(entity.get()));
+        prints.push_back(fingerprint(records.back()));
+    }
+}
+
+WorldJournal::CommitStats WorldJournal::commit(const WorldSnapshot& snapshot) {
+    std::vector<std::string> records;
+    std::vector<uint64_t> prints;
+    serializeAll(snapshot, records, prints);
+
+    CommitStats stats;
+    std::string body;
+    std::unordered_set<std::string> present;
+    present.reserve(records.size());
+    const auto& entities = snapshot.getEntities();
+    for (size_t i = 0; i < entities.size(); ++i) {
+        const std::string& id = entities[i]->getId();
+        present.insert(id);
+        auto it = on_disk_.find(id);
+        if (it == on_disk_.end() || it->second != prints[i]) {
+            body += "U " + records[i] + "\n";
+            ++stats.upserts;
+        }
+    }
+    for (const auto& entry : on_disk_) {
+        if (!present.count(entry.first)) {
+            body += "D " + entry.first + "\n";
+            ++stats.removals;
+        }
+    }
+
+    if (!has_base_) return writeBase(snapshot, records, prints);
+    if (stats.upserts + stats.removals == 0) {
+        stats.ok = true;
+        return stats;
+    }
+
+    uint64_t seq = seq_ + 1;
+    std::string batch = "B " + std::to_string(seq) + " " +
+                        std::to_string(stats.upserts + stats.removals) + "\n" + body +
+                        "E " + std::to_string(seq) + " " +
+                        std::to_string(WorldPersistence::checksum(body)) + "\n";
+
+    // Past this size, replaying the journal costs more than rewriting the base
+    if (static_cast<double>(journal_bytes_ + batch.size()) >
+            static_cast<double>(base_bytes_) * compact_ratio_) {
+        return writeBase(snapshot, records, prints);
+    }
+
+    {
+        utils::ProfileScope scope("write");
+        if (!appendDurable(journal_path_, batch)) return stats;
+    }
+    seq_ = seq;
+    journal_bytes_ += batch.size();
+    for (size_t i = 0; i < entities.size(); ++i) on_disk_[entities[i]->getId()] = prints[i];
+    for (auto it = on_disk_.begin(); it != on_disk_.end();) {
+        if (!present.count(it->first)) it = on_disk_.erase(it);
+        else ++it;
+    }
+
+    stats.ok = true;
+    stats.bytes = batch.size();
+    return stats;
+}
+
+WorldJournal::CommitStats WorldJournal::compact(const WorldSnapshot& snapshot) {
+    std::vector<std::string> records;
+    std::vector<uint64_t> prints;
+    serializeAll(snapshot, records, prints);
+    return writeBase(snapshot, records, prints);
+}
+
+WorldJournal::CommitStats WorldJournal::writeBase(const WorldSnapshot& snapshot,
+                                                  const std::vector<std::string>& records,
+                                                  const std::vector<uint64_t>& prints) {
+    utils::ProfileScope scope("compact");
+    CommitStats stats;
+
+    uint64_t seq = seq_ + 1;
+    std::string image;
+    if (format_ == SaveFormat::Binary) {
+        image = WorldBinaryFormat(persistence_).encodeSnapshot(snapshot, seq);
+    } else {
+        std::string json = "{\"journal_seq\":" + std::to_string(seq) + ",\"entities\":[";
+        for (size_t i = 0; i < records.size(); ++i) {
+            if (i) json += ",";
+            json += records[i];
+        }
+        json += "]}";
+        image = format_ == SaveFormat::Compressed ? WorldPersistence::encodeCompressed(json)
+                                                  : std::move(json);
+    }
+    if (!WorldPersistence::writeFileAtomic(base_path_, image)) return stats;
+
+    // Batches still in the journal are at or below seq and are skipped
+    // on load, so a failed truncate loses nothing
+    WorldPersistence::writeFileAtomic(journal_path_, "");
+    seq_ = seq;
+    has_base_ = true;
+    base_bytes_ = image.size();
+    journal_bytes_ = 0;
+    on_disk_.clear();
+    const auto& entities = snapshot.getEntities();
+    for (size_t i = 0; i < entities.size(); ++i) on_disk_[entities[i]->getId()] = prints[i];
+
+    stats.ok = true;
+    stats.compacted = true;
+    stats.upserts = records.size();
+    stats.bytes = image.size();
+    return stats;
+}
+
+} // namespace data
+} // namespace atlas
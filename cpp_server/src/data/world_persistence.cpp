@@ -1,9 +1,19 @@
 #include "data/world_persistence.h"
 #include "components/game_components.h"
+#include "utils/profiler.h"
+#include <cstdio>
+#include <cstring>
 #include <fstream>
 #include <sstream>
 #include <iostream>
+#include <type_traits>
 #include <sys/stat.h>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 namespace atlas {
 namespace data {
@@ -37,22 +47,82 @@ static std::string escapeJson(const std::string& input) {
 
 bool WorldPersistence::saveWorld(const ecs::World* world,
                                  const std::string& filepath) {
-    std::string json = serializeWorld(world);
+    std::string json;
+    {
+        utils::ProfileScope scope("serialize");
+        json = serializeWorld(world);
+    }
 
-    std::ofstream file(filepath);
-    if (!file.is_open()) {
-        std::cerr << "[WorldPersistence] Cannot open file for writing: "
+    utils::ProfileScope scope("write");
+    if (!writeFileAtomic(filepath, json)) {
+        std::cerr << "[WorldPersistence] Cannot write file: "
                   << filepath << std::endl;
         return false;
     }
 
-    file << json;
-    file.close();
-
     std::cout << "[WorldPersistence] World saved to " << filepath << std::endl;
     return true;
 }
 
+bool WorldPersistence::writeFileAtomic(const std::string& filepath,
+                                       const std::string& data) {
+    const std::string tmp = filepath + ".tmp";
+    FILE* file = std::fopen(tmp.c_str(), "wb");
+    if (!file) return false;
+
+    bool ok = std::fwrite(data.data(), 1, data.size(), file) == data.size();
+    ok = std::fflush(file) == 0 && ok;
+    // The data must be on disk before the rename makes it visible
+#ifdef _WIN32
+    ok = _commit(_fileno(file)) == 0 && ok;
+#else
+    ok = fsync(fileno(file)) == 0 && ok;
+#endif
+    ok = std::fclose(file) == 0 && ok;
+    if (!ok) {
+        std::remove(tmp.c_str());
+        return false;
+    }
+
+#ifdef _WIN32
+    // rename() does not replace an existing file on Windows
+    std::remove(filepath.c_str());
+#endif
+    if (std::rename(tmp.c_str(), filepath.c_str()) != 0) {
+        std::remove(tmp.c_str());
+        return false;
+    }
+
+#ifndef _WIN32
+    // Persist the directory entry as well
+    size_t slash = filepath.rfind('/');
+    std::string dir = slash == std::string::npos ? "." : filepath.substr(0, slash + 1);
+    int dir_fd = open(dir.c_str(), O_RDONLY);
+    if (dir_fd >= 0) {
+        fsync(dir_fd);
+        close(dir_fd);
+    }
+#endif
+    return true;
+}
+
+const char* WorldPersistence::saveFormatExtension(SaveFormat format) {
+    switch (format) {
+        case SaveFormat::Json:       return ".json";
+        case SaveFormat::Compressed: return ".atlasw";
+        case SaveFormat::Binary:     return ".atlasb";
+    }
+    return ".json";
+}
+
+bool WorldPersistence::parseSaveFormat(const std::string& name, SaveFormat& out) {
+    if (name == "json") out = SaveFormat::Json;
+    else if (name == "compressed") out = SaveFormat::Compressed;
+    else if (name == "binary") out = SaveFormat::Binary;
+    else return false;
+    return true;
+}
+
 bool WorldPersistence::loadWorld(ecs::World* world,
                                  const std::string& filepath) {
     std::ifstream file(filepath);
@@ -77,7 +147,20 @@ std::string WorldPersistence::serializeWorld(const ecs::World* world) const {
     // We need a non-const World* to call getAllEntities (existing API limitation)
     auto* mutable_world = const_cast<ecs::World*>(world);
     auto entities = mutable_world->getAllEntities();
+    return serializeEntities(std::vector<const ecs::Entity*>(entities.begin(), entities.end()));
+}
+
+std::string WorldPersistence::serializeSnapshot(const WorldSnapshot& snapshot) const {
+    std::vector<const ecs::Entity*> entities;
+    entities.reserve(snapshot.entities_.size());
+    for (const auto& entity : snapshot.entities_) {
+        entities.push_back(entity.get());
+    }
+    return serializeEntities(entities);
+}
 
+std::string WorldPersistence::serializeEntities(
+        const std::vector<const ecs::Entity*>& entities) const {
     std::ostringstream json;
     json << "{\"entities\":[";
 
@@ -92,6 +175,52 @@ std::string WorldPersistence::serializeWorld(const ecs::World* world) const {
     return json.str();
 }
 
+// ---------------------------------------------------------------------------
+// Snapshots
+// ---------------------------------------------------------------------------
+
+namespace {
+
+template<typename... Ts>
+void copyComponents(const ecs::Entity& from, ecs::Entity& to) {
+    auto copy = [&](const auto* component) {
+        using T = std::decay_t<decltype(*component)>;
+        if (component) to.addComponent(std::make_unique<T>(*component));
+    };
+    (copy(from.getComponent<Ts>()), ...);
+}
+
+// Every component serializeEntity() writes; keep the two in step
+void copyPersistedComponents(const ecs::Entity& from, ecs::Entity& to) {
+    using namespace components;
+    copyComponents<
+        Position, Velocity, Health, Capacitor, Ship, Faction, Standings, AI,
+        Weapon, Player, WormholeConnection, SolarSystem, FleetMembership,
+        Inventory, LootTable, Corporation, DroneBay, ContractBoard, Station,
+        Docked, SystemLocation, Wreck, CaptainPersonality, FleetMorale,
+        CaptainRelationship, EmotionalState, CaptainMemory, FleetFormation, FleetCargoPool,
+        RumorLog, MineralDeposit, SystemResources, MarketHub,
+        AnomalyVisualCue, LODPriority, WarpProfile, WarpVisual, WarpEvent,
+        TacticalProjection, PlayerPresence, FactionCulture>(from, to);
+}
+
+} // namespace
+
+std::unique_ptr<WorldSnapshot> WorldPersistence::snapshotWorld(
+        const ecs::World* world) const {
+    auto* mutable_world = const_cast<ecs::World*>(world);
+    auto entities = mutable_world->getAllEntities();
+
+    auto snapshot = std::make_unique<WorldSnapshot>();
+    snapshot->entities_.reserve(entities.size());
+    for (const auto* entity : entities) {
+        auto copy = std::make_unique<ecs::Entity>(entity->getId(), &snapshot->storage_);
+        copyPersistedComponents(*entity, *copy);
+        snapshot->entities_.push_back(std::move(copy));
+    }
+    return snapshot;
+}
+
 bool WorldPersistence::deserializeWorld(ecs::World* world,
                                         const std::string& json) const {
     // Find the entities array
@@ -526,6 +655,14 @@ std::string WorldPersistence::serializeEntity(
              << "}";
     }
 
+    // SystemLocation
+    auto* loc = entity->getComponent<components::SystemLocation>();
+    if (loc) {
+        json << ",\"system_location\":{"
+             << "\"system_id\":\"" << escapeJson(loc->system_id) << "\""
+             << "}";
+    }
+
     // Wreck
     auto* wrk = entity->getComponent<components::Wreck>();
     if (wrk) {
@@ -699,10 +836,10 @@ std::string WorldPersistence::serializeEntity(
              << ",\"sales_tax_rate\":" << mh->sales_tax_rate
              << ",\"orders\":[";
         bool first_o = true;
-        for (const auto& o : mh->orders) {
+        mh->orders.forEach([&](const components::MarketHub::Order& o) {
             if (!first_o) json << ",";
             first_o = false;
-            json << "{\"order_id\":\"" << escapeJson(o.order_id) << "\""
+            json << "{\"order_id\":" << o.order_id
                  << ",\"item_id\":\"" << escapeJson(o.item_id) << "\""
                  << ",\"item_name\":\"" << escapeJson(o.item_name) << "\""
                  << ",\"owner_id\":\"" << escapeJson(o.owner_id) << "\""
@@ -710,9 +847,8 @@ std::string WorldPersistence::serializeEntity(
                  << ",\"price_per_unit\":" << o.price_per_unit
                  << ",\"quantity\":" << o.quantity
                  << ",\"quantity_remaining\":" << o.quantity_remaining
-                 << ",\"duration_remaining\":" << o.duration_remaining
-                 << ",\"fulfilled\":" << (o.fulfilled ? "true" : "false") << "}";
-        }
+                 << ",\"duration_remaining\":" << mh->orders.durationRemaining(o) << "}";
+        });
         json << "]}";
     }
 
@@ -1420,6 +1556,14 @@ bool WorldPersistence::deserializeEntity(ecs::World* world,
         entity->addComponent(std::move(dck));
     }
 
+    // SystemLocation
+    std::string loc_json = extractObject(json, "system_location");
+    if (!loc_json.empty()) {
+        auto loc = std::make_unique<components::SystemLocation>();
+        loc->system_id = extractString(loc_json, "system_id");
+        entity->addComponent(std::move(loc));
+    }
+
     // Wreck
     std::string wrk_json = extractObject(json, "wreck");
     if (!wrk_json.empty()) {
@@ -1758,8 +1902,10 @@ bool WorldPersistence::deserializeEntity(ecs::World* world,
                             --depth;
                             if (depth == 0 && obj_start != std::string::npos) {
                                 std::string oj = content.substr(obj_start, i - obj_start + 1);
+                                // Saves from before integer ids get fresh ones
                                 components::MarketHub::Order order;
-                                order.order_id           = extractString(oj, "order_id");
+                                order.order_id           = static_cast<uint64_t>(
+                                    extractDouble(oj, "\"order_id\":", 0.0));
                                 order.item_id            = extractString(oj, "item_id");
                                 order.item_name          = extractString(oj, "item_name");
                                 order.owner_id           = extractString(oj, "owner_id");
@@ -1767,9 +1913,11 @@ bool WorldPersistence::deserializeEntity(ecs::World* world,
                                 order.price_per_unit     = extractDouble(oj, "\"price_per_unit\":", 0.0);
                                 order.quantity           = extractInt(oj, "\"quantity\":", 1);
                                 order.quantity_remaining = extractInt(oj, "\"quantity_remaining\":", 1);
-                                order.duration_remaining = extractFloat(oj, "\"duration_remaining\":", -1.0f);
-                                order.fulfilled          = extractBool(oj, "\"fulfilled\":", false);
-                                mh->orders.push_back(order);
+                                float duration = extractFloat(oj, "\"duration_remaining\":", -1.0f);
+                                // Filled orders from older saves are skipped (nothing remains)
+                                if (!extractBool(oj, "\"fulfilled\":", false)) {
+                                    mh->orders.add(std::move(order), duration);
+                                }
                                 obj_start = std::string::npos;
                             }
                         }
@@ -2074,61 +2222,72 @@ std::string WorldPersistence::decompress(const std::string& input,
     return out;
 }
 
-bool WorldPersistence::saveWorldCompressed(const ecs::World* world,
-                                            const std::string& filepath) {
-    std::string json = serializeWorld(world);
+std::string WorldPersistence::encodeCompressed(const std::string& json) {
     uint32_t original_size = static_cast<uint32_t>(json.size());
     uint32_t csum = checksum(json);
-
     std::string compressed = compress(json);
     uint32_t compressed_size = static_cast<uint32_t>(compressed.size());
 
-    std::ofstream file(filepath, std::ios::binary);
-    if (!file.is_open()) {
-        std::cerr << "[WorldPersistence] Cannot open compressed file for writing: "
+    // Header: magic(4) + original_size(4) + compressed_size(4) + checksum(4)
+    std::string out;
+    out.reserve(16 + compressed.size());
+    out.append(reinterpret_cast<const char*>(&ATLASW_MAGIC), 4);
+    out.append(reinterpret_cast<const char*>(&original_size), 4);
+    out.append(reinterpret_cast<const char*>(&compressed_size), 4);
+    out.append(reinterpret_cast<const char*>(&csum), 4);
+    out += compressed;
+    return out;
+}
+
+bool WorldPersistence::saveWorldCompressed(const ecs::World* world,
+                                            const std::string& filepath) {
+    std::string json;
+    {
+        utils::ProfileScope scope("serialize");
+        json = serializeWorld(world);
+    }
+
+    std::string image;
+    {
+        utils::ProfileScope scope("compress");
+        image = encodeCompressed(json);
+    }
+
+    utils::ProfileScope scope("write");
+    if (!writeFileAtomic(filepath, image)) {
+        std::cerr << "[WorldPersistence] Cannot write compressed file: "
                   << filepath << std::endl;
         return false;
     }
 
-    // Header: magic(4) + original_size(4) + compressed_size(4) + checksum(4)
-    file.write(reinterpret_cast<const char*>(&ATLASW_MAGIC), 4);
-    file.write(reinterpret_cast<const char*>(&original_size), 4);
-    file.write(reinterpret_cast<const char*>(&compressed_size), 4);
-    file.write(reinterpret_cast<const char*>(&csum), 4);
-    file.write(compressed.data(), compressed.size());
-    file.close();
-
     std::cout << "[WorldPersistence] Compressed save: "
-              << original_size << " → " << compressed_size
+              << json.size() << " → " << image.size() - 16
               << " bytes (" << filepath << ")" << std::endl;
     return true;
 }
 
-bool WorldPersistence::loadWorldCompressed(ecs::World* world,
-                                            const std::string& filepath) {
-    std::ifstream file(filepath, std::ios::binary);
-    if (!file.is_open()) {
-        std::cerr << "[WorldPersistence] Cannot open compressed file for reading: "
-                  << filepath << std::endl;
+bool WorldPersistence::decodeCompressed(const std::string& image, std::string& json) {
+    if (image.size() < 16) {
+        std::cerr << "[WorldPersistence] Compressed file too short" << std::endl;
         return false;
     }
 
     uint32_t magic = 0, original_size = 0, compressed_size = 0, csum = 0;
-    file.read(reinterpret_cast<char*>(&magic), 4);
-    file.read(reinterpret_cast<char*>(&original_size), 4);
-    file.read(reinterpret_cast<char*>(&compressed_size), 4);
-    file.read(reinterpret_cast<char*>(&csum), 4);
+    std::memcpy(&magic, image.data(), 4);
+    std::memcpy(&original_size, image.data() + 4, 4);
+    std::memcpy(&compressed_size, image.data() + 8, 4);
+    std::memcpy(&csum, image.data() + 12, 4);
 
     if (magic != ATLASW_MAGIC) {
         std::cerr << "[WorldPersistence] Invalid compressed file magic" << std::endl;
         return false;
     }
+    if (compressed_size > image.size() - 16) {
+        std::cerr << "[WorldPersistence] Compressed file truncated" << std::endl;
+        return false;
+    }
 
-    std::string compressed(compressed_size, '\0');
-    file.read(&compressed[0], compressed_size);
-    file.close();
-
-    std::string json = decompress(compressed, original_size);
+    json = decompress(image.substr(16, compressed_size), original_size);
 
     if (json.size() != original_size) {
         std::cerr << "[WorldPersistence] Size mismatch after decompression" << std::endl;
@@ -2139,7 +2298,24 @@ bool WorldPersistence::loadWorldCompressed(ecs::World* world,
         std::cerr << "[WorldPersistence] Checksum mismatch — file may be corrupt" << std::endl;
         return false;
     }
+    return true;
+}
+
+bool WorldPersistence::loadWorldCompressed(ecs::World* world,
+                                            const std::string& filepath) {
+    std::ifstream file(filepath, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "[WorldPersistence] Cannot open compressed file for reading: "
+                  << filepath << std::endl;
+        return false;
+    }
+
+    std::ostringstream image;
+    image << file.rdbuf();
+    file.close();
 
+    std::string json;
+    if (!decodeCompressed(image.str(), json)) return false;
     return deserializeWorld(world, json);
 }
 
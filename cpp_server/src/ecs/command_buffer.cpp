@@ -0,0 +1,35 @@
+#include "ecs/command_buffer.h"
+
+namespace atlas {
+namespace ecs {
+
+void CommandBuffer::record(Command command) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    commands_.push_back(std::move(command));
+}
+
+size_t CommandBuffer::apply(World& world) {
+    size_t executed = 0;
+    // Commands may record further commands; keep draining until empty
+    for (;;) {
+        std::vector<Command> batch;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (commands_.empty()) break;
+            batch.swap(commands_);
+        }
+        for (auto& command : batch) {
+            command(world);
+            ++executed;
+        }
+    }
+    return executed;
+}
+
+size_t CommandBuffer::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return commands_.size();
+}
+
+} // namespace ecs
+} // namespace atlas
@@ -3,12 +3,25 @@
 namespace atlas {
 namespace ecs {
 
-Entity::Entity(const std::string& id) : id_(id) {
+Entity::Entity(const std::string& id, ComponentStorage* storage, EntityObserver* observer)
+    : id_(id), storage_(storage), observer_(observer) {
+    if (!storage_) {
+        owned_storage_ = std::make_unique<ComponentStorage>();
+        storage_ = owned_storage_.get();
+    }
+}
+
+Entity::~Entity() {
+    for (const auto& ref : components_) {
+        if (ComponentPoolBase* pool = storage_->poolById(ref.type)) {
+            pool->release(ref.slot);
+        }
+    }
 }
 
-bool Entity::hasComponents(const std::vector<std::type_index>& types) const {
+bool Entity::hasComponents(const std::vector<ComponentTypeId>& types) const {
     for (const auto& type : types) {
-        if (components_.find(type) == components_.end()) {
+        if (!findRef(type)) {
             return false;
         }
     }
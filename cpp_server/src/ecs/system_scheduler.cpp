@@ -0,0 +1,111 @@
+#include "ecs/system_scheduler.h"
+#include "utils/profiler.h"
+#include "utils/thread_pool.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+
+namespace atlas {
+namespace ecs {
+
+namespace {
+bool intersects(const std::vector<ComponentTypeId>& a, const std::vector<ComponentTypeId>& b) {
+    for (ComponentTypeId type : a) {
+        if (std::find(b.begin(), b.end(), type) != b.end()) return true;
+    }
+    return false;
+}
+}
+
+bool SystemScheduler::conflicts(const SystemAccess& a, const SystemAccess& b) {
+    if (a.exclusive || b.exclusive) return true;
+    return intersects(a.writes, b.writes) ||
+           intersects(a.writes, b.reads) ||
+           intersects(a.reads, b.writes);
+}
+
+void SystemScheduler::build(const std::vector<System*>& systems) {
+    systems_ = systems;
+    size_t count = systems_.size();
+    dependencies_.assign(count, {});
+    dependents_.assign(count, {});
+    timings_.assign(count, {});
+    profile_scopes_.assign(count, utils::Profiler::kNoScope);
+
+    // Systems may run on pool threads, so their profiler scopes are
+    // registered here, under whatever scope is building the schedule
+    auto& profiler = utils::Profiler::instance();
+    int parent = utils::Profiler::current();
+    for (size_t j = 0; j < count; ++j) {
+        timings_[j].name = systems_[j]->getName();
+        profile_scopes_[j] = profiler.scope(parent, timings_[j].name);
+        for (size_t i = 0; i < j; ++i) {
+            if (conflicts(systems_[i]->getAccess(), systems_[j]->getAccess())) {
+                dependencies_[j].push_back(i);
+                dependents_[i].push_back(j);
+            }
+        }
+    }
+}
+
+size_t SystemScheduler::getCriticalPathLength() const {
+    std::vector<size_t> depth(systems_.size(), 1);
+    size_t longest = 0;
+    for (size_t j = 0; j < systems_.size(); ++j) {
+        for (size_t i : dependencies_[j]) {
+            depth[j] = std::max(depth[j], depth[i] + 1);
+        }
+        longest = std::max(longest, depth[j]);
+    }
+    return longest;
+}
+
+void SystemScheduler::runOne(size_t index, float delta_time) {
+    auto start = std::chrono::steady_clock::now();
+    {
+        utils::ProfileScope scope(profile_scopes_[index]);
+        systems_[index]->update(delta_time);
+    }
+    double ms = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+
+    auto& timing = timings_[index];
+    timing.last_ms = ms;
+    timing.total_ms += ms;
+    timing.max_ms = std::max(timing.max_ms, ms);
+    timing.runs++;
+}
+
+void SystemScheduler::run(float delta_time, utils::ThreadPool* pool) {
+    size_t count = systems_.size();
+    if (!pool || count < 2) {
+        for (size_t i = 0; i < count; ++i) runOne(i, delta_time);
+        return;
+    }
+
+    std::unique_ptr<std::atomic<size_t>[]> remaining(new std::atomic<size_t>[count]);
+    for (size_t i = 0; i < count; ++i) {
+        remaining[i].store(dependencies_[i].size(), std::memory_order_relaxed);
+    }
+
+    utils::TaskGroup group(pool);
+    std::function<void(size_t)> launch = [&](size_t index) {
+        group.run([&, index]() {
+            runOne(index, delta_time);
+            for (size_t next : dependents_[index]) {
+                if (remaining[next].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    launch(next);
+                }
+            }
+        });
+    };
+
+    for (size_t i = 0; i < count; ++i) {
+        if (dependencies_[i].empty()) launch(i);
+    }
+    group.wait();
+}
+
+} // namespace ecs
+} // namespace atlas
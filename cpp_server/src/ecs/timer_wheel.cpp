@@ -0,0 +1,191 @@
+#include "ecs/timer_wheel.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace atlas {
+namespace ecs {
+
+namespace {
+
+// Slack for times that are a whole number of ticks but not exactly
+// representable (100 s at 30 Hz is 3000 ticks, not 3000.0000000004)
+constexpr double kTickEpsilon = 1e-6;
+
+inline int lowestBit(uint64_t bits) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward64(&index, bits);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctzll(bits);
+#endif
+}
+
+inline int highestBit(uint64_t bits) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanReverse64(&index, bits);
+    return static_cast<int>(index);
+#else
+    return 63 - __builtin_clzll(bits);
+#endif
+}
+
+} // namespace
+
+TimerWheel::TimerWheel(double ticks_per_second)
+    : ticks_per_second_(ticks_per_second > 0.0 ? ticks_per_second : kDefaultTicksPerSecond),
+      heads_(static_cast<size_t>(kLevels) * kSlots, kNone) {
+}
+
+uint64_t TimerWheel::tickAt(double t) const {
+    double ticks = t * ticks_per_second_ + kTickEpsilon;
+    return ticks <= 0.0 ? 0 : static_cast<uint64_t>(std::floor(ticks));
+}
+
+TimerWheel::TimerId TimerWheel::scheduleAt(double when, uint64_t key) {
+    double ticks = std::ceil(when * ticks_per_second_ - kTickEpsilon);
+    return schedule(ticks <= 0.0 ? 0 : static_cast<uint64_t>(ticks), key);
+}
+
+TimerWheel::TimerId TimerWheel::schedule(uint64_t due_tick, uint64_t key) {
+    uint32_t index;
+    if (!free_nodes_.empty()) {
+        index = free_nodes_.back();
+        free_nodes_.pop_back();
+    } else {
+        index = static_cast<uint32_t>(nodes_.size());
+        nodes_.emplace_back();
+    }
+    Node& node = nodes_[index];
+    node.due = std::max(due_tick, cursor_ + 1);
+    node.key = key;
+    insert(index);
+    ++count_;
+    return makeId(index, node.generation);
+}
+
+bool TimerWheel::cancel(TimerId id) {
+    const Node* node = lookup(id);
+    if (!node) return false;
+    uint32_t index = static_cast<uint32_t>(id & 0xFFFFFFFFu);
+    // A timer already queued to fire this tick is skipped by advance()
+    if (node->slot != kFiring) unlink(index);
+    release(index);
+    return true;
+}
+
+bool TimerWheel::isPending(TimerId id) const {
+    return lookup(id) != nullptr;
+}
+
+const TimerWheel::Node* TimerWheel::lookup(TimerId id) const {
+    uint32_t index = static_cast<uint32_t>(id & 0xFFFFFFFFu);
+    uint32_t generation = static_cast<uint32_t>(id >> 32);
+    if (index >= nodes_.size()) return nullptr;
+    const Node& node = nodes_[index];
+    if (node.generation != generation || node.slot == kNone) return nullptr;
+    return &node;
+}
+
+void TimerWheel::insert(uint32_t index) {
+    Node& node = nodes_[index];
+    uint64_t diff = node.due ^ cursor_;
+    int level = diff == 0 ? 0 : highestBit(diff) / kSlotBits;
+    uint32_t digit = static_cast<uint32_t>(node.due >> (level * kSlotBits)) & (kSlots - 1);
+    uint32_t slot = static_cast<uint32_t>(level) * kSlots + digit;
+
+    node.slot = slot;
+    node.prev = kNone;
+    node.next = heads_[slot];
+    if (node.next != kNone) nodes_[node.next].prev = index;
+    heads_[slot] = index;
+    occupied_[level] |= uint64_t(1) << digit;
+}
+
+void TimerWheel::unlink(uint32_t index) {
+    Node& node = nodes_[index];
+    uint32_t slot = node.slot;
+    if (node.prev == kNone) heads_[slot] = node.next; else nodes_[node.prev].next = node.next;
+    if (node.next != kNone) nodes_[node.next].prev = node.prev;
+    if (heads_[slot] == kNone) {
+        occupied_[slot / kSlots] &= ~(uint64_t(1) << (slot % kSlots));
+    }
+    node.prev = node.next = kNone;
+}
+
+void TimerWheel::release(uint32_t index) {
+    Node& node = nodes_[index];
+    node.slot = kNone;
+    if (++node.generation == 0) node.generation = 1;
+    free_nodes_.push_back(index);
+    --count_;
+}
+
+bool TimerWheel::collectDue(uint64_t target) {
+    firing_.clear();
+    while (cursor_ < target) {
+        if (count_ == 0) {
+            cursor_ = target;
+            break;
+        }
+
+        // Earliest slot start on any level: a level-0 slot is a fire
+        // tick, a higher one is where its timers move down a level
+        uint64_t next = UINT64_MAX;
+        for (int level = 0; level < kLevels; ++level) {
+            if (!occupied_[level]) continue;
+            int shift = level * kSlotBits;
+            uint32_t digit = static_cast<uint32_t>(cursor_ >> shift) & (kSlots - 1);
+            if (digit == kSlots - 1) continue;
+            uint64_t ahead = occupied_[level] & (~uint64_t(0) << (digit + 1));
+            if (!ahead) continue;
+            int upper = shift + kSlotBits;
+            uint64_t base = upper >= 64 ? 0 : (cursor_ >> upper) << upper;
+            next = std::min(next, base + (static_cast<uint64_t>(lowestBit(ahead)) << shift));
+        }
+        if (next > target) {
+            cursor_ = target;
+            break;
+        }
+        cursor_ = next;
+
+        for (int level = kLevels - 1; level > 0; --level) {
+            int shift = level * kSlotBits;
+            if ((cursor_ & ((uint64_t(1) << shift) - 1)) != 0) continue;
+            uint32_t digit = static_cast<uint32_t>(cursor_ >> shift) & (kSlots - 1);
+            uint32_t slot = static_cast<uint32_t>(level) * kSlots + digit;
+            uint32_t index = heads_[slot];
+            if (index == kNone) continue;
+            heads_[slot] = kNone;
+            occupied_[level] &= ~(uint64_t(1) << digit);
+            while (index != kNone) {
+                uint32_t following = nodes_[index].next;
+                insert(index);
+                index = following;
+            }
+        }
+
+        uint32_t digit = static_cast<uint32_t>(cursor_) & (kSlots - 1);
+        uint32_t index = heads_[digit];
+        if (index == kNone) continue;
+        heads_[digit] = kNone;
+        occupied_[0] &= ~(uint64_t(1) << digit);
+        while (index != kNone) {
+            Node& node = nodes_[index];
+            node.slot = kFiring;
+            firing_.push_back(index);
+            index = node.next;
+            node.prev = node.next = kNone;
+        }
+        return true;
+    }
+    return false;
+}
+
+} // namespace ecs
+} // namespace atlas
@@ -1,18 +1,72 @@
 #include "ecs/world.h"
+#include "utils/profiler.h"
+#include "utils/thread_pool.h"
 #include <iostream>
 
 namespace atlas {
 namespace ecs {
 
+World::World() {
+    for (auto& slot : query_slots_) {
+        slot.store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+World::~World() {
+    // Stop workers before systems and entities go away
+    thread_pool_.reset();
+}
+
 Entity* World::createEntity(const std::string& id) {
-    auto entity = std::make_unique<Entity>(id);
+    auto entity = std::make_unique<Entity>(id, &storage_, this);
     Entity* ptr = entity.get();
-    entities_[id] = std::move(entity);
+    auto& slot = entities_[id];
+    if (slot) {
+        forgetEntity(slot.get());
+        releaseHandle(slot->getHandle());
+    }
+    ptr->handle_ = allocateHandle(ptr);
+    slot = std::move(entity);
     return ptr;
 }
 
 void World::destroyEntity(const std::string& id) {
-    entities_.erase(id);
+    auto it = entities_.find(id);
+    if (it == entities_.end()) return;
+    forgetEntity(it->second.get());
+    releaseHandle(it->second->getHandle());
+    entities_.erase(it);
+}
+
+EntityHandle World::getHandle(const std::string& id) const {
+    auto it = entities_.find(id);
+    if (it != entities_.end()) {
+        return it->second->getHandle();
+    }
+    return EntityHandle{};
+}
+
+EntityHandle World::allocateHandle(Entity* entity) {
+    uint32_t index;
+    if (!free_slots_.empty()) {
+        index = free_slots_.back();
+        free_slots_.pop_back();
+    } else {
+        index = static_cast<uint32_t>(slots_.size());
+        slots_.emplace_back();
+    }
+    slots_[index].entity = entity;
+    slots_[index].created = ++next_created_;
+    return EntityHandle{index, slots_[index].generation};
+}
+
+void World::releaseHandle(EntityHandle handle) {
+    if (!getEntity(handle)) return;
+    EntitySlot& slot = slots_[handle.index];
+    slot.entity = nullptr;
+    // Skip 0 on wrap-around so a recycled slot never issues an invalid handle
+    if (++slot.generation == 0) slot.generation = 1;
+    free_slots_.push_back(handle.index);
 }
 
 Entity* World::getEntity(const std::string& id) {
@@ -42,14 +96,208 @@ std::vector<Entity*> World::getAllEntities() {
     return result;
 }
 
+std::vector<Entity*> World::entitiesInCreationOrder() const {
+    std::vector<const EntitySlot*> live;
+    live.reserve(entities_.size());
+    for (const auto& slot : slots_) {
+        if (slot.entity) live.push_back(&slot);
+    }
+    std::sort(live.begin(), live.end(), [](const EntitySlot* a, const EntitySlot* b) {
+        return a->created < b->created;
+    });
+    std::vector<Entity*> result;
+    result.reserve(live.size());
+    for (const EntitySlot* slot : live) {
+        result.push_back(slot->entity);
+    }
+    return result;
+}
+
+World::HandleLayout World::getHandleLayout() const {
+    HandleLayout layout;
+    layout.generations.reserve(slots_.size());
+    for (const auto& slot : slots_) {
+        layout.generations.push_back(slot.generation);
+    }
+    layout.free_slots = free_slots_;
+    for (Entity* entity : entitiesInCreationOrder()) {
+        layout.entities.push_back({entity->getId(), entity->getHandle().index});
+    }
+    return layout;
+}
+
+bool World::restoreHandleLayout(const HandleLayout& layout) {
+    if (layout.entities.size() != entities_.size()) return false;
+    std::vector<bool> taken(layout.generations.size(), false);
+    for (const auto& placement : layout.entities) {
+        if (placement.index >= taken.size() || taken[placement.index] ||
+            !entities_.count(placement.id)) {
+            return false;
+        }
+        taken[placement.index] = true;
+    }
+    for (uint32_t index : layout.free_slots) {
+        if (index >= taken.size() || taken[index]) return false;
+        taken[index] = true;
+    }
+
+    slots_.assign(layout.generations.size(), EntitySlot{});
+    for (size_t i = 0; i < slots_.size(); ++i) {
+        slots_[i].generation = layout.generations[i];
+    }
+    free_slots_ = layout.free_slots;
+    next_created_ = 0;
+    for (const auto& placement : layout.entities) {
+        Entity* entity = entities_[placement.id].get();
+        EntitySlot& slot = slots_[placement.index];
+        slot.entity = entity;
+        slot.created = ++next_created_;
+        entity->handle_ = EntityHandle{placement.index, slot.generation};
+    }
+    canonicalize();
+    return true;
+}
+
+void World::canonicalize() {
+    std::vector<Entity*> order = entitiesInCreationOrder();
+
+    // Each pool's occupied slots, listed in the order their owners were created
+    std::vector<std::vector<uint32_t>> slots_by_type(storage_.poolCount());
+    for (Entity* entity : order) {
+        for (const auto& ref : entity->components_) {
+            slots_by_type[ref.type].push_back(ref.slot);
+        }
+    }
+    for (ComponentTypeId type = 0; type < slots_by_type.size(); ++type) {
+        if (ComponentPoolBase* pool = storage_.poolById(type)) pool->reorder(slots_by_type[type]);
+    }
+    std::vector<uint32_t> next_slot(slots_by_type.size(), 0);
+    for (Entity* entity : order) {
+        for (auto& ref : entity->components_) {
+            ref.slot = next_slot[ref.type]++;
+            ref.ptr = storage_.poolById(ref.type)->component(ref.slot);
+        }
+    }
+
+    for (auto& pair : queries_) {
+        pair.second->clear();
+    }
+    for (Entity* entity : order) {
+        for (auto& pair : queries_) {
+            pair.second->refresh(entity);
+        }
+    }
+}
+
+Query& World::registerQuery(std::vector<ComponentTypeId> types) {
+    std::sort(types.begin(), types.end());
+    types.erase(std::unique(types.begin(), types.end()), types.end());
+    
+    auto& query = queries_[types];
+    if (query) return *query;
+    
+    query = std::make_unique<Query>(types);
+    for (ComponentTypeId type : types) {
+        if (type >= queries_by_type_.size()) queries_by_type_.resize(type + 1);
+        queries_by_type_[type].push_back(query.get());
+    }
+    for (Entity* entity : entitiesInCreationOrder()) {
+        query->refresh(entity);
+    }
+    return *query;
+}
+
+void World::forgetEntity(Entity* entity) {
+    for (auto& pair : queries_) {
+        pair.second->remove(entity);
+    }
+}
+
+void World::onComponentAdded(Entity* entity, ComponentTypeId type) {
+    if (type >= queries_by_type_.size()) return;
+    for (Query* query : queries_by_type_[type]) {
+        query->refresh(entity);
+    }
+}
+
+void World::onComponentRemoved(Entity* entity, ComponentTypeId type) {
+    if (type >= queries_by_type_.size()) return;
+    for (Query* query : queries_by_type_[type]) {
+        query->remove(entity);
+    }
+}
+
+void World::onComponentReplaced(Entity* entity, ComponentTypeId type) {
+    if (type >= queries_by_type_.size()) return;
+    for (Query* query : queries_by_type_[type]) {
+        query->touch(*entity);
+    }
+}
+
 void World::addSystem(std::unique_ptr<System> system) {
     systems_.push_back(std::move(system));
+    scheduler_dirty_ = true;
 }
 
 void World::update(float delta_time) {
-    for (auto& system : systems_) {
-        system->update(delta_time);
+    if (scheduler_dirty_) {
+        std::vector<System*> systems;
+        systems.reserve(systems_.size());
+        for (auto& system : systems_) {
+            systems.push_back(system.get());
+        }
+        scheduler_.build(systems);
+        scheduler_dirty_ = false;
+    }
+    updating_ = true;
+    scheduler_.run(delta_time, thread_pool_.get());
+    updating_ = false;
+    // Sync point: structural changes recorded by systems land here
+    utils::ProfileScope scope("commands");
+    commands_.apply(*this);
+}
+
+void World::defer(CommandBuffer::Command command) {
+    if (updating_) {
+        commands_.record(std::move(command));
+    } else {
+        command(*this);
+    }
+}
+
+TimerWheel& World::getTimerWheel(const std::string& name) {
+    std::lock_guard<std::mutex> lock(timer_wheel_mutex_);
+    auto& wheel = timer_wheels_[name];
+    if (!wheel) wheel = std::make_unique<TimerWheel>();
+    return *wheel;
+}
+
+void World::parallelFor(size_t count, size_t chunk_size,
+                        const std::function<void(size_t, size_t)>& body) {
+    if (count == 0) return;
+    if (chunk_size == 0 || chunk_size > count) chunk_size = count;
+    if (!thread_pool_ || chunk_size == count) {
+        body(0, count);
+        return;
     }
+    utils::TaskGroup group(thread_pool_.get());
+    for (size_t begin = 0; begin < count; begin += chunk_size) {
+        size_t end = std::min(count, begin + chunk_size);
+        group.run([&body, begin, end] { body(begin, end); });
+    }
+    group.wait();
+}
+
+void World::setWorkerThreads(size_t count) {
+    if (count == getWorkerThreads()) return;
+    thread_pool_.reset();
+    if (count > 0) {
+        thread_pool_ = std::make_unique<utils::ThreadPool>(count);
+    }
+}
+
+size_t World::getWorkerThreads() const {
+    return thread_pool_ ? thread_pool_->getWorkerCount() : 0;
 }
 
 } // namespace ecs
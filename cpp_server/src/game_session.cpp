@@ -8,6 +8,7 @@
 #include "systems/anomaly_system.h"
 #include "systems/mission_system.h"
 #include "systems/mission_generator_system.h"
+#include "utils/profiler.h"
 #include <iostream>
 #include <sstream>
 #include <cmath>
@@ -52,21 +53,32 @@ static std::string escapeJsonString(const std::string& input) {
 GameSession::GameSession(ecs::World* world, network::TCPServer* tcp_server,
                          const std::string& data_path)
     : world_(world)
-    , tcp_server_(tcp_server) {
+    , tcp_server_(tcp_server)
+    , interest_(world) {
     // Load ship data from JSON
     ship_db_.loadFromDirectory(data_path);
 }
 
-void GameSession::initialize() {
+void GameSession::initialize(bool spawn_initial_npcs) {
     // Register the message handler on the TCP server
     tcp_server_->setMessageHandler(
         [this](const network::ClientConnection& client, const std::string& raw) {
             onClientMessage(client, raw);
         }
     );
+    tcp_server_->setDisconnectHandler(
+        [this](const network::ClientConnection& client) {
+            InboundCommand cmd;
+            cmd.kind = InboundCommand::Kind::Disconnect;
+            cmd.client = client;
+            inbound_.push(std::move(cmd));
+        }
+    );
 
     // Spawn a handful of NPC enemies so the world isn't empty
-    spawnInitialNPCs();
+    if (spawn_initial_npcs) {
+        spawnInitialNPCs();
+    }
 
     std::cout << "[GameSession] Initialized – "
               << world_->getEntityCount() << " entities in world"
@@ -79,12 +91,55 @@ void GameSession::initialize() {
 // ---------------------------------------------------------------------------
 
 void GameSession::update(float /*delta_time*/) {
-    // Build a single state-update message and broadcast it to every client
-    std::string state_msg = buildStateUpdate();
+    utils::ProfileScope session_scope("session");
 
+    // Send every client only the entities relevant to it
+    network::InterestManager::Snapshot snapshot;
+
+    // Updates are replaceable: the network layer drops queued ones for a
+    // lagging client. SnapshotDelta only trusts updates that were acked to
+    // carry an entity; removals are carried forward here until an ack
+    // covers them.
+    network::TCPServer::SendBatch batch;
     std::lock_guard<std::mutex> lock(players_mutex_);
-    for (const auto& kv : players_) {
-        tcp_server_->sendToClient(kv.second.connection, state_msg);
+    fragments_.beginTick();
+    for (auto& kv : players_) {
+        PlayerInfo& player = kv.second;
+        uint64_t sequence = player.snapshot_sequence++;
+        {
+            utils::ProfileScope scope("interest");
+            interest_.collect(player.entity_id, player.interest, snapshot);
+        }
+
+        for (const auto* entity : snapshot.entities) {
+            player.unacked_removed.erase(entity->getId());
+        }
+        for (const auto& id : snapshot.removed) {
+            player.unacked_removed[id] = sequence;
+            player.delta.forget(id);
+        }
+        for (const auto& pending : player.unacked_removed) {
+            if (pending.second != sequence) {
+                snapshot.removed.push_back(pending.first);
+            }
+        }
+
+        if (player.binary_wire) {
+            {
+                utils::ProfileScope scope("encode");
+                buildBinaryStateUpdate(snapshot, sequence, player.delta, state_frame_);
+            }
+            utils::ProfileScope scope("send");
+            tcp_server_->sendToClient(player.connection, state_frame_, true);
+        } else {
+            std::string state_msg;
+            {
+                utils::ProfileScope scope("encode");
+                state_msg = buildStateUpdate(snapshot, sequence, player.delta);
+            }
+            utils::ProfileScope scope("send");
+            tcp_server_->sendToClient(player.connection, state_msg, true);
+        }
     }
 }
 
@@ -99,15 +154,60 @@ int GameSession::getPlayerCount() const {
 
 void GameSession::onClientMessage(const network::ClientConnection& client,
                                   const std::string& raw) {
-    network::MessageType type;
-    std::string data;
+    InboundCommand cmd;
+    cmd.client = client;
+
+    if (network::wire::isFrame(raw)) {
+        // Queue each frame on its own; malformed input ends the batch
+        size_t offset = 0;
+        while (offset < raw.size()) {
+            network::wire::Header header;
+            size_t frame_size = 0;
+            if (network::wire::peekFrame(raw.data() + offset, raw.size() - offset, header, frame_size)
+                    != network::wire::FrameStatus::Complete) {
+                std::cerr << "[GameSession] Malformed binary frame from "
+                          << client.address << std::endl;
+                return;
+            }
+            cmd.kind = InboundCommand::Kind::Frame;
+            cmd.data.assign(raw, offset, frame_size);
+            inbound_.push(cmd);
+            offset += frame_size;
+        }
+        return;
+    }
 
-    if (!protocol_.parseMessage(raw, type, data)) {
+    if (!protocol_.parseMessage(raw, cmd.type, cmd.data)) {
         std::cerr << "[GameSession] Unrecognised message from "
                   << client.address << std::endl;
         return;
     }
+    inbound_.push(std::move(cmd));
+}
+
+size_t GameSession::processInbound() {
+    size_t applied = 0;
+    InboundCommand cmd;
+    while (inbound_.pop(cmd)) {
+        if (recorder_) recorder_->recordCommand(cmd);
+        switch (cmd.kind) {
+            case InboundCommand::Kind::Message:
+                dispatchMessage(cmd.client, cmd.type, cmd.data);
+                break;
+            case InboundCommand::Kind::Frame:
+                handleBinaryMessage(cmd.client, cmd.data);
+                break;
+            case InboundCommand::Kind::Disconnect:
+                handleDisconnect(cmd.client);
+                break;
+        }
+        ++applied;
+    }
+    return applied;
+}
 
+void GameSession::dispatchMessage(const network::ClientConnection& client,
+                                  network::MessageType type, const std::string& data) {
     switch (type) {
         case network::MessageType::CONNECT:
             handleConnect(client, data);
@@ -121,6 +221,9 @@ void GameSession::onClientMessage(const network::ClientConnection& client,
         case network::MessageType::CHAT:
             handleChat(client, data);
             break;
+        case network::MessageType::STATE_ACK:
+            handleStateAck(client, data);
+            break;
         case network::MessageType::TARGET_LOCK:
             handleTargetLock(client, data);
             break;
@@ -211,24 +314,23 @@ void GameSession::handleConnect(const network::ClientConnection& client,
         char_name.resize(MAX_CHARACTER_NAME_LEN);
     }
 
+    // Binary encoding is used only if the client asks for this version
+    bool binary_wire = extractJsonString(data, "wire") == "binary" &&
+        static_cast<int>(extractJsonFloat(data, "\"wire_version\":", 0.0f)) == network::wire::kVersion;
+
     // Create the player's ship entity in the game world
     std::string entity_id = createPlayerEntity(player_id, char_name);
 
-    // Record the mapping and snapshot other players for notification
-    std::vector<PlayerInfo> others;
+    // Record the mapping
     {
         std::lock_guard<std::mutex> lock(players_mutex_);
         PlayerInfo info;
         info.entity_id      = entity_id;
         info.character_name  = char_name;
         info.connection      = client;
+        info.interest.phase  = next_interest_phase_++;
+        info.binary_wire     = binary_wire;
         players_[static_cast<int>(client.socket)] = info;
-
-        for (const auto& kv : players_) {
-            if (kv.first != static_cast<int>(client.socket)) {
-                others.push_back(kv.second);
-            }
-        }
     }
 
     // Escape char_name for safe JSON embedding
@@ -240,24 +342,18 @@ void GameSession::handleConnect(const network::ClientConnection& client,
         << "\"data\":{"
         << "\"success\":true,"
         << "\"player_entity_id\":\"" << entity_id << "\","
+        << "\"wire\":\"" << (binary_wire ? "binary" : "json") << "\","
+        << "\"wire_version\":" << static_cast<int>(network::wire::kVersion) << ","
         << "\"message\":\"Welcome, " << safe_name << "!\""
         << "}}";
     tcp_server_->sendToClient(client, ack.str());
 
-    // Send spawn_entity messages for every existing entity
-    for (auto* entity : world_->getAllEntities()) {
-        std::string spawn_msg = buildSpawnEntity(entity->getId());
-        tcp_server_->sendToClient(client, spawn_msg);
-    }
+    // Existing entities, and this ship for other players, arrive with the
+    // next state update once they are in the receiving client's
+    // relevance set (the first update for a client is always complete)
 
     std::cout << "[GameSession] Player connected: " << char_name
               << " (entity " << entity_id << ")" << std::endl;
-
-    // Notify other clients about the new player entity
-    std::string new_spawn = buildSpawnEntity(entity_id);
-    for (const auto& other : others) {
-        tcp_server_->sendToClient(other.connection, new_spawn);
-    }
 }
 
 // ---------------------------------------------------------------------------
@@ -269,7 +365,7 @@ void GameSession::handleDisconnect(const network::ClientConnection& client) {
     {
         std::lock_guard<std::mutex> lock(players_mutex_);
         auto it = players_.find(static_cast<int>(client.socket));
-        if (it != players_.end()) {
+        if (it != players_.end() && it->second.connection.port == client.port) {
             entity_id = it->second.entity_id;
             std::cout << "[GameSession] Player disconnected: "
                       << it->second.character_name << std::endl;
@@ -284,8 +380,9 @@ void GameSession::handleDisconnect(const network::ClientConnection& client) {
         std::ostringstream msg;
         msg << "{\"type\":\"destroy_entity\","
             << "\"data\":{\"entity_id\":\"" << entity_id << "\"}}";
-        std::string destroy_msg = msg.str();
+        network::MessageBuffer destroy_msg(msg.str());   // shared by every recipient
 
+        network::TCPServer::SendBatch batch;
         std::lock_guard<std::mutex> lock(players_mutex_);
         for (const auto& kv : players_) {
             tcp_server_->sendToClient(kv.second.connection, destroy_msg);
@@ -299,13 +396,20 @@ void GameSession::handleDisconnect(const network::ClientConnection& client) {
 
 void GameSession::handleInputMove(const network::ClientConnection& client,
                                   const std::string& data) {
+    // Parse velocity – the client sends {"velocity":{"x":..,"y":..,"z":..}}
+    // Our lightweight parser operates on the inner data block.
+    float vx = extractJsonFloat(data, "\"x\":", 0.0f);
+    float vy = extractJsonFloat(data, "\"y\":", 0.0f);
+    float vz = extractJsonFloat(data, "\"z\":", 0.0f);
+
+    applyInputMove(client, vx, vy, vz);
+}
+
+void GameSession::applyInputMove(const network::ClientConnection& client,
+                                 float vx, float vy, float vz) {
     std::string entity_id;
-    {
-        std::lock_guard<std::mutex> lock(players_mutex_);
-        auto it = players_.find(static_cast<int>(client.socket));
-        if (it == players_.end()) return;
-        entity_id = it->second.entity_id;
-    }
+    bool binary = false;
+    if (!findPlayer(client, entity_id, binary)) return;
 
     auto* entity = world_->getEntity(entity_id);
     if (!entity) return;
@@ -313,17 +417,39 @@ void GameSession::handleInputMove(const network::ClientConnection& client,
     auto* vel = entity->getComponent<components::Velocity>();
     if (!vel) return;
 
-    // Parse velocity – the client sends {"velocity":{"x":..,"y":..,"z":..}}
-    // Our lightweight parser operates on the inner data block.
-    float vx = extractJsonFloat(data, "\"x\":", 0.0f);
-    float vy = extractJsonFloat(data, "\"y\":", 0.0f);
-    float vz = extractJsonFloat(data, "\"z\":", 0.0f);
-
     vel->vx = vx;
     vel->vy = vy;
     vel->vz = vz;
 }
 
+// ---------------------------------------------------------------------------
+// STATE_ACK handler
+// ---------------------------------------------------------------------------
+
+void GameSession::handleStateAck(const network::ClientConnection& client,
+                                 const std::string& data) {
+    uint64_t sequence = 0;
+    if (!extractJsonUInt(data, "\"sequence\":", sequence)) return;
+
+    applyStateAck(client, sequence);
+}
+
+void GameSession::applyStateAck(const network::ClientConnection& client, uint64_t sequence) {
+    std::lock_guard<std::mutex> lock(players_mutex_);
+    auto it = players_.find(static_cast<int>(client.socket));
+    if (it == players_.end()) return;
+
+    // Acks for snapshots that were never sent would corrupt the baseline
+    if (sequence >= it->second.snapshot_sequence) return;
+    it->second.delta.acknowledge(sequence);
+
+    auto& removed = it->second.unacked_removed;
+    for (auto r = removed.begin(); r != removed.end(); ) {
+        if (r->second <= sequence) r = removed.erase(r);
+        else ++r;
+    }
+}
+
 // ---------------------------------------------------------------------------
 // CHAT handler
 // ---------------------------------------------------------------------------
@@ -350,93 +476,69 @@ void GameSession::handleChat(const network::ClientConnection& client,
     std::string chat_msg = protocol_.createChatMessage(
         escapeJsonString(sender), escapeJsonString(message));
 
-    // Broadcast chat to everyone
-    tcp_server_->broadcastToAll(chat_msg);
+    // Broadcast chat to everyone; serialized once, shared by every connection
+    tcp_server_->broadcastToAll(network::MessageBuffer(std::move(chat_msg)));
 }
 
 // ---------------------------------------------------------------------------
 // State broadcast helpers
 // ---------------------------------------------------------------------------
 
-std::string GameSession::buildStateUpdate() const {
-    // Increment snapshot sequence number for packet loss detection
-    uint64_t seq = snapshot_sequence_++;
-    
+std::string GameSession::buildStateUpdate(const network::InterestManager::Snapshot& snapshot,
+                                          uint64_t sequence, network::SnapshotDelta& delta) {
     std::ostringstream json;
     json << "{\"type\":\"state_update\",\"data\":{"
-         << "\"sequence\":" << seq << ","
-         << "\"timestamp\":" << std::chrono::duration_cast<std::chrono::milliseconds>(
-                std::chrono::steady_clock::now().time_since_epoch()).count() << ","
-         << "\"entities\":[";
-
-    auto entities = world_->getAllEntities();
-    bool first = true;
-    for (const auto* entity : entities) {
-        if (!first) json << ",";
-        first = false;
-
-        auto* pos  = entity->getComponent<components::Position>();
-        auto* vel  = entity->getComponent<components::Velocity>();
-        auto* hp   = entity->getComponent<components::Health>();
-
-        json << "{\"id\":\"" << entity->getId() << "\"";
-
-        // Position
-        if (pos) {
-            json << ",\"pos\":{\"x\":" << pos->x
-                 << ",\"y\":" << pos->y
-                 << ",\"z\":" << pos->z
-                 << ",\"rot\":" << pos->rotation << "}";
-        }
-
-        // Velocity
-        if (vel) {
-            json << ",\"vel\":{\"vx\":" << vel->vx
-                 << ",\"vy\":" << vel->vy
-                 << ",\"vz\":" << vel->vz << "}";
-        }
+         << "\"sequence\":" << sequence << ",";
 
-        // Health
-        if (hp) {
-            json << ",\"health\":{"
-                 << "\"shield\":" << hp->shield_hp
-                 << ",\"armor\":" << hp->armor_hp
-                 << ",\"hull\":" << hp->hull_hp
-                 << ",\"max_shield\":" << hp->shield_max
-                 << ",\"max_armor\":" << hp->armor_max
-                 << ",\"max_hull\":" << hp->hull_max
-                 << "}";
-        }
+    uint64_t baseline = 0;
+    if (delta.baselineFor(sequence, baseline)) {
+        json << "\"baseline\":" << baseline << ",";
+    }
 
-        // Capacitor
-        auto* cap = entity->getComponent<components::Capacitor>();
-        if (cap) {
-            json << ",\"capacitor\":{"
-                 << "\"current\":" << cap->capacitor
-                 << ",\"max\":" << cap->capacitor_max
-                 << "}";
-        }
+    json << "\"timestamp\":" << std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count() << ","
+         << "\"partial\":true,"
+         << "\"removed\":[";
 
-        // Ship info (needed for correct model selection on the client)
-        auto* ship = entity->getComponent<components::Ship>();
-        if (ship) {
-            json << ",\"ship_type\":\"" << ship->ship_type << "\"";
-            json << ",\"ship_name\":\"" << ship->ship_name << "\"";
-        }
+    for (size_t i = 0; i < snapshot.removed.size(); ++i) {
+        if (i > 0) json << ",";
+        json << "\"" << snapshot.removed[i] << "\"";
+    }
 
-        // Faction (needed for correct model coloring on the client)
-        auto* fac = entity->getComponent<components::Faction>();
-        if (fac) {
-            json << ",\"faction\":\"" << fac->faction_name << "\"";
-        }
+    json << "],\"entities\":[";
 
-        json << "}";
+    // Only fields changed since the client's baseline are written
+    bool first = true;
+    for (const auto* entity : snapshot.entities) {
+        delta.writeEntity(json, fragments_.get(*entity), sequence, first);
     }
 
     json << "]}}";
     return json.str();
 }
 
+void GameSession::buildBinaryStateUpdate(const network::InterestManager::Snapshot& snapshot,
+                                         uint64_t sequence, network::SnapshotDelta& delta,
+                                         std::string& out) {
+    network::wire::StateUpdate& msg = wire_update_;
+    msg.sequence = sequence;
+    msg.has_baseline = delta.baselineFor(sequence, msg.baseline);
+    msg.partial = true;
+    msg.timestamp = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+    msg.removed = snapshot.removed;
+
+    // Entity records are spliced in from the tick's fragment cache
+    size_t count = 0;
+    entity_records_.clear();
+    for (const auto* entity : snapshot.entities) {
+        if (delta.appendEntityRecord(entity_records_, fragments_.get(*entity), sequence)) ++count;
+    }
+
+    out.clear();
+    network::wire::encode(msg, entity_records_, count, out);
+}
+
 std::string GameSession::buildSpawnEntity(const std::string& entity_id) const {
     auto* entity = world_->getEntity(entity_id);
     if (!entity) return "{}";
@@ -587,6 +689,10 @@ std::string GameSession::createPlayerEntity(const std::string& player_id,
     cap->recharge_rate = tmpl ? (tmpl->capacitor / tmpl->capacitor_recharge_time) : 3.0f;
     entity->addComponent(std::move(cap));
 
+    auto loc = std::make_unique<components::SystemLocation>();
+    loc->system_id = solar_system_;
+    entity->addComponent(std::move(loc));
+
     return entity_id;
 }
 
@@ -665,6 +771,10 @@ void GameSession::spawnNPC(const std::string& id, const std::string& name,
     weapon->rate_of_fire  = 4.0f;
     entity->addComponent(std::move(weapon));
 
+    auto loc = std::make_unique<components::SystemLocation>();
+    loc->system_id = solar_system_;
+    entity->addComponent(std::move(loc));
+
     std::cout << "[GameSession] Spawned NPC: " << name
               << " (" << faction_name << " " << ship_name << ")" << std::endl;
 }
@@ -675,23 +785,34 @@ void GameSession::spawnNPC(const std::string& id, const std::string& name,
 
 void GameSession::handleTargetLock(const network::ClientConnection& client,
                                    const std::string& data) {
-    std::string entity_id;
-    {
-        std::lock_guard<std::mutex> lock(players_mutex_);
-        auto it = players_.find(static_cast<int>(client.socket));
-        if (it == players_.end()) return;
-        entity_id = it->second.entity_id;
-    }
-
     std::string target_id = extractJsonString(data, "target_id");
     if (target_id.empty()) return;
 
+    applyTargetLock(client, target_id);
+}
+
+void GameSession::applyTargetLock(const network::ClientConnection& client,
+                                  const std::string& target_id) {
+    std::string entity_id;
+    bool binary = false;
+    if (!findPlayer(client, entity_id, binary)) return;
+
     bool success = false;
     if (targeting_system_) {
         success = targeting_system_->startLock(entity_id, target_id);
     }
 
     // Send acknowledgement to the requesting client
+    if (binary) {
+        network::wire::TargetMessage msg;
+        msg.target_id = target_id;
+        msg.success = success;
+        std::string frame;
+        network::wire::encode(network::wire::Type::TargetLockAck, msg, frame);
+        tcp_server_->sendToClient(client, frame);
+        return;
+    }
+
     std::ostringstream ack;
     ack << "{\"type\":\"target_lock_ack\",\"data\":{"
         << "\"success\":" << (success ? "true" : "false") << ","
@@ -706,22 +827,32 @@ void GameSession::handleTargetLock(const network::ClientConnection& client,
 
 void GameSession::handleTargetUnlock(const network::ClientConnection& client,
                                      const std::string& data) {
-    std::string entity_id;
-    {
-        std::lock_guard<std::mutex> lock(players_mutex_);
-        auto it = players_.find(static_cast<int>(client.socket));
-        if (it == players_.end()) return;
-        entity_id = it->second.entity_id;
-    }
-
     std::string target_id = extractJsonString(data, "target_id");
     if (target_id.empty()) return;
 
+    applyTargetUnlock(client, target_id);
+}
+
+void GameSession::applyTargetUnlock(const network::ClientConnection& client,
+                                    const std::string& target_id) {
+    std::string entity_id;
+    bool binary = false;
+    if (!findPlayer(client, entity_id, binary)) return;
+
     if (targeting_system_) {
         targeting_system_->unlockTarget(entity_id, target_id);
     }
 
     // Send acknowledgement
+    if (binary) {
+        network::wire::TargetMessage msg;
+        msg.target_id = target_id;
+        std::string frame;
+        network::wire::encode(network::wire::Type::TargetUnlockAck, msg, frame);
+        tcp_server_->sendToClient(client, frame);
+        return;
+    }
+
     std::ostringstream ack;
     ack << "{\"type\":\"target_unlock_ack\",\"data\":{"
         << "\"target_id\":\"" << escapeJsonString(target_id) << "\""
@@ -735,17 +866,18 @@ void GameSession::handleTargetUnlock(const network::ClientConnection& client,
 
 void GameSession::handleModuleActivate(const network::ClientConnection& client,
                                        const std::string& data) {
-    std::string entity_id;
-    {
-        std::lock_guard<std::mutex> lock(players_mutex_);
-        auto it = players_.find(static_cast<int>(client.socket));
-        if (it == players_.end()) return;
-        entity_id = it->second.entity_id;
-    }
-
     int slot_index = static_cast<int>(extractJsonFloat(data, "\"slot_index\":", -1.0f));
     std::string target_id = extractJsonString(data, "target_id");
 
+    applyModuleActivate(client, slot_index, target_id);
+}
+
+void GameSession::applyModuleActivate(const network::ClientConnection& client,
+                                      int slot_index, const std::string& target_id) {
+    std::string entity_id;
+    bool binary = false;
+    if (!findPlayer(client, entity_id, binary)) return;
+
     auto* entity = world_->getEntity(entity_id);
     if (!entity) return;
 
@@ -769,6 +901,16 @@ void GameSession::handleModuleActivate(const network::ClientConnection& client,
         }
     }
 
+    if (binary) {
+        network::wire::ModuleMessage msg;
+        msg.slot_index = slot_index;
+        msg.success = success;
+        std::string frame;
+        network::wire::encode(network::wire::Type::ModuleActivateAck, msg, frame);
+        tcp_server_->sendToClient(client, frame);
+        return;
+    }
+
     std::ostringstream ack;
     ack << "{\"type\":\"module_activate_ack\",\"data\":{"
         << "\"success\":" << (success ? "true" : "false") << ","
@@ -783,17 +925,26 @@ void GameSession::handleModuleActivate(const network::ClientConnection& client,
 
 void GameSession::handleModuleDeactivate(const network::ClientConnection& client,
                                          const std::string& data) {
-    std::string entity_id;
-    {
-        std::lock_guard<std::mutex> lock(players_mutex_);
-        auto it = players_.find(static_cast<int>(client.socket));
-        if (it == players_.end()) return;
-        entity_id = it->second.entity_id;
-    }
-
     int slot_index = static_cast<int>(extractJsonFloat(data, "\"slot_index\":", -1.0f));
 
+    applyModuleDeactivate(client, slot_index);
+}
+
+void GameSession::applyModuleDeactivate(const network::ClientConnection& client, int slot_index) {
+    std::string entity_id;
+    bool binary = false;
+    if (!findPlayer(client, entity_id, binary)) return;
+
     // Module deactivation acknowledged (future: stop active module cycles)
+    if (binary) {
+        network::wire::ModuleMessage msg;
+        msg.slot_index = slot_index;
+        std::string frame;
+        network::wire::encode(network::wire::Type::ModuleDeactivateAck, msg, frame);
+        tcp_server_->sendToClient(client, frame);
+        return;
+    }
+
     std::ostringstream ack;
     ack << "{\"type\":\"module_deactivate_ack\",\"data\":{"
         << "\"slot_index\":" << slot_index
@@ -801,6 +952,83 @@ void GameSession::handleModuleDeactivate(const network::ClientConnection& client
     tcp_server_->sendToClient(client, ack.str());
 }
 
+// ---------------------------------------------------------------------------
+// Binary wire-protocol dispatch
+// ---------------------------------------------------------------------------
+
+void GameSession::handleBinaryMessage(const network::ClientConnection& client,
+                                      const std::string& raw) {
+    namespace wire = network::wire;
+
+    size_t offset = 0;
+    while (offset < raw.size()) {
+        wire::Header header;
+        size_t frame_size = 0;
+        if (wire::peekFrame(raw.data() + offset, raw.size() - offset, header, frame_size)
+                != wire::FrameStatus::Complete) {
+            std::cerr << "[GameSession] Malformed binary frame from "
+                      << client.address << std::endl;
+            return;
+        }
+
+        const char* payload = raw.data() + offset + wire::kHeaderSize;
+        size_t size = header.length;
+        offset += frame_size;
+
+        switch (header.type) {
+            case wire::Type::InputMove: {
+                wire::InputMove msg;
+                if (wire::decode(payload, size, msg)) applyInputMove(client, msg.vx, msg.vy, msg.vz);
+                break;
+            }
+            case wire::Type::StateAck: {
+                wire::StateAck msg;
+                if (wire::decode(payload, size, msg)) applyStateAck(client, msg.sequence);
+                break;
+            }
+            case wire::Type::TargetLock: {
+                wire::TargetMessage msg;
+                if (wire::decode(payload, size, msg) && !msg.target_id.empty()) {
+                    applyTargetLock(client, msg.target_id);
+                }
+                break;
+            }
+            case wire::Type::TargetUnlock: {
+                wire::TargetMessage msg;
+                if (wire::decode(payload, size, msg) && !msg.target_id.empty()) {
+                    applyTargetUnlock(client, msg.target_id);
+                }
+                break;
+            }
+            case wire::Type::ModuleActivate: {
+                wire::ModuleMessage msg;
+                if (wire::decode(payload, size, msg)) {
+                    applyModuleActivate(client, msg.slot_index, msg.target_id);
+                }
+                break;
+            }
+            case wire::Type::ModuleDeactivate: {
+                wire::ModuleMessage msg;
+                if (wire::decode(payload, size, msg)) applyModuleDeactivate(client, msg.slot_index);
+                break;
+            }
+            default:
+                // Server-to-client types are never accepted inbound
+                break;
+        }
+    }
+}
+
+bool GameSession::findPlayer(const network::ClientConnection& client,
+                             std::string& entity_id, bool& binary) const {
+    std::lock_guard<std::mutex> lock(players_mutex_);
+    auto it = players_.find(static_cast<int>(client.socket));
+    if (it == players_.end()) return false;
+    entity_id = it->second.entity_id;
+    binary = it->second.binary_wire;
+    return true;
+}
+
 // ---------------------------------------------------------------------------
 // Lightweight JSON helpers (no external library required)
 // ---------------------------------------------------------------------------
@@ -849,6 +1077,28 @@ float GameSession::extractJsonFloat(const std::string& json,
     }
 }
 
+bool GameSession::extractJsonUInt(const std::string& json,
+                                  const std::string& key,
+                                  uint64_t& value) {
+    size_t pos = json.find(key);
+    if (pos == std::string::npos) return false;
+
+    pos += key.size();
+    // Skip whitespace
+    while (pos < json.size() && (json[pos] == ' ' || json[pos] == '\t')) ++pos;
+
+    size_t end = pos;
+    while (end < json.size() && json[end] >= '0' && json[end] <= '9') ++end;
+    if (end == pos) return false;
+
+    try {
+        value = std::stoull(json.substr(pos, end - pos));
+        return true;
+    } catch (...) {
+        return false;
+    }
+}
+
 // ---------------------------------------------------------------------------
 // DOCK_REQUEST handler
 // ---------------------------------------------------------------------------
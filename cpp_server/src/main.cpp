@@ -1,4 +1,5 @@
 #include "server.h"
+#include "data/world_binary_format.h"
 #include "utils/logger.h"
 #include <iostream>
 #include <csignal>
@@ -18,6 +19,26 @@ void signalHandler(int signal) {
 }
 
 int main(int argc, char* argv[]) {
+    // Offline save conversion: --convert-save <input> <output>
+    if (argc > 1 && std::string(argv[1]) == "--convert-save") {
+        if (argc != 4) {
+            std::cerr << "Usage: " << argv[0] << " --convert-save <input> <output>" << std::endl;
+            return 1;
+        }
+        atlas::data::WorldPersistence persistence;
+        return atlas::data::WorldBinaryFormat(persistence).convert(argv[2], argv[3]) ? 0 : 1;
+    }
+
+    // Headless replay of a tick recording: --replay <recording> [config]
+    if (argc > 1 && std::string(argv[1]) == "--replay") {
+        if (argc < 3 || argc > 4) {
+            std::cerr << "Usage: " << argv[0] << " --replay <recording> [config]" << std::endl;
+            return 1;
+        }
+        atlas::Server server(argc > 3 ? argv[3] : "config/server.json");
+        return server.replay(argv[2]) ? 0 : 1;
+    }
+
     // Parse command line arguments
     std::string config_path = "config/server.json";
     if (argc > 1) {
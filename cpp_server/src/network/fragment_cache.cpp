@@ -0,0 +1,165 @@
+#include "network/fragment_cache.h"
+#include "ecs/entity.h"
+#include "components/game_components.h"
+#include <sstream>
+
+namespace atlas {
+namespace network {
+
+const std::string& FragmentCache::Fragment::json(int group) {
+    uint32_t bit = 1u << group;
+    if (!(json_ready_ & bit)) {
+        std::ostringstream out;
+        writeGroup(out, fields_, group);
+        json_[group] = out.str();
+        json_ready_ |= bit;
+        ++*encode_count_;
+    }
+    return json_[group];
+}
+
+const std::string& FragmentCache::Fragment::binary(int group) {
+    uint32_t bit = 1u << group;
+    if (!(binary_ready_ & bit)) {
+        if (!wire_ready_) {
+            toWire(id_, fields_, wire_);
+            wire_ready_ = true;
+        }
+        binary_[group].clear();
+        wire::encodeEntityFields(wire_, static_cast<uint8_t>(bit), binary_[group]);
+        binary_ready_ |= bit;
+        ++*encode_count_;
+    }
+    return binary_[group];
+}
+
+void FragmentCache::beginTick() {
+    index_.clear();
+    used_ = 0;
+    encode_count_ = 0;
+}
+
+FragmentCache::Fragment& FragmentCache::get(const ecs::Entity& entity) {
+    auto [it, inserted] = index_.try_emplace(&entity, used_);
+    if (!inserted) return fragments_[it->second];
+
+    if (used_ == fragments_.size()) fragments_.emplace_back();
+    Fragment& fragment = fragments_[used_++];
+    fragment.id_ = entity.getId();
+    capture(entity, fragment.fields_);
+    fragment.json_ready_ = 0;
+    fragment.binary_ready_ = 0;
+    fragment.wire_ready_ = false;
+    fragment.encode_count_ = &encode_count_;
+    return fragment;
+}
+
+void FragmentCache::capture(const ecs::Entity& entity, Fields& out) {
+    out.present.fill(false);
+
+    if (auto* pos = entity.getComponent<components::Position>()) {
+        out.pos = {pos->x, pos->y, pos->z, pos->rotation};
+        out.present[kPos] = true;
+    }
+    if (auto* vel = entity.getComponent<components::Velocity>()) {
+        out.vel = {vel->vx, vel->vy, vel->vz};
+        out.present[kVel] = true;
+    }
+    if (auto* hp = entity.getComponent<components::Health>()) {
+        out.health = {hp->shield_hp, hp->armor_hp, hp->hull_hp,
+                      hp->shield_max, hp->armor_max, hp->hull_max};
+        out.present[kHealth] = true;
+    }
+    if (auto* cap = entity.getComponent<components::Capacitor>()) {
+        out.capacitor = {cap->capacitor, cap->capacitor_max};
+        out.present[kCapacitor] = true;
+    }
+    if (auto* ship = entity.getComponent<components::Ship>()) {
+        out.ship_type = ship->ship_type;
+        out.ship_name = ship->ship_name;
+        out.present[kShip] = true;
+    }
+    if (auto* fac = entity.getComponent<components::Faction>()) {
+        out.faction = fac->faction_name;
+        out.present[kFaction] = true;
+    }
+}
+
+bool FragmentCache::groupEquals(const Fields& a, const Fields& b, int group) {
+    if (a.present[group] != b.present[group]) return false;
+    switch (group) {
+        case kPos:       return a.pos == b.pos;
+        case kVel:       return a.vel == b.vel;
+        case kHealth:    return a.health == b.health;
+        case kCapacitor: return a.capacitor == b.capacitor;
+        case kShip:      return a.ship_type == b.ship_type && a.ship_name == b.ship_name;
+        case kFaction:   return a.faction == b.faction;
+        default:         return true;
+    }
+}
+
+void FragmentCache::writeGroup(std::ostream& out, const Fields& v, int group) {
+    switch (group) {
+        case kPos:
+            out << ",\"pos\":{\"x\":" << v.pos[0]
+                << ",\"y\":" << v.pos[1]
+                << ",\"z\":" << v.pos[2]
+                << ",\"rot\":" << v.pos[3] << "}";
+            break;
+        case kVel:
+            out << ",\"vel\":{\"vx\":" << v.vel[0]
+                << ",\"vy\":" << v.vel[1]
+                << ",\"vz\":" << v.vel[2] << "}";
+            break;
+        case kHealth:
+            out << ",\"health\":{"
+                << "\"shield\":" << v.health[0]
+                << ",\"armor\":" << v.health[1]
+                << ",\"hull\":" << v.health[2]
+                << ",\"max_shield\":" << v.health[3]
+                << ",\"max_armor\":" << v.health[4]
+                << ",\"max_hull\":" << v.health[5]
+                << "}";
+            break;
+        case kCapacitor:
+            out << ",\"capacitor\":{"
+                << "\"current\":" << v.capacitor[0]
+                << ",\"max\":" << v.capacitor[1]
+                << "}";
+            break;
+        case kShip:
+            out << ",\"ship_type\":\"" << v.ship_type << "\""
+                << ",\"ship_name\":\"" << v.ship_name << "\"";
+            break;
+        case kFaction:
+            out << ",\"faction\":\"" << v.faction << "\"";
+            break;
+        default:
+            break;
+    }
+}
+
+void FragmentCache::toWire(const std::string& id, const Fields& v, wire::EntityState& out) {
+    out.id = id;
+    out.x = v.pos[0];
+    out.y = v.pos[1];
+    out.z = v.pos[2];
+    out.rotation = v.pos[3];
+    out.vx = v.vel[0];
+    out.vy = v.vel[1];
+    out.vz = v.vel[2];
+    out.shield = v.health[0];
+    out.armor = v.health[1];
+    out.hull = v.health[2];
+    out.shield_max = v.health[3];
+    out.armor_max = v.health[4];
+    out.hull_max = v.health[5];
+    out.capacitor = v.capacitor[0];
+    out.capacitor_max = v.capacitor[1];
+    out.ship_type = v.ship_type;
+    out.ship_name = v.ship_name;
+    out.faction = v.faction;
+}
+
+} // namespace network
+} // namespace atlas
@@ -0,0 +1,104 @@
+#include "network/interest_manager.h"
+#include "ecs/world.h"
+#include "components/game_components.h"
+#include "systems/spatial_index_system.h"
+#include <algorithm>
+
+namespace atlas {
+namespace network {
+
+namespace {
+
+const std::string& systemOf(const ecs::Entity* entity, const std::string& home_system) {
+    auto* loc = entity->getComponent<components::SystemLocation>();
+    return loc ? loc->system_id : home_system;
+}
+
+float distanceSq(const components::Position& a, const components::Position& b) {
+    float dx = a.x - b.x;
+    float dy = a.y - b.y;
+    float dz = a.z - b.z;
+    return dx * dx + dy * dy + dz * dz;
+}
+
+bool forceVisible(const ecs::Entity* entity) {
+    auto* lod = entity->getComponent<components::LODPriority>();
+    return lod && lod->force_visible;
+}
+
+} // namespace
+
+void InterestManager::collect(const std::string& observer_id, ClientState& state, Snapshot& out) const {
+    out.entities.clear();
+    out.removed.clear();
+
+    uint64_t tick = ++state.ticks;
+    uint64_t interval = static_cast<uint64_t>(std::max(1, settings_.far_interval));
+    out.full = tick == 1 || (tick + state.phase) % interval == 0;
+
+    auto include = [&](const ecs::Entity* entity) {
+        auto& known = state.known[entity->getId()];
+        known.handle = entity->getHandle();
+        known.last_seen = tick;
+        out.entities.push_back(entity);
+    };
+
+    ecs::Entity* observer = world_->getEntity(observer_id);
+    const components::Position* obs_pos =
+        observer ? observer->getComponent<components::Position>() : nullptr;
+    if (observer) include(observer);
+
+    if (obs_pos) {
+        const std::string& system = systemOf(observer, settings_.home_system);
+        float radius = out.full ? settings_.far_range : settings_.near_range;
+        bool unbounded = radius <= 0.0f;
+        float radius_sq = radius * radius;
+        float near_sq = settings_.near_range * settings_.near_range;
+
+        auto relevantTo = [&](const ecs::Entity* candidate) {
+            return candidate != observer
+                && !candidate->hasComponent<components::Docked>()
+                && systemOf(candidate, settings_.home_system) == system;
+        };
+
+        std::vector<ecs::Entity*> nearby;
+        if (spatial_index_ && !unbounded) {
+            spatial_index_->queryRadius(obs_pos->x, obs_pos->y, obs_pos->z, radius, nearby);
+        }
+        const auto& candidates = (spatial_index_ && !unbounded)
+            ? nearby : world_->view<components::Position>().entities();
+
+        for (const ecs::Entity* candidate : candidates) {
+            if (!relevantTo(candidate)) continue;
+            float dist_sq = distanceSq(*candidate->getComponent<components::Position>(), *obs_pos);
+            if (!unbounded && dist_sq > radius_sq) continue;
+            if (!out.full && dist_sq > near_sq && !forceVisible(candidate)) continue;
+            include(candidate);
+        }
+
+        // force_visible entities are sent every tick wherever they are
+        if (!unbounded) {
+            for (const ecs::Entity* candidate : world_->view<components::Position, components::LODPriority>()) {
+                if (!forceVisible(candidate) || !relevantTo(candidate)) continue;
+                if (distanceSq(*candidate->getComponent<components::Position>(), *obs_pos) <= radius_sq) continue;
+                include(candidate);
+            }
+        }
+    }
+
+    // Drop destroyed entities every tick; on full ticks also drop those
+    // that are no longer relevant
+    for (auto it = state.known.begin(); it != state.known.end(); ) {
+        bool alive = world_->getEntity(it->second.handle) != nullptr;
+        bool dropped = out.full && it->second.last_seen != tick;
+        if (!alive || dropped) {
+            out.removed.push_back(it->first);
+            it = state.known.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+} // namespace network
+} // namespace atlas
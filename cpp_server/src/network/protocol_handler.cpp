@@ -14,6 +14,7 @@ void ProtocolHandler::initializeMessageTypes() {
     message_type_map_["disconnect"] = MessageType::DISCONNECT;
     message_type_map_["input_move"] = MessageType::INPUT_MOVE;
     message_type_map_["state_update"] = MessageType::STATE_UPDATE;
+    message_type_map_["state_ack"] = MessageType::STATE_ACK;
     message_type_map_["chat"] = MessageType::CHAT;
     message_type_map_["command"] = MessageType::COMMAND;
     message_type_map_["spawn_entity"] = MessageType::SPAWN_ENTITY;
@@ -63,6 +64,7 @@ std::string ProtocolHandler::messageTypeToString(MessageType type) {
         case MessageType::DISCONNECT: return "disconnect";
         case MessageType::INPUT_MOVE: return "input_move";
         case MessageType::STATE_UPDATE: return "state_update";
+        case MessageType::STATE_ACK: return "state_ack";
         case MessageType::CHAT: return "chat";
         case MessageType::COMMAND: return "command";
         case MessageType::SPAWN_ENTITY: return "spawn_entity";
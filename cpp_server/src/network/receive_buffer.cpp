@@ -0,0 +1,94 @@
+#include "network/receive_buffer.h"
+#include "network/wire_format.h"
+#include <algorithm>
+#include <cstring>
+
+namespace atlas {
+namespace network {
+
+ReceiveBuffer::ReceiveBuffer(size_t max_message)
+    : storage_(kInitialCapacity)
+    , mask_(kInitialCapacity - 1)
+    , max_message_(max_message) {
+}
+
+char* ReceiveBuffer::writeSpace(size_t& available) {
+    if (size_ == 0) {
+        head_ = 0;  // keep the free space in one piece
+    } else if (size_ == storage_.size()) {
+        grow();
+    }
+
+    size_t tail = (head_ + size_) & mask_;
+    size_t end = tail >= head_ ? storage_.size() : head_;
+    available = end - tail;
+    return storage_.data() + tail;
+}
+
+void ReceiveBuffer::commit(size_t bytes) {
+    size_ += bytes;
+}
+
+ReceiveBuffer::Status ReceiveBuffer::next(std::string& out) {
+    while (size_ > 0) {
+        if (static_cast<uint8_t>(at(0)) == wire::kMagic) {
+            if (size_ < wire::kHeaderSize) return Status::NeedMore;
+
+            char bytes[wire::kHeaderSize];
+            for (size_t i = 0; i < wire::kHeaderSize; ++i) bytes[i] = at(i);
+            wire::Header header;
+            size_t frame_size = 0;
+            if (wire::peekFrame(bytes, wire::kHeaderSize, header, frame_size) == wire::FrameStatus::Invalid) {
+                return Status::Error;
+            }
+            frame_size = wire::kHeaderSize + header.length;
+            if (frame_size > max_message_) return Status::Error;
+            if (size_ < frame_size) return Status::NeedMore;
+
+            copyOut(frame_size, out);
+            consume(frame_size);
+            return Status::Message;
+        }
+
+        size_t newline = scanned_;
+        while (newline < size_ && at(newline) != '\n') ++newline;
+        if (newline == size_) {
+            scanned_ = size_;
+            return size_ > max_message_ ? Status::Error : Status::NeedMore;
+        }
+
+        size_t length = newline;
+        if (length > 0 && at(length - 1) == '\r') --length;
+        if (length > max_message_) return Status::Error;
+        copyOut(length, out);
+        consume(newline + 1);
+        if (!out.empty()) return Status::Message;
+    }
+    return Status::NeedMore;
+}
+
+void ReceiveBuffer::copyOut(size_t length, std::string& out) const {
+    out.resize(length);
+    size_t first = std::min(length, storage_.size() - head_);
+    std::memcpy(&out[0], storage_.data() + head_, first);
+    std::memcpy(&out[0] + first, storage_.data(), length - first);
+}
+
+void ReceiveBuffer::consume(size_t bytes) {
+    head_ = (head_ + bytes) & mask_;
+    size_ -= bytes;
+    scanned_ = 0;
+}
+
+void ReceiveBuffer::grow() {
+    std::vector<char> larger(storage_.size() * 2);
+    size_t first = std::min(size_, storage_.size() - head_);
+    std::memcpy(larger.data(), storage_.data() + head_, first);
+    std::memcpy(larger.data() + first, storage_.data(), size_ - first);
+    storage_.swap(larger);
+    mask_ = storage_.size() - 1;
+    head_ = 0;
+}
+
+} // namespace network
+} // namespace atlas
@@ -0,0 +1,159 @@
+#include "network/snapshot_delta.h"
+#include "ecs/entity.h"
+
+namespace atlas {
+namespace network {
+
+void SnapshotDelta::acknowledge(uint64_t sequence) {
+    if (!acked_) {
+        received_ = 1;
+    } else if (sequence > acked_sequence_) {
+        uint64_t shift = sequence - acked_sequence_;
+        received_ = (shift < kAckWindow ? received_ << shift : 0) | 1;
+    } else {
+        uint64_t age = acked_sequence_ - sequence;
+        if (age < kAckWindow) received_ |= uint64_t{1} << age;
+        return;
+    }
+    acked_sequence_ = sequence;
+    acked_ = true;
+}
+
+bool SnapshotDelta::baselineFor(uint64_t sequence, uint64_t& baseline) const {
+    if (!acked_ || acked_sequence_ >= sequence) return false;
+    if (sequence - acked_sequence_ > kMaxBaselineAge) return false;
+    baseline = acked_sequence_;
+    return true;
+}
+
+void SnapshotDelta::confirm(Record& record) const {
+    if (!acked_ || record.carried == 0) return;
+    // Line the carried bits up with received_, bit i = acked_sequence_ - i
+    uint64_t carried = 0;
+    if (record.last_carried >= acked_sequence_) {
+        uint64_t shift = record.last_carried - acked_sequence_;
+        if (shift < kAckWindow) carried = record.carried >> shift;
+    } else {
+        uint64_t shift = acked_sequence_ - record.last_carried;
+        if (shift < kAckWindow) carried = record.carried << shift;
+    }
+    uint64_t both = carried & received_;
+    if (both == 0) return;
+    uint64_t newest = acked_sequence_ - static_cast<uint64_t>(__builtin_ctzll(both));
+    if (!record.is_synced || newest > record.synced) {
+        record.synced = newest;
+        record.is_synced = true;
+    }
+}
+
+uint32_t SnapshotDelta::select(const std::string& id, const Values& current, uint64_t sequence,
+                              Record*& record_out) {
+    auto [it, inserted] = entities_.try_emplace(id);
+    Record& record = it->second;
+    if (inserted) {
+        record.changed.fill(sequence);
+    } else {
+        confirm(record);
+        for (int group = 0; group < kGroupCount; ++group) {
+            if (!FragmentCache::groupEquals(record.sent, current, group)) {
+                record.changed[group] = sequence;
+            }
+        }
+    }
+    uint64_t gap = sequence - record.last_carried;
+    record.carried = (!inserted && gap < kAckWindow ? record.carried << gap : 0) | 1;
+    record.last_carried = sequence;
+    // Strings are copied only when they changed
+    record.sent.pos = current.pos;
+    record.sent.vel = current.vel;
+    record.sent.health = current.health;
+    record.sent.capacitor = current.capacitor;
+    record.sent.present = current.present;
+    if (record.changed[FragmentCache::kShip] == sequence) {
+        record.sent.ship_type = current.ship_type;
+        record.sent.ship_name = current.ship_name;
+    }
+    if (record.changed[FragmentCache::kFaction] == sequence) {
+        record.sent.faction = current.faction;
+    }
+    record_out = &record;
+
+    // Groups unchanged since the entity's synced snapshot are already current
+    // on the client, even if later snapshots carrying it were dropped
+    uint64_t baseline = 0;
+    bool delta = baselineFor(sequence, baseline) && record.is_synced;
+
+    uint32_t mask = 0;
+    for (int group = 0; group < kGroupCount; ++group) {
+        if (!record.sent.present[group]) continue;
+        if (delta && record.changed[group] <= record.synced) continue;
+        mask |= 1u << group;
+    }
+    return mask;
+}
+
+bool SnapshotDelta::writeEntity(std::ostream& out, const ecs::Entity& entity, uint64_t sequence, bool& first) {
+    FragmentCache::capture(entity, scratch_);
+    Record* record = nullptr;
+    uint32_t mask = select(entity.getId(), scratch_, sequence, record);
+    if (mask == 0) return false;
+
+    if (!first) out << ",";
+    first = false;
+    out << "{\"id\":\"" << entity.getId() << "\"";
+    for (int group = 0; group < kGroupCount; ++group) {
+        if (mask & (1u << group)) FragmentCache::writeGroup(out, record->sent, group);
+    }
+    out << "}";
+    return true;
+}
+
+bool SnapshotDelta::writeEntity(wire::EntityState& out, const ecs::Entity& entity, uint64_t sequence) {
+    FragmentCache::capture(entity, scratch_);
+    Record* record = nullptr;
+    uint32_t mask = select(entity.getId(), scratch_, sequence, record);
+    if (mask == 0) return false;
+
+    // Group order matches the wire field bits
+    FragmentCache::toWire(entity.getId(), record->sent, out);
+    out.fields = static_cast<uint8_t>(mask);
+    return true;
+}
+
+bool SnapshotDelta::writeEntity(std::ostream& out, FragmentCache::Fragment& fragment,
+                                uint64_t sequence, bool& first) {
+    Record* record = nullptr;
+    uint32_t mask = select(fragment.id(), fragment.fields(), sequence, record);
+    if (mask == 0) return false;
+
+    if (!first) out << ",";
+    first = false;
+    out << "{\"id\":\"" << fragment.id() << "\"";
+    for (int group = 0; group < kGroupCount; ++group) {
+        if (mask & (1u << group)) out << fragment.json(group);
+    }
+    out << "}";
+    return true;
+}
+
+bool SnapshotDelta::appendEntityRecord(std::string& records, FragmentCache::Fragment& fragment,
+                                       uint64_t sequence) {
+    Record* record = nullptr;
+    uint32_t mask = select(fragment.id(), fragment.fields(), sequence, record);
+    if (mask == 0) return false;
+
+    wire::Writer w(records);
+    w.str(fragment.id());
+    w.u8(static_cast<uint8_t>(mask));
+    for (int group = 0; group < kGroupCount; ++group) {
+        if (mask & (1u << group)) records.append(fragment.binary(group));
+    }
+    return true;
+}
+
+void SnapshotDelta::forget(const std::string& entity_id) {
+    entities_.erase(entity_id);
+}
+
+} // namespace network
+} // namespace atlas
@@ -1,18 +1,89 @@
 #include "network/tcp_server.h"
+#include "network/receive_buffer.h"
+#include "network/wire_format.h"
+#include "utils/profiler.h"
+#include <algorithm>
+#include <cerrno>
+#include <ctime>
 #include <iostream>
 #include <cstring>
+#include <deque>
 
 #ifdef _WIN32
 #pragma comment(lib, "ws2_32.lib")
+#else
+#include <netinet/tcp.h>
+#endif
+
+#ifdef EVE_TCP_SERVER_EPOLL
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/uio.h>
 #endif
 
 namespace atlas {
 namespace network {
 
-TCPServer::TCPServer(const std::string& host, uint16_t port, int max_connections)
+#ifdef _WIN32
+static constexpr int kSendFlags = 0;
+#else
+static constexpr int kSendFlags = MSG_NOSIGNAL;  // report EPIPE instead of raising SIGPIPE
+#endif
+
+struct TCPServer::Connection {
+    ClientConnection info;
+    ReceiveBuffer receive;
+    std::string message;            // reused for every extracted message
+#ifdef EVE_TCP_SERVER_EPOLL
+    IOLoop* loop = nullptr;         // owning I/O thread
+#endif
+
+    // Outbound queue, guarded by send_mutex
+    struct OutMessage {
+        MessageBuffer data;         // shared with other connections
+        bool replaceable = false;
+    };
+    std::mutex send_mutex;
+    std::deque<OutMessage> outbox;
+    size_t outbox_bytes = 0;        // bytes in outbox not yet written
+    size_t front_written = 0;       // bytes of outbox.front() already written
+    bool flush_queued = false;      // on its loop's ready queue
+    bool closed = false;
+};
+
+struct TCPServer::BatchState {
+    int depth = 0;
+#ifdef EVE_TCP_SERVER_EPOLL
+    std::vector<IOLoop*> deferred;  // loops to wake when the batch ends
+#endif
+};
+
+TCPServer::BatchState& TCPServer::batchState() {
+    thread_local BatchState state;
+    return state;
+}
+
+TCPServer::SendBatch::SendBatch() {
+    ++batchState().depth;
+}
+
+TCPServer::SendBatch::~SendBatch() {
+    BatchState& state = batchState();
+    if (--state.depth > 0) return;
+#ifdef EVE_TCP_SERVER_EPOLL
+    for (IOLoop* loop : state.deferred) {
+        wakeLoop(*loop);
+    }
+    state.deferred.clear();
+#endif
+}
+
+TCPServer::TCPServer(const std::string& host, uint16_t port, int max_connections, int io_threads)
     : host_(host)
     , port_(port)
     , max_connections_(max_connections)
+    , io_threads_(std::max(1, io_threads))
     , server_socket_(INVALID_SOCKET)
     , running_(false) {
 }
@@ -25,7 +96,7 @@ bool TCPServer::initialize() {
     if (!initializeSockets()) {
         return false;
     }
-    
+
     // Create socket
     server_socket_ = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
     if (server_socket_ == INVALID_SOCKET) {
@@ -33,7 +104,7 @@ bool TCPServer::initialize() {
         cleanupSockets();
         return false;
     }
-    
+
     // Set socket options
     int opt = 1;
 #ifdef _WIN32
@@ -41,41 +112,335 @@ bool TCPServer::initialize() {
 #else
     setsockopt(server_socket_, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
 #endif
-    
+
     // Bind socket
     sockaddr_in server_addr{};
     server_addr.sin_family = AF_INET;
     server_addr.sin_port = htons(port_);
-    
+
     if (host_ == "0.0.0.0" || host_ == "") {
         server_addr.sin_addr.s_addr = INADDR_ANY;
     } else {
         inet_pton(AF_INET, host_.c_str(), &server_addr.sin_addr);
     }
-    
+
     if (bind(server_socket_, (sockaddr*)&server_addr, sizeof(server_addr)) == SOCKET_ERROR) {
         std::cerr << "Failed to bind socket to " << host_ << ":" << port_ << std::endl;
         closeSocket(server_socket_);
         cleanupSockets();
         return false;
     }
-    
+
+    // Record the port actually bound (port 0 picks a free one)
+    socklen_t addr_len = sizeof(server_addr);
+    if (getsockname(server_socket_, (sockaddr*)&server_addr, &addr_len) == 0) {
+        port_ = ntohs(server_addr.sin_port);
+    }
+
     // Listen
-    if (listen(server_socket_, max_connections_) == SOCKET_ERROR) {
+    if (listen(server_socket_, std::max(max_connections_, SOMAXCONN)) == SOCKET_ERROR) {
         std::cerr << "Failed to listen on socket" << std::endl;
         closeSocket(server_socket_);
         cleanupSockets();
         return false;
     }
-    
+
+    return true;
+}
+
+#ifdef EVE_TCP_SERVER_EPOLL
+
+// ---------------------------------------------------------------------------
+// epoll reactor
+// ---------------------------------------------------------------------------
+
+void TCPServer::start() {
+    if (running_) {
+        return;
+    }
+
+    int flags = fcntl(server_socket_, F_GETFL, 0);
+    fcntl(server_socket_, F_SETFL, flags | O_NONBLOCK);
+
+    for (int i = 0; i < io_threads_; ++i) {
+        auto loop = std::make_unique<IOLoop>();
+        loop->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+        loop->wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+        epoll_event ev{};
+        ev.events = EPOLLIN;
+        ev.data.ptr = loop.get();
+        epoll_ctl(loop->epoll_fd, EPOLL_CTL_ADD, loop->wake_fd, &ev);
+        loops_.push_back(std::move(loop));
+    }
+
+    // The listening socket is served by the first loop; data.ptr == this
+    // tells it apart from connections
+    epoll_event ev{};
+    ev.events = EPOLLIN | EPOLLET;
+    ev.data.ptr = this;
+    epoll_ctl(loops_[0]->epoll_fd, EPOLL_CTL_ADD, server_socket_, &ev);
+
+    running_ = true;
+    for (auto& loop : loops_) {
+        IOLoop* raw = loop.get();
+        loop->thread = std::thread([this, raw]() { runLoop(*raw); });
+    }
+}
+
+void TCPServer::stop() {
+    if (!running_) {
+        return;
+    }
+
+    running_ = false;
+
+    // Wake every loop so it sees running_ == false
+    for (auto& loop : loops_) {
+        uint64_t one = 1;
+        ssize_t ignored = write(loop->wake_fd, &one, sizeof(one));
+        (void)ignored;
+    }
+    for (auto& loop : loops_) {
+        if (loop->thread.joinable()) {
+            loop->thread.join();
+        }
+    }
+
+    // Close all client connections
+    {
+        std::lock_guard<std::mutex> lock(clients_mutex_);
+        for (auto& kv : connections_) {
+            std::lock_guard<std::mutex> send_lock(kv.second->send_mutex);
+            kv.second->closed = true;
+            closeSocket(kv.first);
+        }
+        connections_.clear();
+    }
+
+    for (auto& loop : loops_) {
+        close(loop->epoll_fd);
+        close(loop->wake_fd);
+    }
+    loops_.clear();
+
+    if (server_socket_ != INVALID_SOCKET) {
+        closeSocket(server_socket_);
+        server_socket_ = INVALID_SOCKET;
+    }
+
+    cleanupSockets();
+}
+
+void TCPServer::runLoop(IOLoop& loop) {
+    constexpr int kMaxEvents = 256;
+    epoll_event events[kMaxEvents];
+
+    while (running_) {
+        int count = epoll_wait(loop.epoll_fd, events, kMaxEvents, -1);
+        if (count < 0) {
+            if (errno == EINTR) continue;
+            std::cerr << "[TCPServer] epoll_wait failed: " << std::strerror(errno) << std::endl;
+            break;
+        }
+
+        for (int i = 0; i < count && running_; ++i) {
+            void* tag = events[i].data.ptr;
+            uint32_t flags = events[i].events;
+
+            if (tag == &loop) {
+                uint64_t value;
+                while (read(loop.wake_fd, &value, sizeof(value)) > 0) {}
+                flushReady(loop);
+                continue;
+            }
+            if (tag == this) {
+                acceptConnections();
+                continue;
+            }
+
+            // Only this thread closes the connection, so the flag is stable
+            auto* conn = static_cast<Connection*>(tag);
+            if (conn->closed) continue;
+            bool alive = (flags & (EPOLLERR | EPOLLHUP)) == 0;
+            if (alive && (flags & EPOLLOUT)) {
+                alive = flushPending(*conn);
+            }
+            if (alive && (flags & (EPOLLIN | EPOLLRDHUP))) {
+                alive = readConnection(*conn);
+            }
+            if (!alive) {
+                closeConnection(loop, conn);
+            }
+        }
+        loop.closed.clear();
+    }
+}
+
+void TCPServer::acceptConnections() {
+    // Edge-triggered: accept until the backlog is empty
+    while (running_) {
+        sockaddr_in client_addr{};
+        socklen_t client_addr_len = sizeof(client_addr);
+        socket_t client_socket = accept4(server_socket_, (sockaddr*)&client_addr, &client_addr_len,
+                                         SOCK_NONBLOCK | SOCK_CLOEXEC);
+
+        if (client_socket == INVALID_SOCKET) {
+            if (errno == EINTR || errno == ECONNABORTED) continue;
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                std::cerr << "[TCPServer] Accept failed: " << std::strerror(errno) << std::endl;
+            }
+            return;
+        }
+
+        if (getClientCount() >= max_connections_) {
+            std::cerr << "[TCPServer] Connection limit reached, rejecting client" << std::endl;
+            closeSocket(client_socket);
+            continue;
+        }
+
+        auto conn = createConnection(client_socket, client_addr);
+        conn->loop = loops_[next_loop_++ % loops_.size()].get();
+        addConnection(conn);
+
+        // EPOLLOUT is edge-triggered too: it fires when a full socket
+        // buffer drains, which is exactly when pending output can go
+        epoll_event ev{};
+        ev.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+        ev.data.ptr = conn.get();
+        epoll_ctl(conn->loop->epoll_fd, EPOLL_CTL_ADD, client_socket, &ev);
+    }
+}
+
+bool TCPServer::readConnection(Connection& conn) {
+    utils::ProfileScope scope("net_read");
+    while (true) {
+        size_t space = 0;
+        char* dest = conn.receive.writeSpace(space);
+        ssize_t bytes_received = recv(conn.info.socket, dest, space, 0);
+
+        if (bytes_received > 0) {
+            conn.receive.commit(static_cast<size_t>(bytes_received));
+            if (!dispatchMessages(conn)) return false;
+            continue;
+        }
+        if (bytes_received == 0) return false;      // orderly close
+        if (errno == EINTR) continue;
+        return errno == EAGAIN || errno == EWOULDBLOCK;
+    }
+}
+
+bool TCPServer::flushPending(Connection& conn) {
+    constexpr int kMaxIov = 64;
+    std::lock_guard<std::mutex> lock(conn.send_mutex);
+    conn.flush_queued = false;
+    if (conn.closed) return true;   // already handled by closeConnection
+
+    // Gather as many queued messages as fit into one sendmsg() call
+    while (!conn.outbox.empty()) {
+        iovec iov[kMaxIov];
+        int count = 0;
+        size_t skip = conn.front_written;
+        for (auto it = conn.outbox.begin(); it != conn.outbox.end() && count < kMaxIov; ++it) {
+            iov[count].iov_base = const_cast<char*>(it->data.data()) + skip;
+            iov[count].iov_len = it->data.size() - skip;
+            skip = 0;
+            ++count;
+        }
+
+        msghdr msg{};
+        msg.msg_iov = iov;
+        msg.msg_iovlen = static_cast<size_t>(count);
+        ssize_t sent = sendmsg(conn.info.socket, &msg, kSendFlags);
+        if (sent < 0) {
+            if (errno == EINTR) continue;
+            // A full socket buffer ends in EPOLLOUT, which flushes again
+            return errno == EAGAIN || errno == EWOULDBLOCK;
+        }
+
+        size_t remaining = static_cast<size_t>(sent);
+        conn.outbox_bytes -= remaining;
+        while (remaining > 0) {
+            size_t left = conn.outbox.front().data.size() - conn.front_written;
+            if (remaining < left) {
+                conn.front_written += remaining;
+                break;
+            }
+            remaining -= left;
+            conn.outbox.pop_front();
+            conn.front_written = 0;
+        }
+    }
     return true;
 }
 
+void TCPServer::flushReady(IOLoop& loop) {
+    // Clear the flag before draining: a sender that queues after this
+    // point sees false and wakes the loop again
+    loop.wake_pending.exchange(false, std::memory_order_acq_rel);
+
+    utils::ProfileScope scope("net_flush");
+    std::shared_ptr<Connection> conn;
+    while (loop.ready.pop(conn)) {
+        if (!flushPending(*conn)) {
+            closeConnection(loop, conn.get());
+        }
+    }
+}
+
+void TCPServer::wakeLoop(IOLoop& loop) {
+    if (!loop.wake_pending.exchange(true, std::memory_order_acq_rel)) {
+        uint64_t one = 1;
+        ssize_t ignored = write(loop.wake_fd, &one, sizeof(one));
+        (void)ignored;
+    }
+}
+
+void TCPServer::closeConnection(IOLoop& loop, Connection* conn) {
+    // Only the owning loop sets closed while running, so this read is safe
+    if (conn->closed) return;
+    epoll_ctl(loop.epoll_fd, EPOLL_CTL_DEL, conn->info.socket, nullptr);
+
+    // Keep the connection alive until the current epoll batch is handled
+    {
+        std::lock_guard<std::mutex> lock(clients_mutex_);
+        auto it = connections_.find(conn->info.socket);
+        if (it != connections_.end() && it->second.get() == conn) {
+            loop.closed.push_back(std::move(it->second));
+            connections_.erase(it);
+        }
+    }
+
+    // Report the disconnect while the descriptor still belongs to this
+    // client, so it is ordered before anything from a later connection
+    if (disconnect_handler_) {
+        disconnect_handler_(conn->info);
+    }
+
+    {
+        // Senders check closed under this lock, so none can write to the
+        // descriptor after it is closed and possibly reused
+        std::lock_guard<std::mutex> lock(conn->send_mutex);
+        conn->closed = true;
+        conn->outbox.clear();
+        conn->outbox_bytes = 0;
+        closeSocket(conn->info.socket);
+    }
+
+    std::cout << "[TCPServer] Client disconnected: " << conn->info.address << ":" << conn->info.port << std::endl;
+}
+
+#else
+
+// ---------------------------------------------------------------------------
+// Thread-per-client fallback
+// ---------------------------------------------------------------------------
+
 void TCPServer::start() {
     if (running_) {
         return;
     }
-    
+
     running_ = true;
     accept_thread_ = std::thread(&TCPServer::acceptLoop, this);
 }
@@ -84,29 +449,28 @@ void TCPServer::stop() {
     if (!running_) {
         return;
     }
-    
+
     running_ = false;
-    
+
     // Close server socket to unblock accept
     if (server_socket_ != INVALID_SOCKET) {
         closeSocket(server_socket_);
         server_socket_ = INVALID_SOCKET;
     }
-    
+
     // Wait for accept thread
     if (accept_thread_.joinable()) {
         accept_thread_.join();
     }
-    
+
     // Close all client connections
     {
         std::lock_guard<std::mutex> lock(clients_mutex_);
-        for (auto& client : clients_) {
-            closeSocket(client.socket);
+        for (auto& kv : connections_) {
+            closeSocket(kv.first);
         }
-        clients_.clear();
     }
-    
+
     // Wait for client threads
     for (auto& thread : client_threads_) {
         if (thread.joinable()) {
@@ -114,7 +478,12 @@ void TCPServer::stop() {
         }
     }
     client_threads_.clear();
-    
+
+    {
+        std::lock_guard<std::mutex> lock(clients_mutex_);
+        connections_.clear();
+    }
+
     cleanupSockets();
 }
 
@@ -122,98 +491,248 @@ void TCPServer::acceptLoop() {
     while (running_) {
         sockaddr_in client_addr{};
         socklen_t client_addr_len = sizeof(client_addr);
-        
+
         socket_t client_socket = accept(server_socket_, (sockaddr*)&client_addr, &client_addr_len);
-        
+
         if (client_socket == INVALID_SOCKET) {
             if (running_) {
                 std::cerr << "Accept failed" << std::endl;
             }
             break;
         }
-        
-        // Get client address
-        char client_ip[INET_ADDRSTRLEN];
-        inet_ntop(AF_INET, &client_addr.sin_addr, client_ip, INET_ADDRSTRLEN);
-        uint16_t client_port = ntohs(client_addr.sin_port);
-        
-        ClientConnection client;
-        client.socket = client_socket;
-        client.address = client_ip;
-        client.port = client_port;
-        client.authenticated = false;
-        client.connect_time = std::time(nullptr);
-        
-        std::cout << "[TCPServer] New connection from " << client_ip << ":" << client_port << std::endl;
-        
-        // Add to clients list
-        {
-            std::lock_guard<std::mutex> lock(clients_mutex_);
-            clients_.push_back(client);
-        }
-        
+
+        auto conn = createConnection(client_socket, client_addr);
+        addConnection(conn);
+
         // Start client handler thread
-        client_threads_.push_back(std::thread(&TCPServer::handleClient, this, client));
+        client_threads_.push_back(std::thread(&TCPServer::handleClient, this, conn));
     }
 }
 
-void TCPServer::handleClient(ClientConnection client) {
-    char buffer[4096];
-    
+void TCPServer::handleClient(std::shared_ptr<Connection> conn) {
     while (running_) {
-        int bytes_received = recv(client.socket, buffer, sizeof(buffer) - 1, 0);
-        
+        size_t space = 0;
+        char* dest = conn->receive.writeSpace(space);
+        int bytes_received = recv(conn->info.socket, dest, static_cast<int>(space), 0);
+
         if (bytes_received <= 0) {
             // Connection closed or error
             break;
         }
-        
-        buffer[bytes_received] = '\0';
-        std::string message(buffer, bytes_received);
-        
-        // Call message handler if set
-        if (message_handler_) {
-            message_handler_(client, message);
+        conn->receive.commit(static_cast<size_t>(bytes_received));
+
+        if (!dispatchMessages(*conn)) {
+            break;
         }
     }
-    
+
     // Remove client from list
     {
         std::lock_guard<std::mutex> lock(clients_mutex_);
-        clients_.erase(
-            std::remove_if(clients_.begin(), clients_.end(),
-                [&](const ClientConnection& c) { return c.socket == client.socket; }),
-            clients_.end()
-        );
+        connections_.erase(conn->info.socket);
+    }
+    {
+        std::lock_guard<std::mutex> lock(conn->send_mutex);
+        conn->closed = true;
+    }
+    if (disconnect_handler_) {
+        disconnect_handler_(conn->info);
+    }
+
+    std::cout << "[TCPServer] Client disconnected: " << conn->info.address << ":" << conn->info.port << std::endl;
+    closeSocket(conn->info.socket);
+}
+
+#endif // EVE_TCP_SERVER_EPOLL
+
+// ---------------------------------------------------------------------------
+// Shared connection handling
+// ---------------------------------------------------------------------------
+
+std::shared_ptr<TCPServer::Connection> TCPServer::createConnection(socket_t socket, const sockaddr_in& addr) {
+    char client_ip[INET_ADDRSTRLEN];
+    inet_ntop(AF_INET, &addr.sin_addr, client_ip, INET_ADDRSTRLEN);
+
+    auto conn = std::make_shared<Connection>();
+    conn->info.socket = socket;
+    conn->info.address = client_ip;
+    conn->info.port = ntohs(addr.sin_port);
+    conn->info.authenticated = false;
+    conn->info.connect_time = std::time(nullptr);
+
+    // Small game messages should not wait for Nagle's algorithm
+    int nodelay = 1;
+    setsockopt(socket, IPPROTO_TCP, TCP_NODELAY, (const char*)&nodelay, sizeof(nodelay));
+
+    return conn;
+}
+
+void TCPServer::addConnection(const std::shared_ptr<Connection>& conn) {
+    std::cout << "[TCPServer] New connection from " << conn->info.address << ":" << conn->info.port << std::endl;
+
+    std::lock_guard<std::mutex> lock(clients_mutex_);
+    connections_[conn->info.socket] = conn;
+}
+
+std::shared_ptr<TCPServer::Connection> TCPServer::findConnection(const ClientConnection& client) const {
+    std::lock_guard<std::mutex> lock(clients_mutex_);
+    auto it = connections_.find(client.socket);
+    // A reused descriptor belongs to a different peer
+    if (it == connections_.end() || it->second->info.port != client.port) {
+        return nullptr;
     }
-    
-    std::cout << "[TCPServer] Client disconnected: " << client.address << ":" << client.port << std::endl;
-    closeSocket(client.socket);
+    return it->second;
+}
+
+bool TCPServer::dispatchMessages(Connection& conn) {
+    // Messages are newline-delimited JSON or binary wire frames; one recv
+    // may carry several of them or only part of one
+    ReceiveBuffer::Status status;
+    while ((status = conn.receive.next(conn.message)) == ReceiveBuffer::Status::Message) {
+        // Call message handler if set
+        if (message_handler_) {
+            message_handler_(conn.info, conn.message);
+        }
+    }
+
+    if (status == ReceiveBuffer::Status::Error) {
+        std::cerr << "[TCPServer] Malformed or oversized message from "
+                  << conn.info.address << ":" << conn.info.port << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool TCPServer::sendTo(const std::shared_ptr<Connection>& conn, const MessageBuffer& message,
+                       bool replaceable) {
+#ifdef EVE_TCP_SERVER_EPOLL
+    bool schedule = false;
+    {
+        std::lock_guard<std::mutex> lock(conn->send_mutex);
+        if (conn->closed) return false;
+
+        // A lagging client gets only the newest replaceable message; the
+        // front one stays if the socket already holds part of it
+        if (replaceable && conn->outbox_bytes + message.size() > kSendHighWater) {
+            auto first = conn->outbox.begin() + (conn->front_written > 0 ? 1 : 0);
+            auto keep = std::remove_if(first, conn->outbox.end(),
+                [](const Connection::OutMessage& m) { return m.replaceable; });
+            size_t dropped = 0;
+            for (auto it = keep; it != conn->outbox.end(); ++it) {
+                conn->outbox_bytes -= it->data.size();
+                ++dropped;
+            }
+            conn->outbox.erase(keep, conn->outbox.end());
+            dropped_messages_ += dropped;
+        }
+
+        if (conn->outbox_bytes + message.size() > kMaxPendingOutput) {
+            std::cerr << "[TCPServer] Dropping slow client " << conn->info.address
+                      << ":" << conn->info.port << std::endl;
+            // Let the owning I/O thread notice and close the connection
+            shutdown(conn->info.socket, SHUT_RDWR);
+            return false;
+        }
+
+        conn->outbox.push_back(Connection::OutMessage{message, replaceable});
+        conn->outbox_bytes += message.size();
+        if (!conn->flush_queued) {
+            conn->flush_queued = true;
+            schedule = true;
+        }
+    }
+
+    if (schedule) {
+        IOLoop& loop = *conn->loop;
+        loop.ready.push(conn);
+        BatchState& batch = batchState();
+        if (batch.depth > 0) {
+            if (std::find(batch.deferred.begin(), batch.deferred.end(), &loop) == batch.deferred.end()) {
+                batch.deferred.push_back(&loop);
+            }
+        } else {
+            wakeLoop(loop);
+        }
+    }
+    return true;
+#else
+    // Blocking sockets: write inline; there is no I/O thread to hand off to
+    (void)replaceable;
+    std::lock_guard<std::mutex> lock(conn->send_mutex);
+    if (conn->closed) return false;
+
+    size_t offset = 0;
+    while (offset < message.size()) {
+        auto sent = send(conn->info.socket, message.data() + offset,
+                         static_cast<int>(message.size() - offset), kSendFlags);
+        if (sent > 0) {
+            offset += static_cast<size_t>(sent);
+            continue;
+        }
+#ifndef _WIN32
+        if (sent < 0 && errno == EINTR) continue;
+#endif
+        shutdown(conn->info.socket, 2);  // SHUT_RDWR / SD_BOTH
+        return false;
+    }
+    return true;
+#endif
 }
 
 int TCPServer::getClientCount() const {
     std::lock_guard<std::mutex> lock(clients_mutex_);
-    return static_cast<int>(clients_.size());
+    return static_cast<int>(connections_.size());
 }
 
 std::vector<ClientConnection> TCPServer::getClients() const {
     std::lock_guard<std::mutex> lock(clients_mutex_);
-    return clients_;
+    std::vector<ClientConnection> clients;
+    clients.reserve(connections_.size());
+    for (const auto& kv : connections_) {
+        clients.push_back(kv.second->info);
+    }
+    return clients;
 }
 
 void TCPServer::setMessageHandler(MessageHandler handler) {
     message_handler_ = handler;
 }
 
-bool TCPServer::sendToClient(const ClientConnection& client, const std::string& data) {
-    int bytes_sent = send(client.socket, data.c_str(), static_cast<int>(data.size()), 0);
-    return bytes_sent > 0;
+void TCPServer::setDisconnectHandler(DisconnectHandler handler) {
+    disconnect_handler_ = handler;
+}
+
+bool TCPServer::sendToClient(const ClientConnection& client, const std::string& data,
+                             bool replaceable) {
+    auto conn = findConnection(client);
+    if (!conn) return false;
+    return sendTo(conn, MessageBuffer(data), replaceable);
+}
+
+bool TCPServer::sendToClient(const ClientConnection& client, const MessageBuffer& message,
+                             bool replaceable) {
+    auto conn = findConnection(client);
+    if (!conn) return false;
+    return sendTo(conn, message, replaceable);
 }
 
 void TCPServer::broadcastToAll(const std::string& data) {
-    std::lock_guard<std::mutex> lock(clients_mutex_);
-    for (const auto& client : clients_) {
-        send(client.socket, data.c_str(), static_cast<int>(data.size()), 0);
+    broadcastToAll(MessageBuffer(data));
+}
+
+void TCPServer::broadcastToAll(const MessageBuffer& message) {
+    // Send outside clients_mutex_ so accepts and closes are not held up
+    std::vector<std::shared_ptr<Connection>> targets;
+    {
+        std::lock_guard<std::mutex> lock(clients_mutex_);
+        targets.reserve(connections_.size());
+        for (const auto& kv : connections_) {
+            targets.push_back(kv.second);
+        }
+    }
+    SendBatch batch;
+    for (const auto& conn : targets) {
+        sendTo(conn, message, false);
     }
 }
 
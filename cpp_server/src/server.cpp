@@ -8,11 +8,17 @@
 #include "systems/shield_recharge_system.h"
 #include "systems/weapon_system.h"
 #include "systems/station_system.h"
+#include "systems/spatial_index_system.h"
+#include "data/world_binary_format.h"
 #include "utils/logger.h"
+#include "utils/profiler.h"
+#include "utils/tick_scheduler.h"
+#include <cstdio>
 #include <iostream>
 #include <fstream>
 #include <thread>
 #include <chrono>
+#include <algorithm>
 #include <sys/stat.h>
 #ifdef _WIN32
 #include <direct.h>
@@ -21,7 +27,7 @@
 namespace atlas {
 
 Server::Server(const std::string& config_path)
-    : running_(false) {
+    : world_saver_(world_persistence_), running_(false) {
     
     config_ = std::make_unique<ServerConfig>();
     if (!config_->loadFromFile(config_path)) {
@@ -38,10 +44,21 @@ Server::~Server() {
 }
 
 void Server::initializeGameWorld() {
-    // Initialize game systems in order
+    // Initialize game systems in order; the spatial index goes first so
+    // every later system queries this tick's positions
+    auto spatial_index = std::make_unique<systems::SpatialIndexSystem>(game_world_.get());
+    spatial_index_system_ = spatial_index.get();
+    game_world_->addSystem(std::move(spatial_index));
     game_world_->addSystem(std::make_unique<systems::CapacitorSystem>(game_world_.get()));
     game_world_->addSystem(std::make_unique<systems::ShieldRechargeSystem>(game_world_.get()));
-    game_world_->addSystem(std::make_unique<systems::AISystem>(game_world_.get()));
+    auto ai = std::make_unique<systems::AISystem>(game_world_.get());
+    ai->setSpatialIndex(spatial_index_system_);
+    systems::AISystem::ThinkSettings think;
+    think.near_range = config_->ai_near_range;
+    think.think_interval = config_->ai_think_interval;
+    think.budget_turns = config_->ai_think_budget_turns;
+    ai->setThinkSettings(think);
+    game_world_->addSystem(std::move(ai));
 
     auto targeting = std::make_unique<systems::TargetingSystem>(game_world_.get());
     targeting_system_ = targeting.get();
@@ -59,10 +76,33 @@ void Server::initializeGameWorld() {
     combat_system_ = combat.get();
     game_world_->addSystem(std::move(combat));
     
+    if (config_->system_worker_threads > 0) {
+        game_world_->setWorkerThreads(static_cast<size_t>(config_->system_worker_threads));
+    }
+    
     auto& log = utils::Logger::instance();
     log.info("Game world initialized with " +
              std::to_string(game_world_->getEntityCount()) + " entities");
-    log.info("Systems: Capacitor, ShieldRecharge, AI, Targeting, Station, Movement, Weapon, Combat");
+    log.info("Systems: SpatialIndex, Capacitor, ShieldRecharge, AI, Targeting, Station, Movement, Weapon, Combat");
+    log.info("System worker threads: " + std::to_string(game_world_->getWorkerThreads()));
+}
+
+void Server::createGameSession(bool spawn_initial_npcs) {
+    game_session_ = std::make_unique<GameSession>(
+        game_world_.get(), tcp_server_.get(), config_->data_path);
+    game_session_->setTargetingSystem(targeting_system_);
+    game_session_->setStationSystem(station_system_);
+    game_session_->setMovementSystem(movement_system_);
+    game_session_->setCombatSystem(combat_system_);
+    game_session_->setSpatialIndex(spatial_index_system_);
+    network::InterestManager::Settings interest;
+    interest.near_range = config_->interest_near_range;
+    interest.far_range = config_->interest_far_range;
+    interest.far_interval = config_->interest_far_interval;
+    interest.home_system = config_->solar_system;
+    game_session_->setInterestSettings(interest);
+    game_session_->setSolarSystem(config_->solar_system);
+    game_session_->initialize(spawn_initial_npcs);
 }
 
 bool Server::initialize() {
@@ -70,6 +110,13 @@ bool Server::initialize() {
 
     // Initialize file logging using the configured log_path
     log.init(config_->log_path);
+    log.setRotation(static_cast<size_t>(std::max(0, config_->log_max_file_mb)) * 1024 * 1024,
+                    config_->log_max_files);
+    if (config_->log_async) {
+        // Keep disk writes off the tick thread
+        log.startAsync(static_cast<size_t>(std::max(16, config_->log_queue_size)),
+                       config_->log_flush_interval_ms);
+    }
 
     log.info("==================================");
     log.info("EVE OFFLINE Dedicated Server");
@@ -80,7 +127,8 @@ bool Server::initialize() {
     tcp_server_ = std::make_unique<network::TCPServer>(
         config_->host, 
         config_->port, 
-        config_->max_connections
+        config_->max_connections,
+        config_->network_io_threads
     );
     
     if (!tcp_server_->initialize()) {
@@ -130,26 +178,29 @@ bool Server::initialize() {
     log.info("  Steam Integration: " + std::string(config_->use_steam ? "Enabled" : "Disabled"));
     log.info("  Max Players: " + std::to_string(config_->max_connections));
     log.info("  Tick Rate: " + std::to_string(static_cast<int>(config_->tick_rate)) + " Hz");
+    log.info("  Tick Catch-up: " + config_->tick_catch_up);
     log.info("  Log Path: " + config_->log_path);
     
     // Initialize game world and systems
     initializeGameWorld();
     
     // Initialize game session (bridges networking ↔ ECS world)
-    game_session_ = std::make_unique<GameSession>(
-        game_world_.get(), tcp_server_.get(), config_->data_path);
-    game_session_->setTargetingSystem(targeting_system_);
-    game_session_->setStationSystem(station_system_);
-    game_session_->setMovementSystem(movement_system_);
-    game_session_->setCombatSystem(combat_system_);
-    game_session_->initialize();
+    createGameSession();
     
     // Load persisted world state if enabled
+    if (!data::WorldPersistence::parseSaveFormat(config_->save_format, save_format_)) {
+        log.warn("Unknown save_format '" + config_->save_format + "', using json");
+    }
     if (config_->persistent_world) {
-        std::string filepath = config_->save_path + "/world_state.json";
-        std::ifstream check(filepath);
-        if (check.good()) {
-            check.close();
+        std::string filepath = worldSavePath();
+        if (config_->save_journal) {
+            world_journal_ = std::make_unique<data::WorldJournal>(
+                world_persistence_, filepath, config_->save_path + "/world_state.journal",
+                save_format_);
+            world_journal_->setCompactRatio(
+                std::max(1, config_->journal_compact_percent) / 100.0);
+        }
+        if (world_journal_ ? world_journal_->exists() : std::ifstream(filepath).good()) {
             log.info("Loading persistent world from " + filepath + "...");
             if (loadWorld()) {
                 log.info("Persistent world loaded successfully (" +
@@ -176,6 +227,7 @@ void Server::start() {
     }
     
     running_ = true;
+    stop_requested_ = false;
     tcp_server_->start();
     
     utils::Logger::instance().info("Server started! Ready for connections.");
@@ -222,22 +274,61 @@ void Server::run() {
 }
 
 void Server::mainLoop() {
-    const float tick_duration = 1.0f / config_->tick_rate;
-    const auto tick_ms = std::chrono::milliseconds(static_cast<int>(tick_duration * 1000));
+    utils::TickScheduler::Settings schedule;
+    schedule.tick_rate = config_->tick_rate;
+    schedule.max_catch_up_ticks = config_->tick_max_catch_up;
+    schedule.spin = std::chrono::microseconds(std::max(0, config_->tick_spin_us));
+    if (!utils::TickScheduler::parsePolicy(config_->tick_catch_up, schedule.policy)) {
+        utils::Logger::instance().warn("Unknown tick_catch_up '" + config_->tick_catch_up +
+                                       "', using catch_up");
+    }
+    utils::TickScheduler scheduler(schedule);
     
     auto last_save_time = std::chrono::steady_clock::now();
     const auto save_interval = std::chrono::seconds(config_->save_interval_seconds);
+    double save_cost_ms = 0.0;      // duration of the last autosave
+    
+    auto last_metrics_write = std::chrono::steady_clock::now();
+    const auto metrics_interval = std::chrono::seconds(std::max(1, config_->metrics_interval_seconds));
+    
+    // The recording starts from the world as it is now; the snapshot is
+    // taken before the first tick so the network threads cannot race it.
+    // Storage and queries are put in creation order first, which is the
+    // order a replay rebuilds them in.
+    if (!config_->tick_recording.empty() && game_session_) {
+        game_world_->canonicalize();
+        std::string snapshot = data::WorldBinaryFormat(world_persistence_).encodeWorld(game_world_.get());
+        if (recorder_.open(config_->tick_recording, snapshot, game_world_->getHandleLayout())) {
+            game_session_->setRecorder(&recorder_);
+            utils::Logger::instance().info("Recording ticks to " + config_->tick_recording);
+        }
+    }
     
-    while (running_) {
-        auto frame_start = std::chrono::steady_clock::now();
+    scheduler.start();
+    while (running_ && !stop_requested_) {
+        auto tick = scheduler.waitNext();
         metrics_.recordTickStart();
+        utils::ProfileScope tick_scope("tick");
+        recorder_.beginTick(tick.number, tick.delta);
+        
+        // Apply client input received since the last tick, before any
+        // system runs, so the network threads never touch the world
+        if (game_session_) {
+            // Acks and replies from all handlers leave in one write per client
+            utils::ProfileScope scope("inbound");
+            network::TCPServer::SendBatch batch;
+            game_session_->processInbound();
+        }
         
         // Update game world (ECS systems)
-        game_world_->update(tick_duration);
+        {
+            utils::ProfileScope scope("world");
+            game_world_->update(tick.delta);
+        }
         
         // Broadcast state to all connected clients
         if (game_session_) {
-            game_session_->update(tick_duration);
+            game_session_->update(tick.delta);
         }
         
         // Update Steam callbacks
@@ -246,31 +337,152 @@ void Server::mainLoop() {
         }
         
         // Update console (process user input)
-        console_.update();
+        {
+            utils::ProfileScope scope("console");
+            console_.update();
+        }
         
-        // Auto-save check
+        // Auto-save check: only the snapshot runs on the tick; the save
+        // itself finishes on the saver thread. The snapshot is deferred to
+        // a tick with room for it, but never by more than one extra
+        // interval, and never while the previous save is still writing.
         if (config_->auto_save && config_->persistent_world) {
             auto now = std::chrono::steady_clock::now();
             if (now - last_save_time >= save_interval) {
-                saveWorld();
-                last_save_time = now;
+                double needed = std::min(save_cost_ms, scheduler.getPeriodMs() / 2.0);
+                bool overdue = now - last_save_time >= 2 * save_interval;
+                if (!world_saver_.isBusy() && (overdue || scheduler.hasBudget(needed, now))) {
+                    beginAutoSave();
+                    auto done = std::chrono::steady_clock::now();
+                    save_cost_ms = std::chrono::duration<double, std::milli>(done - now).count();
+                    last_save_time = now;
+                }
             }
         }
 
+        data::AsyncWorldSaver::Result saved;
+        if (world_saver_.poll(saved)) {
+            metrics_.recordSave(saved.snapshot_ms, saved.background_ms, saved.bytes, saved.ok);
+            if (saved.ok && saved.journaled && !saved.compacted) {
+                utils::Logger::instance().info(
+                    "[AutoSave] Journaled " + std::to_string(saved.upserts) + " changed and " +
+                    std::to_string(saved.removals) + " removed of " +
+                    std::to_string(saved.entities) + " entities (" +
+                    std::to_string(saved.bytes / 1024) + " KB) in " +
+                    std::to_string(static_cast<int>(saved.background_ms)) + " ms; tick paused " +
+                    std::to_string(saved.snapshot_ms) + " ms");
+            } else if (saved.ok) {
+                utils::Logger::instance().info(
+                    "[AutoSave] Saved " + std::to_string(saved.entities) + " entities (" +
+                    std::to_string(saved.bytes / 1024) + " KB) in " +
+                    std::to_string(static_cast<int>(saved.background_ms)) + " ms; tick paused " +
+                    std::to_string(saved.snapshot_ms) + " ms");
+            } else {
+                utils::Logger::instance().error("[AutoSave] Failed to write " + saved.filepath);
+            }
+        }
+
+        scheduler.endTick();
         metrics_.recordTickEnd();
 
         // Update entity / player counters and emit periodic stats
         metrics_.setEntityCount(static_cast<int>(game_world_->getEntityCount()));
         metrics_.setPlayerCount(getPlayerCount());
+        metrics_.setScheduleStats(scheduler.getStats());
         metrics_.logSummaryIfDue(60.0);
         
-        // Sleep for remaining tick time
-        auto frame_end = std::chrono::steady_clock::now();
-        auto frame_duration = frame_end - frame_start;
-        if (frame_duration < tick_ms) {
-            std::this_thread::sleep_for(tick_ms - frame_duration);
+        if (!config_->metrics_file.empty()) {
+            auto now = std::chrono::steady_clock::now();
+            if (now - last_metrics_write >= metrics_interval) {
+                metrics_.writeScrapeFile(config_->metrics_file);
+                last_metrics_write = now;
+            }
         }
     }
+
+    if (recorder_.isOpen()) {
+        game_session_->setRecorder(nullptr);
+        recorder_.close();
+        utils::Logger::instance().info(
+            "Recorded " + std::to_string(recorder_.getTickCount()) + " ticks, " +
+            std::to_string(recorder_.getCommandCount()) + " commands (" +
+            std::to_string(recorder_.getBytesWritten() / 1024) + " KB); world fingerprint " +
+            getWorldFingerprint());
+    }
+}
+
+bool Server::replay(const std::string& recording_path) {
+    data::TickRecordingReader reader;
+    if (!reader.open(recording_path)) {
+        std::cerr << "Not a tick recording: " << recording_path << std::endl;
+        return false;
+    }
+
+    // Same systems and session as a live server; the TCP server is never
+    // initialized, so replies and state updates go nowhere. The world
+    // holds only the recording's entities, never the startup NPCs.
+    initializeGameWorld();
+    tcp_server_ = std::make_unique<network::TCPServer>("127.0.0.1", 0, 1, 1);
+    createGameSession(false);
+    const std::string& snapshot = reader.getSnapshot();
+    if (!data::WorldBinaryFormat(world_persistence_).decode(game_world_.get(), snapshot.data(),
+                                                            snapshot.size())) {
+        std::cerr << "Corrupt starting world in " << recording_path << std::endl;
+        return false;
+    }
+
+    // Give every entity the handle it had in the recorded run; version 1
+    // recordings carry no handle table and get fresh handles
+    const auto& layout = reader.getHandleLayout();
+    if (layout.generations.empty() && layout.entities.empty()) {
+        game_world_->canonicalize();
+    } else if (!game_world_->restoreHandleLayout(layout)) {
+        std::cerr << "Handle table does not match the starting world in "
+                  << recording_path << std::endl;
+        return false;
+    }
+    std::cout << "Replaying " << recording_path << " from "
+              << game_world_->getEntityCount() << " entities" << std::endl;
+
+    uint64_t ticks = 0;
+    uint64_t commands = 0;
+    double simulated = 0.0;
+    data::TickRecordingReader::Tick tick;
+    auto start = std::chrono::steady_clock::now();
+    while (reader.next(tick)) {
+        utils::ProfileScope tick_scope("tick");
+        {
+            utils::ProfileScope scope("inbound");
+            for (const auto& command : tick.commands) {
+                game_session_->replayCommand(command);
+            }
+            game_session_->processInbound();
+        }
+        {
+            utils::ProfileScope scope("world");
+            game_world_->update(tick.delta);
+        }
+        game_session_->update(tick.delta);
+        ++ticks;
+        commands += tick.commands.size();
+        simulated += tick.delta;
+    }
+    double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "Replayed " << ticks << " ticks, " << commands << " commands in "
+              << wall << " s (" << (wall > 0.0 ? simulated / wall : 0.0) << "x real time)"
+              << (reader.isTruncated() ? "; recording was truncated" : "") << "\n"
+              << metrics_.profileReport() << "\n"
+              << "Final world: " << game_world_->getEntityCount() << " entities, fingerprint "
+              << getWorldFingerprint() << std::endl;
+    return true;
+}
+
+std::string Server::getWorldFingerprint() const {
+    uint64_t sum = data::WorldJournal::fingerprintWorld(world_persistence_, game_world_.get());
+    char hex[17];
+    std::snprintf(hex, sizeof(hex), "%016llx", static_cast<unsigned long long>(sum));
+    return hex;
 }
 
 void Server::updateSteam() {
@@ -292,8 +504,7 @@ int Server::getPlayerCount() const {
                          : (tcp_server_ ? tcp_server_->getClientCount() : 0);
 }
 
-bool Server::saveWorld() {
-    // Ensure save directory exists
+bool Server::ensureSaveDirectory() {
     struct stat st;
     if (stat(config_->save_path.c_str(), &st) != 0) {
         int ret;
@@ -308,14 +519,57 @@ bool Server::saveWorld() {
             return false;
         }
     }
+    return true;
+}
+
+std::string Server::worldSavePath() const {
+    return config_->save_path + "/world_state" +
+           data::WorldPersistence::saveFormatExtension(save_format_);
+}
 
-    std::string filepath = config_->save_path + "/world_state.json";
+bool Server::saveWorld() {
+    utils::ProfileScope scope("save");
+
+    // Never race a background save for the same file
+    world_saver_.wait();
+    if (!ensureSaveDirectory()) return false;
+
+    std::string filepath = worldSavePath();
     utils::Logger::instance().info("[AutoSave] Saving world state...");
+    if (world_journal_) {
+        // A full save must also restart the journal
+        return world_journal_->compact(*world_persistence_.snapshotWorld(game_world_.get())).ok;
+    }
+    if (save_format_ == data::SaveFormat::Compressed) {
+        return world_persistence_.saveWorldCompressed(game_world_.get(), filepath);
+    }
+    if (save_format_ == data::SaveFormat::Binary) {
+        return data::WorldBinaryFormat(world_persistence_).save(game_world_.get(), filepath);
+    }
     return world_persistence_.saveWorld(game_world_.get(), filepath);
 }
 
+bool Server::beginAutoSave() {
+    utils::ProfileScope scope("save");
+
+    if (!ensureSaveDirectory()) return false;
+    if (world_journal_) {
+        return world_saver_.begin(game_world_.get(), *world_journal_);
+    }
+    return world_saver_.begin(game_world_.get(), worldSavePath(), save_format_);
+}
+
 bool Server::loadWorld() {
-    std::string filepath = config_->save_path + "/world_state.json";
+    if (world_journal_) {
+        return world_journal_->load(game_world_.get());
+    }
+    std::string filepath = worldSavePath();
+    if (save_format_ == data::SaveFormat::Compressed) {
+        return world_persistence_.loadWorldCompressed(game_world_.get(), filepath);
+    }
+    if (save_format_ == data::SaveFormat::Binary) {
+        return data::WorldBinaryFormat(world_persistence_).load(game_world_.get(), filepath);
+    }
     return world_persistence_.loadWorld(game_world_.get(), filepath);
 }
 
@@ -1,5 +1,6 @@
 #include "systems/ai_system.h"
 #include "systems/combat_system.h"
+#include "systems/spatial_index_system.h"
 #include "ecs/world.h"
 #include "components/game_components.h"
 #include <cmath>
@@ -11,37 +12,157 @@ namespace systems {
 
 AISystem::AISystem(ecs::World* world)
     : System(world) {
+    writes<components::AI>();
+    writes<components::Velocity>();
+    writes<components::MiningLaser>();
+    reads<components::Position>();
+    reads<components::Faction>();
+    reads<components::Standings>();
+    reads<components::Health>();
+    reads<components::DamageEvent>();
+    reads<components::Ship>();
+    reads<components::Weapon>();
+    reads<components::Inventory>();
+    reads<components::MineralDeposit>();
+    reads<components::Player>();
+    reads<components::LODPriority>();
 }
 
 void AISystem::update(float delta_time) {
-    // Get all entities with AI component
-    auto entities = world_->getEntities<components::AI, components::Position, components::Velocity>();
+    // Cached query of all entities with AI, Position and Velocity
+    const auto& entities = world_->view<components::AI, components::Position, components::Velocity>();
+    ++tick_;
+    
+    const int interval = std::max(1, think_settings_.think_interval);
+    if (interval == 1 && think_settings_.budget_turns <= 0) {
+        for (auto* entity : entities) think(entity);
+        last_think_count_ = entities.size();
+        return;
+    }
+    
+    markEveryTick();
     
+    // Every-tick NPCs think now; the rest queue up when their turn comes
+    size_t thought = 0;
     for (auto* entity : entities) {
-        auto* ai = entity->getComponent<components::AI>();
+        ecs::EntityHandle handle = entity->getHandle();
+        ThinkSlot& slot = thinkSlot(handle);
+        if (slot.hot_tick == tick_ || inCombat(*entity->getComponent<components::AI>())) {
+            think(entity);
+            slot.think_tick = tick_;
+            ++thought;
+        } else if ((handle.index + tick_) % static_cast<uint64_t>(interval) == 0 &&
+                   slot.queued_generation != handle.generation) {
+            slot.queued_generation = handle.generation;
+            deferred_.push_back(handle);
+        }
+    }
+    
+    // Turns, oldest first, until the budget runs out. The budget counts
+    // turns rather than time, so which NPCs think on a tick depends only
+    // on the simulation, never on machine speed or load
+    const size_t max_turns = think_settings_.budget_turns > 0
+        ? static_cast<size_t>(think_settings_.budget_turns) : std::numeric_limits<size_t>::max();
+    size_t turns = 0;
+    while (!deferred_.empty() && turns < max_turns) {
+        ecs::EntityHandle handle = deferred_.front();
+        deferred_.pop_front();
+        ThinkSlot& slot = thinkSlot(handle);
+        if (slot.queued_generation == handle.generation) slot.queued_generation = 0;
         
-        // Execute behavior based on current state
-        switch (ai->state) {
-            case components::AI::State::Idle:
-                idleBehavior(entity);
-                break;
-            case components::AI::State::Approaching:
-                approachBehavior(entity);
-                break;
-            case components::AI::State::Orbiting:
-                orbitBehavior(entity);
-                break;
-            case components::AI::State::Attacking:
-                attackBehavior(entity);
-                break;
-            case components::AI::State::Fleeing:
-                fleeBehavior(entity);
-                break;
-            case components::AI::State::Mining:
-                miningBehavior(entity);
-                break;
+        ecs::Entity* entity = world_->getEntity(handle);
+        if (!entity || slot.think_tick == tick_ || !entities.contains(*entity)) continue;
+        think(entity);
+        slot.think_tick = tick_;
+        ++thought;
+        ++turns;
+    }
+    last_think_count_ = thought;
+}
+
+void AISystem::think(ecs::Entity* entity) {
+    auto* ai = entity->getComponent<components::AI>();
+    
+    // Execute behavior based on current state
+    switch (ai->state) {
+        case components::AI::State::Idle:
+            idleBehavior(entity);
+            break;
+        case components::AI::State::Approaching:
+            approachBehavior(entity);
+            break;
+        case components::AI::State::Orbiting:
+            orbitBehavior(entity);
+            break;
+        case components::AI::State::Attacking:
+            attackBehavior(entity);
+            break;
+        case components::AI::State::Fleeing:
+            fleeBehavior(entity);
+            break;
+        case components::AI::State::Mining:
+            miningBehavior(entity);
+            break;
+    }
+}
+
+AISystem::ThinkSlot& AISystem::thinkSlot(ecs::EntityHandle handle) {
+    if (handle.index >= think_slots_.size()) think_slots_.resize(handle.index + 1);
+    return think_slots_[handle.index];
+}
+
+void AISystem::markEveryTick() {
+    // NPCs near a player
+    const float range = think_settings_.near_range;
+    const float range_sq = range * range;
+    if (range > 0.0f) {
+        for (auto* player : world_->view<components::Player, components::Position>()) {
+            auto* player_pos = player->getComponent<components::Position>();
+            nearby_.clear();
+            if (spatial_index_) {
+                spatial_index_->queryRadius(player_pos->x, player_pos->y, player_pos->z, range, nearby_);
+            }
+            const auto& candidates = spatial_index_
+                ? nearby_ : world_->view<components::AI, components::Position>().entities();
+            
+            for (auto* npc : candidates) {
+                if (!npc->hasComponent<components::AI>()) continue;
+                auto* pos = npc->getComponent<components::Position>();
+                float dx = pos->x - player_pos->x;
+                float dy = pos->y - player_pos->y;
+                float dz = pos->z - player_pos->z;
+                if (dx * dx + dy * dy + dz * dz > range_sq) continue;
+                thinkSlot(npc->getHandle()).hot_tick = tick_;
+            }
+        }
+    }
+    
+    // Being shot at: react now rather than on the next turn
+    for (auto* npc : world_->view<components::AI, components::DamageEvent>()) {
+        if (!npc->getComponent<components::DamageEvent>()->recent_hits.empty()) {
+            thinkSlot(npc->getHandle()).hot_tick = tick_;
         }
     }
+    
+    // Close to the observer, as scored by LODCullingSystem
+    for (auto* npc : world_->view<components::AI, components::LODPriority>()) {
+        auto* lod = npc->getComponent<components::LODPriority>();
+        if (lod->force_visible || lod->priority >= 1.0f) {
+            thinkSlot(npc->getHandle()).hot_tick = tick_;
+        }
+    }
+}
+
+bool AISystem::inCombat(const components::AI& ai) {
+    switch (ai.state) {
+        case components::AI::State::Approaching:
+        case components::AI::State::Orbiting:
+        case components::AI::State::Attacking:
+        case components::AI::State::Fleeing:
+            return true;
+        default:
+            return false;
+    }
 }
 
 void AISystem::idleBehavior(ecs::Entity* entity) {
@@ -57,6 +178,7 @@ void AISystem::idleBehavior(ecs::Entity* entity) {
             ecs::Entity* deposit = findNearestDeposit(entity);
             if (deposit) {
                 ai->target_entity_id = deposit->getId();
+                ai->target_handle = deposit->getHandle();
                 ai->state = components::AI::State::Approaching;
                 return;
             }
@@ -68,6 +190,7 @@ void AISystem::idleBehavior(ecs::Entity* entity) {
         ecs::Entity* attacker = findAttackerOfFriendly(entity);
         if (attacker) {
             ai->target_entity_id = attacker->getId();
+            ai->target_handle = attacker->getHandle();
             ai->state = components::AI::State::Approaching;
             return;
         }
@@ -97,6 +220,7 @@ void AISystem::idleBehavior(ecs::Entity* entity) {
     // If found a target, switch to approaching
     if (target) {
         ai->target_entity_id = target->getId();
+        ai->target_handle = target->getHandle();
         ai->state = components::AI::State::Approaching;
     }
 }
@@ -114,7 +238,7 @@ void AISystem::approachBehavior(ecs::Entity* entity) {
         return;
     }
     
-    auto* target = world_->getEntity(ai->target_entity_id);
+    auto* target = resolveTarget(world_, *ai);
     if (!target) {
         ai->state = components::AI::State::Idle;
         ai->target_entity_id.clear();
@@ -172,7 +296,7 @@ void AISystem::orbitBehavior(ecs::Entity* entity) {
         return;
     }
     
-    auto* target = world_->getEntity(ai->target_entity_id);
+    auto* target = resolveTarget(world_, *ai);
     if (!target) {
         ai->state = components::AI::State::Idle;
         ai->target_entity_id.clear();
@@ -237,7 +361,7 @@ void AISystem::fleeBehavior(ecs::Entity* entity) {
         return;
     }
     
-    auto* target = world_->getEntity(ai->target_entity_id);
+    auto* target = resolveTarget(world_, *ai);
     if (!target) {
         ai->state = components::AI::State::Idle;
         ai->target_entity_id.clear();
@@ -270,12 +394,29 @@ void AISystem::fleeBehavior(ecs::Entity* entity) {
     }
 }
 
+ecs::Entity* AISystem::resolveTarget(ecs::World* world, components::AI& ai) {
+    if (ai.target_entity_id.empty()) return nullptr;
+    
+    ecs::Entity* target = world->getEntity(ai.target_handle);
+    if (target && target->getId() == ai.target_entity_id) return target;
+    
+    target = world->getEntity(ai.target_entity_id);
+    ai.target_handle = target ? target->getHandle() : ecs::EntityHandle{};
+    return target;
+}
+
 ecs::Entity* AISystem::selectTarget(ecs::Entity* entity) {
     auto* ai = entity->getComponent<components::AI>();
     auto* pos = entity->getComponent<components::Position>();
     if (!ai || !pos) return nullptr;
     
-    auto all_entities = world_->getEntities<components::Position>();
+    // Only entities within awareness range can be picked; with an index
+    // that is all we look at, otherwise every positioned entity
+    nearby_.clear();
+    if (spatial_index_) {
+        spatial_index_->queryRadius(pos->x, pos->y, pos->z, ai->awareness_range, nearby_);
+    }
+    const auto& all_entities = spatial_index_ ? nearby_ : world_->view<components::Position>().entities();
     
     ecs::Entity* best_target = nullptr;
     float best_score = std::numeric_limits<float>::max();
@@ -390,7 +531,7 @@ void AISystem::miningBehavior(ecs::Entity* entity) {
         return;
     }
     
-    auto* target = world_->getEntity(ai->target_entity_id);
+    auto* target = resolveTarget(world_, *ai);
     if (!target) {
         ai->state = components::AI::State::Idle;
         ai->target_entity_id.clear();
@@ -428,7 +569,16 @@ ecs::Entity* AISystem::findNearestDeposit(ecs::Entity* entity) {
     auto* pos = entity->getComponent<components::Position>();
     if (!ai || !pos) return nullptr;
     
-    auto all_entities = world_->getEntities<components::Position, components::MineralDeposit>();
+    if (spatial_index_) {
+        auto nearest = spatial_index_->queryNearest(pos->x, pos->y, pos->z, 1, ai->awareness_range,
+            [](ecs::Entity* candidate) {
+                auto* dep = candidate->getComponent<components::MineralDeposit>();
+                return dep && !dep->isDepleted();
+            });
+        return nearest.empty() ? nullptr : nearest.front();
+    }
+    
+    const auto& all_entities = world_->view<components::Position, components::MineralDeposit>();
     
     ecs::Entity* nearest = nullptr;
     float best_dist = std::numeric_limits<float>::max();
@@ -462,10 +612,16 @@ ecs::Entity* AISystem::findAttackerOfFriendly(ecs::Entity* entity) {
     auto* our_faction = entity->getComponent<components::Faction>();
     if (!ai || !pos || !our_faction) return nullptr;
 
-    auto candidates = world_->getEntities<components::Position, components::DamageEvent>();
+    nearby_.clear();
+    if (spatial_index_) {
+        spatial_index_->queryRadius(pos->x, pos->y, pos->z, ai->awareness_range, nearby_);
+    }
+    const auto& candidates = spatial_index_
+        ? nearby_ : world_->view<components::Position, components::DamageEvent>().entities();
 
     for (auto* friendly : candidates) {
         if (friendly == entity) continue;
+        if (!friendly->hasComponent<components::DamageEvent>()) continue;
 
         auto* f_pos = friendly->getComponent<components::Position>();
         if (!f_pos) continue;
@@ -500,7 +656,7 @@ ecs::Entity* AISystem::findAttackerOfFriendly(ecs::Entity* entity) {
         // The most recent hit's source is the attacker
         // DamageEvent doesn't store attacker id, so look for nearby hostiles
         // targeting this friendly entity
-        auto all_ai = world_->getEntities<components::AI, components::Position>();
+        const auto& all_ai = world_->view<components::AI, components::Position>();
         for (auto* potential_attacker : all_ai) {
             if (potential_attacker == entity) continue;
             auto* atk_ai = potential_attacker->getComponent<components::AI>();
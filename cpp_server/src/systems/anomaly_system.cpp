@@ -8,21 +8,27 @@ namespace atlas {
 namespace systems {
 
 AnomalySystem::AnomalySystem(ecs::World* world)
-    : System(world) {
+    : System(world),
+      anomalies_(world, getName(),
+                 [](ecs::Entity*, components::Anomaly& anomaly, float elapsed) {
+                     return advanceDespawn(anomaly, elapsed);
+                 }) {
 }
 
 void AnomalySystem::update(float delta_time) {
-    // Tick despawn timers on all anomalies
-    for (auto* entity : world_->getAllEntities()) {
-        auto* anom = entity->getComponent<components::Anomaly>();
-        if (!anom) continue;
-        if (anom->completed) continue;
+    // Despawn timers fire from the wheel; live anomalies cost nothing here
+    anomalies_.update(delta_time);
+}
 
-        anom->despawn_timer -= delta_time;
-        if (anom->despawn_timer <= 0.0f) {
-            anom->completed = true;  // mark for cleanup
-        }
+float AnomalySystem::advanceDespawn(components::Anomaly& anomaly, float elapsed) {
+    if (anomaly.completed) return -1.0f;
+
+    anomaly.despawn_timer -= elapsed;
+    if (anomaly.despawn_timer <= 0.0f) {
+        anomaly.completed = true;  // mark for cleanup
+        return -1.0f;
     }
+    return anomaly.despawn_timer;
 }
 
 // -----------------------------------------------------------------------
@@ -74,9 +80,7 @@ int AnomalySystem::generateAnomalies(const std::string& system_id,
         auto* entity = world_->createEntity(anom_id);
         if (!entity) continue;
 
-        auto anom_comp = std::make_unique<components::Anomaly>();
-        auto* anom = anom_comp.get();
-        entity->addComponent(std::move(anom_comp));
+        auto* anom = entity->addComponent(std::make_unique<components::Anomaly>());
         anom->anomaly_id = anom_id;
         anom->anomaly_name = generateName(type, i);
         anom->system_id = system_id;
@@ -28,9 +28,7 @@ double BountySystem::processKill(const std::string& killer_id,
     // Auto-create BountyLedger if missing
     auto* ledger = entity->getComponent<components::BountyLedger>();
     if (!ledger) {
-        auto newLedger = std::make_unique<components::BountyLedger>();
-        ledger = newLedger.get();
-        entity->addComponent(std::move(newLedger));
+        ledger = entity->addComponent(std::make_unique<components::BountyLedger>());
     }
 
     // Award bounty ISK
@@ -8,6 +8,7 @@ namespace systems {
 
 CapacitorSystem::CapacitorSystem(ecs::World* world)
     : System(world) {
+    writes<components::Capacitor>();
 }
 
 void CapacitorSystem::update(float delta_time) {
@@ -10,6 +10,7 @@ namespace systems {
 
 CombatSystem::CombatSystem(ecs::World* world)
     : System(world) {
+    declaresNoComponentAccess();
 }
 
 void CombatSystem::update(float delta_time) {
@@ -53,15 +54,8 @@ bool CombatSystem::applyDamage(const std::string& target_id, float damage, const
             damage = overflow_damage;
         } else {
             // Record damage event - shield absorbed all damage
-            auto* dmgEvent = target->getComponent<components::DamageEvent>();
-            if (!dmgEvent) {
-                target->addComponent(std::make_unique<components::DamageEvent>());
-                dmgEvent = target->getComponent<components::DamageEvent>();
-            }
-            if (dmgEvent) {
-                dmgEvent->addHit(original_damage, damage_type, "shield",
-                                 dmgEvent->last_hit_time + 1.0f);
-            }
+            recordDamageEvent(target, original_damage, damage_type, "shield",
+                              false, false, false);
             return true;  // All damage absorbed by shields
         }
     } else {
@@ -89,16 +83,8 @@ bool CombatSystem::applyDamage(const std::string& target_id, float damage, const
             damage = overflow_damage;
         } else {
             // Record damage event - armor absorbed remaining damage
-            auto* dmgEvent = target->getComponent<components::DamageEvent>();
-            if (!dmgEvent) {
-                target->addComponent(std::make_unique<components::DamageEvent>());
-                dmgEvent = target->getComponent<components::DamageEvent>();
-            }
-            if (dmgEvent) {
-                dmgEvent->addHit(original_damage, damage_type, layer_hit,
-                                 dmgEvent->last_hit_time + 1.0f,
-                                 shield_depleted, false, false);
-            }
+            recordDamageEvent(target, original_damage, damage_type, layer_hit,
+                              shield_depleted, false, false);
             return true;  // All damage absorbed by armor
         }
     } else {
@@ -126,16 +112,8 @@ bool CombatSystem::applyDamage(const std::string& target_id, float damage, const
     }
     
     // Record damage event
-    auto* dmgEvent = target->getComponent<components::DamageEvent>();
-    if (!dmgEvent) {
-        target->addComponent(std::make_unique<components::DamageEvent>());
-        dmgEvent = target->getComponent<components::DamageEvent>();
-    }
-    if (dmgEvent) {
-        dmgEvent->addHit(original_damage, damage_type, layer_hit,
-                         dmgEvent->last_hit_time + 1.0f,
-                         shield_depleted, armor_depleted, hull_critical);
-    }
+    recordDamageEvent(target, original_damage, damage_type, layer_hit,
+                      shield_depleted, armor_depleted, hull_critical);
     
     // Fire death callback when hull reaches zero
     if (health->hull_hp <= 0.0f && death_callback_) {
@@ -193,6 +171,28 @@ bool CombatSystem::fireWeapon(const std::string& shooter_id, const std::string&
     return true;
 }
 
+void CombatSystem::recordDamageEvent(ecs::Entity* target, float damage, const std::string& damage_type,
+                                     const std::string& layer, bool shield_depleted,
+                                     bool armor_depleted, bool hull_critical) {
+    if (auto* dmgEvent = target->getComponent<components::DamageEvent>()) {
+        dmgEvent->addHit(damage, damage_type, layer, dmgEvent->last_hit_time + 1.0f,
+                         shield_depleted, armor_depleted, hull_critical);
+        return;
+    }
+    
+    ecs::EntityHandle handle = target->getHandle();
+    world_->defer([=](ecs::World& world) {
+        auto* entity = world.getEntity(handle);
+        if (!entity) return;
+        auto* dmgEvent = entity->getComponent<components::DamageEvent>();
+        if (!dmgEvent) {
+            dmgEvent = entity->addComponent(std::make_unique<components::DamageEvent>());
+        }
+        dmgEvent->addHit(damage, damage_type, layer, dmgEvent->last_hit_time + 1.0f,
+                         shield_depleted, armor_depleted, hull_critical);
+    });
+}
+
 float CombatSystem::calculateDamage(float base_damage, float resistance) {
     // Resistance is 0.0 to 1.0 (0% to 100%)
     return base_damage * (1.0f - resistance);
@@ -341,7 +341,7 @@ int FleetSystem::broadcastTarget(const std::string& fleet_id,
 
     int count = 0;
     for (auto& [eid, info] : it->second.members) {
-        auto* entity = world_->getEntity(eid);
+        auto* entity = resolveMember(eid, info);
         if (!entity) continue;
 
         auto* target_comp = entity->getComponent<components::Target>();
@@ -379,7 +379,7 @@ int FleetSystem::fleetWarp(const std::string& fleet_id,
 
     int count = 0;
     for (auto& [eid, info] : it->second.members) {
-        auto* entity = world_->getEntity(eid);
+        auto* entity = resolveMember(eid, info);
         if (!entity) continue;
 
         auto* vel = entity->getComponent<components::Velocity>();
@@ -424,6 +424,15 @@ size_t FleetSystem::getMemberCount(const std::string& fleet_id) const {
 
 // ---- Private helpers ----
 
+ecs::Entity* FleetSystem::resolveMember(const std::string& entity_id, FleetMemberInfo& info) {
+    auto* entity = world_->getEntity(info.handle);
+    if (entity && entity->getId() == entity_id) return entity;
+
+    entity = world_->getEntity(entity_id);
+    info.handle = entity ? entity->getHandle() : ecs::EntityHandle{};
+    return entity;
+}
+
 void FleetSystem::applyFleetBonuses(const std::string& fleet_id) {
     auto it = fleets_.find(fleet_id);
     if (it == fleets_.end()) return;
@@ -432,7 +441,7 @@ void FleetSystem::applyFleetBonuses(const std::string& fleet_id) {
     for (const auto& [booster_type, booster_eid] : it->second.active_boosters) {
         auto bonuses = getBonusesForType(booster_type);
         for (auto& [eid, info] : it->second.members) {
-            auto* entity = world_->getEntity(eid);
+            auto* entity = resolveMember(eid, info);
             if (!entity) continue;
 
             auto* fm = entity->getComponent<components::FleetMembership>();
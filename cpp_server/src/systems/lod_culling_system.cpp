@@ -1,4 +1,5 @@
 #include "systems/lod_culling_system.h"
+#include "systems/spatial_index_system.h"
 #include "components/game_components.h"
 #include <cmath>
 
@@ -6,42 +7,68 @@ namespace atlas {
 
 using namespace components;
 
+namespace {
+
+void applyPriority(LODPriority* lod, const Position* pos,
+                   float observerX, float observerY, float observerZ,
+                   float cull_distance) {
+    // Never cull force_visible entities
+    if (lod->force_visible) {
+        lod->priority = 2.0f;
+        return;
+    }
+
+    float dx = pos->x - observerX;
+    float dy = pos->y - observerY;
+    float dz = pos->z - observerZ;
+    float dist = std::sqrt(dx * dx + dy * dy + dz * dz);
+
+    if (dist >= cull_distance) {
+        // Beyond culling distance — mark as culled
+        lod->priority = 0.0f;
+    } else if (lod->impostor_distance <= 0.0f) {
+        // No impostor distance set — use linear falloff
+        float t = dist / cull_distance;
+        lod->priority = 2.0f * (1.0f - t);
+    } else if (dist >= lod->impostor_distance) {
+        // In impostor range — low priority
+        float t = (dist - lod->impostor_distance) / (cull_distance - lod->impostor_distance);
+        lod->priority = 0.5f * (1.0f - t);
+    } else {
+        // Close to observer — full priority (scaled 1.0–2.0)
+        float t = dist / lod->impostor_distance;
+        lod->priority = 2.0f - t;
+    }
+}
+
+} // namespace
+
 void LODCullingSystem::updatePriorities(ecs::World* world,
                                         float observerX, float observerY, float observerZ,
                                         float cull_distance) {
-    auto entities = world->getAllEntities();
-    for (auto* entity : entities) {
-        auto* pos = entity->getComponent<Position>();
-        auto* lod = entity->getComponent<LODPriority>();
-        if (!pos || !lod) continue;
-
-        // Never cull force_visible entities
-        if (lod->force_visible) {
-            lod->priority = 2.0f;
-            continue;
-        }
+    for (auto* entity : world->view<Position, LODPriority>()) {
+        applyPriority(entity->getComponent<LODPriority>(), entity->getComponent<Position>(),
+                      observerX, observerY, observerZ, cull_distance);
+    }
+}
 
-        float dx = pos->x - observerX;
-        float dy = pos->y - observerY;
-        float dz = pos->z - observerZ;
-        float dist = std::sqrt(dx * dx + dy * dy + dz * dz);
+void LODCullingSystem::updatePriorities(ecs::World* world,
+                                        const systems::SpatialIndexSystem& index,
+                                        float observerX, float observerY, float observerZ,
+                                        float cull_distance) {
+    // Cull everything, then rescore what the index finds in range
+    for (auto* entity : world->view<Position, LODPriority>()) {
+        auto* lod = entity->getComponent<LODPriority>();
+        lod->priority = lod->force_visible ? 2.0f : 0.0f;
+    }
 
-        if (dist >= cull_distance) {
-            // Beyond culling distance — mark as culled
-            lod->priority = 0.0f;
-        } else if (lod->impostor_distance <= 0.0f) {
-            // No impostor distance set — use linear falloff
-            float t = dist / cull_distance;
-            lod->priority = 2.0f * (1.0f - t);
-        } else if (dist >= lod->impostor_distance) {
-            // In impostor range — low priority
-            float t = (dist - lod->impostor_distance) / (cull_distance - lod->impostor_distance);
-            lod->priority = 0.5f * (1.0f - t);
-        } else {
-            // Close to observer — full priority (scaled 1.0–2.0)
-            float t = dist / lod->impostor_distance;
-            lod->priority = 2.0f - t;
-        }
+    std::vector<ecs::Entity*> nearby;
+    index.queryRadius(observerX, observerY, observerZ, cull_distance, nearby);
+    for (auto* entity : nearby) {
+        auto* lod = entity->getComponent<LODPriority>();
+        if (!lod) continue;
+        applyPriority(lod, entity->getComponent<Position>(),
+                      observerX, observerY, observerZ, cull_distance);
     }
 }
 
@@ -6,30 +6,37 @@ namespace atlas {
 namespace systems {
 
 ManufacturingSystem::ManufacturingSystem(ecs::World* world)
-    : System(world) {
+    : System(world),
+      facilities_(world, getName(),
+                  [](ecs::Entity*, components::ManufacturingFacility& facility, float elapsed) {
+                      return advanceJobs(facility, elapsed);
+                  }) {
+    writes<components::ManufacturingFacility>();
 }
 
 void ManufacturingSystem::update(float delta_time) {
-    for (auto* entity : world_->getAllEntities()) {
-        auto* facility = entity->getComponent<components::ManufacturingFacility>();
-        if (!facility) continue;
-
-        for (auto& job : facility->jobs) {
-            if (job.status != "active") continue;
-
-            job.time_remaining -= delta_time;
-            if (job.time_remaining <= 0.0f) {
-                job.runs_completed++;
-                if (job.runs_completed >= job.runs) {
-                    job.time_remaining = 0.0f;
-                    job.status = "completed";
-                } else {
-                    // Start next run
-                    job.time_remaining = job.time_per_run;
-                }
+    facilities_.update(delta_time);
+}
+
+float ManufacturingSystem::advanceJobs(components::ManufacturingFacility& facility, float elapsed) {
+    float next_due = -1.0f;
+    for (auto& job : facility.jobs) {
+        if (job.status != "active") continue;
+
+        job.time_remaining -= elapsed;
+        if (job.time_remaining <= 0.0f) {
+            job.runs_completed++;
+            if (job.runs_completed >= job.runs) {
+                job.time_remaining = 0.0f;
+                job.status = "completed";
+                continue;
             }
+            // Start next run
+            job.time_remaining = job.time_per_run;
         }
+        if (next_due < 0.0f || job.time_remaining < next_due) next_due = job.time_remaining;
     }
+    return next_due;
 }
 
 std::string ManufacturingSystem::startJob(const std::string& facility_entity_id,
@@ -72,7 +79,9 @@ std::string ManufacturingSystem::startJob(const std::string& facility_entity_id,
     job.install_cost = install_cost;
     job.status = "active";
 
-    facility->jobs.push_back(job);
+    facilities_.modify(entity, [&job](components::ManufacturingFacility& f) {
+        f.jobs.push_back(job);
+    });
     return job.job_id;
 }
 
@@ -84,13 +93,17 @@ bool ManufacturingSystem::cancelJob(const std::string& facility_entity_id,
     auto* facility = entity->getComponent<components::ManufacturingFacility>();
     if (!facility) return false;
 
-    for (auto& job : facility->jobs) {
-        if (job.job_id == job_id && job.status == "active") {
-            job.status = "cancelled";
-            return true;
+    bool cancelled = false;
+    facilities_.modify(entity, [&](components::ManufacturingFacility& f) {
+        for (auto& job : f.jobs) {
+            if (job.job_id == job_id && job.status == "active") {
+                job.status = "cancelled";
+                cancelled = true;
+                break;
+            }
         }
-    }
-    return false;
+    });
+    return cancelled;
 }
 
 int ManufacturingSystem::getActiveJobCount(const std::string& facility_entity_id) {
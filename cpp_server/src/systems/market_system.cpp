@@ -2,6 +2,7 @@
 #include "ecs/world.h"
 #include "components/game_components.h"
 #include <algorithm>
+#include <cmath>
 #include <limits>
 
 namespace atlas {
@@ -9,58 +10,53 @@ namespace systems {
 
 MarketSystem::MarketSystem(ecs::World* world)
     : System(world) {
+    writes<components::MarketHub>();
+    writes<components::Player>();     // expired buy orders refund escrow
 }
 
 void MarketSystem::update(float delta_time) {
-    // Tick order durations and expire/clean up
+    // Only orders that come due are touched
     auto entities = world_->getEntities<components::MarketHub>();
     for (auto* entity : entities) {
         auto* hub = entity->getComponent<components::MarketHub>();
         if (!hub) continue;
 
-        for (auto& order : hub->orders) {
-            if (order.fulfilled) continue;
-            if (order.duration_remaining < 0.0f) continue; // permanent
-            order.duration_remaining -= delta_time;
-            if (order.duration_remaining <= 0.0f) {
-                order.fulfilled = true;
-            }
-        }
-
-        // Remove fulfilled orders
-        hub->orders.erase(
-            std::remove_if(hub->orders.begin(), hub->orders.end(),
-                [](const components::MarketHub::Order& o) { return o.fulfilled; }),
-            hub->orders.end());
+        hub->orders.advance(delta_time, [this](const components::MarketHub::Order& order) {
+            refundEscrow(order);
+        });
     }
 }
 
-std::string MarketSystem::placeSellOrder(const std::string& station_id,
-                                          const std::string& seller_id,
-                                          const std::string& item_id,
-                                          const std::string& item_name,
-                                          int quantity,
-                                          double price_per_unit) {
+uint64_t MarketSystem::placeSellOrder(const std::string& station_id,
+                                      const std::string& seller_id,
+                                      const std::string& item_id,
+                                      const std::string& item_name,
+                                      int quantity,
+                                      double price_per_unit,
+                                      float duration) {
     auto* station = world_->getEntity(station_id);
-    if (!station) return "";
+    if (!station) return 0;
 
     auto* hub = station->getComponent<components::MarketHub>();
-    if (!hub) return "";
+    if (!hub) return 0;
 
     auto* seller = world_->getEntity(seller_id);
-    if (!seller) return "";
+    if (!seller) return 0;
 
     auto* player = seller->getComponent<components::Player>();
-    if (!player) return "";
+    if (!player) return 0;
+
+    if (quantity <= 0) return 0;
+    // NaN would break the book's price ordering
+    if (!std::isfinite(price_per_unit) || price_per_unit <= 0.0) return 0;
 
     // Deduct broker fee
     double broker_fee = price_per_unit * quantity * hub->broker_fee_rate;
-    if (player->isk < broker_fee) return "";
+    if (player->isk < broker_fee) return 0;
     player->isk -= broker_fee;
 
     // Create order
     components::MarketHub::Order order;
-    order.order_id = "order_" + std::to_string(++order_counter_);
     order.item_id = item_id;
     order.item_name = item_name;
     order.owner_id = seller_id;
@@ -68,39 +64,40 @@ std::string MarketSystem::placeSellOrder(const std::string& station_id,
     order.price_per_unit = price_per_unit;
     order.quantity = quantity;
     order.quantity_remaining = quantity;
-    hub->orders.push_back(order);
-
-    return order.order_id;
+    return hub->orders.add(std::move(order), duration);
 }
 
-std::string MarketSystem::placeBuyOrder(const std::string& station_id,
-                                         const std::string& buyer_id,
-                                         const std::string& item_id,
-                                         const std::string& item_name,
-                                         int quantity,
-                                         double price_per_unit) {
+uint64_t MarketSystem::placeBuyOrder(const std::string& station_id,
+                                     const std::string& buyer_id,
+                                     const std::string& item_id,
+                                     const std::string& item_name,
+                                     int quantity,
+                                     double price_per_unit,
+                                     float duration) {
     auto* station = world_->getEntity(station_id);
-    if (!station) return "";
+    if (!station) return 0;
 
     auto* hub = station->getComponent<components::MarketHub>();
-    if (!hub) return "";
+    if (!hub) return 0;
 
     auto* buyer = world_->getEntity(buyer_id);
-    if (!buyer) return "";
+    if (!buyer) return 0;
 
     auto* player = buyer->getComponent<components::Player>();
-    if (!player) return "";
+    if (!player) return 0;
+
+    if (quantity <= 0) return 0;
+    if (!std::isfinite(price_per_unit) || price_per_unit <= 0.0) return 0;
 
     // Escrow total cost + broker fee
     double total_cost = price_per_unit * quantity;
     double broker_fee = total_cost * hub->broker_fee_rate;
     double escrow = total_cost + broker_fee;
-    if (player->isk < escrow) return "";
+    if (player->isk < escrow) return 0;
     player->isk -= escrow;
 
     // Create order
     components::MarketHub::Order order;
-    order.order_id = "order_" + std::to_string(++order_counter_);
     order.item_id = item_id;
     order.item_name = item_name;
     order.owner_id = buyer_id;
@@ -108,9 +105,36 @@ std::string MarketSystem::placeBuyOrder(const std::string& station_id,
     order.price_per_unit = price_per_unit;
     order.quantity = quantity;
     order.quantity_remaining = quantity;
-    hub->orders.push_back(order);
+    return hub->orders.add(std::move(order), duration);
+}
+
+bool MarketSystem::cancelOrder(const std::string& station_id,
+                               const std::string& owner_id,
+                               uint64_t order_id) {
+    auto* station = world_->getEntity(station_id);
+    if (!station) return false;
+
+    auto* hub = station->getComponent<components::MarketHub>();
+    if (!hub) return false;
+
+    const auto* order = hub->orders.find(order_id);
+    if (!order || order->owner_id != owner_id) return false;
+
+    components::MarketHub::Order removed;
+    hub->orders.cancel(order_id, &removed);
+    refundEscrow(removed);
+    return true;
+}
 
-    return order.order_id;
+void MarketSystem::refundEscrow(const data::OrderBook::Order& order) {
+    if (!order.is_buy_order) return;
+    auto* owner = world_->getEntity(order.owner_id);
+    if (!owner) return;
+    auto* player = owner->getComponent<components::Player>();
+    if (player) {
+        // The broker fee is not refunded
+        player->isk += order.price_per_unit * order.quantity_remaining;
+    }
 }
 
 int MarketSystem::buyFromMarket(const std::string& station_id,
@@ -133,16 +157,8 @@ int MarketSystem::buyFromMarket(const std::string& station_id,
     int remaining = quantity;
 
     while (remaining > 0) {
-        // Find cheapest sell order for this item
-        components::MarketHub::Order* best = nullptr;
-        for (auto& order : hub->orders) {
-            if (order.fulfilled || order.is_buy_order) continue;
-            if (order.item_id != item_id) continue;
-            if (order.quantity_remaining <= 0) continue;
-            if (!best || order.price_per_unit < best->price_per_unit) {
-                best = &order;
-            }
-        }
+        // Cheapest sell order for this item, oldest first at equal prices
+        const auto* best = hub->orders.best(item_id, false);
         if (!best) break;
 
         int can_buy = std::min(remaining, best->quantity_remaining);
@@ -163,10 +179,7 @@ int MarketSystem::buyFromMarket(const std::string& station_id,
             }
         }
 
-        best->quantity_remaining -= can_buy;
-        if (best->quantity_remaining <= 0) {
-            best->fulfilled = true;
-        }
+        hub->orders.fill(best->order_id, can_buy);   // best is invalid after this
 
         total_bought += can_buy;
         remaining -= can_buy;
@@ -183,16 +196,8 @@ double MarketSystem::getLowestSellPrice(const std::string& station_id,
     auto* hub = station->getComponent<components::MarketHub>();
     if (!hub) return -1.0;
 
-    double lowest = -1.0;
-    for (const auto& order : hub->orders) {
-        if (order.fulfilled || order.is_buy_order) continue;
-        if (order.item_id != item_id) continue;
-        if (order.quantity_remaining <= 0) continue;
-        if (lowest < 0.0 || order.price_per_unit < lowest) {
-            lowest = order.price_per_unit;
-        }
-    }
-    return lowest;
+    const auto* best = hub->orders.best(item_id, false);
+    return best ? best->price_per_unit : -1.0;
 }
 
 double MarketSystem::getHighestBuyPrice(const std::string& station_id,
@@ -203,16 +208,8 @@ double MarketSystem::getHighestBuyPrice(const std::string& station_id,
     auto* hub = station->getComponent<components::MarketHub>();
     if (!hub) return -1.0;
 
-    double highest = -1.0;
-    for (const auto& order : hub->orders) {
-        if (order.fulfilled || !order.is_buy_order) continue;
-        if (order.item_id != item_id) continue;
-        if (order.quantity_remaining <= 0) continue;
-        if (highest < 0.0 || order.price_per_unit > highest) {
-            highest = order.price_per_unit;
-        }
-    }
-    return highest;
+    const auto* best = hub->orders.best(item_id, true);
+    return best ? best->price_per_unit : -1.0;
 }
 
 int MarketSystem::getOrderCount(const std::string& station_id) {
@@ -222,13 +219,7 @@ int MarketSystem::getOrderCount(const std::string& station_id) {
     auto* hub = station->getComponent<components::MarketHub>();
     if (!hub) return 0;
 
-    int count = 0;
-    for (const auto& order : hub->orders) {
-        if (!order.fulfilled && order.quantity_remaining > 0) {
-            count++;
-        }
-    }
-    return count;
+    return static_cast<int>(hub->orders.size());
 }
 
 int MarketSystem::seedNPCOrders(const std::string& station_id) {
@@ -248,7 +239,6 @@ int MarketSystem::seedNPCOrders(const std::string& station_id) {
     int created = 0;
     for (const auto& s : seeds) {
         components::MarketHub::Order order;
-        order.order_id = "npc_seed_" + std::to_string(++order_counter_);
         order.item_id = s.id;
         order.item_name = s.name;
         order.owner_id = "npc_market";
@@ -256,10 +246,9 @@ int MarketSystem::seedNPCOrders(const std::string& station_id) {
         order.price_per_unit = s.price;
         order.quantity = s.qty;
         order.quantity_remaining = s.qty;
-        order.duration_remaining = -1.0f;  // permanent
-        order.fulfilled = false;
-        hub->orders.push_back(order);
-        ++created;
+        if (hub->orders.add(std::move(order)) != 0) {  // permanent
+            ++created;
+        }
     }
     return created;
 }
@@ -13,9 +13,11 @@ MiningSystem::MiningSystem(ecs::World* world)
 }
 
 void MiningSystem::update(float delta_time) {
-    for (auto* entity : world_->getAllEntities()) {
+    // Lasers are switched on by AISystem as well as startMining(), so
+    // their cycles stay on the per-tick path, but only over miners
+    for (auto* entity : world_->view<components::MiningLaser>()) {
         auto* laser = entity->getComponent<components::MiningLaser>();
-        if (!laser || !laser->active) continue;
+        if (!laser->active) continue;
 
         auto* deposit_entity = world_->getEntity(laser->target_deposit_id);
         if (!deposit_entity) {
@@ -123,9 +125,9 @@ std::string MiningSystem::createDeposit(const std::string& mineral_type,
 
 int MiningSystem::getActiveMinerCount() const {
     int count = 0;
-    for (const auto* entity : world_->getAllEntities()) {
+    for (const auto* entity : world_->view<components::MiningLaser>()) {
         auto* laser = entity->getComponent<components::MiningLaser>();
-        if (laser && laser->active) count++;
+        if (laser->active) count++;
     }
     return count;
 }
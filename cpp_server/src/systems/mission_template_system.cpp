@@ -36,9 +36,7 @@ void MissionTemplateSystem::addTemplate(
     auto* entity = world_->createEntity(entity_id);
     if (!entity) return;
 
-    auto comp = std::make_unique<components::MissionTemplate>();
-    auto* tpl  = comp.get();
-    entity->addComponent(std::move(comp));
+    auto* tpl = entity->addComponent(std::make_unique<components::MissionTemplate>());
 
     tpl->template_id          = template_id;
     tpl->name_pattern          = name_pattern;
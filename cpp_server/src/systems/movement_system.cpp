@@ -17,6 +17,9 @@ static constexpr float DEFAULT_ALIGN_TIME = 2.5f;
 
 MovementSystem::MovementSystem(ecs::World* world)
     : System(world) {
+    writes<components::Position>();
+    writes<components::Velocity>();
+    writes<components::WarpState>();
 }
 
 void MovementSystem::setCollisionZones(const std::vector<CollisionZone>& zones) {
@@ -42,7 +45,7 @@ void MovementSystem::update(float delta_time) {
         auto& cmd = it->second;
 
         if (cmd.type == MovementCommand::Type::Approach) {
-            auto* target = world_->getEntity(cmd.target_id);
+            auto* target = world_->getEntity(cmd.target);
             if (target) {
                 auto* tpos = target->getComponent<components::Position>();
                 if (tpos) {
@@ -66,7 +69,7 @@ void MovementSystem::update(float delta_time) {
                 }
             }
         } else if (cmd.type == MovementCommand::Type::Orbit) {
-            auto* target = world_->getEntity(cmd.target_id);
+            auto* target = world_->getEntity(cmd.target);
             if (target) {
                 auto* tpos = target->getComponent<components::Position>();
                 if (tpos) {
@@ -157,14 +160,14 @@ void MovementSystem::update(float delta_time) {
         ++it;
     }
 
-    // Get all entities with Position and Velocity components
-    auto entities = world_->getEntities<components::Position, components::Velocity>();
-    
-    for (auto* entity : entities) {
+    // Integrate every entity with Position and Velocity, streaming
+    // through the packed Velocity pool in page-sized parallel chunks.
+    // Each entity only touches its own Position and Velocity.
+    world_->parallelForEach<components::Velocity>([&](ecs::Entity* entity, components::Velocity& velocity) {
         auto* pos = entity->getComponent<components::Position>();
-        auto* vel = entity->getComponent<components::Velocity>();
+        auto* vel = &velocity;
         
-        if (!pos || !vel) continue;
+        if (!pos) return;
         
         // Update position based on velocity
         pos->x += vel->vx * delta_time;
@@ -210,47 +213,45 @@ void MovementSystem::update(float delta_time) {
                 }
             }
         }
-    }
+    });
 }
 
 void MovementSystem::commandOrbit(const std::string& entity_id,
                                    const std::string& target_id,
                                    float distance) {
+    auto* entity = world_->getEntity(entity_id);
+    if (!entity) return;
     MovementCommand cmd;
     cmd.type = MovementCommand::Type::Orbit;
-    cmd.target_id = target_id;
+    cmd.target = world_->getHandle(target_id);
     cmd.orbit_distance = distance;
     // Read align time from Ship component for inertia-based turning
-    auto* entity = world_->getEntity(entity_id);
-    if (entity) {
-        auto* ship = entity->getComponent<components::Ship>();
-        if (ship) {
-            cmd.align_time = ship->align_time;
-        }
+    auto* ship = entity->getComponent<components::Ship>();
+    if (ship) {
+        cmd.align_time = ship->align_time;
     }
-    movement_commands_[entity_id] = cmd;
+    movement_commands_[entity->getHandle()] = cmd;
 }
 
 void MovementSystem::commandApproach(const std::string& entity_id,
                                       const std::string& target_id) {
+    auto* entity = world_->getEntity(entity_id);
+    if (!entity) return;
     MovementCommand cmd;
     cmd.type = MovementCommand::Type::Approach;
-    cmd.target_id = target_id;
+    cmd.target = world_->getHandle(target_id);
     // Read align time from Ship component for inertia-based turning
-    auto* entity = world_->getEntity(entity_id);
-    if (entity) {
-        auto* ship = entity->getComponent<components::Ship>();
-        if (ship) {
-            cmd.align_time = ship->align_time;
-        }
+    auto* ship = entity->getComponent<components::Ship>();
+    if (ship) {
+        cmd.align_time = ship->align_time;
     }
-    movement_commands_[entity_id] = cmd;
+    movement_commands_[entity->getHandle()] = cmd;
 }
 
 void MovementSystem::commandStop(const std::string& entity_id) {
-    movement_commands_.erase(entity_id);
     auto* entity = world_->getEntity(entity_id);
     if (!entity) return;
+    movement_commands_.erase(entity->getHandle());
     auto* vel = entity->getComponent<components::Velocity>();
     if (vel) {
         vel->vx = 0.0f;
@@ -311,7 +312,7 @@ bool MovementSystem::commandWarp(const std::string& entity_id,
     cmd.warp_duration = warp_duration;
     cmd.align_time = align_time;
     cmd.warping = true;
-    movement_commands_[entity_id] = cmd;
+    movement_commands_[entity->getHandle()] = cmd;
     return true;
 }
 
@@ -6,91 +6,104 @@ namespace atlas {
 namespace systems {
 
 PISystem::PISystem(ecs::World* world)
-    : System(world) {
+    : System(world),
+      colonies_(world, getName(),
+                [](ecs::Entity*, components::PlanetaryColony& colony, float elapsed) {
+                    return advanceColony(&colony, elapsed);
+                }) {
+    writes<components::PlanetaryColony>();
 }
 
 void PISystem::update(float delta_time) {
-    for (auto* entity : world_->getAllEntities()) {
-        auto* colony = entity->getComponent<components::PlanetaryColony>();
-        if (!colony) continue;
-
-        // Tick extractors
-        for (auto& ext : colony->extractors) {
-            if (!ext.active) continue;
-            ext.cycle_progress += delta_time;
-            while (ext.cycle_progress >= ext.cycle_time) {
-                ext.cycle_progress -= ext.cycle_time;
-
-                // Check storage capacity
-                if (colony->totalStored() + ext.quantity_per_cycle > static_cast<int>(colony->storage_capacity))
-                    continue;
-
-                // Add extracted resource to storage
-                bool found = false;
-                for (auto& s : colony->storage) {
-                    if (s.resource_type == ext.resource_type) {
-                        s.quantity += ext.quantity_per_cycle;
-                        found = true;
-                        break;
-                    }
-                }
-                if (!found) {
-                    components::PlanetaryColony::StoredResource sr;
-                    sr.resource_type = ext.resource_type;
-                    sr.quantity = ext.quantity_per_cycle;
-                    colony->storage.push_back(sr);
+    colonies_.update(delta_time);
+}
+
+float PISystem::advanceColony(components::PlanetaryColony* colony, float delta_time) {
+    // Seconds until the first extractor or processor finishes its cycle
+    float next_due = -1.0f;
+    auto due = [&next_due](float remaining) {
+        if (next_due < 0.0f || remaining < next_due) next_due = remaining;
+    };
+
+    // Tick extractors
+    for (auto& ext : colony->extractors) {
+        if (!ext.active) continue;
+        ext.cycle_progress += delta_time;
+        while (ext.cycle_progress >= ext.cycle_time) {
+            ext.cycle_progress -= ext.cycle_time;
+
+            // Check storage capacity
+            if (colony->totalStored() + ext.quantity_per_cycle > static_cast<int>(colony->storage_capacity))
+                continue;
+
+            // Add extracted resource to storage
+            bool found = false;
+            for (auto& s : colony->storage) {
+                if (s.resource_type == ext.resource_type) {
+                    s.quantity += ext.quantity_per_cycle;
+                    found = true;
+                    break;
                 }
             }
+            if (!found) {
+                components::PlanetaryColony::StoredResource sr;
+                sr.resource_type = ext.resource_type;
+                sr.quantity = ext.quantity_per_cycle;
+                colony->storage.push_back(sr);
+            }
         }
+        due(ext.cycle_time - ext.cycle_progress);
+    }
 
-        // Tick processors
-        for (auto& proc : colony->processors) {
-            if (!proc.active) continue;
-            proc.cycle_progress += delta_time;
-            while (proc.cycle_progress >= proc.cycle_time) {
-                proc.cycle_progress -= proc.cycle_time;
-
-                // Check input availability
-                int available_input = 0;
-                for (const auto& s : colony->storage) {
-                    if (s.resource_type == proc.input_type) {
-                        available_input = s.quantity;
-                        break;
-                    }
+    // Tick processors
+    for (auto& proc : colony->processors) {
+        if (!proc.active) continue;
+        proc.cycle_progress += delta_time;
+        while (proc.cycle_progress >= proc.cycle_time) {
+            proc.cycle_progress -= proc.cycle_time;
+
+            // Check input availability
+            int available_input = 0;
+            for (const auto& s : colony->storage) {
+                if (s.resource_type == proc.input_type) {
+                    available_input = s.quantity;
+                    break;
                 }
-                if (available_input < proc.input_quantity) continue;
-
-                // Check output storage capacity
-                if (colony->totalStored() - proc.input_quantity + proc.output_quantity
-                    > static_cast<int>(colony->storage_capacity))
-                    continue;
-
-                // Consume input
-                for (auto& s : colony->storage) {
-                    if (s.resource_type == proc.input_type) {
-                        s.quantity -= proc.input_quantity;
-                        break;
-                    }
+            }
+            if (available_input < proc.input_quantity) continue;
+
+            // Check output storage capacity
+            if (colony->totalStored() - proc.input_quantity + proc.output_quantity
+                > static_cast<int>(colony->storage_capacity))
+                continue;
+
+            // Consume input
+            for (auto& s : colony->storage) {
+                if (s.resource_type == proc.input_type) {
+                    s.quantity -= proc.input_quantity;
+                    break;
                 }
+            }
 
-                // Produce output
-                bool found = false;
-                for (auto& s : colony->storage) {
-                    if (s.resource_type == proc.output_type) {
-                        s.quantity += proc.output_quantity;
-                        found = true;
-                        break;
-                    }
-                }
-                if (!found) {
-                    components::PlanetaryColony::StoredResource sr;
-                    sr.resource_type = proc.output_type;
-                    sr.quantity = proc.output_quantity;
-                    colony->storage.push_back(sr);
+            // Produce output
+            bool found = false;
+            for (auto& s : colony->storage) {
+                if (s.resource_type == proc.output_type) {
+                    s.quantity += proc.output_quantity;
+                    found = true;
+                    break;
                 }
             }
+            if (!found) {
+                components::PlanetaryColony::StoredResource sr;
+                sr.resource_type = proc.output_type;
+                sr.quantity = proc.output_quantity;
+                colony->storage.push_back(sr);
+            }
         }
+        due(proc.cycle_time - proc.cycle_progress);
     }
+    return next_due;
 }
 
 bool PISystem::installExtractor(const std::string& colony_entity_id,
@@ -111,7 +124,7 @@ bool PISystem::installExtractor(const std::string& colony_entity_id,
     if (colony->usedCpu() + ext.cpu_usage > colony->cpu_max) return false;
     if (colony->usedPowergrid() + ext.powergrid_usage > colony->powergrid_max) return false;
 
-    colony->extractors.push_back(ext);
+    colonies_.modify(entity, [&ext](components::PlanetaryColony& c) { c.extractors.push_back(ext); });
     return true;
 }
 
@@ -137,7 +150,7 @@ bool PISystem::installProcessor(const std::string& colony_entity_id,
     if (colony->usedCpu() + proc.cpu_usage > colony->cpu_max) return false;
     if (colony->usedPowergrid() + proc.powergrid_usage > colony->powergrid_max) return false;
 
-    colony->processors.push_back(proc);
+    colonies_.modify(entity, [&proc](components::PlanetaryColony& c) { c.processors.push_back(proc); });
     return true;
 }
 
@@ -6,7 +6,12 @@ namespace atlas {
 namespace systems {
 
 ResearchSystem::ResearchSystem(ecs::World* world)
-    : System(world) {
+    : System(world),
+      labs_(world, getName(),
+            [this](ecs::Entity*, components::ResearchLab& lab, float elapsed) {
+                return advanceJobs(lab, elapsed);
+            }) {
+    writes<components::ResearchLab>();
 }
 
 float ResearchSystem::nextRandom() {
@@ -16,32 +21,35 @@ float ResearchSystem::nextRandom() {
 }
 
 void ResearchSystem::update(float delta_time) {
-    for (auto* entity : world_->getAllEntities()) {
-        auto* lab = entity->getComponent<components::ResearchLab>();
-        if (!lab) continue;
-
-        for (auto& job : lab->jobs) {
-            if (job.status != "active") continue;
-
-            job.time_remaining -= delta_time;
-            if (job.time_remaining <= 0.0f) {
-                job.time_remaining = 0.0f;
-
-                if (job.research_type == "invention") {
-                    // Roll for success
-                    float roll = nextRandom();
-                    if (roll <= job.success_chance) {
-                        job.status = "completed";
-                    } else {
-                        job.status = "failed";
-                    }
-                } else {
-                    // ME/TE research always succeeds
+    labs_.update(delta_time);
+}
+
+float ResearchSystem::advanceJobs(components::ResearchLab& lab, float elapsed) {
+    float next_due = -1.0f;
+    for (auto& job : lab.jobs) {
+        if (job.status != "active") continue;
+
+        job.time_remaining -= elapsed;
+        if (job.time_remaining <= 0.0f) {
+            job.time_remaining = 0.0f;
+
+            if (job.research_type == "invention") {
+                // Roll for success
+                float roll = nextRandom();
+                if (roll <= job.success_chance) {
                     job.status = "completed";
+                } else {
+                    job.status = "failed";
                 }
+            } else {
+                // ME/TE research always succeeds
+                job.status = "completed";
             }
+            continue;
         }
+        if (next_due < 0.0f || job.time_remaining < next_due) next_due = job.time_remaining;
     }
+    return next_due;
 }
 
 std::string ResearchSystem::startMEResearch(const std::string& lab_entity_id,
@@ -79,7 +87,7 @@ std::string ResearchSystem::startMEResearch(const std::string& lab_entity_id,
     job.install_cost = install_cost;
     job.status = "active";
 
-    lab->jobs.push_back(job);
+    labs_.modify(entity, [&job](components::ResearchLab& l) { l.jobs.push_back(job); });
     return job.job_id;
 }
 
@@ -117,7 +125,7 @@ std::string ResearchSystem::startTEResearch(const std::string& lab_entity_id,
     job.install_cost = install_cost;
     job.status = "active";
 
-    lab->jobs.push_back(job);
+    labs_.modify(entity, [&job](components::ResearchLab& l) { l.jobs.push_back(job); });
     return job.job_id;
 }
 
@@ -161,7 +169,7 @@ std::string ResearchSystem::startInvention(const std::string& lab_entity_id,
     job.install_cost = install_cost;
     job.status = "active";
 
-    lab->jobs.push_back(job);
+    labs_.modify(entity, [&job](components::ResearchLab& l) { l.jobs.push_back(job); });
     return job.job_id;
 }
 
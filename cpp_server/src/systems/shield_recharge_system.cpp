@@ -8,21 +8,18 @@ namespace systems {
 
 ShieldRechargeSystem::ShieldRechargeSystem(ecs::World* world)
     : System(world) {
+    writes<components::Health>();
 }
 
 void ShieldRechargeSystem::update(float delta_time) {
-    auto entities = world_->getEntities<components::Health>();
-    
-    for (auto* entity : entities) {
-        auto* health = entity->getComponent<components::Health>();
-        if (!health) continue;
-        
+    // Stream straight through the packed Health pool
+    world_->forEach<components::Health>([delta_time](ecs::Entity*, components::Health& health) {
         // Recharge shields over time
-        if (health->shield_hp < health->shield_max) {
-            float recharge = health->shield_recharge_rate * delta_time;
-            health->shield_hp = std::min(health->shield_hp + recharge, health->shield_max);
+        if (health.shield_hp < health.shield_max) {
+            float recharge = health.shield_recharge_rate * delta_time;
+            health.shield_hp = std::min(health.shield_hp + recharge, health.shield_max);
         }
-    }
+    });
 }
 
 float ShieldRechargeSystem::getShieldPercentage(const std::string& entity_id) const {
@@ -0,0 +1,184 @@
+#include "systems/spatial_index_system.h"
+#include "ecs/world.h"
+#include "components/game_components.h"
+#include <algorithm>
+#include <cmath>
+
+namespace atlas {
+namespace systems {
+
+SpatialIndexSystem::SpatialIndexSystem(ecs::World* world, float cell_size)
+    : System(world)
+    , cell_size_(cell_size > 0.0f ? cell_size : kDefaultCellSize)
+    , inv_cell_size_(1.0f / cell_size_) {
+}
+
+void SpatialIndexSystem::update(float /*delta_time*/) {
+    refresh();
+}
+
+void SpatialIndexSystem::refresh() {
+    ++stamp_;
+    last_cell_changes_ = 0;
+
+    world_->forEach<components::Position>([this](ecs::Entity* entity, components::Position& pos) {
+        ecs::EntityHandle handle = entity->getHandle();
+        if (handle.index >= records_.size()) records_.resize(handle.index + 1);
+        Record& record = records_[handle.index];
+        uint64_t cell = cellKey(cellCoord(pos.x), cellCoord(pos.y), cellCoord(pos.z));
+
+        if (record.indexed && record.handle == handle && record.cell == cell) {
+            // Same cell: just refresh the cached coordinates
+            Entry& entry = cells_[cell][record.position];
+            entry.x = pos.x;
+            entry.y = pos.y;
+            entry.z = pos.z;
+        } else {
+            // New entity, reused slot, or crossed into another cell
+            if (record.indexed) {
+                removeFromCell(record);
+                ++last_cell_changes_;
+            }
+            insert(record, handle, cell, pos.x, pos.y, pos.z);
+        }
+        record.stamp = stamp_;
+    });
+
+    // Drop entities that were destroyed or lost their Position
+    for (auto& record : records_) {
+        if (record.indexed && record.stamp != stamp_) {
+            removeFromCell(record);
+        }
+    }
+}
+
+void SpatialIndexSystem::queryRadius(float x, float y, float z, float radius,
+                                     std::vector<ecs::Entity*>& out) const {
+    if (radius < 0.0f) return;
+    float radius_sq = radius * radius;
+    visitCells(x - radius, y - radius, z - radius, x + radius, y + radius, z + radius,
+               [&](const Entry& entry) {
+        float dx = entry.x - x;
+        float dy = entry.y - y;
+        float dz = entry.z - z;
+        if (dx * dx + dy * dy + dz * dz > radius_sq) return;
+        if (auto* entity = world_->getEntity(entry.handle)) out.push_back(entity);
+    });
+}
+
+void SpatialIndexSystem::queryAABB(float min_x, float min_y, float min_z,
+                                   float max_x, float max_y, float max_z,
+                                   std::vector<ecs::Entity*>& out) const {
+    visitCells(min_x, min_y, min_z, max_x, max_y, max_z, [&](const Entry& entry) {
+        if (entry.x < min_x || entry.x > max_x ||
+            entry.y < min_y || entry.y > max_y ||
+            entry.z < min_z || entry.z > max_z) return;
+        if (auto* entity = world_->getEntity(entry.handle)) out.push_back(entity);
+    });
+}
+
+std::vector<ecs::Entity*> SpatialIndexSystem::queryNearest(float x, float y, float z, size_t k, float max_radius,
+                                                           const std::function<bool(ecs::Entity*)>& filter) const {
+    std::vector<std::pair<float, ecs::Entity*>> found;
+    if (k == 0 || max_radius < 0.0f) return {};
+
+    // Grow the search radius until it holds k matches; anything outside
+    // the radius is farther than everything inside it
+    float radius = std::min(cell_size_, max_radius);
+    for (;;) {
+        found.clear();
+        float radius_sq = radius * radius;
+        visitCells(x - radius, y - radius, z - radius, x + radius, y + radius, z + radius,
+                   [&](const Entry& entry) {
+            float dx = entry.x - x;
+            float dy = entry.y - y;
+            float dz = entry.z - z;
+            float dist_sq = dx * dx + dy * dy + dz * dz;
+            if (dist_sq > radius_sq) return;
+            auto* entity = world_->getEntity(entry.handle);
+            if (!entity || (filter && !filter(entity))) return;
+            found.emplace_back(dist_sq, entity);
+        });
+        if (found.size() >= k || radius >= max_radius) break;
+        radius = std::min(radius * 2.0f, max_radius);
+    }
+
+    size_t count = std::min(k, found.size());
+    std::partial_sort(found.begin(), found.begin() + count, found.end(),
+                      [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    std::vector<ecs::Entity*> result;
+    result.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        result.push_back(found[i].second);
+    }
+    return result;
+}
+
+int64_t SpatialIndexSystem::cellCoord(float v) const {
+    return static_cast<int64_t>(std::floor(v * inv_cell_size_));
+}
+
+uint64_t SpatialIndexSystem::cellKey(int64_t cx, int64_t cy, int64_t cz) {
+    // 21 bits per axis; far-apart cells that alias only add candidates,
+    // which the exact distance checks reject
+    const uint64_t mask = (1ull << 21) - 1;
+    return (static_cast<uint64_t>(cx) & mask)
+         | ((static_cast<uint64_t>(cy) & mask) << 21)
+         | ((static_cast<uint64_t>(cz) & mask) << 42);
+}
+
+void SpatialIndexSystem::insert(Record& record, ecs::EntityHandle handle, uint64_t cell,
+                                float x, float y, float z) {
+    auto& entries = cells_[cell];
+    record.handle = handle;
+    record.cell = cell;
+    record.position = static_cast<uint32_t>(entries.size());
+    record.indexed = true;
+    entries.push_back({handle, x, y, z});
+    ++indexed_count_;
+}
+
+void SpatialIndexSystem::removeFromCell(Record& record) {
+    auto it = cells_.find(record.cell);
+    if (it != cells_.end()) {
+        auto& entries = it->second;
+        const Entry& last = entries.back();
+        entries[record.position] = last;
+        records_[last.handle.index].position = record.position;
+        entries.pop_back();
+        if (entries.empty()) cells_.erase(it);
+    }
+    record.indexed = false;
+    --indexed_count_;
+}
+
+void SpatialIndexSystem::visitCells(float min_x, float min_y, float min_z,
+                                    float max_x, float max_y, float max_z,
+                                    const std::function<void(const Entry&)>& fn) const {
+    int64_t x0 = cellCoord(min_x), x1 = cellCoord(max_x);
+    int64_t y0 = cellCoord(min_y), y1 = cellCoord(max_y);
+    int64_t z0 = cellCoord(min_z), z1 = cellCoord(max_z);
+
+    // Huge boxes: walking the occupied cells is cheaper than probing
+    double span = static_cast<double>(x1 - x0 + 1) * (y1 - y0 + 1) * (z1 - z0 + 1);
+    if (span > static_cast<double>(cells_.size())) {
+        for (const auto& [key, entries] : cells_) {
+            for (const auto& entry : entries) fn(entry);
+        }
+        return;
+    }
+
+    for (int64_t cx = x0; cx <= x1; ++cx) {
+        for (int64_t cy = y0; cy <= y1; ++cy) {
+            for (int64_t cz = z0; cz <= z1; ++cz) {
+                auto it = cells_.find(cellKey(cx, cy, cz));
+                if (it == cells_.end()) continue;
+                for (const auto& entry : it->second) fn(entry);
+            }
+        }
+    }
+}
+
+} // namespace systems
+} // namespace atlas
@@ -10,6 +10,7 @@ static constexpr float DEFAULT_DOCKING_RANGE = 2500.0f;
 
 StationSystem::StationSystem(ecs::World* world)
     : System(world) {
+    declaresNoComponentAccess();
 }
 
 void StationSystem::update(float /*delta_time*/) {
@@ -8,11 +8,13 @@ namespace systems {
 
 TargetingSystem::TargetingSystem(ecs::World* world)
     : System(world) {
+    writes<components::Target>();
+    reads<components::Ship>();
 }
 
 void TargetingSystem::update(float delta_time) {
     // Get all entities with targeting capability
-    auto entities = world_->getEntities<components::Target, components::Ship>();
+    const auto& entities = world_->view<components::Target, components::Ship>();
     
     for (auto* entity : entities) {
         auto* target_comp = entity->getComponent<components::Target>();
@@ -1,5 +1,6 @@
 #include "systems/weapon_system.h"
 #include "systems/combat_system.h"
+#include "systems/ai_system.h"
 #include "ecs/world.h"
 #include "components/game_components.h"
 #include <cmath>
@@ -10,38 +11,43 @@ namespace systems {
 
 WeaponSystem::WeaponSystem(ecs::World* world)
     : System(world) {
+    writes<components::Weapon>();
+    writes<components::Capacitor>();
+    writes<components::Health>();
+    writes<components::AI>();  // resolveTarget refreshes the cached handle
+    reads<components::Position>();
 }
 
 void WeaponSystem::update(float delta_time) {
-    auto entities = world_->getEntities<components::Weapon>();
-    
-    for (auto* entity : entities) {
-        auto* weapon = entity->getComponent<components::Weapon>();
-        if (!weapon) continue;
-        
-        // Update weapon cooldowns
-        if (weapon->cooldown > 0.0f) {
-            weapon->cooldown -= delta_time;
-            if (weapon->cooldown < 0.0f) {
-                weapon->cooldown = 0.0f;
+    // Update weapon cooldowns; independent per weapon, so run in chunks
+    world_->parallelForEach<components::Weapon>([delta_time](ecs::Entity*, components::Weapon& weapon) {
+        if (weapon.cooldown > 0.0f) {
+            weapon.cooldown -= delta_time;
+            if (weapon.cooldown < 0.0f) {
+                weapon.cooldown = 0.0f;
             }
         }
-        
-        // Auto-fire for AI entities in Attacking state
+    });
+    
+    // Auto-fire for AI entities in Attacking state. Firing writes other
+    // entities' Health, so this pass stays on one thread.
+    for (auto* entity : world_->view<components::Weapon, components::AI>()) {
+        auto* weapon = entity->getComponent<components::Weapon>();
         auto* ai = entity->getComponent<components::AI>();
-        if (ai && ai->state == components::AI::State::Attacking 
+        if (ai->state == components::AI::State::Attacking 
             && !ai->target_entity_id.empty()) {
             if (weapon->cooldown <= 0.0f) {
-                fireWeapon(entity->getId(), ai->target_entity_id);
+                fireWeapon(entity, AISystem::resolveTarget(world_, *ai));
             }
         }
     }
 }
 
 bool WeaponSystem::fireWeapon(const std::string& shooter_id, const std::string& target_id) {
-    auto* shooter = world_->getEntity(shooter_id);
-    auto* target = world_->getEntity(target_id);
-    
+    return fireWeapon(world_->getEntity(shooter_id), world_->getEntity(target_id));
+}
+
+bool WeaponSystem::fireWeapon(ecs::Entity* shooter, ecs::Entity* target) {
     if (!shooter || !target) return false;
     
     auto* weapon = shooter->getComponent<components::Weapon>();
@@ -2,28 +2,33 @@
 #include "ecs/world.h"
 #include "ecs/entity.h"
 #include "components/game_components.h"
+#include <algorithm>
 
 namespace atlas {
 namespace systems {
 
 WormholeSystem::WormholeSystem(ecs::World* world)
-    : ecs::System(world) {}
+    : ecs::System(world),
+      wormholes_(world, getName(),
+                 [](ecs::Entity*, components::WormholeConnection& wh, float elapsed) {
+                     return advanceAge(wh, elapsed);
+                 }) {}
 
 void WormholeSystem::update(float delta_time) {
-    float delta_hours = delta_time / 3600.0f;
+    wormholes_.update(delta_time);
+}
 
-    auto entities = world_->getEntities();
-    for (auto* entity : entities) {
-        auto* wh = entity->getComponent<components::WormholeConnection>();
-        if (!wh || wh->collapsed) continue;
+float WormholeSystem::advanceAge(components::WormholeConnection& wh, float elapsed) {
+    if (wh.collapsed) return -1.0f;
 
-        wh->elapsed_hours += delta_hours;
+    wh.elapsed_hours += elapsed / 3600.0f;
 
-        // Collapse if lifetime exceeded or mass depleted
-        if (wh->elapsed_hours >= wh->max_lifetime_hours || wh->remaining_mass <= 0.0) {
-            wh->collapsed = true;
-        }
+    // Collapse if lifetime exceeded or mass depleted
+    if (wh.elapsed_hours >= wh.max_lifetime_hours || wh.remaining_mass <= 0.0) {
+        wh.collapsed = true;
+        return -1.0f;
     }
+    return std::min((wh.max_lifetime_hours - wh.elapsed_hours) * 3600.0f, kAgeRefreshSeconds);
 }
 
 bool WormholeSystem::jumpThroughWormhole(const std::string& wormhole_entity_id, double ship_mass) {
@@ -77,7 +82,10 @@ float WormholeSystem::getRemainingLifetimeFraction(const std::string& wormhole_e
     auto* wh = entity->getComponent<components::WormholeConnection>();
     if (!wh || wh->max_lifetime_hours <= 0.0f) return -1.0f;
 
-    float remaining = wh->max_lifetime_hours - wh->elapsed_hours;
+    // elapsed_hours is only brought up to date when the wormhole is visited
+    float elapsed = wh->elapsed_hours;
+    if (!wh->collapsed) elapsed += wormholes_.pendingSeconds(entity) / 3600.0f;
+    float remaining = wh->max_lifetime_hours - elapsed;
     if (remaining < 0.0f) remaining = 0.0f;
     return remaining / wh->max_lifetime_hours;
 }
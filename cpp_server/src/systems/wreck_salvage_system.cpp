@@ -51,6 +51,13 @@ std::string WreckSalvageSystem::createWreck(const std::string& destroyed_entity_
     pos->z = z;
     entity->addComponent(std::move(pos));
 
+    // Same solar system as the destroyed ship, if it is still around
+    auto* source = world_->getEntity(destroyed_entity_id);
+    auto* source_loc = source ? source->getComponent<components::SystemLocation>() : nullptr;
+    if (source_loc) {
+        entity->addComponent(std::make_unique<components::SystemLocation>(*source_loc));
+    }
+
     // Wreck component
     auto wreck = std::make_unique<components::Wreck>();
     wreck->source_entity_id = destroyed_entity_id;
@@ -69,7 +69,12 @@ namespace {
         }
     }
 
+    // Set once stdin reaches end of file (redirected from /dev/null or a
+    // finished pipe); it then stays readable forever
+    static bool g_stdin_eof = false;
+
     bool stdinHasInput() {
+        if (g_stdin_eof) return false;
         fd_set readfds;
         FD_ZERO(&readfds);
         FD_SET(STDIN_FILENO, &readfds);
@@ -83,9 +88,13 @@ namespace {
 
     char getStdinChar() {
         char c = 0;
-        if (read(STDIN_FILENO, &c, 1) == 1) {
+        ssize_t n = read(STDIN_FILENO, &c, 1);
+        if (n == 1) {
             return c;
         }
+        if (n == 0) {
+            g_stdin_eof = true;
+        }
         return 0;
     }
 #endif
@@ -226,7 +235,7 @@ std::string ServerConsole::handleHelpCommand() {
     oss << "  status          - Show server status\n";
     oss << "  players         - List connected players\n";
     oss << "  kick <player>   - Kick a player (not yet implemented)\n";
-    oss << "  metrics         - Show detailed performance metrics\n";
+    oss << "  metrics         - Show performance metrics and per-scope latency\n";
     oss << "  save            - Save world state\n";
     oss << "  load            - Load world state (not yet implemented)\n";
     oss << "  stop            - Gracefully stop the server";
@@ -276,7 +285,7 @@ std::string ServerConsole::handleStopCommand() {
 
 std::string ServerConsole::handleMetricsCommand() {
     const auto& metrics = server_->getMetrics();
-    return metrics.summary();
+    return metrics.summary() + "\n" + metrics.profileReport();
 }
 
 std::string ServerConsole::handleSaveCommand() {
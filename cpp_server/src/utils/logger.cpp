@@ -1,8 +1,12 @@
 #include "utils/logger.h"
+#include <algorithm>
+#include <condition_variable>
+#include <cstdio>
+#include <ctime>
 #include <iostream>
-#include <iomanip>
-#include <sstream>
 #include <chrono>
+#include <thread>
+#include <vector>
 #include <sys/stat.h>
 #ifdef _WIN32
 #include <direct.h>
@@ -11,6 +15,95 @@
 namespace atlas {
 namespace utils {
 
+namespace {
+
+struct Record {
+    uint64_t seq = 0;
+    LogLevel level = LogLevel::INFO;
+    std::string line;
+};
+
+/**
+ * Single-producer single-consumer ring: the logging thread pushes, the
+ * writer thread drains.
+ */
+struct Ring {
+    explicit Ring(size_t capacity) : slots(capacity), mask(capacity - 1) {}
+
+    bool push(Record&& record) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - head_.load(std::memory_order_acquire) > mask) return false;
+        slots[tail & mask] = std::move(record);
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    size_t size() const {
+        return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+    }
+
+    void drainInto(std::vector<Record>& out) {
+        size_t head = head_.load(std::memory_order_relaxed);
+        size_t tail = tail_.load(std::memory_order_acquire);
+        for (; head != tail; ++head) {
+            out.push_back(std::move(slots[head & mask]));
+        }
+        head_.store(head, std::memory_order_release);
+    }
+
+    std::vector<Record> slots;
+    size_t mask;
+    std::atomic<bool> closed{false};        // owning thread has exited
+
+private:
+    alignas(64) std::atomic<size_t> head_{0};
+    alignas(64) std::atomic<size_t> tail_{0};
+};
+
+size_t roundUpPow2(size_t n) {
+    size_t p = 1;
+    while (p < n) p <<= 1;
+    return p;
+}
+
+} // namespace
+
+struct Logger::AsyncState {
+    std::mutex rings_mutex;
+    std::vector<std::shared_ptr<Ring>> rings;
+    size_t capacity = 8192;
+
+    std::atomic<uint64_t> seq{0};
+    std::atomic<uint64_t> dropped{0};
+    uint64_t dropped_reported = 0;          // writer thread only
+
+    std::thread writer;
+    std::mutex wake_mutex;
+    std::condition_variable wake;
+    std::condition_variable flushed_cv;
+    std::chrono::milliseconds interval{200};
+    bool stop = false;
+    uint64_t flush_requested = 0;
+    uint64_t flushed = 0;
+
+    std::vector<Record> batch;              // writer thread only
+
+    // The calling thread's ring, registered on first use
+    std::shared_ptr<Ring>& localRing() {
+        struct Holder {
+            std::shared_ptr<Ring> ring;
+            ~Holder() { if (ring) ring->closed.store(true, std::memory_order_release); }
+        };
+        thread_local Holder holder;
+        if (!holder.ring) {
+            std::lock_guard<std::mutex> lock(rings_mutex);
+            holder.ring = std::make_shared<Ring>(capacity);
+            rings.push_back(holder.ring);
+        }
+        return holder.ring;
+    }
+};
+
 Logger& Logger::instance() {
     static Logger inst;
     return inst;
@@ -35,16 +128,22 @@ bool Logger::init(const std::string& log_dir, const std::string& filename) {
 #endif
     }
 
-    std::string path = log_dir + "/" + filename;
-    log_file_.open(path, std::ios::out | std::ios::app);
+    if (log_file_.is_open()) {
+        log_file_.close();
+    }
+    log_path_ = log_dir + "/" + filename;
+    log_file_.open(log_path_, std::ios::out | std::ios::app);
     if (!log_file_.is_open()) {
-        std::cerr << "[Logger] Failed to open log file: " << path << std::endl;
+        std::cerr << "[Logger] Failed to open log file: " << log_path_ << std::endl;
         return false;
     }
+    log_file_.seekp(0, std::ios::end);
+    file_bytes_ = static_cast<size_t>(std::max<std::streamoff>(0, log_file_.tellp()));
     return true;
 }
 
 void Logger::shutdown() {
+    stopAsync();
     std::lock_guard<std::mutex> lock(mutex_);
     if (log_file_.is_open()) {
         log_file_.close();
@@ -52,23 +151,19 @@ void Logger::shutdown() {
 }
 
 void Logger::setLevel(LogLevel level) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    min_level_ = level;
+    min_level_.store(level, std::memory_order_relaxed);
 }
 
 LogLevel Logger::getLevel() const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    return min_level_;
+    return min_level_.load(std::memory_order_relaxed);
 }
 
 void Logger::setConsoleOutput(bool enabled) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    console_output_ = enabled;
+    console_output_.store(enabled, std::memory_order_relaxed);
 }
 
 void Logger::setFileOutput(bool enabled) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    file_output_ = enabled;
+    file_output_.store(enabled, std::memory_order_relaxed);
 }
 
 bool Logger::isFileOpen() const {
@@ -76,6 +171,12 @@ bool Logger::isFileOpen() const {
     return log_file_.is_open();
 }
 
+void Logger::setRotation(size_t max_file_bytes, int max_files) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    max_file_bytes_ = max_file_bytes;
+    max_files_ = std::max(1, max_files);
+}
+
 // Convenience methods
 void Logger::debug(const std::string& message) { log(LogLevel::DEBUG, message); }
 void Logger::info(const std::string& message)  { log(LogLevel::INFO, message);  }
@@ -84,27 +185,213 @@ void Logger::error(const std::string& message) { log(LogLevel::ERROR, message);
 void Logger::fatal(const std::string& message) { log(LogLevel::FATAL, message); }
 
 void Logger::log(LogLevel level, const std::string& message) {
-    std::lock_guard<std::mutex> lock(mutex_);
+    if (level < min_level_.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    // Counted so stopAsync() can wait out calls that already chose the
+    // async path
+    async_producers_.fetch_add(1, std::memory_order_acq_rel);
+    if (async_enabled_.load(std::memory_order_acquire)) {
+        Record record;
+        record.seq = async_->seq.fetch_add(1, std::memory_order_relaxed);
+        record.level = level;
+        record.line = formatLine(level, message);
 
-    if (level < min_level_) {
+        auto& ring = async_->localRing();
+        if (!ring->push(std::move(record))) {
+            async_->dropped.fetch_add(1, std::memory_order_relaxed);
+        } else if (ring->size() == ring->slots.size() / 2) {
+            async_->wake.notify_one();      // filling fast; don't wait for the interval
+        }
+        async_producers_.fetch_sub(1, std::memory_order_acq_rel);
+
+        if (level == LogLevel::FATAL) {
+            flush();
+        }
         return;
     }
+    async_producers_.fetch_sub(1, std::memory_order_acq_rel);
 
-    std::string ts = timestamp();
-    std::string lvl = levelToString(level);
-    std::string line = ts + " [" + lvl + "] " + message;
+    std::string line = formatLine(level, message);
+    std::lock_guard<std::mutex> lock(mutex_);
 
-    if (console_output_) {
+    if (console_output_.load(std::memory_order_relaxed)) {
         auto& out = (level >= LogLevel::ERROR) ? std::cerr : std::cout;
         out << line << std::endl;
     }
 
-    if (file_output_ && log_file_.is_open()) {
-        log_file_ << line << std::endl;
+    if (file_output_.load(std::memory_order_relaxed) && log_file_.is_open()) {
+        line += '\n';
+        writeFile(line);
+        log_file_.flush();
+    }
+}
+
+void Logger::startAsync(size_t queue_capacity, int flush_interval_ms) {
+    if (async_enabled_.load(std::memory_order_acquire)) return;
+    if (!async_) {
+        async_ = std::make_unique<AsyncState>();
+    }
+    {
+        std::lock_guard<std::mutex> lock(async_->rings_mutex);
+        async_->capacity = roundUpPow2(std::max<size_t>(queue_capacity, 16));
+    }
+    {
+        std::lock_guard<std::mutex> lock(async_->wake_mutex);
+        async_->interval = std::chrono::milliseconds(std::max(1, flush_interval_ms));
+        async_->stop = false;
+    }
+    async_->writer = std::thread([this] { writerLoop(); });
+    async_enabled_.store(true, std::memory_order_release);
+}
+
+void Logger::stopAsync() {
+    if (!async_ || !async_enabled_.exchange(false, std::memory_order_acq_rel)) return;
+
+    // Let calls already past the async check finish their push
+    while (async_producers_.load(std::memory_order_acquire) != 0) {
+        std::this_thread::yield();
+    }
+    {
+        std::lock_guard<std::mutex> lock(async_->wake_mutex);
+        async_->stop = true;
+    }
+    async_->wake.notify_one();
+    if (async_->writer.joinable()) {
+        async_->writer.join();
+    }
+}
+
+bool Logger::isAsync() const {
+    return async_enabled_.load(std::memory_order_acquire);
+}
+
+void Logger::flush() {
+    if (!async_enabled_.load(std::memory_order_acquire)) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (log_file_.is_open()) log_file_.flush();
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(async_->wake_mutex);
+    uint64_t ticket = ++async_->flush_requested;
+    async_->wake.notify_one();
+    // Bounded so a stalled disk cannot hang the caller forever
+    async_->flushed_cv.wait_for(lock, std::chrono::seconds(2), [&] {
+        return async_->flushed >= ticket || async_->stop;
+    });
+}
+
+uint64_t Logger::getDroppedCount() const {
+    return async_ ? async_->dropped.load(std::memory_order_relaxed) : 0;
+}
+
+void Logger::writerLoop() {
+    while (true) {
+        uint64_t ticket;
+        bool stopping;
+        {
+            std::unique_lock<std::mutex> lock(async_->wake_mutex);
+            async_->wake.wait_for(lock, async_->interval, [&] {
+                return async_->stop || async_->flush_requested != async_->flushed;
+            });
+            ticket = async_->flush_requested;
+            stopping = async_->stop;
+        }
+
+        drainQueues();
+
+        {
+            std::lock_guard<std::mutex> lock(async_->wake_mutex);
+            async_->flushed = std::max(async_->flushed, ticket);
+        }
+        async_->flushed_cv.notify_all();
+        if (stopping) break;
+    }
+}
+
+void Logger::drainQueues() {
+    auto& batch = async_->batch;
+    batch.clear();
+    {
+        std::lock_guard<std::mutex> lock(async_->rings_mutex);
+        for (auto it = async_->rings.begin(); it != async_->rings.end();) {
+            Ring& ring = **it;
+            bool closed = ring.closed.load(std::memory_order_acquire);
+            ring.drainInto(batch);
+            // A ring whose thread exited is dropped once empty
+            it = closed ? async_->rings.erase(it) : it + 1;
+        }
+    }
+
+    uint64_t dropped = async_->dropped.load(std::memory_order_relaxed);
+    if (dropped != async_->dropped_reported) {
+        Record record;
+        record.seq = ~uint64_t(0);
+        record.level = LogLevel::WARN;
+        record.line = formatLine(LogLevel::WARN, "[Logger] Dropped " +
+            std::to_string(dropped - async_->dropped_reported) + " messages (queue full)");
+        batch.push_back(std::move(record));
+        async_->dropped_reported = dropped;
+    }
+    if (batch.empty()) return;
+
+    // Rings are per thread; restore the global order
+    std::sort(batch.begin(), batch.end(),
+              [](const Record& a, const Record& b) { return a.seq < b.seq; });
+
+    std::string out, err, file;
+    bool console = console_output_.load(std::memory_order_relaxed);
+    for (const auto& record : batch) {
+        if (console) {
+            std::string& target = record.level >= LogLevel::ERROR ? err : out;
+            target += record.line;
+            target += '\n';
+        }
+        file += record.line;
+        file += '\n';
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!out.empty()) std::cout << out << std::flush;
+    if (!err.empty()) std::cerr << err << std::flush;
+    if (file_output_.load(std::memory_order_relaxed) && log_file_.is_open()) {
+        writeFile(file);
         log_file_.flush();
     }
 }
 
+void Logger::writeFile(const std::string& data) {
+    if (max_file_bytes_ > 0 && file_bytes_ > 0 && file_bytes_ + data.size() > max_file_bytes_) {
+        rotate();
+    }
+    log_file_.write(data.data(), static_cast<std::streamsize>(data.size()));
+    file_bytes_ += data.size();
+}
+
+void Logger::rotate() {
+    log_file_.close();
+    // server.log.N-1 -> server.log.N, ..., server.log -> server.log.1
+    std::remove((log_path_ + "." + std::to_string(max_files_)).c_str());
+    for (int i = max_files_ - 1; i >= 1; --i) {
+        std::rename((log_path_ + "." + std::to_string(i)).c_str(),
+                    (log_path_ + "." + std::to_string(i + 1)).c_str());
+    }
+    std::rename(log_path_.c_str(), (log_path_ + ".1").c_str());
+    log_file_.open(log_path_, std::ios::out | std::ios::trunc);
+    file_bytes_ = 0;
+}
+
+std::string Logger::formatLine(LogLevel level, const std::string& message) const {
+    std::string line = timestamp();
+    line += " [";
+    line += levelToString(level);
+    line += "] ";
+    line += message;
+    return line;
+}
+
 std::string Logger::levelToString(LogLevel level) {
     switch (level) {
         case LogLevel::DEBUG: return "DEBUG";
@@ -122,17 +409,27 @@ std::string Logger::timestamp() {
     auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
         now.time_since_epoch()) % 1000;
 
-    std::tm tm_buf;
+    // The date and time only change once a second; format them then
+    thread_local std::time_t cached_second = -1;
+    thread_local char cached[24];
+    if (time_t_now != cached_second) {
+        std::tm tm_buf;
 #ifdef _WIN32
-    localtime_s(&tm_buf, &time_t_now);
+        localtime_s(&tm_buf, &time_t_now);
 #else
-    localtime_r(&time_t_now, &tm_buf);
+        localtime_r(&time_t_now, &tm_buf);
 #endif
+        std::strftime(cached, sizeof(cached), "%Y-%m-%d %H:%M:%S", &tm_buf);
+        cached_second = time_t_now;
+    }
 
-    std::ostringstream oss;
-    oss << std::put_time(&tm_buf, "%Y-%m-%d %H:%M:%S");
-    oss << '.' << std::setfill('0') << std::setw(3) << ms.count();
-    return oss.str();
+    int millis = static_cast<int>(ms.count());
+    std::string out(cached);
+    out += '.';
+    out += static_cast<char>('0' + millis / 100);
+    out += static_cast<char>('0' + (millis / 10) % 10);
+    out += static_cast<char>('0' + millis % 10);
+    return out;
 }
 
 } // namespace utils
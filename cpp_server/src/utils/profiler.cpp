@@ -0,0 +1,261 @@
+#include "utils/profiler.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <unordered_map>
+
+namespace atlas {
+namespace utils {
+
+// ---------------------------------------------------------------------------
+// LatencyHistogram
+// ---------------------------------------------------------------------------
+
+LatencyHistogram::LatencyHistogram()
+    : counts_(kBucketCount, 0) {}
+
+size_t LatencyHistogram::bucketIndex(uint64_t ns) {
+    const uint64_t limit = (uint64_t(1) << kMaxBits) - 1;
+    if (ns > limit) ns = limit;
+    if (ns < static_cast<uint64_t>(kSubBuckets)) return static_cast<size_t>(ns);
+
+    int msb = 63;
+    while (!(ns >> msb)) --msb;
+    int shift = msb - kSubBucketBits;
+    uint64_t sub = (ns >> shift) - kSubBuckets;
+    return static_cast<size_t>((shift + 1) * kSubBuckets + sub);
+}
+
+uint64_t LatencyHistogram::bucketLow(size_t index) {
+    if (index < static_cast<size_t>(kSubBuckets)) return index;
+    int shift = static_cast<int>(index / kSubBuckets) - 1;
+    uint64_t sub = index % kSubBuckets;
+    return (kSubBuckets + sub) << shift;
+}
+
+uint64_t LatencyHistogram::bucketHigh(size_t index) {
+    if (index < static_cast<size_t>(kSubBuckets)) return index;
+    int shift = static_cast<int>(index / kSubBuckets) - 1;
+    return bucketLow(index) + (uint64_t(1) << shift) - 1;
+}
+
+void LatencyHistogram::record(uint64_t ns) {
+    ++counts_[bucketIndex(ns)];
+    ++count_;
+    sum_ += ns;
+    max_ = std::max(max_, ns);
+}
+
+void LatencyHistogram::add(const LatencyHistogram& other) {
+    for (size_t i = 0; i < kBucketCount; ++i) counts_[i] += other.counts_[i];
+    count_ += other.count_;
+    sum_ += other.sum_;
+    max_ = std::max(max_, other.max_);
+}
+
+void LatencyHistogram::subtract(const LatencyHistogram& earlier) {
+    size_t highest = 0;
+    for (size_t i = 0; i < kBucketCount; ++i) {
+        counts_[i] -= std::min(counts_[i], earlier.counts_[i]);
+        if (counts_[i]) highest = i;
+    }
+    count_ -= std::min(count_, earlier.count_);
+    sum_ -= std::min(sum_, earlier.sum_);
+    // The exact maximum of the remainder is unknown; bound it by its
+    // highest bucket
+    max_ = count_ ? std::min(max_, bucketHigh(highest)) : 0;
+}
+
+uint64_t LatencyHistogram::percentile(double q) const {
+    if (count_ == 0) return 0;
+    q = std::min(1.0, std::max(0.0, q));
+    uint64_t rank = static_cast<uint64_t>(std::ceil(q * static_cast<double>(count_)));
+    if (rank == 0) rank = 1;
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < kBucketCount; ++i) {
+        seen += counts_[i];
+        if (seen >= rank) {
+            uint64_t mid = bucketLow(i) + (bucketHigh(i) - bucketLow(i)) / 2;
+            return std::min(mid, max_);
+        }
+    }
+    return max_;
+}
+
+// ---------------------------------------------------------------------------
+// Profiler
+// ---------------------------------------------------------------------------
+
+namespace {
+
+thread_local int tl_current_scope = Profiler::kNoScope;
+
+struct ScopeKey {
+    int parent;
+    const char* name;
+    bool operator==(const ScopeKey& o) const { return parent == o.parent && name == o.name; }
+};
+
+struct ScopeKeyHash {
+    size_t operator()(const ScopeKey& k) const {
+        return std::hash<const void*>()(k.name) ^ (static_cast<size_t>(k.parent + 1) * 0x9E3779B97F4A7C15ull);
+    }
+};
+
+} // namespace
+
+Profiler& Profiler::instance() {
+    static Profiler inst;
+    return inst;
+}
+
+int Profiler::scope(int parent, const std::string& name) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (size_t i = 0; i < nodes_.size(); ++i) {
+        if (nodes_[i].parent == parent && nodes_[i].name == name) {
+            return static_cast<int>(i);
+        }
+    }
+    if (nodes_.size() >= static_cast<size_t>(kMaxScopes)) return kNoScope;
+    if (parent < kNoScope || parent >= static_cast<int>(nodes_.size())) parent = kNoScope;
+
+    Node node;
+    node.parent = parent;
+    node.name = name;
+    if (parent == kNoScope) {
+        node.path = name;
+    } else {
+        node.path = nodes_[parent].path + "/" + name;
+        node.depth = nodes_[parent].depth + 1;
+    }
+    nodes_.push_back(std::move(node));
+    scope_count_.store(nodes_.size(), std::memory_order_release);
+    return static_cast<int>(nodes_.size() - 1);
+}
+
+Profiler::Shard& Profiler::localShard() {
+    // A thread's shard goes back to the pool when it exits; its samples
+    // stay counted and the next new thread keeps writing into it
+    struct Lease {
+        Shard* shard = nullptr;
+        ~Lease() {
+            if (!shard) return;
+            Profiler& profiler = Profiler::instance();
+            std::lock_guard<std::mutex> lock(profiler.mutex_);
+            profiler.free_shards_.push_back(shard);
+        }
+    };
+    thread_local Lease lease;
+    if (!lease.shard) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!free_shards_.empty()) {
+            lease.shard = free_shards_.back();
+            free_shards_.pop_back();
+        } else {
+            shards_.push_back(std::make_unique<Shard>());
+            lease.shard = shards_.back().get();
+        }
+    }
+    return *lease.shard;
+}
+
+void Profiler::record(int scope, uint64_t ns) {
+    if (scope < 0 || scope >= kMaxScopes) return;
+    Shard& shard = localShard();
+    AtomicHistogram* h = shard.scopes[scope].load(std::memory_order_relaxed);
+    if (!h) {
+        shard.owned.push_back(std::make_unique<AtomicHistogram>());
+        h = shard.owned.back().get();
+        shard.scopes[scope].store(h, std::memory_order_release);
+    }
+
+    auto bump = [](std::atomic<uint64_t>& v, uint64_t by) {
+        v.store(v.load(std::memory_order_relaxed) + by, std::memory_order_relaxed);
+    };
+    bump(h->counts[LatencyHistogram::bucketIndex(ns)], 1);
+    bump(h->count, 1);
+    bump(h->sum, ns);
+    if (ns > h->max.load(std::memory_order_relaxed)) {
+        h->max.store(ns, std::memory_order_relaxed);
+    }
+}
+
+int Profiler::current() {
+    return tl_current_scope;
+}
+
+void Profiler::setCurrent(int scope) {
+    tl_current_scope = scope;
+}
+
+std::vector<Profiler::ScopeStats> Profiler::collect() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    std::vector<ScopeStats> merged(nodes_.size());
+    for (size_t i = 0; i < nodes_.size(); ++i) {
+        merged[i].id = static_cast<int>(i);
+        merged[i].path = nodes_[i].path;
+        merged[i].depth = nodes_[i].depth;
+        LatencyHistogram& out = merged[i].histogram;
+        for (const auto& shard : shards_) {
+            const AtomicHistogram* h = shard->scopes[i].load(std::memory_order_acquire);
+            if (!h) continue;
+            for (size_t b = 0; b < LatencyHistogram::kBucketCount; ++b) {
+                out.counts_[b] += h->counts[b].load(std::memory_order_relaxed);
+            }
+            out.count_ += h->count.load(std::memory_order_relaxed);
+            out.sum_ += h->sum.load(std::memory_order_relaxed);
+            out.max_ = std::max(out.max_, h->max.load(std::memory_order_relaxed));
+        }
+    }
+
+    // Depth-first, children in registration order
+    std::vector<std::vector<size_t>> children(nodes_.size());
+    std::vector<size_t> roots;
+    for (size_t i = 0; i < nodes_.size(); ++i) {
+        if (nodes_[i].parent == kNoScope) roots.push_back(i);
+        else children[nodes_[i].parent].push_back(i);
+    }
+    std::vector<ScopeStats> ordered;
+    ordered.reserve(merged.size());
+    std::function<void(size_t)> visit = [&](size_t i) {
+        ordered.push_back(std::move(merged[i]));
+        for (size_t child : children[i]) visit(child);
+    };
+    for (size_t root : roots) visit(root);
+    return ordered;
+}
+
+// ---------------------------------------------------------------------------
+// ProfileScope
+// ---------------------------------------------------------------------------
+
+ProfileScope::ProfileScope(const char* name)
+    : parent_(Profiler::current()) {
+    thread_local std::unordered_map<ScopeKey, int, ScopeKeyHash> ids;
+    ScopeKey key{parent_, name};
+    auto it = ids.find(key);
+    if (it == ids.end()) {
+        it = ids.emplace(key, Profiler::instance().scope(parent_, name)).first;
+    }
+    scope_ = it->second;
+    Profiler::setCurrent(scope_);
+    start_ = std::chrono::steady_clock::now();
+}
+
+ProfileScope::ProfileScope(int scope)
+    : scope_(scope), parent_(Profiler::current()) {
+    Profiler::setCurrent(scope_);
+    start_ = std::chrono::steady_clock::now();
+}
+
+ProfileScope::~ProfileScope() {
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start_).count();
+    Profiler::instance().record(scope_, static_cast<uint64_t>(ns));
+    Profiler::setCurrent(parent_);
+}
+
+} // namespace utils
+} // namespace atlas
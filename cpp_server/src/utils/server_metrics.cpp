@@ -3,6 +3,8 @@
 #include <sstream>
 #include <iomanip>
 #include <algorithm>
+#include <cstdio>
+#include <fstream>
 
 namespace atlas {
 namespace utils {
@@ -52,6 +54,33 @@ uint64_t ServerMetrics::getTotalTicks() const {
     return tick_count_total_;
 }
 
+void ServerMetrics::setScheduleStats(const TickScheduler::Stats& stats) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    schedule_ = stats;
+    has_schedule_ = true;
+}
+
+TickScheduler::Stats ServerMetrics::getScheduleStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return schedule_;
+}
+
+void ServerMetrics::recordSave(double tick_ms, double background_ms,
+                               uint64_t bytes, bool ok) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++save_.saves;
+    if (!ok) ++save_.failures;
+    save_.last_tick_ms = tick_ms;
+    save_.max_tick_ms = std::max(save_.max_tick_ms, tick_ms);
+    save_.last_background_ms = background_ms;
+    save_.last_bytes = bytes;
+}
+
+ServerMetrics::SaveStats ServerMetrics::getSaveStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return save_;
+}
+
 void ServerMetrics::setEntityCount(int count) {
     std::lock_guard<std::mutex> lock(mutex_);
     entity_count_ = count;
@@ -120,6 +149,18 @@ std::string ServerMetrics::summary() const {
     }
 
     oss << " | ticks=" << tick_count_total_;
+
+    if (has_schedule_) {
+        oss << " | overruns=" << schedule_.overruns
+            << " late=" << schedule_.late_ticks
+            << " skipped=" << schedule_.skipped_ticks
+            << " tidi=" << schedule_.dilation;
+    }
+    if (save_.saves > 0) {
+        oss << " | saves=" << save_.saves
+            << " save_tick=" << save_.last_tick_ms << "ms"
+            << " save_bg=" << save_.last_background_ms << "ms";
+    }
     return oss.str();
 }
 
@@ -135,11 +176,144 @@ void ServerMetrics::logSummaryIfDue(double interval_seconds) {
 }
 
 void ServerMetrics::resetWindow() {
+    auto profile = Profiler::instance().collect();
+
     std::lock_guard<std::mutex> lock(mutex_);
     tick_sum_ms_ = 0.0;
     tick_max_ms_ = 0.0;
     tick_min_ms_ = 0.0;
     tick_count_window_ = 0;
+
+    profile_baseline_.assign(Profiler::kMaxScopes, LatencyHistogram());
+    for (auto& scope : profile) {
+        profile_baseline_[scope.id] = std::move(scope.histogram);
+    }
+}
+
+std::vector<Profiler::ScopeStats> ServerMetrics::getProfile() const {
+    auto profile = Profiler::instance().collect();
+    subtractBaseline(profile);
+    return profile;
+}
+
+void ServerMetrics::subtractBaseline(std::vector<Profiler::ScopeStats>& profile) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (profile_baseline_.empty()) return;
+    for (auto& scope : profile) {
+        scope.histogram.subtract(profile_baseline_[scope.id]);
+    }
+}
+
+namespace {
+
+double nsToMs(uint64_t ns) {
+    return static_cast<double>(ns) / 1e6;
+}
+
+} // namespace
+
+std::string ServerMetrics::profileReport() const {
+    auto profile = getProfile();
+
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(3);
+    oss << std::left << std::setw(36) << "scope (ms)" << std::right
+        << std::setw(10) << "count"
+        << std::setw(10) << "p50"
+        << std::setw(10) << "p99"
+        << std::setw(10) << "p999"
+        << std::setw(10) << "max";
+    for (const auto& scope : profile) {
+        const auto& h = scope.histogram;
+        std::string name = scope.path.substr(scope.path.rfind('/') + 1);
+        oss << "\n" << std::left << std::setw(36)
+            << (std::string(static_cast<size_t>(scope.depth) * 2, ' ') + name)
+            << std::right
+            << std::setw(10) << h.count()
+            << std::setw(10) << nsToMs(h.percentile(0.50))
+            << std::setw(10) << nsToMs(h.percentile(0.99))
+            << std::setw(10) << nsToMs(h.percentile(0.999))
+            << std::setw(10) << nsToMs(h.max());
+    }
+    return oss.str();
+}
+
+std::string ServerMetrics::scrapeText() const {
+    // One collect() for both, so window[i] and total[i] are the same scope
+    // even if another thread registers a scope meanwhile
+    auto total = Profiler::instance().collect();
+    auto window = total;
+    subtractBaseline(window);
+
+    std::ostringstream oss;
+    oss << std::setprecision(9);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        oss << "# TYPE atlas_uptime_seconds gauge\n"
+            << "atlas_uptime_seconds "
+            << std::chrono::duration<double>(std::chrono::steady_clock::now() - server_start_).count() << "\n"
+            << "# TYPE atlas_ticks_total counter\n"
+            << "atlas_ticks_total " << tick_count_total_ << "\n"
+            << "# TYPE atlas_entities gauge\n"
+            << "atlas_entities " << entity_count_ << "\n"
+            << "# TYPE atlas_players gauge\n"
+            << "atlas_players " << player_count_ << "\n";
+        if (has_schedule_) {
+            oss << "# TYPE atlas_tick_overruns_total counter\n"
+                << "atlas_tick_overruns_total " << schedule_.overruns << "\n"
+                << "# TYPE atlas_tick_late_total counter\n"
+                << "atlas_tick_late_total " << schedule_.late_ticks << "\n"
+                << "# TYPE atlas_tick_skipped_total counter\n"
+                << "atlas_tick_skipped_total " << schedule_.skipped_ticks << "\n"
+                << "# TYPE atlas_tick_dilation gauge\n"
+                << "atlas_tick_dilation " << schedule_.dilation << "\n";
+        }
+        if (save_.saves > 0) {
+            oss << "# TYPE atlas_saves_total counter\n"
+                << "atlas_saves_total " << save_.saves << "\n"
+                << "# TYPE atlas_save_failures_total counter\n"
+                << "atlas_save_failures_total " << save_.failures << "\n"
+                << "# TYPE atlas_save_tick_seconds gauge\n"
+                << "atlas_save_tick_seconds " << save_.last_tick_ms / 1e3 << "\n"
+                << "# TYPE atlas_save_tick_max_seconds gauge\n"
+                << "atlas_save_tick_max_seconds " << save_.max_tick_ms / 1e3 << "\n"
+                << "# TYPE atlas_save_background_seconds gauge\n"
+                << "atlas_save_background_seconds " << save_.last_background_ms / 1e3 << "\n"
+                << "# TYPE atlas_save_bytes gauge\n"
+                << "atlas_save_bytes " << save_.last_bytes << "\n";
+        }
+    }
+
+    oss << "# TYPE atlas_scope_seconds summary\n";
+    for (size_t i = 0; i < window.size(); ++i) {
+        const auto& w = window[i].histogram;
+        const std::string label = "scope=\"" + window[i].path + "\"";
+        for (double q : {0.5, 0.99, 0.999}) {
+            oss << "atlas_scope_seconds{" << label << ",quantile=\"" << q << "\"} "
+                << static_cast<double>(w.percentile(q)) / 1e9 << "\n";
+        }
+        oss << "atlas_scope_seconds_sum{" << label << "} "
+            << static_cast<double>(total[i].histogram.sum()) / 1e9 << "\n"
+            << "atlas_scope_seconds_count{" << label << "} " << total[i].histogram.count() << "\n";
+    }
+    oss << "# TYPE atlas_scope_max_seconds gauge\n";
+    for (const auto& scope : window) {
+        oss << "atlas_scope_max_seconds{scope=\"" << scope.path << "\"} "
+            << static_cast<double>(scope.histogram.max()) / 1e9 << "\n";
+    }
+    return oss.str();
+}
+
+bool ServerMetrics::writeScrapeFile(const std::string& path) const {
+    const std::string tmp = path + ".tmp";
+    {
+        std::ofstream file(tmp, std::ios::trunc);
+        if (!file.is_open()) return false;
+        file << scrapeText();
+        if (!file.good()) return false;
+    }
+    // Scrapers never see a half-written file
+    return std::rename(tmp.c_str(), path.c_str()) == 0;
 }
 
 } // namespace utils
@@ -0,0 +1,138 @@
+#include "utils/thread_pool.h"
+
+namespace atlas {
+namespace utils {
+
+namespace {
+// Identifies the pool/worker the current thread belongs to, if any
+thread_local ThreadPool* tls_pool = nullptr;
+thread_local size_t tls_worker_index = 0;
+}
+
+ThreadPool::ThreadPool(size_t worker_count) {
+    if (worker_count == 0) worker_count = 1;
+    queues_.reserve(worker_count);
+    for (size_t i = 0; i < worker_count; ++i) {
+        queues_.push_back(std::make_unique<WorkerQueue>());
+    }
+    workers_.reserve(worker_count);
+    for (size_t i = 0; i < worker_count; ++i) {
+        workers_.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        stopping_ = true;
+    }
+    wake_cv_.notify_all();
+    for (auto& worker : workers_) {
+        if (worker.joinable()) worker.join();
+    }
+}
+
+void ThreadPool::submit(Task task) {
+    size_t index = (tls_pool == this)
+        ? tls_worker_index
+        : next_queue_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+    {
+        std::lock_guard<std::mutex> lock(queues_[index]->mutex);
+        queues_[index]->tasks.push_back(std::move(task));
+    }
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        pending_.fetch_add(1, std::memory_order_release);
+    }
+    wake_cv_.notify_one();
+}
+
+bool ThreadPool::runPendingTask() {
+    Task task;
+    size_t self = (tls_pool == this) ? tls_worker_index : queues_.size();
+    bool found = (self < queues_.size() && popLocal(self, task)) || steal(self, task);
+    if (!found) return false;
+    pending_.fetch_sub(1, std::memory_order_acq_rel);
+    task();
+    return true;
+}
+
+bool ThreadPool::popLocal(size_t index, Task& out) {
+    auto& queue = *queues_[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) return false;
+    out = std::move(queue.tasks.back());
+    queue.tasks.pop_back();
+    return true;
+}
+
+bool ThreadPool::steal(size_t thief, Task& out) {
+    size_t count = queues_.size();
+    size_t start = (thief < count) ? thief + 1 : 0;
+    for (size_t i = 0; i < count; ++i) {
+        size_t victim = (start + i) % count;
+        if (victim == thief) continue;
+        auto& queue = *queues_[victim];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty()) continue;
+        out = std::move(queue.tasks.front());
+        queue.tasks.pop_front();
+        return true;
+    }
+    return false;
+}
+
+void ThreadPool::workerLoop(size_t index) {
+    tls_pool = this;
+    tls_worker_index = index;
+
+    while (true) {
+        if (runPendingTask()) continue;
+
+        std::unique_lock<std::mutex> lock(wake_mutex_);
+        wake_cv_.wait(lock, [this] {
+            return stopping_.load() || pending_.load(std::memory_order_acquire) > 0;
+        });
+        if (stopping_ && pending_.load() == 0) return;
+    }
+}
+
+void TaskGroup::run(ThreadPool::Task task) {
+    auto guarded = [this, task = std::move(task)]() {
+        try {
+            task();
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(error_mutex_);
+            if (!error_) error_ = std::current_exception();
+        }
+        outstanding_.fetch_sub(1, std::memory_order_acq_rel);
+    };
+
+    outstanding_.fetch_add(1, std::memory_order_acq_rel);
+    if (pool_) {
+        pool_->submit(std::move(guarded));
+    } else {
+        guarded();
+    }
+}
+
+void TaskGroup::drain() {
+    while (outstanding_.load(std::memory_order_acquire) > 0) {
+        if (!pool_ || !pool_->runPendingTask()) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void TaskGroup::wait() {
+    drain();
+    std::exception_ptr error;
+    {
+        std::lock_guard<std::mutex> lock(error_mutex_);
+        std::swap(error, error_);
+    }
+    if (error) std::rethrow_exception(error);
+}
+
+} // namespace utils
+} // namespace atlas
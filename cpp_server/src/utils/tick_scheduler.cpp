@@ -0,0 +1,146 @@
+#include "utils/tick_scheduler.h"
+#include <algorithm>
+#include <thread>
+
+namespace atlas {
+namespace utils {
+
+namespace {
+
+double toMs(TickScheduler::Clock::duration d) {
+    return std::chrono::duration<double, std::milli>(d).count();
+}
+
+} // namespace
+
+TickScheduler::TickScheduler()
+    : TickScheduler(Settings()) {}
+
+TickScheduler::TickScheduler(const Settings& settings)
+    : settings_(settings) {
+    if (settings_.tick_rate <= 0.0) settings_.tick_rate = 30.0;
+    if (settings_.max_catch_up_ticks < 0) settings_.max_catch_up_ticks = 0;
+    // Exact period in clock ticks; truncating to whole milliseconds
+    // would run a 30 Hz server at 30.3 Hz
+    period_ = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(1.0 / settings_.tick_rate));
+    step_seconds_ = static_cast<float>(1.0 / settings_.tick_rate);
+}
+
+void TickScheduler::start(Clock::time_point now) {
+    deadline_ = now;
+    tick_begin_ = now;
+    last_begin_ = now;
+    catching_up_ = false;
+    started_ = true;
+    stats_ = Stats();
+}
+
+TickScheduler::Tick TickScheduler::waitNext() {
+    if (!started_) start();
+
+    Clock::time_point target = deadline_;
+    Clock::time_point now = Clock::now();
+    if (now < target) {
+        // Sleep most of the way; the OS may oversleep by a scheduler
+        // quantum, so the last stretch is spun
+        if (target - now > settings_.spin) {
+            std::this_thread::sleep_until(target - settings_.spin);
+        }
+        while ((now = Clock::now()) < target) {
+            std::this_thread::yield();
+        }
+    }
+    return beginTick(now);
+}
+
+TickScheduler::Tick TickScheduler::beginTick(Clock::time_point now) {
+    if (!started_) start(now);
+
+    Tick tick;
+    Clock::duration late = now > deadline_ ? now - deadline_ : Clock::duration::zero();
+    int64_t behind = late / period_;    // further deadlines already missed
+
+    if (behind > 0) {
+        ++stats_.late_ticks;
+        switch (settings_.policy) {
+            case CatchUpPolicy::Skip:
+                stats_.skipped_ticks += static_cast<uint64_t>(behind);
+                deadline_ += period_ * behind;
+                break;
+            case CatchUpPolicy::CatchUp:
+                if (behind > settings_.max_catch_up_ticks) {
+                    int64_t dropped = behind - settings_.max_catch_up_ticks;
+                    stats_.skipped_ticks += static_cast<uint64_t>(dropped);
+                    deadline_ += period_ * dropped;
+                }
+                break;
+            case CatchUpPolicy::Dilate:
+                deadline_ = now;
+                break;
+        }
+    }
+
+    // The tick following a late one is catching up if it is already due
+    tick.catching_up = catching_up_;
+    if (catching_up_) ++stats_.catch_up_ticks;
+
+    tick.number = stats_.ticks++;
+    tick.delta = step_seconds_;
+    tick.lateness_ms = toMs(late);
+    stats_.max_lateness_ms = std::max(stats_.max_lateness_ms, tick.lateness_ms);
+
+    // Smoothed simulated/real time ratio, from the interval between starts
+    if (tick.number > 0) {
+        double interval = toMs(now - last_begin_);
+        double ratio = interval > 0.0 ? getPeriodMs() / interval : 1.0;
+        stats_.dilation += 0.05 * (std::min(ratio, 2.0) - stats_.dilation);
+    }
+
+    last_begin_ = now;
+    tick_begin_ = now;
+    deadline_ += period_;
+    catching_up_ = deadline_ <= now;
+    return tick;
+}
+
+void TickScheduler::endTick(Clock::time_point now) {
+    Clock::duration work = now - tick_begin_;
+    stats_.last_work_ms = toMs(work);
+    if (work > period_) {
+        ++stats_.overruns;
+    }
+}
+
+double TickScheduler::remainingBudgetMs(Clock::time_point now) const {
+    return toMs(deadline_ - now) - toMs(settings_.spin);
+}
+
+bool TickScheduler::hasBudget(double estimated_ms, Clock::time_point now) const {
+    if (catching_up_ || deadline_ <= now) return false;
+    return remainingBudgetMs(now) >= estimated_ms;
+}
+
+double TickScheduler::getPeriodMs() const {
+    return toMs(period_);
+}
+
+const char* TickScheduler::policyName(CatchUpPolicy policy) {
+    switch (policy) {
+        case CatchUpPolicy::Skip:    return "skip";
+        case CatchUpPolicy::CatchUp: return "catch_up";
+        case CatchUpPolicy::Dilate:  return "dilate";
+    }
+    return "catch_up";
+}
+
+bool TickScheduler::parsePolicy(const std::string& name, CatchUpPolicy& out) {
+    if (name == "skip") out = CatchUpPolicy::Skip;
+    else if (name == "catch_up") out = CatchUpPolicy::CatchUp;
+    else if (name == "dilate") out = CatchUpPolicy::Dilate;
+    else return false;
+    return true;
+}
+
+} // namespace utils
+} // namespace atlas
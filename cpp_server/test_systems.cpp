@@ -36,6 +36,11 @@
 #include "systems/tournament_system.h"
 #include "systems/leaderboard_system.h"
 #include "data/world_persistence.h"
+#include "data/async_world_saver.h"
+#include "data/world_journal.h"
+#include "data/world_binary_format.h"
+#include "data/order_book.h"
+#include "data/tick_recording.h"
 #include "data/npc_database.h"
 #include "systems/movement_system.h"
 #include "systems/station_system.h"
@@ -73,6 +78,7 @@
 #include "systems/rumor_propagation_system.h"
 #include "systems/fleet_norm_system.h"
 #include "systems/lod_culling_system.h"
+#include "systems/spatial_index_system.h"
 #include "systems/star_system_state_system.h"
 #include "systems/local_reputation_system.h"
 #include "systems/npc_archetype_system.h"
@@ -80,13 +86,30 @@
 #include "ui/server_console.h"
 #include "utils/logger.h"
 #include "utils/server_metrics.h"
+#include "utils/tick_scheduler.h"
+#include "utils/profiler.h"
+#include "utils/thread_pool.h"
+#include "utils/mpsc_queue.h"
+#include "network/interest_manager.h"
+#include "network/snapshot_delta.h"
+#include "network/fragment_cache.h"
+#include "network/message_buffer.h"
+#include "network/wire_format.h"
+#include "network/receive_buffer.h"
+#include "network/tcp_server.h"
+#include "server.h"
 #include <iostream>
 #include <cassert>
 #include <string>
 #include <cmath>
+#include <limits>
+#include <algorithm>
+#include <sstream>
+#include <cstring>
 #include <memory>
 #include <fstream>
 #include <thread>
+#include <sys/stat.h>
 
 using namespace atlas;
 
@@ -111,10 +134,7 @@ bool approxEqual(float a, float b, float epsilon = 0.01f) {
 // Helper to add a component and return a raw pointer to it
 template<typename T>
 T* addComp(ecs::Entity* e) {
-    auto c = std::make_unique<T>();
-    T* ptr = c.get();
-    e->addComponent(std::move(c));
-    return ptr;
+    return e->addComponent(std::make_unique<T>());
 }
 
 // ==================== CapacitorSystem Tests ====================
@@ -2233,6 +2253,124 @@ void testLoggerLevelFiltering() {
     log.setLevel(utils::LogLevel::INFO);
 }
 
+static size_t countOccurrences(const std::string& path, const std::string& needle) {
+    std::ifstream f(path);
+    std::string line;
+    size_t count = 0;
+    while (std::getline(f, line)) {
+        if (line.find(needle) != std::string::npos) ++count;
+    }
+    return count;
+}
+
+void testLoggerAsyncWriter() {
+    std::cout << "\n=== Logger Async Writer ===" << std::endl;
+
+    auto& log = utils::Logger::instance();
+    log.setConsoleOutput(false);
+    log.shutdown();
+    std::remove("/tmp/eve_test_logs/async_test.log");
+    assertTrue(log.init("/tmp/eve_test_logs", "async_test.log"), "Logger init for async test succeeds");
+
+    log.startAsync(1024, 50);
+    assertTrue(log.isAsync(), "Logger is async after startAsync");
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&log, t] {
+            for (int i = 0; i < 200; ++i) {
+                log.info("async_line t" + std::to_string(t) + " #" + std::to_string(i));
+            }
+        });
+    }
+    for (auto& th : threads) th.join();
+    log.info("async_last_line");
+    log.flush();
+
+    const std::string path = "/tmp/eve_test_logs/async_test.log";
+    assertTrue(countOccurrences(path, "async_line") == 800, "All lines from all threads written");
+    assertTrue(countOccurrences(path, "async_last_line") == 1, "flush() writes lines logged before it");
+
+    // Per-thread order survives the batching
+    std::ifstream f(path);
+    std::string line;
+    int last = -1;
+    bool ordered = true;
+    while (std::getline(f, line)) {
+        auto pos = line.find("async_line t0 #");
+        if (pos == std::string::npos) continue;
+        int n = std::stoi(line.substr(pos + 15));
+        if (n != last + 1) ordered = false;
+        last = n;
+    }
+    assertTrue(ordered, "Lines from one thread stay in order");
+
+    log.stopAsync();
+    assertTrue(!log.isAsync(), "stopAsync returns to synchronous logging");
+    log.shutdown();
+    std::remove(path.c_str());
+    log.setConsoleOutput(true);
+}
+
+void testLoggerAsyncDropsWhenFull() {
+    std::cout << "\n=== Logger Async Drops When Full ===" << std::endl;
+
+    auto& log = utils::Logger::instance();
+    log.setConsoleOutput(false);
+    log.shutdown();
+    const std::string path = "/tmp/eve_test_logs/drop_test.log";
+    std::remove(path.c_str());
+    log.init("/tmp/eve_test_logs", "drop_test.log");
+
+    // Tiny queue and a long interval: a burst cannot fit
+    log.startAsync(16, 10000);
+    uint64_t dropped_before = log.getDroppedCount();
+    const int burst = 5000;
+    std::thread producer([&log, burst] {
+        for (int i = 0; i < burst; ++i) log.info("burst_line " + std::to_string(i));
+    });
+    producer.join();
+    log.flush();
+
+    uint64_t dropped = log.getDroppedCount() - dropped_before;
+    size_t written = countOccurrences(path, "burst_line");
+    assertTrue(dropped > 0, "Overflowing lines are dropped instead of blocking");
+    assertTrue(written + dropped == static_cast<size_t>(burst), "Every line is either written or counted");
+    assertTrue(countOccurrences(path, "Dropped") >= 1, "Drop count is reported in the log");
+
+    log.shutdown();
+    std::remove(path.c_str());
+    log.setConsoleOutput(true);
+}
+
+void testLoggerRotation() {
+    std::cout << "\n=== Logger Rotation ===" << std::endl;
+
+    auto& log = utils::Logger::instance();
+    log.setConsoleOutput(false);
+    log.shutdown();
+    const std::string path = "/tmp/eve_test_logs/rotate_test.log";
+    for (const char* suffix : {"", ".1", ".2", ".3"}) std::remove((path + suffix).c_str());
+    log.init("/tmp/eve_test_logs", "rotate_test.log");
+
+    log.setRotation(1000, 2);
+    for (int i = 0; i < 100; ++i) {
+        log.info("rotation line " + std::to_string(i));     // ~50 bytes each
+    }
+    log.shutdown();
+    log.setRotation(0, 5);
+
+    struct stat st;
+    assertTrue(stat((path + ".1").c_str(), &st) == 0, "Rotated file .1 exists");
+    assertTrue(stat((path + ".2").c_str(), &st) == 0, "Rotated file .2 exists");
+    assertTrue(stat((path + ".3").c_str(), &st) != 0, "Only max_files rotated files kept");
+    assertTrue(stat(path.c_str(), &st) == 0 && st.st_size <= 1000, "Current file stays under the limit");
+    assertTrue(countOccurrences(path, "rotation line 99") == 1, "Newest line is in the current file");
+
+    for (const char* suffix : {"", ".1", ".2"}) std::remove((path + suffix).c_str());
+    log.setConsoleOutput(true);
+}
+
 // ==================== ServerMetrics Tests ====================
 
 void testMetricsTickTiming() {
@@ -2333,6 +2471,212 @@ void testMetricsResetWindow() {
     assertTrue(metrics.getMinTickMs() == 0.0, "Min reset to 0 after window reset");
 }
 
+void testTickSchedulerPolicies() {
+    std::cout << "\n=== Tick Scheduler Policies ===" << std::endl;
+
+    using Sched = utils::TickScheduler;
+    Sched::Settings settings;
+    settings.tick_rate = 10.0;                  // 100 ms period
+    settings.spin = std::chrono::microseconds(0);
+    const auto period = std::chrono::milliseconds(100);
+    const auto t0 = Sched::Clock::time_point() + std::chrono::hours(1);
+
+    // On schedule: deadlines stay on the grid, every step is fixed
+    Sched on_time(settings);
+    on_time.start(t0);
+    auto tick = on_time.beginTick(t0);
+    assertTrue(tick.number == 0 && tick.lateness_ms == 0.0, "First tick is due at start");
+    assertTrue(std::fabs(tick.delta - 0.1f) < 1e-6f, "Tick advances by the fixed step");
+    on_time.endTick(t0 + std::chrono::milliseconds(30));
+    tick = on_time.beginTick(t0 + period + std::chrono::milliseconds(2));
+    assertTrue(on_time.nextDeadline() == t0 + 2 * period, "Slightly late tick keeps the grid");
+    on_time.endTick(t0 + 3 * period);
+    assertTrue(on_time.getStats().overruns == 1, "Tick longer than a period is an overrun");
+    assertTrue(on_time.getStats().late_ticks == 0, "Lateness under a period is not a late tick");
+
+    // Skip: a tick 2.5 periods late drops the two missed ticks
+    settings.policy = Sched::CatchUpPolicy::Skip;
+    Sched skip(settings);
+    skip.start(t0);
+    skip.beginTick(t0);
+    skip.beginTick(t0 + 3 * period + period / 2);
+    assertTrue(skip.getStats().skipped_ticks == 2, "Skip drops missed ticks");
+    assertTrue(skip.nextDeadline() == t0 + 4 * period, "Skip continues on the original grid");
+
+    // CatchUp bounded to one tick: one missed tick is dropped, one is replayed
+    settings.policy = Sched::CatchUpPolicy::CatchUp;
+    settings.max_catch_up_ticks = 1;
+    Sched catch_up(settings);
+    catch_up.start(t0);
+    catch_up.beginTick(t0);
+    auto late = t0 + 3 * period + period / 2;
+    catch_up.beginTick(late);
+    assertTrue(catch_up.getStats().skipped_ticks == 1, "Catch-up drops ticks beyond the bound");
+    assertTrue(catch_up.nextDeadline() <= late, "Next tick is due immediately");
+    assertTrue(!catch_up.hasBudget(0.0, late), "No budget while catching up");
+    tick = catch_up.beginTick(late);
+    assertTrue(tick.catching_up, "Replayed tick is flagged as catching up");
+    assertTrue(catch_up.nextDeadline() == t0 + 4 * period, "Catch-up rejoins the grid");
+    assertTrue(catch_up.getStats().catch_up_ticks == 1, "Catch-up tick counted");
+
+    // Dilate: nothing is dropped, the grid moves
+    settings.policy = Sched::CatchUpPolicy::Dilate;
+    Sched dilate(settings);
+    dilate.start(t0);
+    dilate.beginTick(t0);
+    dilate.beginTick(late);
+    assertTrue(dilate.getStats().skipped_ticks == 0, "Dilate drops no ticks");
+    assertTrue(dilate.nextDeadline() == late + period, "Dilate restarts the grid at the late tick");
+    assertTrue(dilate.getStats().dilation < 1.0, "Dilation factor falls below real time");
+
+    // Budget for deferrable work is what is left before the next deadline
+    Sched budget(settings);
+    budget.start(t0);
+    budget.beginTick(t0);
+    auto mid = t0 + std::chrono::milliseconds(60);
+    assertTrue(std::fabs(budget.remainingBudgetMs(mid) - 40.0) < 0.01, "Remaining budget is time to deadline");
+    assertTrue(budget.hasBudget(30.0, mid), "30 ms of work fits");
+    assertTrue(!budget.hasBudget(50.0, mid), "50 ms of work does not fit");
+
+    Sched::CatchUpPolicy parsed;
+    assertTrue(Sched::parsePolicy("dilate", parsed) && parsed == Sched::CatchUpPolicy::Dilate,
+               "Policy names parse");
+    assertTrue(!Sched::parsePolicy("bogus", parsed), "Unknown policy name is rejected");
+}
+
+void testTickSchedulerRealTime() {
+    std::cout << "\n=== Tick Scheduler Real Time ===" << std::endl;
+
+    utils::TickScheduler::Settings settings;
+    settings.tick_rate = 200.0;                 // 5 ms period
+    utils::TickScheduler scheduler(settings);
+
+    auto start = utils::TickScheduler::Clock::now();
+    scheduler.start(start);
+    for (int i = 0; i < 6; ++i) {
+        scheduler.waitNext();
+        scheduler.endTick();
+    }
+    auto elapsed = utils::TickScheduler::Clock::now() - start;
+    // Tick 5 is due at 25 ms; it can never start early
+    assertTrue(elapsed >= std::chrono::milliseconds(25), "Ticks never start before their deadline");
+    assertTrue(scheduler.getStats().ticks == 6, "Six ticks run");
+
+    utils::ServerMetrics metrics;
+    metrics.setScheduleStats(scheduler.getStats());
+    assertTrue(metrics.summary().find("overruns=") != std::string::npos, "Summary reports schedule stats");
+}
+
+void testLatencyHistogramPercentiles() {
+    std::cout << "\n=== Latency Histogram Percentiles ===" << std::endl;
+
+    utils::LatencyHistogram h;
+    assertTrue(h.percentile(0.5) == 0, "Empty histogram reports 0");
+
+    // 1..10000 microseconds, uniformly
+    for (uint64_t us = 1; us <= 10000; ++us) h.record(us * 1000);
+    auto within = [](uint64_t value, double expected) {
+        return std::fabs(static_cast<double>(value) - expected) <= expected * 0.03;
+    };
+    assertTrue(h.count() == 10000, "All samples counted");
+    assertTrue(within(h.percentile(0.5), 5000e3), "p50 within 3%");
+    assertTrue(within(h.percentile(0.99), 9900e3), "p99 within 3%");
+    assertTrue(within(h.percentile(0.999), 9990e3), "p999 within 3%");
+    assertTrue(h.max() == 10000000, "Max is exact");
+    assertTrue(h.percentile(1.0) <= h.max(), "p100 never exceeds max");
+
+    // Every value falls inside its bucket's bounds
+    bool bounded = true;
+    for (uint64_t v : {0ull, 1ull, 31ull, 32ull, 33ull, 1000ull, 123456789ull, 1ull << 39}) {
+        size_t i = utils::LatencyHistogram::bucketIndex(v);
+        if (v < utils::LatencyHistogram::bucketLow(i) || v > utils::LatencyHistogram::bucketHigh(i)) {
+            bounded = false;
+        }
+    }
+    assertTrue(bounded, "Bucket bounds contain their values");
+
+    // Windowing: subtracting an earlier snapshot leaves only new samples
+    utils::LatencyHistogram earlier = h;
+    for (int i = 0; i < 100; ++i) h.record(50000000);    // 50 ms spikes
+    h.subtract(earlier);
+    assertTrue(h.count() == 100, "Window holds only new samples");
+    assertTrue(within(h.percentile(0.5), 50e6), "Window p50 is the spike");
+}
+
+void testProfilerScopesAcrossThreads() {
+    std::cout << "\n=== Profiler Scopes Across Threads ===" << std::endl;
+
+    auto& profiler = utils::Profiler::instance();
+    utils::ServerMetrics metrics;
+    metrics.resetWindow();
+
+    auto work = [] {
+        for (int i = 0; i < 50; ++i) {
+            utils::ProfileScope outer("profiler_test");
+            utils::ProfileScope inner("child");
+        }
+    };
+    std::thread a(work);
+    std::thread b(work);
+    a.join();
+    b.join();
+    work();
+
+    auto find = [](const std::vector<utils::Profiler::ScopeStats>& stats, const std::string& path)
+            -> const utils::Profiler::ScopeStats* {
+        for (const auto& s : stats) {
+            if (s.path == path) return &s;
+        }
+        return nullptr;
+    };
+    auto all = profiler.collect();
+    const auto* outer = find(all, "profiler_test");
+    const auto* inner = find(all, "profiler_test/child");
+    assertTrue(outer && inner, "Nested scope registered under its parent");
+    assertTrue(outer && outer->histogram.count() >= 150, "Samples from all threads merged");
+    assertTrue(inner && inner->depth == outer->depth + 1, "Child is one level deeper");
+    assertTrue(utils::Profiler::current() == utils::Profiler::kNoScope, "Scope stack unwound");
+
+    // Tree order: a child directly follows its parent
+    bool ordered = false;
+    for (size_t i = 0; i + 1 < all.size(); ++i) {
+        if (all[i].path == "profiler_test") ordered = all[i + 1].path == "profiler_test/child";
+    }
+    assertTrue(ordered, "collect() lists children after their parent");
+
+    auto window = metrics.getProfile();
+    const auto* windowed = find(window, "profiler_test");
+    assertTrue(windowed && windowed->histogram.count() == 150, "Window counts samples since reset");
+    metrics.resetWindow();
+    window = metrics.getProfile();
+    windowed = find(window, "profiler_test");
+    assertTrue(windowed && windowed->histogram.count() == 0, "Reset starts an empty window");
+
+    std::string report = metrics.profileReport();
+    assertTrue(report.find("p999") != std::string::npos, "Report has percentile columns");
+    assertTrue(report.find("  child") != std::string::npos, "Report indents child scopes");
+
+    std::string scrape = metrics.scrapeText();
+    assertTrue(scrape.find("atlas_scope_seconds{scope=\"profiler_test/child\",quantile=\"0.99\"}")
+               != std::string::npos, "Scrape text has scope quantiles");
+    assertTrue(scrape.find("atlas_scope_seconds_count{scope=\"profiler_test\"}") != std::string::npos,
+               "Scrape text has scope counts");
+    assertTrue(outer && inner &&
+               scrape.find("atlas_scope_seconds_count{scope=\"profiler_test\"} " +
+                           std::to_string(outer->histogram.count()) + "\n") != std::string::npos &&
+               scrape.find("atlas_scope_seconds_count{scope=\"profiler_test/child\"} " +
+                           std::to_string(inner->histogram.count()) + "\n") != std::string::npos,
+               "Each scope's cumulative count is under its own label");
+
+    std::string path = "/tmp/atlas_test_metrics.prom";
+    assertTrue(metrics.writeScrapeFile(path), "Scrape file written");
+    std::ifstream in(path);
+    std::string first;
+    std::getline(in, first);
+    assertTrue(first.find("# TYPE") == 0, "Scrape file starts with a TYPE line");
+    std::remove(path.c_str());
+}
+
 // ==================== Mission System Tests ====================
 
 void testMissionAcceptAndComplete() {
@@ -3521,8 +3865,8 @@ void testMarketPlaceSellOrder() {
     auto* pc = addComp<components::Player>(seller);
     pc->isk = 100000.0;
 
-    std::string oid = marketSys.placeSellOrder("station_1", "seller_1", "tritanium", "Tritanium", 100, 5.0);
-    assertTrue(!oid.empty(), "Sell order created");
+    uint64_t oid = marketSys.placeSellOrder("station_1", "seller_1", "tritanium", "Tritanium", 100, 5.0);
+    assertTrue(oid != 0, "Sell order created");
     assertTrue(marketSys.getOrderCount("station_1") == 1, "One order on station");
     assertTrue(pc->isk < 100000.0, "Broker fee deducted from seller");
 }
@@ -3600,16 +3944,126 @@ void testMarketOrderExpiry() {
     auto* pc = addComp<components::Player>(seller);
     pc->isk = 1000000.0;
 
-    marketSys.placeSellOrder("station_1", "seller_1", "tritanium", "Tritanium", 100, 5.0);
+    // Five-second order
+    marketSys.placeSellOrder("station_1", "seller_1", "tritanium", "Tritanium", 100, 5.0, 5.0f);
     assertTrue(marketSys.getOrderCount("station_1") == 1, "One active order");
 
-    // Set order duration
-    hub->orders[0].duration_remaining = 5.0f;
-
     marketSys.update(6.0f);
     assertTrue(marketSys.getOrderCount("station_1") == 0, "Order expired and removed");
 }
 
+void testMarketPriceTimePriorityAndCancel() {
+    std::cout << "\n=== Market Price-Time Priority and Cancel ===" << std::endl;
+    ecs::World world;
+    systems::MarketSystem marketSys(&world);
+
+    auto* station = world.createEntity("station_1");
+    auto* hub = addComp<components::MarketHub>(station);
+    hub->station_id = "station_1";
+    hub->broker_fee_rate = 0.0;
+    hub->sales_tax_rate = 0.0;
+
+    std::vector<components::Player*> players;
+    for (const char* id : {"early", "late", "cheap", "bidder", "buyer"}) {
+        auto* pc = addComp<components::Player>(world.createEntity(id));
+        pc->isk = 10000.0;
+        players.push_back(pc);
+    }
+
+    uint64_t early = marketSys.placeSellOrder("station_1", "early", "trit", "Tritanium", 10, 5.0);
+    uint64_t late = marketSys.placeSellOrder("station_1", "late", "trit", "Tritanium", 10, 5.0);
+    uint64_t cheap = marketSys.placeSellOrder("station_1", "cheap", "trit", "Tritanium", 5, 4.0);
+    assertTrue(early != 0 && late > early && cheap > late, "Order ids increase with placement");
+    assertTrue(hub->orders.best("trit", false)->order_id == cheap, "Cheapest ask is best");
+
+    // 5 from the cheap order, then the older of the two at 5.0
+    assertTrue(marketSys.buyFromMarket("station_1", "buyer", "trit", 8) == 8, "Bought across two levels");
+    assertTrue(hub->orders.find(cheap) == nullptr, "Cheap ask filled and removed");
+    assertTrue(hub->orders.find(early)->quantity_remaining == 7 &&
+               hub->orders.find(late)->quantity_remaining == 10,
+               "Earlier order at the same price fills first");
+    assertTrue(approxEqual(players[4]->isk, 10000.0 - 5 * 4.0 - 3 * 5.0), "Buyer paid each level's price");
+
+    assertTrue(!marketSys.cancelOrder("station_1", "late", early), "Cannot cancel another owner's order");
+    assertTrue(marketSys.cancelOrder("station_1", "early", early), "Owner cancels order");
+    assertTrue(hub->orders.best("trit", false)->order_id == late, "Next order moves to the front");
+
+    uint64_t bid = marketSys.placeBuyOrder("station_1", "bidder", "trit", "Tritanium", 100, 3.0);
+    assertTrue(approxEqual(players[3]->isk, 9700.0), "Buy order escrowed");
+    assertTrue(approxEqual(marketSys.getHighestBuyPrice("station_1", "trit"), 3.0), "Bid ladder holds the order");
+    assertTrue(marketSys.cancelOrder("station_1", "bidder", bid), "Buy order cancelled");
+    assertTrue(approxEqual(players[3]->isk, 10000.0), "Escrow refunded on cancel");
+    assertTrue(marketSys.getHighestBuyPrice("station_1", "trit") < 0.0, "Bid ladder empty");
+}
+
+void testMarketRejectsInvalidPrices() {
+    std::cout << "\n=== Market Rejects Invalid Prices ===" << std::endl;
+    ecs::World world;
+    systems::MarketSystem marketSys(&world);
+
+    auto* station = world.createEntity("station_1");
+    auto* hub = addComp<components::MarketHub>(station);
+    hub->station_id = "station_1";
+    auto* pc = addComp<components::Player>(world.createEntity("trader"));
+    pc->isk = 10000.0;
+
+    const double bad_prices[] = {
+        std::numeric_limits<double>::quiet_NaN(),
+        std::numeric_limits<double>::infinity(),
+        -std::numeric_limits<double>::infinity(),
+        -5.0,
+        0.0,
+    };
+    bool rejected = true;
+    for (double price : bad_prices) {
+        rejected = rejected &&
+                   marketSys.placeSellOrder("station_1", "trader", "trit", "Tritanium", 10, price) == 0 &&
+                   marketSys.placeBuyOrder("station_1", "trader", "trit", "Tritanium", 10, price) == 0;
+    }
+    assertTrue(rejected, "NaN, infinite, negative and zero prices rejected");
+    assertTrue(approxEqual(pc->isk, 10000.0), "No fee or escrow charged for a rejected order");
+    assertTrue(marketSys.getOrderCount("station_1") == 0, "Book stays empty");
+
+    // The book still orders prices after the rejected attempts
+    marketSys.placeSellOrder("station_1", "trader", "trit", "Tritanium", 1, 6.0);
+    marketSys.placeSellOrder("station_1", "trader", "trit", "Tritanium", 1, 4.0);
+    assertTrue(approxEqual(marketSys.getLowestSellPrice("station_1", "trit"), 4.0), "Lowest ask still found");
+}
+
+void testOrderBookExpiryHeap() {
+    std::cout << "\n=== Order Book Expiry Heap ===" << std::endl;
+    data::OrderBook book;
+    auto make = [](const std::string& item, bool buy, double price) {
+        data::OrderBook::Order order;
+        order.item_id = item;
+        order.is_buy_order = buy;
+        order.price_per_unit = price;
+        order.quantity = order.quantity_remaining = 1;
+        return order;
+    };
+
+    auto soon = book.add(make("a", false, 1.0), 5.0f);
+    auto later = book.add(make("a", false, 2.0), 20.0f);
+    auto cancelled = book.add(make("b", true, 1.0), 5.0f);
+    book.add(make("b", true, 2.0));     // permanent
+    assertTrue(book.size() == 4 && book.itemCount() == 2, "Four orders on two items");
+    assertTrue(book.cancel(cancelled), "Order cancelled");
+
+    std::vector<data::OrderBook::OrderId> expired;
+    auto record = [&](const data::OrderBook::Order& o) { expired.push_back(o.order_id); };
+    assertTrue(book.advance(4.0, record) == 0, "Nothing due early");
+    assertTrue(book.advance(1.0, record) == 1 && expired.size() == 1 && expired[0] == soon,
+               "Due order expires; cancelled one is skipped");
+    assertTrue(approxEqual(book.durationRemaining(*book.find(later)), 15.0f), "Remaining duration follows the clock");
+    assertTrue(book.advance(1000.0, record) == 1 && book.size() == 1, "Permanent order never expires");
+    assertTrue(book.best("a", false) == nullptr && book.itemCount() == 1, "Empty item dropped");
+
+    data::OrderBook::Order restored = make("c", false, 1.0);
+    restored.order_id = 50;
+    assertTrue(book.add(restored) == 50 && book.add(restored) == 0, "Restored id kept, duplicate rejected");
+    assertTrue(book.add(make("c", false, 1.0)) == 51, "New ids continue after restored ones");
+}
+
 // ==================== Corporation System Tests ====================
 
 void testCorpCreate() {
@@ -4277,7 +4731,7 @@ void testSerializeDeserializeEconomyComponents() {
     market->broker_fee_rate = 0.03;
     market->sales_tax_rate = 0.05;
     components::MarketHub::Order order;
-    order.order_id = "order_001";
+    order.order_id = 1001;
     order.item_id = "trit";
     order.item_name = "Tritanium";
     order.owner_id = "player_1";
@@ -4285,9 +4739,7 @@ void testSerializeDeserializeEconomyComponents() {
     order.price_per_unit = 5.5;
     order.quantity = 1000;
     order.quantity_remaining = 800;
-    order.duration_remaining = 86400.0f;
-    order.fulfilled = false;
-    market->orders.push_back(order);
+    market->orders.add(order, 86400.0f);
 
     data::WorldPersistence persistence;
     std::string json = persistence.serializeWorld(&world);
@@ -4326,16 +4778,17 @@ void testSerializeDeserializeEconomyComponents() {
     assertTrue(approxEqual(static_cast<float>(market2->broker_fee_rate), 0.03f), "broker_fee_rate preserved");
     assertTrue(approxEqual(static_cast<float>(market2->sales_tax_rate), 0.05f), "sales_tax_rate preserved");
     assertTrue(market2->orders.size() == 1, "order count preserved");
-    assertTrue(market2->orders[0].order_id == "order_001", "order_id preserved");
-    assertTrue(market2->orders[0].item_id == "trit", "order item_id preserved");
-    assertTrue(market2->orders[0].item_name == "Tritanium", "order item_name preserved");
-    assertTrue(market2->orders[0].owner_id == "player_1", "order owner_id preserved");
-    assertTrue(market2->orders[0].is_buy_order == true, "is_buy_order preserved");
-    assertTrue(approxEqual(static_cast<float>(market2->orders[0].price_per_unit), 5.5f), "price_per_unit preserved");
-    assertTrue(market2->orders[0].quantity == 1000, "order quantity preserved");
-    assertTrue(market2->orders[0].quantity_remaining == 800, "order quantity_remaining preserved");
-    assertTrue(approxEqual(market2->orders[0].duration_remaining, 86400.0f), "order duration_remaining preserved");
-    assertTrue(market2->orders[0].fulfilled == false, "order fulfilled preserved");
+    const auto* order2 = market2->orders.find(1001);
+    assertTrue(order2 != nullptr, "order_id preserved");
+    assertTrue(order2->item_id == "trit", "order item_id preserved");
+    assertTrue(order2->item_name == "Tritanium", "order item_name preserved");
+    assertTrue(order2->owner_id == "player_1", "order owner_id preserved");
+    assertTrue(order2->is_buy_order == true, "is_buy_order preserved");
+    assertTrue(approxEqual(static_cast<float>(order2->price_per_unit), 5.5f), "price_per_unit preserved");
+    assertTrue(order2->quantity == 1000, "order quantity preserved");
+    assertTrue(order2->quantity_remaining == 800, "order quantity_remaining preserved");
+    assertTrue(approxEqual(market2->orders.durationRemaining(*order2), 86400.0f), "order duration_remaining preserved");
+    assertTrue(market2->orders.best("trit", true) == order2, "order rests on the bid ladder");
 }
 
 // ==================== PISystem Tests ====================
@@ -5837,6 +6290,13 @@ void testWreckCreate() {
     assertTrue(wreck->source_entity_id == "dead_ship_1", "Source entity id correct");
     assertTrue(approxEqual(wreck->lifetime_remaining, 600.0f), "Lifetime is correct");
     assertTrue(!wreck->salvaged, "Not yet salvaged");
+    assertTrue(!entity->hasComponent<components::SystemLocation>(), "Unknown source leaves no system");
+
+    auto* ship = world.createEntity("dead_ship_2");
+    addComp<components::SystemLocation>(ship)->system_id = "rimward";
+    auto* placed = world.getEntity(wreckSys.createWreck("dead_ship_2", 0.0f, 0.0f, 0.0f));
+    assertTrue(placed->getComponent<components::SystemLocation>()->system_id == "rimward",
+               "Wreck is in its ship's solar system");
 }
 
 void testWreckLifetimeDecay() {
@@ -8640,16 +9100,16 @@ void testMarketOrePricing() {
     npc_player->isk = 1000000.0;
 
     // NPC places sell orders for common ores
-    std::string o1 = marketSys.placeSellOrder("trade_hub", "npc_ore_seller",
-                                               "Veldspar", "Veldspar", 10000, 15.0);
-    std::string o2 = marketSys.placeSellOrder("trade_hub", "npc_ore_seller",
-                                               "Scordite", "Scordite", 5000, 38.0);
-    std::string o3 = marketSys.placeSellOrder("trade_hub", "npc_ore_seller",
-                                               "Pyroxeres", "Pyroxeres", 3000, 70.0);
+    uint64_t o1 = marketSys.placeSellOrder("trade_hub", "npc_ore_seller",
+                                            "Veldspar", "Veldspar", 10000, 15.0);
+    uint64_t o2 = marketSys.placeSellOrder("trade_hub", "npc_ore_seller",
+                                            "Scordite", "Scordite", 5000, 38.0);
+    uint64_t o3 = marketSys.placeSellOrder("trade_hub", "npc_ore_seller",
+                                            "Pyroxeres", "Pyroxeres", 3000, 70.0);
 
-    assertTrue(!o1.empty(), "Veldspar sell order placed");
-    assertTrue(!o2.empty(), "Scordite sell order placed");
-    assertTrue(!o3.empty(), "Pyroxeres sell order placed");
+    assertTrue(o1 != 0, "Veldspar sell order placed");
+    assertTrue(o2 != 0, "Scordite sell order placed");
+    assertTrue(o3 != 0, "Pyroxeres sell order placed");
 
     double veldspar_price = marketSys.getLowestSellPrice("trade_hub", "Veldspar");
     double scordite_price = marketSys.getLowestSellPrice("trade_hub", "Scordite");
@@ -8678,13 +9138,13 @@ void testMarketMineralPricing() {
     npc_player->isk = 10000000.0;
 
     // NPC places buy orders for refined minerals
-    std::string b1 = marketSys.placeBuyOrder("mineral_hub", "npc_mineral_buyer",
-                                              "Tritanium", "Tritanium", 50000, 6.0);
-    std::string b2 = marketSys.placeBuyOrder("mineral_hub", "npc_mineral_buyer",
-                                              "Pyerite", "Pyerite", 20000, 9.0);
+    uint64_t b1 = marketSys.placeBuyOrder("mineral_hub", "npc_mineral_buyer",
+                                           "Tritanium", "Tritanium", 50000, 6.0);
+    uint64_t b2 = marketSys.placeBuyOrder("mineral_hub", "npc_mineral_buyer",
+                                           "Pyerite", "Pyerite", 20000, 9.0);
 
-    assertTrue(!b1.empty(), "Tritanium buy order placed");
-    assertTrue(!b2.empty(), "Pyerite buy order placed");
+    assertTrue(b1 != 0, "Tritanium buy order placed");
+    assertTrue(b2 != 0, "Pyerite buy order placed");
 
     double trit_price = marketSys.getHighestBuyPrice("mineral_hub", "Tritanium");
     double pyer_price = marketSys.getHighestBuyPrice("mineral_hub", "Pyerite");
@@ -10444,14 +10904,14 @@ void testNPCMarketSeedPricesCorrect() {
 
     market.seedNPCOrders("station_seed2");
 
-    assertTrue(hub->orders[0].item_name == "Tritanium", "First order is Tritanium");
-    assertTrue(approxEqual(hub->orders[0].price_per_unit, 6.0), "Tritanium price is 6.0 ISK");
-    assertTrue(hub->orders[1].item_name == "Pyerite", "Second order is Pyerite");
-    assertTrue(approxEqual(hub->orders[1].price_per_unit, 10.0), "Pyerite price is 10.0 ISK");
-    assertTrue(hub->orders[2].item_name == "Mexallon", "Third order is Mexallon");
-    assertTrue(approxEqual(hub->orders[2].price_per_unit, 40.0), "Mexallon price is 40.0 ISK");
-    assertTrue(hub->orders[3].item_name == "Nocxidium", "Fourth order is Nocxidium");
-    assertTrue(approxEqual(hub->orders[3].price_per_unit, 800.0, 1.0), "Nocxidium price is 800.0 ISK");
+    assertTrue(hub->orders.find(1)->item_name == "Tritanium", "First order is Tritanium");
+    assertTrue(approxEqual(hub->orders.find(1)->price_per_unit, 6.0), "Tritanium price is 6.0 ISK");
+    assertTrue(hub->orders.find(2)->item_name == "Pyerite", "Second order is Pyerite");
+    assertTrue(approxEqual(hub->orders.find(2)->price_per_unit, 10.0), "Pyerite price is 10.0 ISK");
+    assertTrue(hub->orders.find(3)->item_name == "Mexallon", "Third order is Mexallon");
+    assertTrue(approxEqual(hub->orders.find(3)->price_per_unit, 40.0), "Mexallon price is 40.0 ISK");
+    assertTrue(hub->orders.find(4)->item_name == "Nocxidium", "Fourth order is Nocxidium");
+    assertTrue(approxEqual(hub->orders.find(4)->price_per_unit, 800.0, 1.0), "Nocxidium price is 800.0 ISK");
 }
 
 void testNPCMarketSeedOrdersPermanent() {
@@ -10465,11 +10925,11 @@ void testNPCMarketSeedOrdersPermanent() {
 
     market.seedNPCOrders("station_seed3");
 
-    for (const auto& order : hub->orders) {
-        assertTrue(order.duration_remaining < 0.0f, "NPC order is permanent (duration_remaining < 0)");
+    hub->orders.forEach([&](const components::MarketHub::Order& order) {
+        assertTrue(hub->orders.durationRemaining(order) < 0.0f, "NPC order is permanent (duration_remaining < 0)");
         assertTrue(order.owner_id == "npc_market", "NPC order owned by npc_market");
         assertTrue(!order.is_buy_order, "NPC seed orders are sell orders");
-    }
+    });
 }
 
 void testNPCMarketSeedBuyableByPlayer() {
@@ -11885,7 +12345,7 @@ void testPersistenceEconomyFile() {
 
     // Add sell order
     components::MarketHub::Order sell;
-    sell.order_id = "sell_001";
+    sell.order_id = 1;
     sell.item_id = "trit";
     sell.item_name = "Tritanium";
     sell.owner_id = "npc_trader_1";
@@ -11893,13 +12353,11 @@ void testPersistenceEconomyFile() {
     sell.price_per_unit = 6.0;
     sell.quantity = 50000;
     sell.quantity_remaining = 45000;
-    sell.duration_remaining = 172800.0f;
-    sell.fulfilled = false;
-    market->orders.push_back(sell);
+    market->orders.add(sell, 172800.0f);
 
     // Add buy order
     components::MarketHub::Order buy;
-    buy.order_id = "buy_001";
+    buy.order_id = 2;
     buy.item_id = "pye";
     buy.item_name = "Pyerite";
     buy.owner_id = "npc_trader_2";
@@ -11907,9 +12365,7 @@ void testPersistenceEconomyFile() {
     buy.price_per_unit = 12.0;
     buy.quantity = 20000;
     buy.quantity_remaining = 20000;
-    buy.duration_remaining = 86400.0f;
-    buy.fulfilled = false;
-    market->orders.push_back(buy);
+    market->orders.add(buy, 86400.0f);
 
     // Create mineral deposits
     auto* belt = world.createEntity("asteroid_belt_1");
@@ -11953,11 +12409,11 @@ void testPersistenceEconomyFile() {
     assertTrue(market2 != nullptr, "MarketHub component after load");
     assertTrue(market2->station_id == "station_jita", "station_id preserved");
     assertTrue(market2->orders.size() == 2, "Both orders preserved");
-    assertTrue(market2->orders[0].order_id == "sell_001", "Sell order preserved");
-    assertTrue(!market2->orders[0].is_buy_order, "Sell order type preserved");
-    assertTrue(market2->orders[0].quantity_remaining == 45000, "Sell order qty remaining preserved");
-    assertTrue(market2->orders[1].order_id == "buy_001", "Buy order preserved");
-    assertTrue(market2->orders[1].is_buy_order, "Buy order type preserved");
+    assertTrue(market2->orders.find(1) != nullptr, "Sell order preserved");
+    assertTrue(!market2->orders.find(1)->is_buy_order, "Sell order type preserved");
+    assertTrue(market2->orders.find(1)->quantity_remaining == 45000, "Sell order qty remaining preserved");
+    assertTrue(market2->orders.find(2) != nullptr, "Buy order preserved");
+    assertTrue(market2->orders.find(2)->is_buy_order, "Buy order type preserved");
 
     // Verify mineral deposit
     auto* belt2 = world2.getEntity("asteroid_belt_1");
@@ -12811,6 +13267,503 @@ void testCompressedVsUncompressedSize() {
     std::remove(comp_path.c_str());
 }
 
+void testWorldSnapshotIsDetached() {
+    std::cout << "\n=== World Snapshot: Detached Copy ===" << std::endl;
+
+    ecs::World world;
+    for (int i = 0; i < 20; ++i) {
+        auto* e = world.createEntity("snap_" + std::to_string(i));
+        auto* pos = addComp<components::Position>(e);
+        pos->x = static_cast<float>(i);
+        auto* hp = addComp<components::Health>(e);
+        hp->hull_hp = 100.0f + static_cast<float>(i);
+        if (i % 2 == 0) {
+            auto* inv = addComp<components::Inventory>(e);
+            inv->items.push_back({"tritanium", "Tritanium", "mineral", 10, 0.01f});
+        }
+    }
+
+    data::WorldPersistence persistence;
+    auto snapshot = persistence.snapshotWorld(&world);
+    std::string live_json = persistence.serializeWorld(&world);
+    assertTrue(snapshot->getEntityCount() == 20, "Snapshot copies every entity");
+    assertTrue(persistence.serializeSnapshot(*snapshot) == live_json,
+               "Snapshot serializes exactly like the live world");
+
+    // Later changes to the world must not reach the snapshot
+    world.getEntity("snap_3")->getComponent<components::Health>()->hull_hp = 1.0f;
+    world.destroyEntity("snap_4");
+    world.createEntity("snap_new");
+    assertTrue(persistence.serializeSnapshot(*snapshot) == live_json,
+               "Snapshot unaffected by later world changes");
+}
+
+void testAsyncWorldSaver() {
+    std::cout << "\n=== Async World Saver ===" << std::endl;
+
+    ecs::World world;
+    for (int i = 0; i < 200; ++i) {
+        auto* e = world.createEntity("bg_" + std::to_string(i));
+        auto* pos = addComp<components::Position>(e);
+        pos->x = static_cast<float>(i * 10);
+        auto* ship = addComp<components::Ship>(e);
+        ship->ship_type = "Frigate";
+    }
+
+    data::WorldPersistence persistence;
+    data::AsyncWorldSaver saver(persistence);
+    const std::string json_path = "/tmp/eve_async_save_test.json";
+    const std::string atlasw_path = "/tmp/eve_async_save_test.atlasw";
+
+    data::AsyncWorldSaver::Result result;
+    assertTrue(!saver.poll(result), "No result before the first save");
+    assertTrue(saver.begin(&world, json_path, data::SaveFormat::Json), "Background save started");
+
+    // The world may change as soon as begin() returns
+    world.getEntity("bg_7")->getComponent<components::Position>()->x = -1.0f;
+    for (int i = 0; i < 50; ++i) world.destroyEntity("bg_" + std::to_string(i + 100));
+
+    saver.wait();
+    assertTrue(!saver.isBusy(), "Saver idle after wait");
+    assertTrue(saver.poll(result), "Finished save reported");
+    assertTrue(!saver.poll(result), "Result reported only once");
+    assertTrue(result.ok, "Background save succeeded");
+    assertTrue(result.entities == 200, "Result counts snapshot entities");
+    assertTrue(result.bytes > 0 && result.background_ms >= 0.0 && result.snapshot_ms >= 0.0,
+               "Result carries size and timings");
+
+    struct stat st;
+    assertTrue(stat((json_path + ".tmp").c_str(), &st) != 0, "Temporary file renamed away");
+
+    ecs::World loaded;
+    assertTrue(persistence.loadWorld(&loaded, json_path), "Background JSON save loads");
+    assertTrue(loaded.getEntityCount() == 200, "Save holds the world as of begin()");
+    assertTrue(approxEqual(loaded.getEntity("bg_7")->getComponent<components::Position>()->x, 70.0f),
+               "Save unaffected by changes after begin()");
+
+    assertTrue(saver.begin(&world, atlasw_path, data::SaveFormat::Compressed), "Compressed background save started");
+    assertTrue(!saver.begin(&world, atlasw_path, data::SaveFormat::Compressed), "Second save refused while busy");
+    saver.wait();
+    assertTrue(saver.poll(result) && result.ok, "Compressed background save succeeded");
+    ecs::World loaded2;
+    assertTrue(persistence.loadWorldCompressed(&loaded2, atlasw_path), "Compressed save loads");
+    assertTrue(loaded2.getEntityCount() == 150, "Compressed save holds the current world");
+
+    utils::ServerMetrics metrics;
+    metrics.recordSave(result.snapshot_ms, result.background_ms, result.bytes, result.ok);
+    assertTrue(metrics.getSaveStats().saves == 1, "Metrics count the save");
+    assertTrue(metrics.summary().find("save_tick=") != std::string::npos,
+               "Summary reports the save's tick time");
+    assertTrue(metrics.scrapeText().find("atlas_save_background_seconds") != std::string::npos,
+               "Scrape text exports the background time");
+
+    std::remove(json_path.c_str());
+    std::remove(atlasw_path.c_str());
+}
+
+void testWorldJournalIncremental() {
+    std::cout << "\n=== World Journal: Incremental Saves ===" << std::endl;
+
+    const std::string base_path = "/tmp/eve_journal_test.json";
+    const std::string journal_path = "/tmp/eve_journal_test.journal";
+    std::remove(base_path.c_str());
+    std::remove(journal_path.c_str());
+
+    ecs::World world;
+    for (int i = 0; i < 100; ++i) {
+        auto* e = world.createEntity("jrn_" + std::to_string(i));
+        auto* pos = addComp<components::Position>(e);
+        pos->x = static_cast<float>(i) * 1.5f;
+        auto* hp = addComp<components::Health>(e);
+        hp->hull_hp = 250.0f;
+        hp->hull_max = 250.0f;
+    }
+
+    data::WorldPersistence persistence;
+    data::WorldJournal journal(persistence, base_path, journal_path, data::SaveFormat::Json);
+    assertTrue(!journal.exists(), "No journal files before the first commit");
+
+    auto first = journal.commit(*persistence.snapshotWorld(&world));
+    assertTrue(first.ok && first.compacted, "First commit writes the base save");
+    assertTrue(journal.getJournalBytes() == 0, "Journal empty after writing the base");
+
+    // Churn: three changed, one removed, one added
+    for (int i : {3, 40, 77}) {
+        world.getEntity("jrn_" + std::to_string(i))->getComponent<components::Health>()->hull_hp = 10.0f;
+    }
+    world.destroyEntity("jrn_50");
+    addComp<components::Position>(world.createEntity("jrn_new"))->x = 9.0f;
+
+    auto delta = journal.commit(*persistence.snapshotWorld(&world));
+    assertTrue(delta.ok && !delta.compacted, "Second commit appends to the journal");
+    assertTrue(delta.upserts == 4 && delta.removals == 1, "Journal holds only the churn");
+    assertTrue(delta.bytes * 10 < journal.getBaseBytes(), "Journal batch far smaller than the base");
+
+    auto idle = journal.commit(*persistence.snapshotWorld(&world));
+    assertTrue(idle.ok && idle.upserts == 0 && idle.removals == 0 && idle.bytes == 0,
+               "Unchanged world writes nothing");
+
+    // Background commit through the saver
+    world.getEntity("jrn_5")->getComponent<components::Position>()->x = -5.0f;
+    data::AsyncWorldSaver saver(persistence);
+    data::AsyncWorldSaver::Result result;
+    assertTrue(saver.begin(&world, journal), "Journaled background save started");
+    saver.wait();
+    assertTrue(saver.poll(result) && result.ok && result.journaled && result.upserts == 1,
+               "Background save journals the one change");
+
+    ecs::World restored;
+    data::WorldJournal reader(persistence, base_path, journal_path, data::SaveFormat::Json);
+    assertTrue(reader.load(&restored), "Base plus journal loads");
+    assertTrue(restored.getEntityCount() == 100, "Replay applies additions and removals");
+    assertTrue(restored.getEntity("jrn_50") == nullptr, "Removed entity stays removed");
+    assertTrue(restored.getEntity("jrn_new") != nullptr, "Added entity restored");
+    assertTrue(approxEqual(restored.getEntity("jrn_40")->getComponent<components::Health>()->hull_hp, 10.0f),
+               "Changed entity restored from the journal");
+    assertTrue(approxEqual(restored.getEntity("jrn_5")->getComponent<components::Position>()->x, -5.0f),
+               "Latest batch wins");
+    assertTrue(reader.getSequence() == journal.getSequence(), "Replay resumes the batch sequence");
+
+    auto after_load = reader.commit(*persistence.snapshotWorld(&restored));
+    assertTrue(after_load.ok && after_load.upserts == 0 && after_load.removals == 0,
+               "Loaded entities count as already saved");
+
+    std::remove(base_path.c_str());
+    std::remove(journal_path.c_str());
+}
+
+void testWorldJournalCompactionAndTornTail() {
+    std::cout << "\n=== World Journal: Compaction and Torn Tail ===" << std::endl;
+
+    const std::string base_path = "/tmp/eve_journal_compact.atlasw";
+    const std::string journal_path = "/tmp/eve_journal_compact.journal";
+    std::remove(base_path.c_str());
+    std::remove(journal_path.c_str());
+
+    ecs::World world;
+    for (int i = 0; i < 20; ++i) {
+        addComp<components::Position>(world.createEntity("cmp_" + std::to_string(i)))->x = 1.0f;
+    }
+
+    data::WorldPersistence persistence;
+    data::WorldJournal journal(persistence, base_path, journal_path, data::SaveFormat::Compressed);
+    journal.commit(*persistence.snapshotWorld(&world));
+
+    // Past the compaction threshold the base is rewritten instead
+    journal.setCompactRatio(0.01);
+    world.getEntity("cmp_1")->getComponent<components::Position>()->x = 2.0f;
+    auto compacted = journal.commit(*persistence.snapshotWorld(&world));
+    assertTrue(compacted.ok && compacted.compacted, "Oversized journal compacts into the base");
+    assertTrue(journal.getJournalBytes() == 0, "Compaction empties the journal");
+
+    journal.setCompactRatio(0.5);
+    world.getEntity("cmp_2")->getComponent<components::Position>()->x = 3.0f;
+    auto appended = journal.commit(*persistence.snapshotWorld(&world));
+    assertTrue(appended.ok && !appended.compacted && appended.upserts == 1,
+               "Small change appended after compaction");
+
+    // Simulate a crash in the middle of appending a batch
+    {
+        std::ofstream torn(journal_path, std::ios::app | std::ios::binary);
+        torn << "B 99 2\nU {\"id\":\"cmp_3\",\"position\":{\"x\":7";
+    }
+    struct stat st;
+    stat(journal_path.c_str(), &st);
+    uint64_t torn_size = static_cast<uint64_t>(st.st_size);
+
+    ecs::World restored;
+    data::WorldJournal reader(persistence, base_path, journal_path, data::SaveFormat::Compressed);
+    assertTrue(reader.load(&restored), "Journal with a torn tail still loads");
+    assertTrue(restored.getEntityCount() == 20, "All entities restored");
+    assertTrue(approxEqual(restored.getEntity("cmp_1")->getComponent<components::Position>()->x, 2.0f),
+               "Compacted change present in the base");
+    assertTrue(approxEqual(restored.getEntity("cmp_2")->getComponent<components::Position>()->x, 3.0f),
+               "Complete batch replayed");
+    assertTrue(approxEqual(restored.getEntity("cmp_3")->getComponent<components::Position>()->x, 1.0f),
+               "Torn batch ignored");
+    stat(journal_path.c_str(), &st);
+    assertTrue(static_cast<uint64_t>(st.st_size) < torn_size &&
+               static_cast<uint64_t>(st.st_size) == reader.getJournalBytes(),
+               "Torn tail truncated from the journal");
+
+    std::remove(base_path.c_str());
+    std::remove(journal_path.c_str());
+}
+
+void testWorldBinaryFormatRoundTrip() {
+    std::cout << "\n=== World Binary Format: Round Trip ===" << std::endl;
+
+    ecs::World world;
+    for (int i = 0; i < 50; ++i) {
+        auto* e = world.createEntity("bin_" + std::to_string(i));
+        auto* pos = addComp<components::Position>(e);
+        pos->x = static_cast<float>(i);
+        pos->rotation = 0.5f;
+        addComp<components::Faction>(e)->faction_name = i % 2 ? "Caldari" : "Amarr";
+    }
+    auto* ship = world.getEntity("bin_3");
+    auto* hull = addComp<components::Ship>(ship);
+    hull->ship_name = "Rifter";
+    hull->max_locked_targets = 5;
+    auto* ai = addComp<components::AI>(ship);
+    ai->behavior = components::AI::Behavior::Flee;
+    ai->target_entity_id = "bin_4";
+    addComp<components::Player>(ship)->isk = 1234567.25;
+    addComp<components::Wreck>(ship)->salvaged = true;
+
+    // Every column field off its default, so a field missing from a layout
+    // shows up in the per-entity comparison below
+    auto* pos3 = ship->getComponent<components::Position>();
+    pos3->y = -2.5f;
+    pos3->z = 3.25f;
+    auto* vel = addComp<components::Velocity>(ship);
+    vel->vx = 1.5f; vel->vy = -2.5f; vel->vz = 3.5f;
+    vel->angular_velocity = 0.75f; vel->max_speed = 321.0f;
+    auto* hp = addComp<components::Health>(ship);
+    hp->hull_hp = 11.0f; hp->hull_max = 12.0f; hp->armor_hp = 13.0f; hp->armor_max = 14.0f;
+    hp->shield_hp = 15.0f; hp->shield_max = 16.0f; hp->shield_recharge_rate = 17.0f;
+    hp->hull_em_resist = 0.01f; hp->hull_thermal_resist = 0.02f;
+    hp->hull_kinetic_resist = 0.03f; hp->hull_explosive_resist = 0.04f;
+    hp->armor_em_resist = 0.05f; hp->armor_thermal_resist = 0.06f;
+    hp->armor_kinetic_resist = 0.07f; hp->armor_explosive_resist = 0.08f;
+    hp->shield_em_resist = 0.09f; hp->shield_thermal_resist = 0.11f;
+    hp->shield_kinetic_resist = 0.12f; hp->shield_explosive_resist = 0.13f;
+    auto* cap = addComp<components::Capacitor>(ship);
+    cap->capacitor = 21.0f; cap->capacitor_max = 22.0f; cap->recharge_rate = 23.0f;
+    hull->ship_type = "Frigate"; hull->ship_class = "Assault"; hull->race = "Minmatar";
+    hull->cpu = 31.0f; hull->cpu_max = 32.0f; hull->powergrid = 33.0f; hull->powergrid_max = 34.0f;
+    hull->signature_radius = 35.0f; hull->scan_resolution = 36.0f; hull->max_targeting_range = 37.0f;
+    ai->state = components::AI::State::Orbiting;
+    ai->orbit_distance = 4321.0f;
+    ai->awareness_range = 8765.0f;
+    auto* gun = addComp<components::Weapon>(ship);
+    gun->weapon_type = "Autocannon"; gun->damage_type = "explosive"; gun->damage = 41.0f;
+    gun->optimal_range = 42.0f; gun->falloff_range = 43.0f; gun->tracking_speed = 0.44f;
+    gun->rate_of_fire = 4.5f; gun->capacitor_cost = 4.6f; gun->ammo_type = "EMP"; gun->ammo_count = 47;
+    auto* pilot = ship->getComponent<components::Player>();
+    pilot->player_id = "p_3"; pilot->character_name = "Pilot"; pilot->corporation = "Corp";
+    auto* fleet = addComp<components::FleetMembership>(ship);
+    fleet->fleet_id = "f_1"; fleet->role = "Commander"; fleet->squad_id = "s_1"; fleet->wing_id = "w_1";
+    auto* sta = addComp<components::Station>(ship);
+    sta->station_name = "Rens VI"; sta->docking_range = 5000.5f;
+    sta->repair_cost_per_hp = 2.5f; sta->docked_count = 7;
+    addComp<components::Docked>(ship)->station_id = "bin_9";
+    auto* wreck = ship->getComponent<components::Wreck>();
+    wreck->source_entity_id = "bin_2";
+    wreck->lifetime_remaining = 99.5f;
+    auto* lod = addComp<components::LODPriority>(ship);
+    lod->priority = 2.5f; lod->force_visible = true; lod->impostor_distance = 1234.0f;
+    auto* warp = addComp<components::WarpProfile>(ship);
+    warp->warp_speed = 6.5f; warp->mass_norm = 0.625f; warp->intensity = 0.375f; warp->comfort_scale = 1.75f;
+    addComp<components::SystemLocation>(ship)->system_id = "rimward";
+    components::Inventory::Item ore;
+    ore.item_id = "veldspar";
+    ore.quantity = 42;
+    addComp<components::Inventory>(ship)->items.push_back(ore);
+
+    data::WorldPersistence persistence;
+    data::WorldBinaryFormat binary(persistence);
+    const std::string path = "/tmp/eve_binary_roundtrip.atlasb";
+    assertTrue(binary.save(&world, path), "Binary save succeeds");
+    assertTrue(data::WorldBinaryFormat::isBinaryFile(path), "Saved file has the binary magic");
+
+    ecs::World restored;
+    assertTrue(binary.load(&restored, path), "Binary load succeeds");
+    assertTrue(restored.getEntityCount() == 50, "All entities restored");
+    assertTrue(approxEqual(restored.getEntity("bin_7")->getComponent<components::Position>()->x, 7.0f),
+               "Columnar float field restored");
+    assertTrue(restored.getEntity("bin_7")->getComponent<components::Faction>()->faction_name == "Caldari",
+               "String field restored through the string table");
+    auto* ship2 = restored.getEntity("bin_3");
+    assertTrue(ship2->getComponent<components::Ship>()->ship_name == "Rifter" &&
+               ship2->getComponent<components::Ship>()->max_locked_targets == 5,
+               "Mixed string and int fields restored");
+    assertTrue(ship2->getComponent<components::AI>()->behavior == components::AI::Behavior::Flee &&
+               ship2->getComponent<components::AI>()->target_entity_id == "bin_4",
+               "Enum field restored");
+    assertTrue(ship2->getComponent<components::Player>()->isk == 1234567.25, "Double field restored");
+    assertTrue(ship2->getComponent<components::Wreck>()->salvaged, "Bool field restored");
+    auto* sta2 = ship2->getComponent<components::Station>();
+    assertTrue(sta2 && sta2->docking_range == 5000.5f && sta2->repair_cost_per_hp == 2.5f &&
+               sta2->docked_count == 7, "Station docking and repair fields restored");
+    assertTrue(ship2->getComponent<components::Wreck>()->lifetime_remaining == 99.5f,
+               "Wreck lifetime restored");
+    auto* warp2 = ship2->getComponent<components::WarpProfile>();
+    assertTrue(warp2 && warp2->mass_norm == 0.625f && warp2->intensity == 0.375f,
+               "Warp profile mass and intensity restored");
+    assertTrue(ship2->getComponent<components::SystemLocation>()->system_id == "rimward",
+               "SystemLocation column restored");
+    auto* inv = ship2->getComponent<components::Inventory>();
+    assertTrue(inv && inv->items.size() == 1 && inv->items[0].quantity == 42,
+               "Nested component restored from the JSON section");
+    bool same = restored.getEntityCount() == world.getEntityCount();
+    for (auto* original : world.getAllEntities()) {
+        const auto* copy = restored.getEntity(original->getId());
+        same = same && copy &&
+               persistence.serializeEntity(copy) == persistence.serializeEntity(original);
+    }
+    assertTrue(same, "Every restored entity serializes like the original");
+
+    uint64_t seq = 0;
+    std::string image = binary.encodeWorld(&world, 17);
+    ecs::World from_image;
+    assertTrue(binary.decode(&from_image, image.data(), image.size(), &seq) && seq == 17,
+               "Journal sequence stored in the header");
+
+    // A journal over a binary base resumes from the header's sequence
+    const std::string base_path = "/tmp/eve_binary_journal.atlasb";
+    const std::string journal_path = "/tmp/eve_binary_journal.journal";
+    std::remove(base_path.c_str());
+    std::remove(journal_path.c_str());
+    data::WorldJournal journal(persistence, base_path, journal_path, data::SaveFormat::Binary);
+    journal.commit(*persistence.snapshotWorld(&world));
+    world.getEntity("bin_9")->getComponent<components::Position>()->x = -9.0f;
+    assertTrue(journal.commit(*persistence.snapshotWorld(&world)).upserts == 1,
+               "Journal appends changes over a binary base");
+    ecs::World journaled;
+    data::WorldJournal reader(persistence, base_path, journal_path, data::SaveFormat::Binary);
+    assertTrue(reader.load(&journaled) && journaled.getEntityCount() == 50, "Binary base and journal load");
+    assertTrue(approxEqual(journaled.getEntity("bin_9")->getComponent<components::Position>()->x, -9.0f),
+               "Journal replayed over the binary base");
+
+    std::remove(path.c_str());
+    std::remove(base_path.c_str());
+    std::remove(journal_path.c_str());
+}
+
+void testWorldBinaryFormatRejectsCorruptionAndConverts() {
+    std::cout << "\n=== World Binary Format: Corruption and Conversion ===" << std::endl;
+
+    ecs::World world;
+    for (int i = 0; i < 10; ++i) {
+        auto* e = world.createEntity("conv_" + std::to_string(i));
+        addComp<components::Position>(e)->y = static_cast<float>(i) * 2.0f;
+        addComp<components::Health>(e)->hull_hp = 100.0f + i;
+    }
+
+    data::WorldPersistence persistence;
+    data::WorldBinaryFormat binary(persistence);
+    std::string image = binary.encodeWorld(&world);
+
+    ecs::World truncated;
+    assertTrue(!binary.decode(&truncated, image.data(), image.size() - 5), "Truncated image rejected");
+    std::string flipped = image;
+    flipped[flipped.size() - 1] ^= 0x5A;      // inside the string table
+    ecs::World corrupt;
+    assertTrue(!binary.decode(&corrupt, flipped.data(), flipped.size()) &&
+               corrupt.getEntityCount() == 0,
+               "Corrupt image rejected before creating entities");
+    std::string newer = image;
+    newer[8] = static_cast<char>(data::WorldBinaryFormat::kVersion + 1);
+    ecs::World future;
+    assertTrue(!binary.decode(&future, newer.data(), newer.size()), "Newer version rejected");
+
+    const std::string json_path = "/tmp/eve_convert.json";
+    const std::string bin_path = "/tmp/eve_convert.atlasb";
+    const std::string back_path = "/tmp/eve_convert_back.json";
+    assertTrue(persistence.saveWorld(&world, json_path), "JSON save for conversion");
+    assertTrue(binary.convert(json_path, bin_path) && data::WorldBinaryFormat::isBinaryFile(bin_path),
+               "JSON converted to binary");
+    assertTrue(binary.convert(bin_path, back_path) && !data::WorldBinaryFormat::isBinaryFile(back_path),
+               "Binary converted back to JSON");
+    ecs::World converted;
+    assertTrue(persistence.loadWorld(&converted, back_path) && converted.getEntityCount() == 10,
+               "Converted save loads");
+    assertTrue(approxEqual(converted.getEntity("conv_4")->getComponent<components::Position>()->y, 8.0f) &&
+               approxEqual(converted.getEntity("conv_4")->getComponent<components::Health>()->hull_hp, 104.0f),
+               "Values survive the conversion round trip");
+
+    std::remove(json_path.c_str());
+    std::remove(bin_path.c_str());
+    std::remove(back_path.c_str());
+}
+
+void testTickRecordingRoundTrip() {
+    std::cout << "\n=== Tick Recording: Round Trip and Truncation ===" << std::endl;
+
+    const std::string path = "/tmp/eve_tick_recording.atlastr";
+    const std::string snapshot = "starting world image";
+
+    data::RecordedCommand move;
+    move.client.socket = 42;
+    move.client.address = "10.0.0.7";
+    move.client.port = 50123;
+    move.type = network::MessageType::INPUT_MOVE;
+    move.data = "{\"x\":1.5}";
+    data::RecordedCommand frame = move;
+    frame.kind = data::RecordedCommand::Kind::Frame;
+    frame.data = std::string("\x00\x01\xff binary", 10);
+    data::RecordedCommand leave;
+    leave.kind = data::RecordedCommand::Kind::Disconnect;
+    leave.client.socket = 43;
+
+    ecs::World::HandleLayout layout;
+    layout.generations = {3, 1, 2};
+    layout.free_slots = {0};
+    layout.entities = {{"ship_b", 2}, {"ship_a", 1}};
+
+    {
+        data::TickRecorder recorder;
+        assertTrue(recorder.open(path, snapshot, layout), "Recording opened");
+        recorder.beginTick(1, 1.0f / 30.0f);
+        recorder.recordCommand(move);
+        recorder.recordCommand(frame);
+        recorder.beginTick(2, 1.0f / 30.0f);      // no input this tick
+        recorder.beginTick(3, 2.0f / 30.0f);
+        recorder.recordCommand(leave);
+        recorder.close();
+        assertTrue(recorder.getTickCount() == 3 && recorder.getCommandCount() == 3,
+                   "Recorder counts ticks and commands");
+    }
+
+    data::TickRecordingReader reader;
+    assertTrue(reader.open(path) && reader.getSnapshot() == snapshot, "Snapshot read back");
+    const auto& got_layout = reader.getHandleLayout();
+    assertTrue(got_layout.generations == layout.generations && got_layout.free_slots == layout.free_slots &&
+               got_layout.entities.size() == 2 && got_layout.entities[0].id == "ship_b" &&
+               got_layout.entities[0].index == 2 && got_layout.entities[1].id == "ship_a",
+               "Handle table read back in creation order");
+    data::TickRecordingReader::Tick tick;
+    assertTrue(reader.next(tick) && tick.number == 1 && tick.commands.size() == 2,
+               "First tick carries its two commands");
+    const auto& got = tick.commands[0];
+    assertTrue(got.kind == data::RecordedCommand::Kind::Message &&
+               got.type == network::MessageType::INPUT_MOVE && got.data == move.data &&
+               got.client.socket == 42 && got.client.address == "10.0.0.7" &&
+               got.client.port == 50123,
+               "Message command round-trips");
+    assertTrue(tick.commands[1].kind == data::RecordedCommand::Kind::Frame &&
+               tick.commands[1].data == frame.data,
+               "Binary frame round-trips");
+    assertTrue(reader.next(tick) && tick.number == 2 && tick.commands.empty(), "Empty tick kept");
+    assertTrue(reader.next(tick) && tick.number == 3 && approxEqual(tick.delta, 2.0f / 30.0f) &&
+               tick.commands.size() == 1 &&
+               tick.commands[0].kind == data::RecordedCommand::Kind::Disconnect,
+               "Last tick and its delta read");
+    assertTrue(!reader.next(tick) && !reader.isTruncated(), "Clean end of recording");
+
+    // Cut the file inside the last command record, as a crash would
+    std::string bytes;
+    {
+        std::ifstream in(path, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(bytes.data(), static_cast<std::streamsize>(bytes.size() - 4));
+    }
+    data::TickRecordingReader torn;
+    assertTrue(torn.open(path), "Truncated recording opens");
+    int ticks = 0;
+    while (torn.next(tick)) ++ticks;
+    assertTrue(ticks == 3 && tick.commands.empty() && torn.isTruncated(),
+               "Torn command dropped, earlier ticks kept");
+
+    data::TickRecordingReader not_recording;
+    assertTrue(!not_recording.open("/tmp/eve_missing_recording.atlastr"), "Missing file rejected");
+    std::remove(path.c_str());
+}
+
 // ==================== Phase 2: Star System State System Tests ====================
 
 void testStarSystemStateInitialize() {
@@ -13063,6 +14016,1578 @@ void testNPCArchetypeIntentPatrolDefends() {
                "Patrol defends under moderate threat");
 }
 
+// ==================== ECS Component Storage Tests ====================
+
+void testComponentPoolPointerStability() {
+    std::cout << "\n=== Component Pool Pointer Stability ===" << std::endl;
+    ecs::World world;
+    auto* first = world.createEntity("first");
+    auto* pos = addComp<components::Position>(first);
+    pos->x = 42.0f;
+    for (int i = 0; i < 5000; ++i) {
+        addComp<components::Position>(world.createEntity("filler_" + std::to_string(i)));
+    }
+    assertTrue(first->getComponent<components::Position>() == pos, "Pointer stable after pool growth");
+    assertTrue(approxEqual(pos->x, 42.0f), "Component value preserved after pool growth");
+    assertTrue(world.getComponentCount<components::Position>() == 5001, "Pool counts all positions");
+}
+
+void testComponentPoolReplaceKeepsAddress() {
+    std::cout << "\n=== Component Pool Replace ===" << std::endl;
+    ecs::World world;
+    auto* e = world.createEntity("ship");
+    auto* hp = addComp<components::Health>(e);
+    auto replacement = std::make_unique<components::Health>();
+    replacement->hull_hp = 7.0f;
+    auto* stored = e->addComponent(std::move(replacement));
+    assertTrue(stored == hp, "Re-adding a component reuses its slot");
+    assertTrue(approxEqual(e->getComponent<components::Health>()->hull_hp, 7.0f), "Replacement value visible");
+    assertTrue(world.getComponentCount<components::Health>() == 1, "Replace does not grow the pool");
+}
+
+void testComponentPoolRemoveAndDestroy() {
+    std::cout << "\n=== Component Pool Remove/Destroy ===" << std::endl;
+    ecs::World world;
+    auto* a = world.createEntity("a");
+    auto* b = world.createEntity("b");
+    addComp<components::Velocity>(a);
+    addComp<components::Velocity>(b);
+    addComp<components::Health>(b);
+    a->removeComponent<components::Velocity>();
+    assertTrue(!a->hasComponent<components::Velocity>(), "Removed component no longer attached");
+    assertTrue(world.getComponentCount<components::Velocity>() == 1, "Remove releases pool slot");
+    world.destroyEntity("b");
+    assertTrue(world.getComponentCount<components::Velocity>() == 0, "Destroy releases velocity");
+    assertTrue(world.getComponentCount<components::Health>() == 0, "Destroy releases health");
+}
+
+void testWorldForEachVisitsPool() {
+    std::cout << "\n=== World forEach ===" << std::endl;
+    ecs::World world;
+    for (int i = 0; i < 10; ++i) {
+        auto* e = world.createEntity("e" + std::to_string(i));
+        auto* hp = addComp<components::Health>(e);
+        hp->shield_hp = static_cast<float>(i);
+    }
+    world.destroyEntity("e3");
+    int visited = 0;
+    float sum = 0.0f;
+    world.forEach<components::Health>([&](ecs::Entity* e, components::Health& hp) {
+        if (e->getComponent<components::Health>() == &hp) visited++;
+        sum += hp.shield_hp;
+    });
+    assertTrue(visited == 9, "forEach visits each live component with its owner");
+    assertTrue(approxEqual(sum, 42.0f), "forEach skips destroyed entity");
+}
+
+void testWorldViewTracksStructuralChanges() {
+    std::cout << "\n=== World View Incremental Updates ===" << std::endl;
+    ecs::World world;
+    auto* a = world.createEntity("a");
+    addComp<components::Position>(a);
+    const auto& movers = world.view<components::Position, components::Velocity>();
+    assertTrue(movers.size() == 0, "View starts empty when nothing matches");
+    addComp<components::Velocity>(a);
+    assertTrue(movers.size() == 1, "View picks up entity on addComponent");
+    auto* b = world.createEntity("b");
+    addComp<components::Velocity>(b);
+    addComp<components::Position>(b);
+    assertTrue(movers.size() == 2, "View picks up second entity");
+    a->removeComponent<components::Position>();
+    assertTrue(movers.size() == 1 && movers.entities()[0] == b, "View drops entity on removeComponent");
+    world.destroyEntity("b");
+    assertTrue(movers.empty(), "View drops destroyed entity");
+}
+
+void testWorldViewSharedAcrossOrderings() {
+    std::cout << "\n=== World View Sharing ===" << std::endl;
+    ecs::World world;
+    auto* e = world.createEntity("ship");
+    addComp<components::Position>(e);
+    addComp<components::Health>(e);
+    const auto& q1 = world.view<components::Position, components::Health>();
+    const auto& q2 = world.view<components::Health, components::Position>();
+    const auto& q3 = world.view<components::Position, components::Health>();
+    assertTrue(&q1 == &q2 && &q1 == &q3, "Same component set resolves to one query");
+    assertTrue(world.getQueryCount() == 1, "Only one query registered");
+    assertTrue(world.getEntities<components::Health, components::Position>().size() == 1,
+               "getEntities served from cached query");
+}
+
+void testWorldViewRecreatedEntity() {
+    std::cout << "\n=== World View Recreated Entity ===" << std::endl;
+    ecs::World world;
+    addComp<components::Weapon>(world.createEntity("gun"));
+    const auto& guns = world.view<components::Weapon>();
+    assertTrue(guns.size() == 1, "Weapon view has one entity");
+    auto* fresh = world.createEntity("gun");
+    assertTrue(guns.empty(), "Replaced entity leaves the view");
+    addComp<components::Weapon>(fresh);
+    assertTrue(guns.size() == 1 && guns.entities()[0] == fresh, "New entity joins the view");
+}
+
+void testEntityHandleLookup() {
+    std::cout << "\n=== Entity Handle Lookup ===" << std::endl;
+    ecs::World world;
+    auto* a = world.createEntity("alpha");
+    auto* b = world.createEntity("beta");
+    ecs::EntityHandle ha = a->getHandle();
+    assertTrue(ha.isValid() && b->getHandle().isValid(), "Created entities get valid handles");
+    assertTrue(ha != b->getHandle(), "Handles are distinct");
+    assertTrue(world.getEntity(ha) == a, "Handle resolves to entity");
+    assertTrue(world.getHandle("beta") == b->getHandle(), "String ID maps to handle");
+    assertTrue(!world.getHandle("missing").isValid(), "Unknown ID maps to invalid handle");
+    assertTrue(world.getEntity(ecs::EntityHandle{}) == nullptr, "Default handle resolves to nullptr");
+}
+
+void testEntityHandleStaleAfterDestroy() {
+    std::cout << "\n=== Entity Handle Stale Detection ===" << std::endl;
+    ecs::World world;
+    ecs::EntityHandle old_handle = world.createEntity("victim")->getHandle();
+    world.destroyEntity("victim");
+    assertTrue(!world.isAlive(old_handle), "Handle is stale after destroy");
+    auto* reuse = world.createEntity("newcomer");
+    assertTrue(reuse->getHandle().index == old_handle.index, "Freed slot is reused");
+    assertTrue(world.getEntity(old_handle) == nullptr, "Stale handle does not resolve to new occupant");
+    ecs::EntityHandle first_newcomer = reuse->getHandle();
+    auto* again = world.createEntity("newcomer");
+    assertTrue(!world.isAlive(first_newcomer), "Recreating an ID invalidates the previous handle");
+    assertTrue(world.getEntity(again->getHandle()) == again, "Recreated entity resolves");
+}
+
+void testAIResolveTargetCachesHandle() {
+    std::cout << "\n=== AI Target Handle Cache ===" << std::endl;
+    ecs::World world;
+    auto* npc = world.createEntity("npc");
+    auto* ai = addComp<components::AI>(npc);
+    auto* t1 = world.createEntity("t1");
+    ai->target_entity_id = "t1";
+    assertTrue(systems::AISystem::resolveTarget(&world, *ai) == t1, "Resolves target by ID");
+    assertTrue(ai->target_handle == t1->getHandle(), "Caches target handle");
+    world.destroyEntity("t1");
+    assertTrue(systems::AISystem::resolveTarget(&world, *ai) == nullptr, "Destroyed target resolves to nullptr");
+    auto* t2 = world.createEntity("t2");
+    ai->target_entity_id = "t2";
+    assertTrue(systems::AISystem::resolveTarget(&world, *ai) == t2, "Changed ID refreshes cache");
+}
+
+// ==================== ECS Parallel Scheduler Tests ====================
+
+namespace {
+// Minimal system with caller-declared access, for scheduler tests
+class AccessTestSystem : public ecs::System {
+public:
+    AccessTestSystem(ecs::World* world, const std::string& name) : System(world), name_(name) {}
+    template<typename T> void declareRead() { reads<T>(); }
+    template<typename T> void declareWrite() { writes<T>(); }
+    void update(float) override { ++updates; }
+    std::string getName() const override { return name_; }
+    int updates = 0;
+private:
+    std::string name_;
+};
+} // namespace
+
+void testSchedulerConflictRules() {
+    std::cout << "\n=== Scheduler Conflict Rules ===" << std::endl;
+    ecs::World world;
+    AccessTestSystem read_health(&world, "r"), write_health(&world, "w"),
+                     write_cap(&world, "c"), undeclared(&world, "u");
+    read_health.declareRead<components::Health>();
+    write_health.declareWrite<components::Health>();
+    write_cap.declareWrite<components::Capacitor>();
+    using S = ecs::SystemScheduler;
+    assertTrue(!S::conflicts(read_health.getAccess(), read_health.getAccess()), "Two readers do not conflict");
+    assertTrue(S::conflicts(read_health.getAccess(), write_health.getAccess()), "Reader and writer conflict");
+    assertTrue(S::conflicts(write_health.getAccess(), write_health.getAccess()), "Two writers conflict");
+    assertTrue(!S::conflicts(write_health.getAccess(), write_cap.getAccess()), "Disjoint writers do not conflict");
+    assertTrue(S::conflicts(undeclared.getAccess(), write_cap.getAccess()), "Undeclared system is exclusive");
+}
+
+void testSchedulerBuildsServerGraph() {
+    std::cout << "\n=== Scheduler Server System Graph ===" << std::endl;
+    ecs::World world;
+    systems::CapacitorSystem cap(&world);
+    systems::ShieldRechargeSystem shield(&world);
+    systems::TargetingSystem targeting(&world);
+    systems::MovementSystem movement(&world);
+    systems::WeaponSystem weapon(&world);
+    ecs::SystemScheduler scheduler;
+    scheduler.build({&cap, &shield, &targeting, &movement, &weapon});
+    const auto& deps = scheduler.getDependencies();
+    assertTrue(deps[0].empty() && deps[1].empty() && deps[2].empty() && deps[3].empty(),
+               "Capacitor, Shield, Targeting and Movement are independent");
+    assertTrue(deps[4].size() == 3, "WeaponSystem waits only for systems sharing its components");
+    assertTrue(scheduler.getCriticalPathLength() == 2, "Critical path is two systems long");
+}
+
+void testSchedulerRunsIndustrySystemsInParallel() {
+    std::cout << "\n=== Scheduler Industry Systems In Parallel ===" << std::endl;
+    ecs::World world;
+    systems::PISystem pi(&world);
+    systems::ManufacturingSystem manufacturing(&world);
+    systems::ResearchSystem research(&world);
+    systems::MarketSystem market(&world);
+    systems::AISystem ai(&world);
+    ecs::SystemScheduler scheduler;
+    scheduler.build({&pi, &manufacturing, &research, &market, &ai});
+    const auto& deps = scheduler.getDependencies();
+    assertTrue(deps[0].empty() && deps[1].empty() && deps[2].empty() && deps[3].empty(),
+               "PI, Manufacturing, Research and Market are independent");
+    assertTrue(deps[4].size() == 1 && deps[4][0] == 3, "AISystem waits for Market's Player writes only");
+    assertTrue(scheduler.getCriticalPathLength() == 2, "Critical path is two systems long");
+
+    // Each owns its timer wheel, so a parallel tick completes the same work
+    auto populate = [](ecs::World& w) {
+        for (int i = 0; i < 50; ++i) {
+            auto* station = w.createEntity("ind_" + std::to_string(i));
+            auto* facility = addComp<components::ManufacturingFacility>(station);
+            components::ManufacturingFacility::ManufacturingJob job;
+            job.job_id = "job_" + std::to_string(i);
+            job.runs = 1 + i % 3;
+            job.time_per_run = 1.0f + static_cast<float>(i % 4);
+            job.time_remaining = job.time_per_run;
+            job.status = "active";
+            facility->jobs.push_back(job);
+            addComp<components::ResearchLab>(station);
+            addComp<components::PlanetaryColony>(station);
+            addComp<components::MarketHub>(station);
+        }
+        w.addSystem(std::make_unique<systems::PISystem>(&w));
+        w.addSystem(std::make_unique<systems::ManufacturingSystem>(&w));
+        w.addSystem(std::make_unique<systems::ResearchSystem>(&w));
+        w.addSystem(std::make_unique<systems::MarketSystem>(&w));
+    };
+    ecs::World sequential, parallel;
+    populate(sequential);
+    populate(parallel);
+    parallel.setWorkerThreads(4);
+    for (int tick = 0; tick < 60; ++tick) {
+        sequential.update(0.25f);
+        parallel.update(0.25f);
+    }
+    bool same = true;
+    for (int i = 0; i < 50; ++i) {
+        std::string id = "ind_" + std::to_string(i);
+        const auto& a = sequential.getEntity(id)->getComponent<components::ManufacturingFacility>()->jobs[0];
+        const auto& b = parallel.getEntity(id)->getComponent<components::ManufacturingFacility>()->jobs[0];
+        same = same && a.status == "completed" && a.status == b.status && a.runs_completed == b.runs_completed;
+    }
+    assertTrue(same, "Parallel industry tick completes the same jobs");
+}
+
+void testSchedulerParallelMatchesSequential() {
+    std::cout << "\n=== Scheduler Parallel Matches Sequential ===" << std::endl;
+    auto populate = [](ecs::World& world) {
+        for (int i = 0; i < 200; ++i) {
+            auto* e = world.createEntity("e" + std::to_string(i));
+            auto* hp = addComp<components::Health>(e);
+            hp->shield_hp = 0.0f;
+            hp->shield_max = 1000.0f;
+            hp->shield_recharge_rate = static_cast<float>(i % 7);
+            auto* cap = addComp<components::Capacitor>(e);
+            cap->capacitor = 0.0f;
+            cap->capacitor_max = 1000.0f;
+            cap->recharge_rate = static_cast<float>(i % 5);
+            addComp<components::Position>(e);
+            auto* vel = addComp<components::Velocity>(e);
+            vel->vx = static_cast<float>(i);
+            vel->max_speed = 1000.0f;
+        }
+        world.addSystem(std::make_unique<systems::CapacitorSystem>(&world));
+        world.addSystem(std::make_unique<systems::ShieldRechargeSystem>(&world));
+        world.addSystem(std::make_unique<systems::MovementSystem>(&world));
+    };
+    ecs::World sequential, parallel;
+    populate(sequential);
+    populate(parallel);
+    parallel.setWorkerThreads(2);
+    assertTrue(parallel.getWorkerThreads() == 2, "World owns two scheduler workers");
+    for (int tick = 0; tick < 10; ++tick) {
+        sequential.update(0.1f);
+        parallel.update(0.1f);
+    }
+    bool same = true;
+    for (int i = 0; i < 200; ++i) {
+        std::string id = "e" + std::to_string(i);
+        auto* a = sequential.getEntity(id);
+        auto* b = parallel.getEntity(id);
+        same = same
+            && a->getComponent<components::Health>()->shield_hp == b->getComponent<components::Health>()->shield_hp
+            && a->getComponent<components::Capacitor>()->capacitor == b->getComponent<components::Capacitor>()->capacitor
+            && a->getComponent<components::Position>()->x == b->getComponent<components::Position>()->x;
+    }
+    assertTrue(same, "Parallel tick produces the sequential result");
+    const auto& timings = parallel.getSystemTimings();
+    assertTrue(timings.size() == 3 && timings[0].runs == 10, "Per-system timings recorded each tick");
+    assertTrue(timings[2].name == "MovementSystem", "Timings carry system names");
+}
+
+void testTaskGroupRunsAndPropagates() {
+    std::cout << "\n=== ThreadPool TaskGroup ===" << std::endl;
+    utils::ThreadPool pool(3);
+    std::atomic<int> sum{0};
+    {
+        utils::TaskGroup group(&pool);
+        for (int i = 1; i <= 100; ++i) {
+            group.run([&sum, i] { sum += i; });
+        }
+        group.wait();
+    }
+    assertTrue(sum.load() == 5050, "TaskGroup runs every task");
+    bool caught = false;
+    utils::TaskGroup failing(&pool);
+    failing.run([] { throw std::runtime_error("boom"); });
+    try {
+        failing.wait();
+    } catch (const std::runtime_error&) {
+        caught = true;
+    }
+    assertTrue(caught, "Task exception is rethrown from wait()");
+}
+
+// ==================== ECS Parallel For / Command Buffer Tests ====================
+
+namespace {
+// Runs a callback from update(), for exercising deferred structural changes
+class CallbackTestSystem : public ecs::System {
+public:
+    CallbackTestSystem(ecs::World* world, std::function<void(ecs::World*)> fn)
+        : System(world), fn_(std::move(fn)) {}
+    void update(float) override { fn_(world_); }
+    std::string getName() const override { return "CallbackTestSystem"; }
+private:
+    std::function<void(ecs::World*)> fn_;
+};
+} // namespace
+
+void testParallelForEachVisitsAll() {
+    std::cout << "\n=== ECS parallelForEach ===" << std::endl;
+    ecs::World world;
+    world.setWorkerThreads(3);
+    const int count = 5000;  // spans many pool pages
+    for (int i = 0; i < count; ++i) {
+        auto* vel = addComp<components::Velocity>(world.createEntity("p" + std::to_string(i)));
+        vel->vx = 1.0f;
+    }
+    world.destroyEntity("p17");  // leave a hole in the pool
+    std::atomic<int> visited{0};
+    world.parallelForEach<components::Velocity>([&visited](ecs::Entity*, components::Velocity& vel) {
+        vel.vx += 1.0f;
+        ++visited;
+    });
+    assertTrue(visited.load() == count - 1, "Every live component visited once");
+    bool all_updated = true;
+    world.forEach<components::Velocity>([&all_updated](ecs::Entity*, components::Velocity& vel) {
+        all_updated = all_updated && vel.vx == 2.0f;
+    });
+    assertTrue(all_updated, "Chunks cover the whole pool without overlap");
+}
+
+void testCommandBufferDefersDuringUpdate() {
+    std::cout << "\n=== ECS Deferred Command Buffer ===" << std::endl;
+    ecs::World world;
+    world.createEntity("ship");
+    bool present_during_update = true;
+    world.addSystem(std::make_unique<CallbackTestSystem>(&world, [&](ecs::World* w) {
+        w->defer([](ecs::World& target) {
+            addComp<components::Weapon>(target.getEntity("ship"));
+        });
+        present_during_update = w->getEntity("ship")->hasComponent<components::Weapon>();
+    }));
+    world.update(0.1f);
+    assertTrue(!present_during_update, "Structural change deferred while systems run");
+    assertTrue(world.getEntity("ship")->hasComponent<components::Weapon>(), "Change applied at end of tick");
+    assertTrue(world.getCommandBuffer().empty(), "Command buffer drained");
+    world.defer([](ecs::World& target) { target.destroyEntity("ship"); });
+    assertTrue(world.getEntity("ship") == nullptr, "defer() outside update runs immediately");
+}
+
+void testWorldRestoresHandleLayout() {
+    std::cout << "\n=== ECS Handle Layout Restore ===" << std::endl;
+    ecs::World original;
+    for (const char* id : {"a", "b", "c", "d"}) {
+        addComp<components::Position>(original.createEntity(id));
+    }
+    original.destroyEntity("b");
+    addComp<components::Velocity>(original.createEntity("e"));      // reuses b's slot
+    addComp<components::Position>(original.getEntity("e"));
+    original.destroyEntity("a");                                      // stays free
+    original.canonicalize();
+    auto layout = original.getHandleLayout();
+    assertTrue(layout.entities.size() == 3 && layout.entities[2].id == "e" &&
+               layout.free_slots.size() == 1, "Layout lists live entities in creation order");
+
+    // Same entities created in another order
+    ecs::World copy;
+    for (const char* id : {"e", "d", "c"}) {
+        addComp<components::Position>(copy.createEntity(id));
+    }
+    addComp<components::Velocity>(copy.getEntity("e"));
+    const ecs::Query& before = copy.view<components::Position>();
+    assertTrue(copy.restoreHandleLayout(layout), "Layout restored");
+    bool same_handles = true;
+    for (const char* id : {"c", "d", "e"}) {
+        same_handles = same_handles && copy.getHandle(id) == original.getHandle(id);
+    }
+    assertTrue(same_handles, "Every entity gets its recorded handle");
+    assertTrue(copy.createEntity("f")->getHandle() == original.createEntity("f")->getHandle(),
+               "Next spawn reuses the same freed slot");
+
+    std::vector<std::string> query_order, pool_order, original_order;
+    for (auto* entity : before) query_order.push_back(entity->getId());
+    copy.forEach<components::Position>([&](ecs::Entity* entity, components::Position&) {
+        pool_order.push_back(entity->getId());
+    });
+    original.forEach<components::Position>([&](ecs::Entity* entity, components::Position&) {
+        original_order.push_back(entity->getId());
+    });
+    assertTrue(query_order == std::vector<std::string>({"c", "d", "e"}), "Existing query rebuilt in creation order");
+    assertTrue(pool_order == original_order, "Pools packed in the recorded creation order");
+    assertTrue(copy.getEntity("e")->getComponent<components::Velocity>() != nullptr,
+               "Components follow their entity through the repack");
+
+    ecs::World mismatched;
+    mismatched.createEntity("c");
+    assertTrue(!mismatched.restoreHandleLayout(layout), "Layout for other entities rejected");
+}
+
+void testTimerWheelFiresOnDueTick() {
+    std::cout << "\n=== ECS Timer Wheel ===" << std::endl;
+    ecs::TimerWheel wheel(10.0);
+    std::vector<uint64_t> fired;
+    auto record = [&fired](ecs::TimerWheel::TimerId, uint64_t key) { fired.push_back(key); };
+
+    // Due times spread over several wheel levels (64, 4096, 262144 ticks)
+    wheel.scheduleAfter(0.5, 1);
+    wheel.scheduleAfter(30.0, 2);
+    wheel.scheduleAfter(1000.0, 3);
+    auto far = wheel.scheduleAfter(50000.0, 4);
+    auto cancelled = wheel.scheduleAfter(20.0, 5);
+    assertTrue(wheel.size() == 5, "Five timers pending");
+    assertTrue(wheel.cancel(cancelled) && !wheel.cancel(cancelled), "Cancel succeeds once");
+
+    wheel.advance(0.4, record);
+    assertTrue(fired.empty(), "Nothing due before 0.5s");
+    wheel.advance(0.1, record);
+    assertTrue(fired.size() == 1 && fired[0] == 1, "Timer fires on its due tick");
+    wheel.advance(29.4, record);
+    assertTrue(fired.size() == 1, "30s timer waits through a cascade");
+    wheel.advance(0.1, record);
+    assertTrue(fired.size() == 2 && fired[1] == 2, "30s timer fires at 30s");
+
+    // One large step fires whatever comes due within it
+    wheel.advance(2000.0, [&](ecs::TimerWheel::TimerId, uint64_t key) {
+        fired.push_back(key);
+        if (key == 3) wheel.scheduleAfter(10.0, 6);  // rescheduled from a callback
+    });
+    assertTrue(fired.size() == 3 && fired[2] == 3, "1000s timer fires in a large step");
+    assertTrue(wheel.isPending(far) && wheel.size() == 2, "Far and rescheduled timers still pending");
+    assertTrue(wheel.getTick() == wheel.tickAt(2030.0), "Cursor lands on the target tick");
+    wheel.advance(10.0, record);
+    assertTrue(fired.size() == 4 && fired[3] == 6, "Timer scheduled during advance fires after it");
+    wheel.advance(50000.0, record);
+    assertTrue(fired.size() == 5 && fired[4] == 4 && wheel.empty(), "Far timer fires after cascading down");
+
+    // A deadline already passed is due on the next tick, never the current one
+    wheel.schedule(0, 7);
+    wheel.advance(0.0, record);
+    assertTrue(fired.size() == 5, "Past deadline does not fire without time passing");
+    wheel.advance(0.1, record);
+    assertTrue(fired.size() == 6 && fired[5] == 7, "Past deadline fires on the next tick");
+}
+
+void testTimedComponentsVisitOnlyWhenDue() {
+    std::cout << "\n=== ECS Timed Components (Manufacturing) ===" << std::endl;
+    ecs::World world;
+    systems::ManufacturingSystem mfgSys(&world);
+    auto& wheel = world.getTimerWheel(mfgSys.getName());
+
+    for (int i = 0; i < 100; ++i) {
+        auto* station = world.createEntity("idle_fac_" + std::to_string(i));
+        addComp<components::ManufacturingFacility>(station)->max_jobs = 2;
+    }
+    mfgSys.update(1.0f);
+    assertTrue(wheel.empty(), "Facilities without jobs schedule nothing");
+
+    mfgSys.startJob("idle_fac_0", "nobody", "bp", "out", "Out", 1, 100.0f, 0.0);
+    assertTrue(wheel.size() == 1, "Starting a job schedules one timer");
+    mfgSys.update(60.0f);
+
+    // A job started mid-way does not inherit time from the running one
+    mfgSys.startJob("idle_fac_0", "nobody", "bp", "out", "Out", 1, 10.0f, 0.0);
+    assertTrue(wheel.size() == 1, "Still one timer per facility");
+    mfgSys.update(10.0f);
+    assertTrue(mfgSys.getCompletedJobCount("idle_fac_0") == 1, "Short job completes after its own 10s");
+    assertTrue(mfgSys.getActiveJobCount("idle_fac_0") == 1, "Long job still running");
+    mfgSys.update(29.0f);
+    assertTrue(mfgSys.getActiveJobCount("idle_fac_0") == 1, "Long job not done at 99s");
+    mfgSys.update(1.0f);
+    assertTrue(mfgSys.getCompletedJobCount("idle_fac_0") == 2, "Long job completes at 100s");
+    assertTrue(wheel.empty(), "No timers left once every job is done");
+
+    // Components configured directly are picked up on the next update
+    auto* late = world.createEntity("late_fac");
+    auto* facility = addComp<components::ManufacturingFacility>(late);
+    components::ManufacturingFacility::ManufacturingJob job;
+    job.job_id = "restored";
+    job.runs = 2;
+    job.time_per_run = 5.0f;
+    job.time_remaining = 2.0f;
+    job.status = "active";
+    facility->jobs.push_back(job);
+    mfgSys.update(2.0f);
+    assertTrue(mfgSys.getTotalRunsCompleted("late_fac") == 1, "Restored job resumes with its remaining time");
+    world.destroyEntity("late_fac");
+    mfgSys.update(5.0f);
+    assertTrue(wheel.empty(), "Destroyed facility's timer is dropped");
+
+    // Replacing an idle facility in place (same address) starts tracking over
+    auto replacement = std::make_unique<components::ManufacturingFacility>();
+    replacement->max_jobs = 2;
+    job.job_id = "replaced";
+    job.runs = 1;
+    job.time_per_run = 5.0f;
+    job.time_remaining = 5.0f;
+    replacement->jobs.push_back(job);
+    ecs::Entity* idle = world.getEntity("idle_fac_1");
+    auto* before = idle->getComponent<components::ManufacturingFacility>();
+    assertTrue(idle->addComponent(std::move(replacement)) == before, "Replacement reuses the component's storage");
+    mfgSys.update(5.0f);
+    assertTrue(mfgSys.getCompletedJobCount("idle_fac_1") == 1, "Job on a replaced idle facility completes");
+
+    // Removing and re-adding within one tick gets the same slot back
+    ecs::Entity* readded = world.getEntity("idle_fac_2");
+    readded->removeComponent<components::ManufacturingFacility>();
+    auto* fresh = addComp<components::ManufacturingFacility>(readded);
+    job.job_id = "readded";
+    fresh->jobs.push_back(job);
+    mfgSys.update(5.0f);
+    assertTrue(mfgSys.getCompletedJobCount("idle_fac_2") == 1, "Job on a re-added facility completes");
+}
+
+void testCombatDamageEventDeferredInTick() {
+    std::cout << "\n=== Combat DamageEvent Deferred In Tick ===" << std::endl;
+    ecs::World world;
+    systems::CombatSystem combat(&world);
+    auto* target = world.createEntity("target");
+    auto* hp = addComp<components::Health>(target);
+    hp->shield_hp = 1000.0f;
+    hp->shield_max = 1000.0f;
+    bool created_mid_tick = true;
+    world.addSystem(std::make_unique<CallbackTestSystem>(&world, [&](ecs::World* w) {
+        combat.applyDamage("target", 10.0f, "kinetic");
+        combat.applyDamage("target", 20.0f, "kinetic");
+        created_mid_tick = w->getEntity("target")->hasComponent<components::DamageEvent>();
+    }));
+    world.update(0.1f);
+    auto* dmg = target->getComponent<components::DamageEvent>();
+    assertTrue(!created_mid_tick, "DamageEvent creation deferred during tick");
+    assertTrue(dmg != nullptr && dmg->recent_hits.size() == 2, "Both hits recorded at sync point");
+    assertTrue(approxEqual(hp->shield_hp, 970.0f), "Damage itself applied immediately");
+}
+
+// ==================== Spatial Index Tests ====================
+
+namespace {
+ecs::Entity* placeAt(ecs::World& world, const std::string& id, float x, float y, float z) {
+    auto* e = world.createEntity(id);
+    auto* pos = addComp<components::Position>(e);
+    pos->x = x;
+    pos->y = y;
+    pos->z = z;
+    return e;
+}
+} // namespace
+
+void testSpatialIndexQueriesMatchBruteForce() {
+    std::cout << "\n=== Spatial Index Queries ===" << std::endl;
+    ecs::World world;
+    for (int i = 0; i < 500; ++i) {
+        // Deterministic scatter over a 300 km cube, including negative cells
+        float x = static_cast<float>((i * 7919) % 300000) - 150000.0f;
+        float y = static_cast<float>((i * 104729) % 300000) - 150000.0f;
+        float z = static_cast<float>((i * 15485863LL) % 300000) - 150000.0f;
+        placeAt(world, "s" + std::to_string(i), x, y, z);
+    }
+    systems::SpatialIndexSystem index(&world, 25000.0f);
+    index.update(0.0f);
+    assertTrue(index.getIndexedCount() == 500, "All positioned entities indexed");
+
+    auto distTo = [](ecs::Entity* e, float x, float y, float z) {
+        auto* p = e->getComponent<components::Position>();
+        return std::sqrt((p->x - x) * (p->x - x) + (p->y - y) * (p->y - y) + (p->z - z) * (p->z - z));
+    };
+    size_t expected = 0;
+    for (auto* e : world.view<components::Position>()) {
+        if (distTo(e, 1000.0f, -2000.0f, 500.0f) <= 60000.0f) ++expected;
+    }
+    std::vector<ecs::Entity*> found;
+    index.queryRadius(1000.0f, -2000.0f, 500.0f, 60000.0f, found);
+    assertTrue(found.size() == expected && expected > 0, "Radius query matches brute force");
+
+    found.clear();
+    index.queryAABB(-50000.0f, -50000.0f, -50000.0f, 50000.0f, 50000.0f, 50000.0f, found);
+    bool inside = !found.empty();
+    for (auto* e : found) {
+        auto* p = e->getComponent<components::Position>();
+        inside = inside && std::fabs(p->x) <= 50000.0f && std::fabs(p->y) <= 50000.0f && std::fabs(p->z) <= 50000.0f;
+    }
+    assertTrue(inside, "AABB query returns only entities inside the box");
+
+    auto nearest = index.queryNearest(0.0f, 0.0f, 0.0f, 5, 1e9f);
+    bool sorted = nearest.size() == 5;
+    float kth = nearest.empty() ? 0.0f : distTo(nearest.back(), 0.0f, 0.0f, 0.0f);
+    size_t closer = 0;
+    for (auto* e : world.view<components::Position>()) {
+        if (distTo(e, 0.0f, 0.0f, 0.0f) < kth) ++closer;
+    }
+    for (size_t i = 1; i < nearest.size(); ++i) {
+        sorted = sorted && distTo(nearest[i - 1], 0, 0, 0) <= distTo(nearest[i], 0, 0, 0);
+    }
+    assertTrue(sorted && closer == 4, "k-nearest returns the k closest, closest first");
+}
+
+void testSpatialIndexIncrementalUpdate() {
+    std::cout << "\n=== Spatial Index Incremental Update ===" << std::endl;
+    ecs::World world;
+    auto* mover = placeAt(world, "mover", 0.0f, 0.0f, 0.0f);
+    placeAt(world, "static", 100.0f, 0.0f, 0.0f);
+    systems::SpatialIndexSystem index(&world, 10000.0f);
+    index.update(0.0f);
+
+    mover->getComponent<components::Position>()->x = 5000.0f;
+    index.update(0.0f);
+    assertTrue(index.getLastCellChanges() == 0, "Movement within a cell does not rebucket");
+
+    mover->getComponent<components::Position>()->x = 95000.0f;
+    index.update(0.0f);
+    assertTrue(index.getLastCellChanges() == 1, "Crossing a cell boundary moves one entry");
+    std::vector<ecs::Entity*> found;
+    index.queryRadius(95000.0f, 0.0f, 0.0f, 1000.0f, found);
+    assertTrue(found.size() == 1 && found[0] == mover, "Moved entity found at new position");
+
+    world.destroyEntity("static");
+    index.update(0.0f);
+    found.clear();
+    index.queryRadius(0.0f, 0.0f, 0.0f, 1000.0f, found);
+    assertTrue(found.empty() && index.getIndexedCount() == 1, "Destroyed entity dropped from index");
+}
+
+void testAISpatialIndexSameTarget() {
+    std::cout << "\n=== AI Targeting Via Spatial Index ===" << std::endl;
+    ecs::World world;
+    auto* npc = placeAt(world, "npc", 0.0f, 0.0f, 0.0f);
+    auto* ai = addComp<components::AI>(npc);
+    ai->behavior = components::AI::Behavior::Aggressive;
+    ai->awareness_range = 50000.0f;
+    placeAt(world, "far_player", 40000.0f, 0.0f, 0.0f);
+    addComp<components::Player>(world.getEntity("far_player"));
+    placeAt(world, "near_player", 0.0f, 12000.0f, 0.0f);
+    addComp<components::Player>(world.getEntity("near_player"));
+    placeAt(world, "out_of_range", 80000.0f, 0.0f, 0.0f);
+    addComp<components::Player>(world.getEntity("out_of_range"));
+    placeAt(world, "deposit", -3000.0f, 0.0f, 0.0f);
+
+    systems::AISystem ai_sys(&world);
+    ecs::Entity* scanned = ai_sys.selectTarget(npc);
+    systems::SpatialIndexSystem index(&world);
+    index.refresh();
+    ai_sys.setSpatialIndex(&index);
+    ecs::Entity* indexed = ai_sys.selectTarget(npc);
+    assertTrue(scanned != nullptr && scanned->getId() == "near_player", "Brute-force scan picks closest player");
+    assertTrue(indexed == scanned, "Indexed search picks the same target");
+
+    addComp<components::MineralDeposit>(world.getEntity("deposit"));
+    assertTrue(ai_sys.findNearestDeposit(npc) == world.getEntity("deposit"), "Deposit found via index");
+}
+
+void testAIThinkScheduling() {
+    std::cout << "\n=== AI Think Scheduling ===" << std::endl;
+    ecs::World world;
+    auto addNpc = [&world](const std::string& id, float x, components::AI::Behavior behavior) {
+        auto* npc = placeAt(world, id, x, 0.0f, 0.0f);
+        addComp<components::Velocity>(npc);
+        addComp<components::AI>(npc)->behavior = behavior;
+        return npc;
+    };
+    addComp<components::Player>(placeAt(world, "player", 0.0f, 0.0f, 0.0f));
+    auto* hunter = addNpc("hunter", 5000.0f, components::AI::Behavior::Aggressive);
+    auto* watched = addNpc("watched", 900000.0f, components::AI::Behavior::Passive);
+    addComp<components::LODPriority>(watched)->priority = 1.5f;
+    for (int i = 0; i < 8; ++i) {
+        addNpc("far_" + std::to_string(i), 1000000.0f + i * 1000.0f, components::AI::Behavior::Passive);
+    }
+
+    systems::AISystem ai_sys(&world);
+    systems::AISystem::ThinkSettings settings;
+    settings.near_range = 20000.0f;
+    settings.think_interval = 4;
+    ai_sys.setThinkSettings(settings);
+
+    bool spread = true;
+    for (int tick = 0; tick < 4; ++tick) {
+        ai_sys.update(1.0f / 30.0f);
+        spread = spread && ai_sys.getLastThinkCount() == 4;
+    }
+    assertTrue(hunter->getComponent<components::AI>()->state == components::AI::State::Approaching,
+               "NPC near a player picks its target on the first tick");
+    assertTrue(spread, "Distant idle NPCs take turns, two of eight per tick");
+    assertTrue(ai_sys.getDeferredCount() == 0, "Nothing deferred without a budget");
+
+    // A budget below one pass leaves turns for later ticks
+    ecs::World crowded;
+    for (int i = 0; i < 500; ++i) {
+        auto* npc = crowded.createEntity("npc_" + std::to_string(i));
+        addComp<components::Position>(npc)->x = i * 1000.0f;
+        addComp<components::Velocity>(npc);
+        addComp<components::AI>(npc)->behavior = components::AI::Behavior::Passive;
+    }
+    systems::AISystem busy(&crowded);
+    settings.think_interval = 1;
+    settings.budget_turns = 120;
+    busy.setThinkSettings(settings);
+    busy.update(1.0f / 30.0f);
+    assertTrue(busy.getLastThinkCount() == 120,
+               "Budget stops turns after exactly budget_turns thinks");
+    assertTrue(busy.getLastThinkCount() + busy.getDeferredCount() == 500,
+               "NPCs that missed their turn are queued");
+
+    settings.budget_turns = 1000;
+    busy.setThinkSettings(settings);
+    busy.update(1.0f / 30.0f);
+    assertTrue(busy.getLastThinkCount() == 500 && busy.getDeferredCount() == 0,
+               "Queue drains once the budget allows, each NPC thinking once");
+}
+
+void testLODCullingWithSpatialIndex() {
+    std::cout << "\n=== LOD Culling Via Spatial Index ===" << std::endl;
+    ecs::World world;
+    for (int i = 0; i < 20; ++i) {
+        auto* e = placeAt(world, "l" + std::to_string(i), i * 5000.0f, 0.0f, 0.0f);
+        addComp<components::LODPriority>(e);
+    }
+    world.getEntity("l19")->getComponent<components::LODPriority>()->force_visible = true;
+    LODCullingSystem::updatePriorities(&world, 0.0f, 0.0f, 0.0f, 50000.0f);
+    std::vector<float> expected;
+    for (int i = 0; i < 20; ++i) {
+        expected.push_back(world.getEntity("l" + std::to_string(i))->getComponent<components::LODPriority>()->priority);
+    }
+    systems::SpatialIndexSystem index(&world);
+    index.refresh();
+    LODCullingSystem::updatePriorities(&world, index, 0.0f, 0.0f, 0.0f, 50000.0f);
+    bool same = true;
+    for (int i = 0; i < 20; ++i) {
+        same = same && approxEqual(world.getEntity("l" + std::to_string(i))->getComponent<components::LODPriority>()->priority, expected[i]);
+    }
+    assertTrue(same, "Indexed LOD priorities match full scan");
+    assertTrue(LODCullingSystem::getCulledCount(&world) == 9, "Entities beyond cull distance culled");
+}
+
+// ==================== Interest Management Tests ====================
+
+namespace {
+bool snapshotHas(const network::InterestManager::Snapshot& snap, const std::string& id) {
+    for (const auto* e : snap.entities) {
+        if (e->getId() == id) return true;
+    }
+    return false;
+}
+
+bool snapshotRemoves(const network::InterestManager::Snapshot& snap, const std::string& id) {
+    return std::find(snap.removed.begin(), snap.removed.end(), id) != snap.removed.end();
+}
+} // namespace
+
+void testInterestNearEveryTickFarOnInterval() {
+    std::cout << "\n=== Interest Near/Far Tiers ===" << std::endl;
+    ecs::World world;
+    placeAt(world, "me", 0.0f, 0.0f, 0.0f);
+    placeAt(world, "near", 10000.0f, 0.0f, 0.0f);
+    placeAt(world, "far", 500000.0f, 0.0f, 0.0f);
+    placeAt(world, "beyond", 5000000.0f, 0.0f, 0.0f);
+    network::InterestManager interest(&world);
+    network::InterestManager::Settings settings;
+    settings.far_interval = 4;
+    interest.setSettings(settings);
+    network::InterestManager::ClientState state;
+    network::InterestManager::Snapshot snap;
+
+    interest.collect("me", state, snap);
+    assertTrue(snap.full, "First update is a full refresh");
+    assertTrue(snapshotHas(snap, "me") && snapshotHas(snap, "near") && snapshotHas(snap, "far"),
+               "Full update covers own ship, near and far entities");
+    assertTrue(!snapshotHas(snap, "beyond"), "Entities past far range omitted");
+
+    interest.collect("me", state, snap);
+    assertTrue(!snap.full && snapshotHas(snap, "near") && !snapshotHas(snap, "far"),
+               "Reduced tick sends only near entities");
+    assertTrue(snap.removed.empty(), "Far entity not removed between refreshes");
+
+    interest.collect("me", state, snap);
+    interest.collect("me", state, snap);
+    assertTrue(snap.full && snapshotHas(snap, "far"), "Far entity refreshed on interval");
+
+    systems::SpatialIndexSystem index(&world);
+    index.refresh();
+    interest.setSpatialIndex(&index);
+    network::InterestManager::ClientState indexed_state;
+    interest.collect("me", indexed_state, snap);
+    assertTrue(snap.entities.size() == 3 && !snapshotHas(snap, "beyond"), "Indexed collection matches scan");
+}
+
+void testInterestFiltersSystemAndDocked() {
+    std::cout << "\n=== Interest System/Docked Filtering ===" << std::endl;
+    ecs::World world;
+    auto* me = placeAt(world, "me", 0.0f, 0.0f, 0.0f);
+    addComp<components::SystemLocation>(me)->system_id = "thyrkstad";
+    addComp<components::SystemLocation>(placeAt(world, "local", 1000.0f, 0.0f, 0.0f))->system_id = "thyrkstad";
+    addComp<components::SystemLocation>(placeAt(world, "elsewhere", 1000.0f, 0.0f, 0.0f))->system_id = "solari";
+    auto* docked = placeAt(world, "docked", 0.0f, 1000.0f, 0.0f);
+    addComp<components::SystemLocation>(docked)->system_id = "thyrkstad";
+    addComp<components::Docked>(docked);
+    auto* beacon = placeAt(world, "beacon", 900000.0f, 0.0f, 0.0f);
+    addComp<components::SystemLocation>(beacon)->system_id = "thyrkstad";
+    addComp<components::LODPriority>(beacon)->force_visible = true;
+    placeAt(world, "unplaced", 1000.0f, 0.0f, 0.0f);
+
+    network::InterestManager interest(&world);
+    network::InterestManager::ClientState state;
+    network::InterestManager::Snapshot snap;
+    interest.collect("me", state, snap);
+    assertTrue(snapshotHas(snap, "local"), "Same-system entity sent");
+    assertTrue(!snapshotHas(snap, "elsewhere"), "Other-system entity filtered");
+    assertTrue(!snapshotHas(snap, "docked"), "Docked entity filtered");
+    assertTrue(!snapshotHas(snap, "unplaced"), "Entity without a system filtered when home differs");
+    interest.collect("me", state, snap);
+    assertTrue(!snap.full && snapshotHas(snap, "beacon"), "force_visible entity sent every tick");
+
+    network::InterestManager::Settings settings;
+    settings.home_system = "thyrkstad";
+    interest.setSettings(settings);
+    network::InterestManager::ClientState home_state;
+    interest.collect("me", home_state, snap);
+    assertTrue(snapshotHas(snap, "unplaced") && !snapshotHas(snap, "elsewhere"),
+               "Entity without a system counts as in the home system");
+}
+
+void testGameSessionPlacesShipsInSolarSystem() {
+    std::cout << "\n=== Game Session Solar System ===" << std::endl;
+    ecs::World world;
+    GameSession session(&world, nullptr, "../data");
+    session.setSolarSystem("rimward");
+    session.spawnNPC("placed_npc", "Scout", "Falk", "Iron Corsairs", 0.0f, 0.0f, 0.0f);
+    auto* loc = world.getEntity("placed_npc")->getComponent<components::SystemLocation>();
+    assertTrue(loc && loc->system_id == "rimward", "Spawned NPC is in the session's system");
+
+    // The location survives a save and load
+    data::WorldPersistence persistence;
+    ecs::World restored;
+    assertTrue(persistence.deserializeWorld(&restored, persistence.serializeWorld(&world)),
+               "World with a located NPC reloads");
+    auto* restored_loc = restored.getEntity("placed_npc")->getComponent<components::SystemLocation>();
+    assertTrue(restored_loc && restored_loc->system_id == "rimward", "SystemLocation persisted");
+}
+
+void testInterestRemovals() {
+    std::cout << "\n=== Interest Removals ===" << std::endl;
+    ecs::World world;
+    placeAt(world, "me", 0.0f, 0.0f, 0.0f);
+    placeAt(world, "victim", 1000.0f, 0.0f, 0.0f);
+    auto* leaver = placeAt(world, "leaver", 2000.0f, 0.0f, 0.0f);
+    network::InterestManager interest(&world);
+    network::InterestManager::Settings settings;
+    settings.far_interval = 2;
+    interest.setSettings(settings);
+    network::InterestManager::ClientState state;
+    network::InterestManager::Snapshot snap;
+    interest.collect("me", state, snap);
+
+    world.destroyEntity("victim");
+    leaver->getComponent<components::Position>()->x = 9000000.0f;
+    interest.collect("me", state, snap);
+    assertTrue(snapshotRemoves(snap, "victim"), "Destroyed entity removed straight away");
+    assertTrue(snapshotHas(snap, "leaver") == false && snapshotRemoves(snap, "leaver"),
+               "Entity leaving range removed on full refresh");
+    interest.collect("me", state, snap);
+    assertTrue(snap.removed.empty(), "Removals are sent once");
+}
+
+// ==================== Snapshot Delta Tests ====================
+
+namespace {
+std::string encodeDelta(network::SnapshotDelta& delta, const ecs::Entity& entity, uint64_t sequence) {
+    std::ostringstream out;
+    bool first = true;
+    delta.writeEntity(out, entity, sequence, first);
+    return out.str();
+}
+} // namespace
+
+void testSnapshotDeltaSendsChangedFields() {
+    std::cout << "\n=== Snapshot Delta Changed Fields ===" << std::endl;
+    ecs::World world;
+    auto* ship = placeAt(world, "ship", 0.0f, 0.0f, 0.0f);
+    addComp<components::Velocity>(ship);
+    addComp<components::Health>(ship);
+    addComp<components::Ship>(ship)->ship_type = "Falk";
+    network::SnapshotDelta delta;
+
+    std::string full = encodeDelta(delta, *ship, 0);
+    assertTrue(full.find("\"pos\"") != std::string::npos && full.find("\"ship_type\":\"Falk\"") != std::string::npos,
+               "First snapshot sends every field");
+    delta.acknowledge(0);
+
+    ship->getComponent<components::Position>()->x = 10.0f;
+    std::string moved = encodeDelta(delta, *ship, 1);
+    assertTrue(moved.find("\"pos\"") != std::string::npos && moved.find("\"health\"") == std::string::npos &&
+               moved.find("ship_type") == std::string::npos, "Only changed group sent");
+
+    // Update 1 lost: position must keep being sent until it is acknowledged
+    std::string still = encodeDelta(delta, *ship, 2);
+    assertTrue(still.find("\"pos\"") != std::string::npos, "Unacknowledged change resent");
+    delta.acknowledge(2);
+    assertTrue(encodeDelta(delta, *ship, 3).empty(), "Unchanged entity omitted");
+    delta.acknowledge(1);
+    assertTrue(delta.getAcknowledged() == 2, "Stale acknowledgement ignored");
+}
+
+void testSnapshotDeltaFallsBackToFull() {
+    std::cout << "\n=== Snapshot Delta Full Fallback ===" << std::endl;
+    ecs::World world;
+    auto* ship = placeAt(world, "ship", 0.0f, 0.0f, 0.0f);
+    addComp<components::Health>(ship);
+    network::SnapshotDelta delta;
+    uint64_t baseline = 0;
+
+    encodeDelta(delta, *ship, 0);
+    assertTrue(!delta.baselineFor(1, baseline), "No baseline before any ack");
+    delta.acknowledge(0);
+    assertTrue(delta.baselineFor(1, baseline) && baseline == 0, "Acked snapshot is the baseline");
+
+    uint64_t late = network::SnapshotDelta::kMaxBaselineAge + 1;
+    assertTrue(!delta.baselineFor(late, baseline), "Baseline too old after lost acks");
+    assertTrue(encodeDelta(delta, *ship, late).find("\"health\"") != std::string::npos,
+               "Full snapshot sent when the baseline expires");
+
+    delta.forget("ship");
+    delta.acknowledge(late);
+    std::string reintroduced = encodeDelta(delta, *ship, late + 1);
+    assertTrue(reintroduced.find("\"pos\"") != std::string::npos && reintroduced.find("\"health\"") != std::string::npos,
+               "Forgotten entity resent in full");
+}
+
+void testSnapshotDeltaResendsAfterDroppedUpdate() {
+    std::cout << "\n=== Snapshot Delta Dropped Update ===" << std::endl;
+    ecs::World world;
+    auto* far = placeAt(world, "far", 0.0f, 0.0f, 0.0f);
+    addComp<components::Health>(far);
+    auto* fresh = placeAt(world, "fresh", 0.0f, 0.0f, 0.0f);
+    addComp<components::Health>(fresh);
+    addComp<components::Ship>(fresh)->ship_type = "Falk";
+    network::SnapshotDelta delta;
+
+    encodeDelta(delta, *far, 0);
+    delta.acknowledge(0);
+
+    // Update 1 carries a far-tier change and a new entity, then is dropped
+    // from the send queue; update 2 skips both (far tier) and is acked
+    far->getComponent<components::Health>()->hull_hp = 7.0f;
+    assertTrue(encodeDelta(delta, *far, 1).find("\"health\"") != std::string::npos, "Change sent in update 1");
+    encodeDelta(delta, *fresh, 1);
+    delta.acknowledge(2);
+
+    std::string resent = encodeDelta(delta, *far, 3);
+    assertTrue(resent.find("\"health\"") != std::string::npos && resent.find("\"pos\"") == std::string::npos,
+               "Change from the dropped update resent after a later ack");
+    std::string reintroduced = encodeDelta(delta, *fresh, 3);
+    assertTrue(reintroduced.find("\"pos\"") != std::string::npos &&
+               reintroduced.find("\"ship_type\":\"Falk\"") != std::string::npos,
+               "Entity first sent in the dropped update resent in full");
+
+    // Once an update carrying them is acked, the deltas shrink again
+    delta.acknowledge(1);
+    delta.acknowledge(3);
+    assertTrue(encodeDelta(delta, *far, 4).empty() && encodeDelta(delta, *fresh, 4).empty(),
+               "Acked update syncs the entities");
+}
+
+// ==================== Wire Format Tests ====================
+
+void testWireFormatPrimitives() {
+    std::cout << "\n=== Wire Format Primitives ===" << std::endl;
+    std::string buf;
+    network::wire::Writer w(buf);
+    w.varint(300);
+    w.svarint(-3);
+    w.quantized(1234.56f, network::wire::kPositionStep);
+    w.angle(-1.5f);
+    w.str("abc");
+    assertTrue(buf.size() == 2 + 1 + 3 + 2 + 4, "Small values encode compactly");
+
+    network::wire::Reader r(buf.data(), buf.size());
+    uint64_t u = 0;
+    int64_t s = 0;
+    float q = 0.0f, a = 0.0f;
+    std::string str;
+    assertTrue(r.varint(u) && u == 300, "Varint round-trips");
+    assertTrue(r.svarint(s) && s == -3, "Zigzag varint round-trips");
+    assertTrue(r.quantized(q, network::wire::kPositionStep) && approxEqual(q, 1234.5625f),
+               "Quantized float within one step");
+    assertTrue(r.angle(a) && std::fabs(a + 1.5f) < 0.001f, "Angle round-trips");
+    assertTrue(r.str(str) && str == "abc" && r.remaining() == 0, "String round-trips");
+    uint8_t extra = 0;
+    assertTrue(!r.u8(extra) && !r.ok(), "Read past end fails");
+}
+
+void testWireFormatStateUpdateRoundTrip() {
+    std::cout << "\n=== Wire Format State Update ===" << std::endl;
+    network::wire::StateUpdate msg;
+    msg.sequence = 77;
+    msg.has_baseline = true;
+    msg.baseline = 75;
+    msg.timestamp = 123456789;
+    msg.removed = {"gone"};
+    network::wire::EntityState e;
+    e.id = "ship";
+    e.fields = network::wire::EntityState::kPos | network::wire::EntityState::kShip;
+    e.x = -5000.25f;
+    e.ship_type = "Falk";
+    msg.entities.push_back(e);
+
+    std::string frame;
+    network::wire::encode(msg, frame);
+    network::wire::Header header;
+    size_t frame_size = 0;
+    assertTrue(network::wire::isFrame(frame), "Frame starts with magic byte");
+    assertTrue(network::wire::peekFrame(frame.data(), frame.size(), header, frame_size)
+               == network::wire::FrameStatus::Complete && frame_size == frame.size() &&
+               header.type == network::wire::Type::StateUpdate, "Header describes the frame");
+    assertTrue(network::wire::peekFrame(frame.data(), frame.size() - 1, header, frame_size)
+               == network::wire::FrameStatus::Incomplete, "Truncated frame is incomplete");
+
+    network::wire::StateUpdate out;
+    assertTrue(network::wire::decode(frame.data() + network::wire::kHeaderSize,
+                                     frame.size() - network::wire::kHeaderSize, out),
+               "State update decodes");
+    assertTrue(out.sequence == 77 && out.has_baseline && out.baseline == 75 &&
+               out.timestamp == 123456789 && out.removed.size() == 1 && out.removed[0] == "gone",
+               "Header fields round-trip");
+    assertTrue(out.entities.size() == 1 && out.entities[0].fields == e.fields &&
+               approxEqual(out.entities[0].x, -5000.25f) && out.entities[0].ship_type == "Falk",
+               "Entity fields round-trip");
+    assertTrue(!network::wire::decode(frame.data() + network::wire::kHeaderSize, 5, out),
+               "Truncated payload rejected");
+
+    std::string json = "{\"type\":\"connect\"}";
+    assertTrue(!network::wire::isFrame(json) &&
+               network::wire::peekFrame(json.data(), json.size(), header, frame_size)
+               == network::wire::FrameStatus::Invalid, "JSON is not a frame");
+}
+
+void testSnapshotDeltaBinaryMask() {
+    std::cout << "\n=== Snapshot Delta Binary Mask ===" << std::endl;
+    ecs::World world;
+    auto* ship = placeAt(world, "ship", 0.0f, 0.0f, 0.0f);
+    addComp<components::Health>(ship);
+    network::SnapshotDelta delta;
+    network::wire::EntityState state;
+
+    assertTrue(delta.writeEntity(state, *ship, 0) &&
+               state.fields == (network::wire::EntityState::kPos | network::wire::EntityState::kHealth),
+               "First snapshot sets every present field");
+    delta.acknowledge(0);
+    ship->getComponent<components::Health>()->shield_hp = 1.0f;
+    assertTrue(delta.writeEntity(state, *ship, 1) && state.fields == network::wire::EntityState::kHealth &&
+               approxEqual(state.shield, 1.0f), "Only the changed field is flagged");
+}
+
+void testFragmentCacheSharedEncoding() {
+    std::cout << "\n=== Fragment Cache Shared Encoding ===" << std::endl;
+    ecs::World world;
+    auto* ship = placeAt(world, "ship", 100.0f, 0.0f, 0.0f);
+    addComp<components::Health>(ship);
+    network::FragmentCache cache;
+    cache.beginTick();
+
+    // Cached JSON matches the uncached encoder, and two clients share it
+    network::SnapshotDelta plain, first_client, second_client;
+    std::ostringstream expected, out_a, out_b;
+    bool f0 = true, f1 = true, f2 = true;
+    plain.writeEntity(expected, *ship, 0, f0);
+    first_client.writeEntity(out_a, cache.get(*ship), 0, f1);
+    second_client.writeEntity(out_b, cache.get(*ship), 0, f2);
+    assertTrue(out_a.str() == expected.str() && out_b.str() == expected.str(),
+               "Cached JSON matches the per-client encoding");
+    assertTrue(cache.size() == 1 && cache.getEncodeCount() == 2,
+               "Each field group is encoded once for both clients");
+
+    // Binary records splice into the same frame the struct encoder builds
+    network::SnapshotDelta plain_bin, cached_bin;
+    network::wire::StateUpdate msg;
+    msg.sequence = 0;
+    msg.entities.resize(1);
+    plain_bin.writeEntity(msg.entities[0], *ship, 0);
+    std::string reference;
+    network::wire::encode(msg, reference);
+    std::string records, frame;
+    assertTrue(cached_bin.appendEntityRecord(records, cache.get(*ship), 0), "Record appended");
+    network::wire::encode(msg, records, 1, frame);
+    assertTrue(frame == reference, "Cached binary frame matches the struct encoder");
+
+    // A new tick captures the moved entity again
+    ship->getComponent<components::Position>()->x = 200.0f;
+    cache.beginTick();
+    assertTrue(approxEqual(cache.get(*ship).fields().pos[0], 200.0f) && cache.getEncodeCount() == 0,
+               "beginTick drops last tick's fragments");
+}
+
+void testMessageBufferSharing() {
+    std::cout << "\n=== Message Buffer Sharing ===" << std::endl;
+    network::MessageBuffer json("{\"type\":\"chat\"}");
+    assertTrue(json.str() == "{\"type\":\"chat\"}\n", "JSON is newline-terminated once");
+    network::MessageBuffer copy = json;
+    assertTrue(copy.data() == json.data() && json.useCount() == 2, "Copies share the bytes");
+
+    std::string frame;
+    network::wire::encode(network::wire::StateAck{7}, frame);
+    network::MessageBuffer binary(frame);
+    assertTrue(binary.str() == frame, "Binary frames are kept as they are");
+    assertTrue(network::MessageBuffer().empty(), "Default buffer is empty");
+}
+
+// ==================== Receive Buffer Tests ====================
+
+namespace {
+void feed(network::ReceiveBuffer& buffer, const std::string& bytes) {
+    size_t offset = 0;
+    while (offset < bytes.size()) {
+        size_t space = 0;
+        char* dest = buffer.writeSpace(space);
+        size_t n = std::min(space, bytes.size() - offset);
+        std::memcpy(dest, bytes.data() + offset, n);
+        buffer.commit(n);
+        offset += n;
+    }
+}
+} // namespace
+
+void testReceiveBufferSplitsAndJoins() {
+    std::cout << "\n=== Receive Buffer Framing ===" << std::endl;
+    network::ReceiveBuffer buffer;
+    std::string msg;
+
+    feed(buffer, "{\"a\":1}\n{\"b\":2}\r\n\n{\"c\"");
+    assertTrue(buffer.next(msg) == network::ReceiveBuffer::Status::Message && msg == "{\"a\":1}",
+               "First coalesced message extracted");
+    assertTrue(buffer.next(msg) == network::ReceiveBuffer::Status::Message && msg == "{\"b\":2}",
+               "Second message without CR");
+    assertTrue(buffer.next(msg) == network::ReceiveBuffer::Status::NeedMore, "Partial message waits");
+    feed(buffer, ":3}\n");
+    assertTrue(buffer.next(msg) == network::ReceiveBuffer::Status::Message && msg == "{\"c\":3}",
+               "Message split across reads joined");
+
+    network::wire::StateAck ack;
+    ack.sequence = 42;
+    std::string frame;
+    network::wire::encode(ack, frame);
+    feed(buffer, frame.substr(0, 3));
+    assertTrue(buffer.next(msg) == network::ReceiveBuffer::Status::NeedMore, "Partial frame header waits");
+    feed(buffer, frame.substr(3) + "{\"d\":4}\n");
+    assertTrue(buffer.next(msg) == network::ReceiveBuffer::Status::Message && msg == frame,
+               "Binary frame extracted by length");
+    assertTrue(buffer.next(msg) == network::ReceiveBuffer::Status::Message && msg == "{\"d\":4}",
+               "JSON after binary frame");
+}
+
+void testReceiveBufferWrapsAndGrows() {
+    std::cout << "\n=== Receive Buffer Ring ===" << std::endl;
+    network::ReceiveBuffer buffer(64 * 1024);
+    std::string msg;
+    size_t initial = buffer.capacity();
+
+    // The start of the next message is always pending, so the data
+    // wraps around the end of the ring
+    bool intact = true;
+    std::string line(300, 'x');
+    feed(buffer, "#");
+    for (int i = 0; i < 100; ++i) {
+        feed(buffer, line + std::to_string(i) + "\n#");
+        intact = intact && buffer.next(msg) == network::ReceiveBuffer::Status::Message &&
+                 msg == "#" + line + std::to_string(i);
+    }
+    assertTrue(intact && buffer.capacity() == initial, "Ring reuses its storage");
+
+    std::string big(20000, 'y');
+    feed(buffer, big + "\n");
+    assertTrue(buffer.next(msg) == network::ReceiveBuffer::Status::Message && msg == "#" + big,
+               "Buffer grows for a large message");
+
+    feed(buffer, std::string(70000, 'z'));
+    assertTrue(buffer.next(msg) == network::ReceiveBuffer::Status::Error, "Oversized message rejected");
+
+    network::ReceiveBuffer bad;
+    feed(bad, std::string("\xE7\x7F\x01\x00\x00\x00\x00\x00", 8));
+    assertTrue(bad.next(msg) == network::ReceiveBuffer::Status::Error, "Unknown frame version rejected");
+}
+
+// ==================== TCP Server Tests ====================
+
+#ifdef EVE_TCP_SERVER_EPOLL
+namespace {
+int countProcessThreads() {
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.compare(0, 8, "Threads:") == 0) return std::stoi(line.substr(8));
+    }
+    return -1;
+}
+
+template <typename Pred>
+bool waitFor(Pred pred, int timeout_ms = 5000) {
+    for (int waited = 0; waited < timeout_ms; waited += 5) {
+        if (pred()) return true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return pred();
+}
+} // namespace
+
+void testTCPServerLoopbackClients() {
+    std::cout << "\n=== TCP Server Loopback Clients ===" << std::endl;
+    constexpr int kClients = 200;
+    constexpr int kMessages = 3;
+
+    network::TCPServer server("127.0.0.1", 0, kClients + 10, 2);
+    std::atomic<int> received{0};
+    server.setMessageHandler([&](const network::ClientConnection& client, const std::string& msg) {
+        received++;
+        server.sendToClient(client, "{\"echo\":" + msg + "}");
+    });
+    assertTrue(server.initialize() && server.getPort() != 0, "Server binds an ephemeral port");
+    int threads_before = countProcessThreads();
+    server.start();
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(server.getPort());
+    inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+
+    std::vector<int> clients;
+    for (int i = 0; i < kClients; ++i) {
+        int fd = socket(AF_INET, SOCK_STREAM, 0);
+        if (connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+            close(fd);
+            break;
+        }
+        clients.push_back(fd);
+    }
+    assertTrue(static_cast<int>(clients.size()) == kClients, "All clients connect");
+    assertTrue(waitFor([&] { return server.getClientCount() == kClients; }), "Server tracks every client");
+    assertTrue(countProcessThreads() - threads_before == 2, "Connections share the I/O threads");
+
+    // Each client pipelines all its messages in one write
+    for (int fd : clients) {
+        std::string burst;
+        for (int m = 0; m < kMessages; ++m) burst += std::to_string(m) + "\n";
+        send(fd, burst.data(), burst.size(), 0);
+    }
+
+    bool all_echoed = true;
+    std::string expected = "{\"echo\":0}\n{\"echo\":1}\n{\"echo\":2}\n";
+    for (int fd : clients) {
+        std::string reply;
+        char buf[256];
+        while (reply.size() < expected.size()) {
+            ssize_t n = recv(fd, buf, sizeof(buf), 0);
+            if (n <= 0) break;
+            reply.append(buf, static_cast<size_t>(n));
+        }
+        all_echoed = all_echoed && reply == expected;
+    }
+    assertTrue(received == kClients * kMessages, "Every pipelined message dispatched");
+    assertTrue(all_echoed, "Replies arrive framed and in order");
+
+    for (int fd : clients) close(fd);
+    assertTrue(waitFor([&] { return server.getClientCount() == 0; }), "Closed clients are reaped");
+    server.stop();
+}
+
+void testTCPServerSendBackpressure() {
+    std::cout << "\n=== TCP Server Send Backpressure ===" << std::endl;
+
+    network::TCPServer server("127.0.0.1", 0, 10, 1);
+    assertTrue(server.initialize(), "Server initializes");
+    server.start();
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(server.getPort());
+    inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+    assertTrue(waitFor([&] { return server.getClientCount() == 1; }), "Client connects");
+    network::ClientConnection client = server.getClients()[0];
+
+    // Within a batch nothing is flushed, so the queue passes the high-water
+    // mark and older state updates give way to newer ones
+    const int updates = 2000;
+    bool all_queued = true;
+    {
+        network::TCPServer::SendBatch batch;
+        all_queued = server.sendToClient(client, "{\"first\":1}");
+        for (int i = 0; i < updates; ++i) {
+            std::string update = "{\"update\":" + std::to_string(i) + ",\"pad\":\""
+                                 + std::string(2000, 'x') + "\"}";
+            all_queued = server.sendToClient(client, update, true) && all_queued;
+        }
+        all_queued = server.sendToClient(client, "{\"last\":1}") && all_queued;
+    }
+    assertTrue(all_queued, "Lagging client is kept while updates can be dropped");
+    assertTrue(server.getDroppedMessages() > static_cast<uint64_t>(updates) / 2,
+               "Stale updates dropped above the high-water mark");
+
+    std::string stream;
+    char buf[65536];
+    while (stream.find("{\"last\":1}\n") == std::string::npos) {
+        ssize_t n = recv(fd, buf, sizeof(buf), 0);
+        if (n <= 0) break;
+        stream.append(buf, static_cast<size_t>(n));
+    }
+    size_t received_updates = 0;
+    for (size_t pos = 0; (pos = stream.find("\"update\":", pos)) != std::string::npos; ++pos) {
+        ++received_updates;
+    }
+    std::string newest = "{\"update\":" + std::to_string(updates - 1) + ",";
+    assertTrue(stream.compare(0, 12, "{\"first\":1}\n") == 0, "Reliable message sent first is kept");
+    assertTrue(received_updates + server.getDroppedMessages() == static_cast<uint64_t>(updates),
+               "Every update is either delivered or counted as dropped");
+    assertTrue(stream.find(newest) != std::string::npos &&
+               stream.find(newest) < stream.find("{\"last\":1}"), "Newest update delivered before later messages");
+
+    // Reliable output past the hard limit drops the client instead
+    bool accepted = true;
+    {
+        network::TCPServer::SendBatch batch;
+        std::string chunk(64 * 1024, 'y');
+        for (int i = 0; i < 100 && accepted; ++i) {
+            accepted = server.sendToClient(client, chunk);
+        }
+    }
+    assertTrue(!accepted, "Send refused past kMaxPendingOutput");
+    assertTrue(waitFor([&] { return server.getClientCount() == 0; }), "Slow client is disconnected");
+
+    close(fd);
+    server.stop();
+}
+
+void testTCPServerFlushFailureWithHangup() {
+    std::cout << "\n=== TCP Server Flush Failure With Hangup ===" << std::endl;
+
+    network::TCPServer server("127.0.0.1", 0, 10, 1);
+    std::atomic<bool> handler_entered{false};
+    std::atomic<bool> release{false};
+    server.setMessageHandler([&](const network::ClientConnection&, const std::string&) {
+        handler_entered = true;
+        while (!release) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    });
+    std::atomic<int> disconnects{0};
+    server.setDisconnectHandler([&](const network::ClientConnection&) { disconnects++; });
+    assertTrue(server.initialize(), "Server initializes");
+    server.start();
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(server.getPort());
+    inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+    int blocker = socket(AF_INET, SOCK_STREAM, 0);
+    connect(blocker, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+    assertTrue(waitFor([&] { return server.getClientCount() == 1; }), "First client connects");
+    int victim = socket(AF_INET, SOCK_STREAM, 0);
+    connect(victim, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+    assertTrue(waitFor([&] { return server.getClientCount() == 2; }), "Second client connects");
+    network::ClientConnection victim_info;
+    for (const auto& c : server.getClients()) {
+        sockaddr_in local{};
+        socklen_t len = sizeof(local);
+        getsockname(victim, reinterpret_cast<sockaddr*>(&local), &len);
+        if (c.port == ntohs(local.sin_port)) victim_info = c;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    // Park the only I/O thread in a handler so the next events pile up:
+    // first the wake for the queued flush, then the victim's reset
+    send(blocker, "1\n", 2, 0);
+    assertTrue(waitFor([&] { return handler_entered.load(); }), "I/O thread is parked");
+    assertTrue(server.sendToClient(victim_info, "{\"queued\":1}"), "Flush queued for the victim");
+    linger hard{1, 0};
+    setsockopt(victim, SOL_SOCKET, SO_LINGER, &hard, sizeof(hard));
+    close(victim);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    release = true;
+
+    assertTrue(waitFor([&] { return server.getClientCount() == 1; }), "Reset client is removed");
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    assertTrue(disconnects == 1, "Disconnect reported exactly once");
+    assertTrue(server.getClientCount() == 1, "Surviving client is untouched");
+
+    close(blocker);
+    assertTrue(waitFor([&] { return server.getClientCount() == 0; }), "Remaining client is reaped");
+    server.stop();
+}
+
+// ==================== Server Replay Tests ====================
+
+void testServerReplayMatchesRecordedRun() {
+    std::cout << "\n=== Server Replay Matches Recorded Run ===" << std::endl;
+
+    const std::string dir = "/tmp/eve_replay_e2e";
+    const std::string config_path = dir + "/server.json";
+    const std::string recording = dir + "/session.atlastr";
+    mkdir(dir.c_str(), 0755);
+    {
+        std::ofstream config(config_path);
+        config << "{\n"
+               << "  \"host\": \"127.0.0.1\",\n"
+               << "  \"port\": 0,\n"
+               << "  \"max_connections\": 8,\n"
+               << "  \"persistent_world\": false,\n"
+               << "  \"auto_save\": false,\n"
+               << "  \"use_whitelist\": false,\n"
+               << "  \"use_steam\": false,\n"
+               << "  \"tick_rate\": 60.0,\n"
+               << "  \"ai_near_range\": 100.0,\n"
+               << "  \"ai_think_interval\": 4,\n"
+               << "  \"ai_think_budget_turns\": 5,\n"
+               << "  \"data_path\": \"../data\",\n"
+               << "  \"save_path\": \"" << dir << "\",\n"
+               << "  \"log_path\": \"" << dir << "\",\n"
+               << "  \"log_async\": false,\n"
+               << "  \"metrics_file\": \"\",\n"
+               << "  \"tick_recording\": \"" << recording << "\"\n"
+               << "}\n";
+    }
+
+    std::string live_fingerprint;
+    uint64_t live_handle = 0;
+    {
+        Server live(config_path);
+        assertTrue(live.initialize(), "Live server initializes");
+        GameSession* session = live.getGameSession();
+
+        // A destroyed entity leaves a freed slot with a bumped generation
+        // for the next spawn to reuse, so handles differ from a fresh world
+        session->spawnNPC("replay_doomed", "Doomed", "Falk", "Iron Corsairs", 0.0f, 0.0f, 0.0f);
+        session->spawnNPC("replay_npc_a", "Raider A", "Vipere", "Venom Syndicate", 400.0f, 0.0f, 300.0f);
+        live.getWorld()->destroyEntity("replay_doomed");
+        session->spawnNPC("replay_npc_b", "Raider B", "Falk", "Iron Corsairs", -300.0f, 0.0f, 500.0f);
+        session->spawnNPC("replay_npc_c", "Raider C", "Sentinel", "Crimson Order", 700.0f, 0.0f, -200.0f);
+        live_handle = live.getWorld()->getHandle("replay_npc_b").toBits();
+
+        std::thread loop([&live] { live.run(); });
+
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(live.getPort());
+        inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+        int fd = socket(AF_INET, SOCK_STREAM, 0);
+        connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+        auto say = [fd](const std::string& message) {
+            std::string line = message + "\n";
+            send(fd, line.data(), line.size(), MSG_NOSIGNAL);
+        };
+        std::string received;
+        auto drain = [&]() {
+            char buf[65536];
+            ssize_t n;
+            while ((n = recv(fd, buf, sizeof(buf), MSG_DONTWAIT)) > 0) {
+                received.append(buf, static_cast<size_t>(n));
+            }
+        };
+
+        say("{\"type\":\"connect\",\"data\":{\"player_id\":\"replay_pilot\",\"character_name\":\"Pilot\"}}");
+        assertTrue(waitFor([&] { drain(); return received.find("connect_ack") != std::string::npos; }),
+                   "Client connected to the live server");
+        for (int i = 0; i < 20; ++i) {
+            say("{\"type\":\"input_move\",\"data\":{\"velocity\":{\"x\":" + std::to_string(i % 3 - 1) +
+                ",\"y\":0,\"z\":1}}}");
+            if (i == 5) say("{\"type\":\"target_lock\",\"data\":{\"target_id\":\"replay_npc_a\"}}");
+            if (i % 5 == 0) {
+                say("{\"type\":\"module_activate\",\"data\":{\"slot_index\":0,\"target_id\":\"replay_npc_a\"}}");
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(15));
+            drain();
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        drain();
+
+        live.requestStop();
+        loop.join();
+        live_fingerprint = live.getWorldFingerprint();
+        close(fd);
+        live.stop();
+    }
+
+    Server replayer(config_path);
+    assertTrue(replayer.replay(recording), "Recording replays");
+    assertTrue(replayer.getWorld()->getHandle("replay_npc_b").toBits() == live_handle,
+               "Entity keeps its recorded handle on replay");
+    assertTrue(replayer.getWorld()->getEntity("replay_doomed") == nullptr &&
+               replayer.getWorld()->getEntity("npc_venom_1") != nullptr,
+               "Replay starts from the recorded world only");
+    assertTrue(!live_fingerprint.empty() && replayer.getWorldFingerprint() == live_fingerprint,
+               "Replayed world matches the recorded run");
+    std::remove(recording.c_str());
+    std::remove(config_path.c_str());
+}
+#endif
+
+// ==================== MPSC Queue Tests ====================
+
+void testMpscQueueMultipleProducers() {
+    std::cout << "\n=== MPSC Queue Multiple Producers ===" << std::endl;
+
+    utils::MpscQueue<std::pair<int, int>> queue;
+    assertTrue(queue.empty(), "New queue is empty");
+
+    const int producers = 4;
+    const int per_producer = 20000;
+    std::atomic<int> finished{0};
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&, p]() {
+            for (int i = 0; i < per_producer; ++i) {
+                queue.push({p, i});
+            }
+            finished.fetch_add(1);
+        });
+    }
+
+    // Consume concurrently; each producer's items must arrive in order
+    std::vector<int> next(producers, 0);
+    bool ordered = true;
+    int popped = 0;
+    std::pair<int, int> item;
+    while (popped < producers * per_producer) {
+        if (queue.pop(item)) {
+            if (item.second != next[item.first]) ordered = false;
+            next[item.first] = item.second + 1;
+            ++popped;
+        } else if (finished.load() == producers && queue.empty()) {
+            break;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    for (auto& t : threads) t.join();
+    while (queue.pop(item)) ++popped;
+
+    assertTrue(popped == producers * per_producer, "Every pushed item is popped once");
+    assertTrue(ordered, "Items from one producer keep their order");
+    assertTrue(queue.empty(), "Queue is empty after draining");
+}
+
 int main() {
     std::cout << "========================================" << std::endl;
     std::cout << "EVE OFFLINE C++ Server System Tests" << std::endl;
@@ -13183,6 +15708,9 @@ int main() {
     testLoggerLevels();
     testLoggerFileOutput();
     testLoggerLevelFiltering();
+    testLoggerAsyncWriter();
+    testLoggerAsyncDropsWhenFull();
+    testLoggerRotation();
     
     // ServerMetrics tests
     testMetricsTickTiming();
@@ -13190,6 +15718,10 @@ int main() {
     testMetricsUptime();
     testMetricsSummary();
     testMetricsResetWindow();
+    testTickSchedulerPolicies();
+    testTickSchedulerRealTime();
+    testLatencyHistogramPercentiles();
+    testProfilerScopesAcrossThreads();
 
     // Mission system tests
     testMissionAcceptAndComplete();
@@ -13264,6 +15796,9 @@ int main() {
     testMarketBuyFromMarket();
     testMarketPriceQueries();
     testMarketOrderExpiry();
+    testMarketPriceTimePriorityAndCancel();
+    testMarketRejectsInvalidPrices();
+    testOrderBookExpiryHeap();
 
     // Corporation system tests
     testCorpCreate();
@@ -13868,6 +16403,13 @@ int main() {
     testCompressedWorldPersistence();
     testCompressedChecksum();
     testCompressedVsUncompressedSize();
+    testWorldSnapshotIsDetached();
+    testAsyncWorldSaver();
+    testWorldJournalIncremental();
+    testWorldJournalCompactionAndTornTail();
+    testWorldBinaryFormatRoundTrip();
+    testWorldBinaryFormatRejectsCorruptionAndConverts();
+    testTickRecordingRoundTrip();
 
     // Phase 2: Star System State System tests
     testStarSystemStateInitialize();
@@ -13892,6 +16434,77 @@ int main() {
     testNPCArchetypeIntentEveryoneFleesExtremeThreat();
     testNPCArchetypeIntentPatrolDefends();
 
+    // ECS Component Storage tests
+    testComponentPoolPointerStability();
+    testComponentPoolReplaceKeepsAddress();
+    testComponentPoolRemoveAndDestroy();
+    testWorldForEachVisitsPool();
+
+    // ECS Cached Query tests
+    testWorldViewTracksStructuralChanges();
+    testWorldViewSharedAcrossOrderings();
+    testWorldViewRecreatedEntity();
+
+    // ECS Entity Handle tests
+    testEntityHandleLookup();
+    testEntityHandleStaleAfterDestroy();
+    testAIResolveTargetCachesHandle();
+    
+    // ECS parallel scheduler tests
+    testSchedulerConflictRules();
+    testSchedulerBuildsServerGraph();
+    testSchedulerRunsIndustrySystemsInParallel();
+    testSchedulerParallelMatchesSequential();
+    testTaskGroupRunsAndPropagates();
+    
+    // ECS parallel_for and command buffer tests
+    testParallelForEachVisitsAll();
+    testCommandBufferDefersDuringUpdate();
+    testTimerWheelFiresOnDueTick();
+    testTimedComponentsVisitOnlyWhenDue();
+    testWorldRestoresHandleLayout();
+    testCombatDamageEventDeferredInTick();
+    
+    // Spatial index tests
+    testSpatialIndexQueriesMatchBruteForce();
+    testSpatialIndexIncrementalUpdate();
+    testAISpatialIndexSameTarget();
+    testAIThinkScheduling();
+    testLODCullingWithSpatialIndex();
+    
+    // Interest management tests
+    testInterestNearEveryTickFarOnInterval();
+    testInterestFiltersSystemAndDocked();
+    testGameSessionPlacesShipsInSolarSystem();
+    testInterestRemovals();
+    
+    // Snapshot delta tests
+    testSnapshotDeltaSendsChangedFields();
+    testSnapshotDeltaFallsBackToFull();
+    testSnapshotDeltaResendsAfterDroppedUpdate();
+    
+    // Wire format tests
+    testWireFormatPrimitives();
+    testWireFormatStateUpdateRoundTrip();
+    testSnapshotDeltaBinaryMask();
+    testFragmentCacheSharedEncoding();
+    testMessageBufferSharing();
+    
+    // Receive buffer tests
+    testReceiveBufferSplitsAndJoins();
+    testReceiveBufferWrapsAndGrows();
+    
+    // MPSC queue tests
+    testMpscQueueMultipleProducers();
+    
+    // TCP server tests
+#ifdef EVE_TCP_SERVER_EPOLL
+    testTCPServerLoopbackClients();
+    testTCPServerSendBackpressure();
+    testTCPServerFlushFailureWithHangup();
+    testServerReplayMatchesRecordedRun();
+#endif
+
     std::cout << "\n========================================" << std::endl;
     std::cout << "Results: " << testsPassed << "/" << testsRun << " tests passed" << std::endl;
     std::cout << "========================================" << std::endl;